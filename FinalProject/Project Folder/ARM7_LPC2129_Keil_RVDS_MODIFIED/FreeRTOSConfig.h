@@ -52,6 +52,37 @@
 #define configUSE_STATS_FORMATTING_FUNCTIONS  (1)
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #define portGET_RUN_TIME_COUNTER_VALUE()	(T1TC)
+
+/* Net execution time of every job, measured with T1TC (see
+vTaskGetJobTimeStatsText()).  Timer 1 counts at PCLK / (T1PR + 1), 59940 Hz
+with configTimer1(), so one bin of 60 counts is about 1 ms. */
+#define configGENERATE_JOB_TIME_STATS	(1)
+#define configJOB_TIME_HISTOGRAM_BINS	(8)
+#define configJOB_TIME_HISTOGRAM_BIN_WIDTH	(60)
+
+/* Longest critical sections and scheduler suspensions per call site (see
+uxTaskGetCriticalSectionStats(), or watch xSectionStats in the debugger).  They
+are timed with T1TC as well, so a count is 16.7 us: the first bin holds the
+sections shorter than that and the last one those of 64 counts (1 ms) or more. */
+#define configGENERATE_CRITICAL_SECTION_STATS	(1)
+#define configCRITICAL_SECTION_SITES			(10)
+#define configCRITICAL_SECTION_HISTOGRAM_BINS	(8)
+#define configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH	(1)
+
+/* Allocations and frees of the heap, to size configTOTAL_HEAP_SIZE (see
+heap_trace.h).  Add Source/heap_trace.c to the project, set this to 1, send the
+text of vHeapTraceGetText() over the UART and pass it to Tools/heaptrace.py
+with --total-heap-size 13312.  The 32 events take 1 KB of the 16 KB of RAM the
+heap lives in as well.  They are time stamped with T1TC. */
+#define configGENERATE_HEAP_TRACE		(0)
+#define configHEAP_TRACE_LENGTH			(32)
+
+/* High resolution timers (see hrtimer.h) run from match register 0 of timer 1,
+so they count at the same 59940 Hz as the stats above, 16.7 us a count.  A
+smaller T1PR in configTimer1() makes them finer, but the bin widths above must
+then be scaled to match. */
+#define configUSE_HR_TIMERS				(0)
+#define configHR_TIMER_COUNTS_PER_SECOND	( configCPU_CLOCK_HZ / 1001UL )
 #define configUSE_TIME_SLICING 0
 
 
@@ -86,6 +117,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetSchedulerState	1
 
 
 
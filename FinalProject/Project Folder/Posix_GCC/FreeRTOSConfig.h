@@ -0,0 +1,135 @@
+/*
+ * FreeRTOS V202112.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions for the Posix simulator build.
+ *
+ * The kernel and scheduler options mirror the LPC2129 project in
+ * ARM7_LPC2129_Keil_RVDS_MODIFIED so that a task set behaves the same way on
+ * the host as it does on the board.  Only the sizes that depend on the host
+ * (stacks run on pthreads, so they must be at least PTHREAD_STACK_MIN) and the
+ * run time statistics source differ.
+ *
+ * See http://www.freertos.org/a00110.html
+ *----------------------------------------------------------*/
+
+/* The scheduler can be selected from the command line (see Makefile) so the
+same task set can be run through both the EDF and the fixed priority kernel. */
+#ifndef configUSE_EDF_SCHEDULER
+	#define configUSE_EDF_SCHEDULER	(1U)	/* Enable/Disable EDF Scheduling */
+#endif
+#define EDF_IDLE_PERIOD					(100U)
+
+#define configUSE_APPLICATION_TASK_TAG (1)
+#define INCLUDE_xTaskGetCurrentTaskHandle	(1)
+
+#define configGENERATE_RUN_TIME_STATS	(1)
+#define configUSE_STATS_FORMATTING_FUNCTIONS  (1)
+
+/* Per job execution times.  The run time counter is the runner's virtual
+clock (see main.c), so the measured times are exact and a job of the task set
+measures its wcet plus the overheads it paid. */
+#define configGENERATE_JOB_TIME_STATS	(1)
+#define configJOB_TIME_HISTOGRAM_BINS	(16)
+#define configJOB_TIME_HISTOGRAM_BIN_WIDTH	( ulSimHistogramBinWidth )
+#define portALT_GET_RUN_TIME_COUNTER_VALUE( ulCountValue )	( ulCountValue ) = ulSimRunTimeCounter()
+
+/* Duration of every critical section and scheduler suspension, per call site.
+They take no virtual time, so they are timed with the host's monotonic clock in
+nanoseconds.  The histogram starts at 100 ns and its last bin counts all
+sections of 100 us or more. */
+#define configGENERATE_CRITICAL_SECTION_STATS	(1)
+#define configCRITICAL_SECTION_SITES			(64)
+#define configCRITICAL_SECTION_HISTOGRAM_BINS	(12)
+#define configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH	(100)
+#define portGET_CRITICAL_SECTION_TIME()		ulSimHostNanoseconds()
+
+/* Every allocation and free of the heap (see heap_trace.h), time stamped with
+the virtual clock.  The runner prints them after the schedule, for
+FinalProject/Tools/heaptrace.py. */
+#define configGENERATE_HEAP_TRACE		(1)
+#define configHEAP_TRACE_LENGTH			(256)
+#define portGET_HEAP_TRACE_TIME()		ulSimRunTimeCounter()
+#define configUSE_TIME_SLICING 0
+
+#define configUSE_PREEMPTION		1
+#define configUSE_IDLE_HOOK			1
+#define configUSE_TICK_HOOK			1
+#define configCPU_CLOCK_HZ			( ( unsigned long ) 60000000 )
+#ifndef configTICK_RATE_HZ
+	#define configTICK_RATE_HZ		( ( TickType_t ) 1000 )
+#endif
+#define configMAX_PRIORITIES		( 32 )
+#define configMINIMAL_STACK_SIZE	( ( unsigned short ) 4096 )	/* Words, PTHREAD_STACK_MIN is 16K bytes. */
+#define configTOTAL_HEAP_SIZE		( ( size_t ) 32 * 1024 * 1024 )
+#define configMAX_TASK_NAME_LEN		( 16 )
+#define configUSE_TRACE_FACILITY	1
+#define configUSE_16_BIT_TICKS		0
+#define configIDLE_SHOULD_YIELD		1
+#define configCHECK_FOR_STACK_OVERFLOW	0
+
+#define configQUEUE_REGISTRY_SIZE 	0
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configSUPPORT_STATIC_ALLOCATION     0
+#define configUSE_MUTEXES			1
+#define configUSE_COUNTING_SEMAPHORES	1
+#define configUSE_TIMERS			0
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES 		0
+#define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet		1
+#define INCLUDE_uxTaskPriorityGet		1
+#define INCLUDE_vTaskDelete				1
+#define INCLUDE_vTaskCleanUpResources	0
+#define INCLUDE_vTaskSuspend			1
+#define INCLUDE_vTaskDelayUntil			1
+#define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetSchedulerState	1
+
+/* The LPC2129 build toggles GPIO pins and samples T1TC on every switch (see
+function_SwitchedIN() in FreeRTOS.h).  On the host the switches are recorded
+into the schedule trace instead so they can be compared against a reference
+schedule. */
+#ifndef __ASSEMBLER__
+	#include "SchedTrace.h"
+#endif
+
+#define traceTASK_SWITCHED_IN()		vSimTaskSwitchedIn( ( UBaseType_t ) pxCurrentTCB->pxTaskTag )
+#define traceTASK_SWITCHED_OUT()
+
+/* Abort the simulation rather than carry on with a corrupted kernel. */
+#define configASSERT( x )	if( ( x ) == 0 ) vSchedTraceAssert( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
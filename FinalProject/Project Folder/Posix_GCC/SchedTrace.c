@@ -0,0 +1,120 @@
+/*
+ * Schedule trace recorder for the Posix simulator build.  See SchedTrace.h.
+ *
+ * The recorder is called from inside the kernel (traceTASK_SWITCHED_IN() runs
+ * in vTaskSwitchContext() with interrupts masked) and from the simulated
+ * tasks, so it only writes into buffers that were allocated before the
+ * scheduler started.  Nothing is printed until the scheduler has ended.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "SchedTrace.h"
+
+typedef struct SCHED_SWITCH
+{
+	unsigned long xTime;
+	unsigned long uxTask;
+} SchedSwitch_t;
+
+typedef struct SCHED_JOB
+{
+	unsigned long uxTask;
+	unsigned long xRelease;
+	unsigned long xCompletion;
+} SchedJob_t;
+
+static SchedSwitch_t *pxSwitches = NULL;
+static SchedJob_t *pxJobs = NULL;
+static unsigned long ulMaxSwitches = 0, ulSwitchCount = 0;
+static unsigned long ulMaxJobs = 0, ulJobCount = 0;
+static unsigned long ulLostEvents = 0;
+static unsigned long uxLastTask = ~0UL;
+/*-----------------------------------------------------------*/
+
+int xSchedTraceInit( unsigned long ulSwitches, unsigned long ulJobs )
+{
+	pxSwitches = malloc( ulSwitches * sizeof( SchedSwitch_t ) );
+	pxJobs = malloc( ulJobs * sizeof( SchedJob_t ) );
+
+	if( ( pxSwitches == NULL ) || ( pxJobs == NULL ) )
+	{
+		return -1;
+	}
+
+	ulMaxSwitches = ulSwitches;
+	ulMaxJobs = ulJobs;
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vSchedTraceSwitchedIn( unsigned long uxTag, unsigned long xTime )
+{
+	/* vTaskSwitchContext() is called on every tick even when the same task is
+	selected again, so only the changes are of interest. */
+	if( uxTag != uxLastTask )
+	{
+		uxLastTask = uxTag;
+
+		if( ulSwitchCount < ulMaxSwitches )
+		{
+			pxSwitches[ ulSwitchCount ].xTime = xTime;
+			pxSwitches[ ulSwitchCount ].uxTask = uxTag;
+			ulSwitchCount++;
+		}
+		else
+		{
+			ulLostEvents++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vSchedTraceJob( unsigned long uxTask, unsigned long xRelease, unsigned long xCompletion )
+{
+	if( ulJobCount < ulMaxJobs )
+	{
+		pxJobs[ ulJobCount ].uxTask = uxTask;
+		pxJobs[ ulJobCount ].xRelease = xRelease;
+		pxJobs[ ulJobCount ].xCompletion = xCompletion;
+		ulJobCount++;
+	}
+	else
+	{
+		ulLostEvents++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vSchedTraceDump( FILE * pxFile )
+{
+unsigned long ul;
+
+	for( ul = 0; ul < ulSwitchCount; ul++ )
+	{
+		fprintf( pxFile, "switch %lu %lu\n", pxSwitches[ ul ].xTime, pxSwitches[ ul ].uxTask );
+	}
+
+	for( ul = 0; ul < ulJobCount; ul++ )
+	{
+		fprintf( pxFile, "job %lu %lu %lu\n", pxJobs[ ul ].uxTask, pxJobs[ ul ].xRelease, pxJobs[ ul ].xCompletion );
+	}
+
+	if( ulLostEvents != 0 )
+	{
+		fprintf( pxFile, "overflow %lu\n", ulLostEvents );
+	}
+
+	fflush( pxFile );
+}
+/*-----------------------------------------------------------*/
+
+void vSchedTraceAssert( const char * pcFile, int iLine )
+{
+	fprintf( stderr, "configASSERT failed: %s:%d\n", pcFile, iLine );
+	fflush( stderr );
+	_exit( 2 );
+}
+/*-----------------------------------------------------------*/
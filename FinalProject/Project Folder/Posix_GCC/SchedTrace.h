@@ -0,0 +1,73 @@
+/*
+ * Schedule trace recorder for the Posix simulator build.
+ *
+ * This header is included from FreeRTOSConfig.h, before the kernel types are
+ * defined, so only native C types are used in the prototypes below.  On this
+ * port TickType_t and UBaseType_t are both unsigned long.
+ */
+
+#ifndef SCHED_TRACE_H
+#define SCHED_TRACE_H
+
+#include <stdio.h>
+
+/* Maximum number of tasks that can be recorded, excluding the idle task. */
+#define schedtraceMAX_TASKS			( 64 )
+
+/*
+ * Called by traceTASK_SWITCHED_IN().  uxTag is the application task tag, which
+ * the simulator sets to the task's index plus one, so the idle task (which
+ * has no tag) is recorded as task 0.  Only changes of the running task are
+ * stored.
+ */
+void vSchedTraceSwitchedIn( unsigned long uxTag, unsigned long xTime );
+
+/*
+ * Record one completed job of task uxTask (1 based, as for the tag).  Times
+ * are in the runner's time unit, which is the tick unless the task set file
+ * sets a finer resolution.
+ */
+void vSchedTraceJob( unsigned long uxTask, unsigned long xRelease, unsigned long xCompletion );
+
+/*
+ * Allocate the trace buffers.  Must be called before the scheduler is started.
+ * Returns 0 on success.
+ */
+int xSchedTraceInit( unsigned long ulMaxSwitches, unsigned long ulMaxJobs );
+
+/*
+ * Write the recorded trace to pxFile, one event per line:
+ *
+ *   switch <time> <task>
+ *   job <task> <release> <completion>
+ *   overflow <lost events>
+ */
+void vSchedTraceDump( FILE * pxFile );
+
+/*
+ * Implemented by the runner (main.c) and called by traceTASK_SWITCHED_IN().
+ * Charges the context switch overhead, if one is configured, and records the
+ * switch with vSchedTraceSwitchedIn() at the current virtual time.
+ */
+void vSimTaskSwitchedIn( unsigned long uxTag );
+
+/*
+ * Also implemented by the runner.  The virtual time in units, used as the run
+ * time stats counter, and the histogram bin width of the job time statistics,
+ * which depends on the task set.
+ */
+unsigned long ulSimRunTimeCounter( void );
+extern unsigned long ulSimHistogramBinWidth;
+
+/*
+ * Also implemented by the runner.  The host's monotonic clock in nanoseconds,
+ * which times critical sections and scheduler suspensions.
+ */
+unsigned long ulSimHostNanoseconds( void );
+
+/*
+ * configASSERT() handler.  Reports the failing location and aborts.
+ */
+void vSchedTraceAssert( const char * pcFile, int iLine );
+
+#endif /* SCHED_TRACE_H */
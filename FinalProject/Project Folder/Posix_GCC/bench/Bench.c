@@ -0,0 +1,112 @@
+/*
+ * Shared support of the Posix microbenchmarks.  See Bench.h.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+	#include <x86intrin.h>
+#endif
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+static unsigned long ulFailures = 0;
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+	const char * const pcBenchCycleUnit = "cycles";
+#else
+	const char * const pcBenchCycleUnit = "ns";
+#endif
+
+static int prvCompareSamples( const void * pvA, const void * pvB );
+/*-----------------------------------------------------------*/
+
+void vBenchCheck( int iPassed, const char * pcFile, int iLine )
+{
+	if( iPassed == 0 )
+	{
+		printf( "FAIL %s:%d\n", pcFile, iLine );
+		ulFailures++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchExit( void )
+{
+	printf( "%lu failed checks\n", ulFailures );
+	fflush( stdout );
+	exit( ( ulFailures == 0 ) ? 0 : 1 );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long ullBenchNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( unsigned long long ) xNow.tv_sec * 1000000000ULL ) + ( unsigned long long ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long ullBenchCycles( void )
+{
+	#if defined( __x86_64__ ) || defined( __i386__ )
+		return __rdtsc();
+	#else
+		return ullBenchNanoseconds();
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareSamples( const void * pvA, const void * pvB )
+{
+unsigned long ulA = *( const unsigned long * ) pvA, ulB = *( const unsigned long * ) pvB;
+
+	return ( ulA < ulB ) ? -1 : ( ulA > ulB );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchReport( const char * pcWhat, unsigned long * pulSamples, unsigned long ulCount, const char * pcUnit )
+{
+unsigned long long ullTotal = 0;
+unsigned long ul;
+
+	if( ulCount == 0 )
+	{
+		printf( "  %-24s no samples\n", pcWhat );
+		return;
+	}
+
+	qsort( pulSamples, ulCount, sizeof( pulSamples[ 0 ] ), prvCompareSamples );
+
+	for( ul = 0; ul < ulCount; ul++ )
+	{
+		ullTotal += pulSamples[ ul ];
+	}
+
+	printf( "  %-24s mean %7llu  p99 %7lu  p99.99 %7lu  max %8lu %s\n", pcWhat, ullTotal / ulCount,
+			pulSamples[ ( ulCount * 99UL ) / 100UL ], pulSamples[ ( ulCount * 9999UL ) / 10000UL ],
+			pulSamples[ ulCount - 1 ], pcUnit );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchTaskSwitchedIn( void * pvTag )
+{
+	if( pvTag != NULL )
+	{
+		( void ) ( ( TaskHookFunction_t ) pvTag )( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchAssert( const char * pcFile, int iLine )
+{
+	fprintf( stderr, "configASSERT failed: %s:%d\n", pcFile, iLine );
+	fflush( stderr );
+	_exit( 2 );
+}
+/*-----------------------------------------------------------*/
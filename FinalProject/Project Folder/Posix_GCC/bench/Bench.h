@@ -0,0 +1,56 @@
+/*
+ * Shared support of the Posix microbenchmarks (see the Makefile one directory
+ * up, "make bench").
+ *
+ * This header is included from FreeRTOSConfig.h, before the kernel types are
+ * defined, so only native C types are used in the prototypes below.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/*
+ * Counts a failed check, reports where it failed and carries on, so that one
+ * run shows every difference.  vBenchExit() turns the count into the exit
+ * status.
+ */
+#define benchCHECK( x )		vBenchCheck( ( ( x ) != 0 ), __FILE__, __LINE__ )
+
+void vBenchCheck( int iPassed, const char * pcFile, int iLine );
+
+/*
+ * Prints the number of failed checks and exits the process, with status 0 if
+ * there were none and 1 otherwise.  Called by the benchmark's control task
+ * once it is done, the scheduler is never ended.
+ */
+void vBenchExit( void );
+
+/*
+ * The host's monotonic clock in nanoseconds, and the processor's time stamp
+ * counter where it has one (pcBenchCycleUnit is then "cycles", otherwise the
+ * nanosecond clock is used and it is "ns").
+ */
+unsigned long long ullBenchNanoseconds( void );
+unsigned long long ullBenchCycles( void );
+extern const char * const pcBenchCycleUnit;
+
+/*
+ * Sorts ulCount samples in place and prints their mean, 99th and 99.99th
+ * percentiles and maximum on one line.
+ */
+void vBenchReport( const char * pcWhat, unsigned long * pulSamples, unsigned long ulCount, const char * pcUnit );
+
+/*
+ * Called by traceTASK_SWITCHED_IN() with the application task tag of the task
+ * switched in.  A tag that is not NULL is a TaskHookFunction_t and is called
+ * with a NULL parameter, so a benchmark can count the switches into one task
+ * with vTaskSetApplicationTaskTag().
+ */
+void vBenchTaskSwitchedIn( void * pvTag );
+
+/*
+ * configASSERT() handler.  Reports the failing location and aborts.
+ */
+void vBenchAssert( const char * pcFile, int iLine );
+
+#endif /* BENCH_H */
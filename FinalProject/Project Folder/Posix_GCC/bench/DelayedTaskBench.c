@@ -0,0 +1,186 @@
+/*
+ * Delayed task benchmark, built with configUSE_DELAYED_TASK_WHEEL off and on
+ * (build/bench/delayed_list and build/bench/delayed_wheel), and both again
+ * starting 1500 ticks before the tick count wraps (delayed_list_wrap and
+ * delayed_wheel_wrap).
+ *
+ * The benchmark includes tasks.c, so that it can block 1000 tasks and step the
+ * tick itself without the scheduler: each task is made the current task and
+ * blocked with prvAddCurrentTaskToDelayedList(), then xTaskIncrementTick() is
+ * called once per tick.  Every task that wakes is checked against the tick it
+ * was due and blocked again for its period.  One wake in sixteen is followed
+ * by an early unblock, as when an event arrives before the timeout, which
+ * leaves an empty slot behind in the wheel.
+ *
+ * This is done twice, with periods of 2 to 60 ticks, all within the default
+ * 64 slots of the wheel, and with periods of 2 to 1000 ticks, most of which
+ * are beyond it.  The time of each tick and of each block is reported.  With
+ * the sorted list a block walks the tasks that wake earlier; with the wheel a
+ * block and a tick are bounded by the tasks in one slot.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* The kernel itself, for its private lists and functions. */
+#include "tasks.c"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchTASKS				( 1000 )
+#define benchTICKS				( 3000 )
+#define benchMAX_BLOCKS			( 150000 )
+#define benchTASK_PRIORITY		( 1 )
+
+/*-----------------------------------------------------------*/
+
+static TCB_t xTasks[ benchTASKS ];
+static TCB_t xRunning;
+static TickType_t xPeriods[ benchTASKS ];
+static TickType_t xDue[ benchTASKS ];
+
+static unsigned long ulTick[ benchTICKS ];
+static unsigned long ulBlock[ benchMAX_BLOCKS ];
+static unsigned long ulBlocks;
+static unsigned long ulSeed = 12345;
+
+/*-----------------------------------------------------------*/
+
+static void prvRun( TickType_t xMaxPeriod );
+static void prvBlock( UBaseType_t uxIndex );
+static unsigned long prvRandom( void );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+	return ( ulSeed >> 8 ) & 0xffffffUL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlock( UBaseType_t uxIndex )
+{
+unsigned long long ullStart;
+
+	pxCurrentTCB = &( xTasks[ uxIndex ] );
+
+	ullStart = ullBenchCycles();
+	prvAddCurrentTaskToDelayedList( xPeriods[ uxIndex ], pdFALSE );
+
+	if( ulBlocks < benchMAX_BLOCKS )
+	{
+		ulBlock[ ulBlocks++ ] = ( unsigned long ) ( ullBenchCycles() - ullStart );
+	}
+
+	xDue[ uxIndex ] = xTickCount + xPeriods[ uxIndex ];
+	pxCurrentTCB = &xRunning;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRun( TickType_t xMaxPeriod )
+{
+UBaseType_t uxIndex, uxTick;
+unsigned long ulWoken = 0, ulWrong = 0, ulLost = 0;
+unsigned long long ullStart;
+List_t * pxContainer;
+char cWhat[ 48 ];
+
+	printf( "  periods 2 to %lu, from tick %lu\n", ( unsigned long ) xMaxPeriod, ( unsigned long ) xTickCount );
+	ulBlocks = 0;
+
+	for( uxIndex = 0; uxIndex < benchTASKS; uxIndex++ )
+	{
+		xPeriods[ uxIndex ] = 2 + ( prvRandom() % ( xMaxPeriod - 1 ) );
+		prvAddTaskToReadyList( &( xTasks[ uxIndex ] ) );
+		prvBlock( uxIndex );
+	}
+
+	for( uxTick = 0; uxTick < benchTICKS; uxTick++ )
+	{
+		ullStart = ullBenchCycles();
+		( void ) xTaskIncrementTick();
+		ulTick[ uxTick ] = ( unsigned long ) ( ullBenchCycles() - ullStart );
+
+		for( uxIndex = 0; uxIndex < benchTASKS; uxIndex++ )
+		{
+			pxContainer = listLIST_ITEM_CONTAINER( &( xTasks[ uxIndex ].xStateListItem ) );
+
+			if( pxContainer == &( pxReadyTasksLists[ benchTASK_PRIORITY ] ) )
+			{
+				ulWoken++;
+
+				if( xDue[ uxIndex ] != xTickCount )
+				{
+					ulWrong++;
+				}
+
+				prvBlock( uxIndex );
+
+				if( ( prvRandom() % 16 ) == 0 )
+				{
+					/* Woken early by an event, and blocked again. */
+					( void ) uxListRemove( &( xTasks[ uxIndex ].xStateListItem ) );
+					prvAddTaskToReadyList( &( xTasks[ uxIndex ] ) );
+					prvBlock( uxIndex );
+				}
+			}
+			else if( pxContainer == NULL )
+			{
+				ulLost++;
+			}
+		}
+	}
+
+	printf( "  %lu wakes, %lu at the wrong tick, %lu tasks in no list\n", ulWoken, ulWrong, ulLost );
+	benchCHECK( ulWoken > 0 );
+	benchCHECK( ulWrong == 0 );
+	benchCHECK( ulLost == 0 );
+
+	snprintf( cWhat, sizeof( cWhat ), "tick, periods to %lu", ( unsigned long ) xMaxPeriod );
+	vBenchReport( cWhat, ulTick, benchTICKS, pcBenchCycleUnit );
+	snprintf( cWhat, sizeof( cWhat ), "block, periods to %lu", ( unsigned long ) xMaxPeriod );
+	vBenchReport( cWhat, ulBlock, ulBlocks, pcBenchCycleUnit );
+
+	/* Take every task out for the next run.  The wheel clears the bits of the
+	slots left empty when it next looks at them. */
+	for( uxIndex = 0; uxIndex < benchTASKS; uxIndex++ )
+	{
+		( void ) uxListRemove( &( xTasks[ uxIndex ].xStateListItem ) );
+	}
+
+	prvResetNextTaskUnblockTime();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t uxIndex;
+
+	printf( "delayed tasks, %s\n", ( configUSE_DELAYED_TASK_WHEEL == 1 ) ? "timing wheel" : "sorted list" );
+
+	prvInitialiseTaskLists();
+	xNextTaskUnblockTime = portMAX_DELAY;
+
+	for( uxIndex = 0; uxIndex < benchTASKS; uxIndex++ )
+	{
+		vListInitialiseItem( &( xTasks[ uxIndex ].xStateListItem ) );
+		vListInitialiseItem( &( xTasks[ uxIndex ].xEventListItem ) );
+		listSET_LIST_ITEM_OWNER( &( xTasks[ uxIndex ].xStateListItem ), &( xTasks[ uxIndex ] ) );
+		xTasks[ uxIndex ].uxPriority = benchTASK_PRIORITY;
+	}
+
+	/* Above the tasks, so a wake never asks for a switch that is not made. */
+	xRunning.uxPriority = configMAX_PRIORITIES - 1;
+	pxCurrentTCB = &xRunning;
+
+	prvRun( 60 );
+	prvRun( 1000 );
+	vBenchExit();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,247 @@
+/*
+ * Event group benchmark, built with configUSE_EVENT_GROUP_WAITER_INDEX off
+ * and on (build/bench/eventgroups_list and build/bench/eventgroups_index).
+ *
+ * First checks the waiting modes against the expected results: wait for all
+ * bits, wait for any bit, xEventGroupSync(), a timeout and deleting a group
+ * that still has a waiting task.  Then blocks one task on each of the 23 low
+ * event bits, the most an event group has with 32 bit ticks less one, and
+ * times xEventGroupSetBits():
+ *
+ *   - on a group nobody waits on,
+ *   - setting a bit that wakes one of the 23 tasks,
+ *   - setting the 24th bit, which none of them waits for.
+ *
+ * Without the index each set walks all the waiting tasks.  With it, it only
+ * visits the tasks waiting for the bits that are set.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchWAITERS			( 23 )
+#define benchUNWAITED_BIT		( ( EventBits_t ) 1 << benchWAITERS )
+#define benchROUNDS				( 2000 )
+#define benchIDLE_SETS			( 20000 )
+
+#define benchCONTROL_PRIORITY	( 3 )
+#define benchWAITER_PRIORITY	( 2 )
+
+/*-----------------------------------------------------------*/
+
+static EventGroupHandle_t xGroup;
+static volatile unsigned long ulWakes[ benchWAITERS ];
+
+/* Results of the tasks of the functional checks. */
+static volatile EventBits_t uxWaitResult[ 7 ];
+
+static unsigned long ulSetNone[ benchIDLE_SETS ];
+static unsigned long ulSetWaking[ benchROUNDS * benchWAITERS ];
+static unsigned long ulSetUnwaited[ benchROUNDS ];
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvWaiterTask( void * pvParameters );
+static void prvWaitAllTask( void * pvParameters );
+static void prvWaitAnyTask( void * pvParameters );
+static void prvSyncTask( void * pvParameters );
+static void prvDeletedGroupTask( void * pvParameters );
+static void prvCheckWaitModes( void );
+static unsigned long prvTimeSet( EventGroupHandle_t xEventGroup, EventBits_t uxBits );
+
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void * pvParameters )
+{
+UBaseType_t uxBit = ( UBaseType_t ) ( size_t ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xEventGroupWaitBits( xGroup, ( EventBits_t ) 1 << uxBit, pdTRUE, pdFALSE, portMAX_DELAY );
+		ulWakes[ uxBit ]++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitAllTask( void * pvParameters )
+{
+	uxWaitResult[ 0 ] = xEventGroupWaitBits( ( EventGroupHandle_t ) pvParameters, ( 1 << 1 ) | ( 1 << 5 ) | ( 1 << 9 ), pdTRUE, pdTRUE, portMAX_DELAY );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitAnyTask( void * pvParameters )
+{
+	uxWaitResult[ 1 ] = xEventGroupWaitBits( ( EventGroupHandle_t ) pvParameters, ( 1 << 2 ) | ( 1 << 3 ), pdFALSE, pdFALSE, portMAX_DELAY );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSyncTask( void * pvParameters )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( size_t ) pvParameters;
+
+	uxWaitResult[ 2 + uxIndex ] = xEventGroupSync( xGroup, ( EventBits_t ) 1 << ( 12 + uxIndex ), ( EventBits_t ) 7 << 12, portMAX_DELAY );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeletedGroupTask( void * pvParameters )
+{
+	uxWaitResult[ 6 ] = xEventGroupWaitBits( ( EventGroupHandle_t ) pvParameters, 3, pdFALSE, pdTRUE, portMAX_DELAY );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckWaitModes( void )
+{
+EventGroupHandle_t xChecked;
+TickType_t xStart;
+UBaseType_t uxIndex;
+
+	xChecked = xEventGroupCreate();
+	uxWaitResult[ 0 ] = uxWaitResult[ 1 ] = ~( EventBits_t ) 0;
+	xTaskCreate( prvWaitAllTask, "all", configMINIMAL_STACK_SIZE, xChecked, benchCONTROL_PRIORITY + 1, NULL );
+	xTaskCreate( prvWaitAnyTask, "any", configMINIMAL_STACK_SIZE, xChecked, benchCONTROL_PRIORITY + 1, NULL );
+	vTaskDelay( 2 );
+
+	/* Two of the three bits of the wait for all, none of the wait for any. */
+	( void ) xEventGroupSetBits( xChecked, 1 << 5 );
+	( void ) xEventGroupSetBits( xChecked, 1 << 1 );
+	benchCHECK( uxWaitResult[ 0 ] == ~( EventBits_t ) 0 );
+	benchCHECK( uxWaitResult[ 1 ] == ~( EventBits_t ) 0 );
+
+	( void ) xEventGroupSetBits( xChecked, 1 << 3 );
+	benchCHECK( uxWaitResult[ 1 ] == ( ( 1 << 1 ) | ( 1 << 5 ) | ( 1 << 3 ) ) );
+
+	/* The wait for all clears its own bits on exit. */
+	benchCHECK( xEventGroupSetBits( xChecked, 1 << 9 ) == ( 1 << 3 ) );
+	benchCHECK( uxWaitResult[ 0 ] == ( ( 1 << 1 ) | ( 1 << 5 ) | ( 1 << 9 ) | ( 1 << 3 ) ) );
+	vEventGroupDelete( xChecked );
+
+	/* Three tasks meet at a sync point, the last one is this task. */
+	xGroup = xEventGroupCreate();
+
+	for( uxIndex = 0; uxIndex < 2; uxIndex++ )
+	{
+		uxWaitResult[ 2 + uxIndex ] = ~( EventBits_t ) 0;
+		xTaskCreate( prvSyncTask, "sync", configMINIMAL_STACK_SIZE, ( void * ) ( size_t ) uxIndex, benchCONTROL_PRIORITY + 1, NULL );
+	}
+
+	vTaskDelay( 2 );
+	uxWaitResult[ 4 ] = xEventGroupSync( xGroup, 1 << 14, ( EventBits_t ) 7 << 12, 10 );
+	benchCHECK( uxWaitResult[ 2 ] == ( ( EventBits_t ) 7 << 12 ) );
+	benchCHECK( uxWaitResult[ 3 ] == ( ( EventBits_t ) 7 << 12 ) );
+	benchCHECK( uxWaitResult[ 4 ] == ( ( EventBits_t ) 7 << 12 ) );
+	benchCHECK( xEventGroupGetBits( xGroup ) == 0 );
+
+	/* A wait that times out returns the bits as they are. */
+	xStart = xTaskGetTickCount();
+	benchCHECK( xEventGroupWaitBits( xGroup, 6, pdTRUE, pdTRUE, 5 ) == 0 );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 5 );
+	vEventGroupDelete( xGroup );
+
+	/* Deleting a group releases its waiting tasks with no bits set. */
+	xChecked = xEventGroupCreate();
+	uxWaitResult[ 6 ] = ~( EventBits_t ) 0;
+	xTaskCreate( prvDeletedGroupTask, "deleted", configMINIMAL_STACK_SIZE, xChecked, benchCONTROL_PRIORITY + 1, NULL );
+	vTaskDelay( 2 );
+	( void ) xEventGroupSetBits( xChecked, 1 );
+	vTaskDelay( 1 );
+	benchCHECK( uxWaitResult[ 6 ] == ~( EventBits_t ) 0 );
+	vEventGroupDelete( xChecked );
+	vTaskDelay( 1 );
+	benchCHECK( uxWaitResult[ 6 ] == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeSet( EventGroupHandle_t xEventGroup, EventBits_t uxBits )
+{
+unsigned long long ullStart;
+
+	ullStart = ullBenchCycles();
+	( void ) xEventGroupSetBits( xEventGroup, uxBits );
+	return ( unsigned long ) ( ullBenchCycles() - ullStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+UBaseType_t uxIndex, uxRound;
+unsigned long ulExpected, ulWoken;
+
+	( void ) pvParameters;
+
+	printf( "event groups, waiter index %s\n", ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) ? "on" : "off" );
+	prvCheckWaitModes();
+
+	xGroup = xEventGroupCreate();
+
+	for( uxIndex = 0; uxIndex < benchIDLE_SETS; uxIndex++ )
+	{
+		ulSetNone[ uxIndex ] = prvTimeSet( xGroup, benchUNWAITED_BIT );
+	}
+
+	( void ) xEventGroupClearBits( xGroup, benchUNWAITED_BIT );
+
+	/* The waiters run below this task, so a set only moves the woken task to
+	the ready list and the time measured does not include a switch. */
+	for( uxIndex = 0; uxIndex < benchWAITERS; uxIndex++ )
+	{
+		xTaskCreate( prvWaiterTask, "waiter", configMINIMAL_STACK_SIZE, ( void * ) ( size_t ) uxIndex, benchWAITER_PRIORITY, NULL );
+	}
+
+	vTaskDelay( 2 );
+
+	for( uxRound = 0; uxRound < benchROUNDS; uxRound++ )
+	{
+		for( uxIndex = 0; uxIndex < benchWAITERS; uxIndex++ )
+		{
+			ulSetWaking[ ( uxRound * benchWAITERS ) + uxIndex ] = prvTimeSet( xGroup, ( EventBits_t ) 1 << uxIndex );
+		}
+
+		/* Let every waiter run and block again. */
+		ulExpected = ( unsigned long ) benchWAITERS * ( uxRound + 1 );
+
+		do
+		{
+			vTaskDelay( 1 );
+
+			for( ulWoken = 0, uxIndex = 0; uxIndex < benchWAITERS; uxIndex++ )
+			{
+				ulWoken += ulWakes[ uxIndex ];
+			}
+		} while( ulWoken < ulExpected );
+
+		benchCHECK( ulWoken == ulExpected );
+
+		ulSetUnwaited[ uxRound ] = prvTimeSet( xGroup, benchUNWAITED_BIT );
+		( void ) xEventGroupClearBits( xGroup, benchUNWAITED_BIT );
+	}
+
+	vBenchReport( "set, no waiters", ulSetNone, benchIDLE_SETS, pcBenchCycleUnit );
+	vBenchReport( "set, wakes 1 of 23", ulSetWaking, benchROUNDS * benchWAITERS, pcBenchCycleUnit );
+	vBenchReport( "set, wakes 0 of 23", ulSetUnwaited, benchROUNDS, pcBenchCycleUnit );
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,111 @@
+/*
+ * FreeRTOS V202112.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions for the Posix microbenchmarks.
+ *
+ * The benchmarks time kernel services on the host's clock, so unlike the
+ * schedule runner one directory up they run in real time, with the fixed
+ * priority scheduler and the timer service task.  The options a benchmark
+ * compares are left to the Makefile, which builds each benchmark once with
+ * the option off and once with it on.
+ *
+ * See http://www.freertos.org/a00110.html
+ *----------------------------------------------------------*/
+
+#ifndef configUSE_EDF_SCHEDULER
+	#define configUSE_EDF_SCHEDULER	(0U)
+#endif
+#define EDF_IDLE_PERIOD					(100U)
+
+#define configUSE_APPLICATION_TASK_TAG (1)
+#define INCLUDE_xTaskGetCurrentTaskHandle	(1)
+#define configUSE_TIME_SLICING 0
+
+#define configUSE_PREEMPTION		1
+#define configUSE_IDLE_HOOK			0
+#ifndef configUSE_TICK_HOOK
+	#define configUSE_TICK_HOOK		0
+#endif
+#define configCPU_CLOCK_HZ			( ( unsigned long ) 60000000 )
+#ifndef configTICK_RATE_HZ
+	#define configTICK_RATE_HZ		( ( TickType_t ) 1000 )
+#endif
+#define configMAX_PRIORITIES		( 32 )
+#define configMINIMAL_STACK_SIZE	( ( unsigned short ) 4096 )	/* Words, PTHREAD_STACK_MIN is 16K bytes. */
+#ifndef configTOTAL_HEAP_SIZE
+	#define configTOTAL_HEAP_SIZE	( ( size_t ) 32 * 1024 * 1024 )
+#endif
+#define configMAX_TASK_NAME_LEN		( 16 )
+#define configUSE_TRACE_FACILITY	1
+#define configUSE_16_BIT_TICKS		0
+#define configIDLE_SHOULD_YIELD		1
+#define configCHECK_FOR_STACK_OVERFLOW	0
+
+#define configQUEUE_REGISTRY_SIZE 	0
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configSUPPORT_STATIC_ALLOCATION     0
+#define configUSE_MUTEXES			1
+#define configUSE_COUNTING_SEMAPHORES	1
+
+#define configUSE_TIMERS			1
+#define configTIMER_TASK_PRIORITY	( configMAX_PRIORITIES - 2 )
+#define configTIMER_QUEUE_LENGTH	( 600 )
+#define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE )
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES 		0
+#define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet		1
+#define INCLUDE_uxTaskPriorityGet		1
+#define INCLUDE_vTaskDelete				1
+#define INCLUDE_vTaskCleanUpResources	0
+#define INCLUDE_vTaskSuspend			1
+#define INCLUDE_vTaskDelayUntil			1
+#define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetSchedulerState	1
+#define INCLUDE_xTimerPendFunctionCall	1
+
+/* The benchmarks can count the switches into a task by giving it a hook
+function as its tag, see Bench.h. */
+#ifndef __ASSEMBLER__
+	#include "Bench.h"
+#endif
+
+#define traceTASK_SWITCHED_IN()		vBenchTaskSwitchedIn( ( void * ) pxCurrentTCB->pxTaskTag )
+#define traceTASK_SWITCHED_OUT()
+
+#define configASSERT( x )	if( ( x ) == 0 ) vBenchAssert( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
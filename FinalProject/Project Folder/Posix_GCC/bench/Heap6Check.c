@@ -0,0 +1,265 @@
+/*
+ * Consistency check of heap_6.c, built with configHEAP_6_MAX_BLOCK_SIZE_LOG2
+ * set to 17 and to 24 (build/bench/heap6check_17 and heap6check_24).  The
+ * scheduler is not started.
+ *
+ * The check includes heap_6.c, so that it can walk the heap's own structures.
+ * The heap is made of three regions given out of address order and not
+ * aligned, the last one larger than the largest block.  400000 random
+ * allocations and frees follow, mostly small blocks with some up to 20 KB and
+ * a few larger than the largest block.  Each allocation is filled with a
+ * pattern that is checked when it is freed.  Every 997 operations, and at the
+ * start and the end, prvCheckHeap() checks that:
+ *
+ *   - the blocks of each region follow each other up to its end marker, and
+ *     each records the block before it;
+ *   - no two free neighbours could have been combined;
+ *   - each free block is in the list of its size class, and the lists hold
+ *     nothing else;
+ *   - the bitmaps mark exactly the lists that are not empty;
+ *   - the free byte count and vPortGetHeapStats() agree with the blocks.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* The heap itself, for its private lists and bitmaps. */
+#include "heap_6.c"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchREGIONS			( 3 )
+#define benchSLOTS				( 600 )
+#define benchOPERATIONS			( 400000UL )
+#define benchCHECK_EVERY		( 997UL )
+
+/*-----------------------------------------------------------*/
+
+static uint8_t ucRegion0[ 100003 ];
+static uint8_t ucRegion1[ 5000 ];
+static uint8_t ucRegion2[ heapMAX_BLOCK_SIZE + 12345 ];
+
+/* The regions as given to vPortDefineHeapRegions(), out of address order and
+each one byte or more past an aligned address. */
+static const HeapRegion_t xRegions[ benchREGIONS + 1 ] =
+{
+	{ ucRegion1 + 3, sizeof( ucRegion1 ) - 3 },
+	{ ucRegion0 + 1, sizeof( ucRegion0 ) - 1 },
+	{ ucRegion2 + 5, sizeof( ucRegion2 ) - 5 },
+	{ NULL,          0                       }
+};
+
+static void * pvSlots[ benchSLOTS ];
+static size_t xSizes[ benchSLOTS ];
+static uint8_t ucPatterns[ benchSLOTS ];
+static unsigned long ulSeed = 1;
+
+/*-----------------------------------------------------------*/
+
+static void prvCheckHeap( void );
+static unsigned long prvRandom( void );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+	return ( ulSeed >> 8 ) & 0xffffffUL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckHeap( void )
+{
+UBaseType_t uxRegion, uxFL, uxSL, uxMappedFL, uxMappedSL;
+BlockLink_t * pxBlock, * pxPrevious, * pxListed;
+uint8_t * pucEnd;
+size_t xSize, xPreviousSize, xFreeBytes = 0, xFreeBlocks = 0, xListed = 0;
+BaseType_t xFree, xPreviousFree;
+HeapStats_t xStats;
+
+	for( uxRegion = 0; uxRegion < benchREGIONS; uxRegion++ )
+	{
+		pxBlock = ( BlockLink_t * ) ( ( ( size_t ) xRegions[ uxRegion ].pucStartAddress + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) );
+		pucEnd = xRegions[ uxRegion ].pucStartAddress + xRegions[ uxRegion ].xSizeInBytes;
+		pxPrevious = NULL;
+		xPreviousFree = pdFALSE;
+		xPreviousSize = 0;
+
+		for( ;; )
+		{
+			benchCHECK( pxBlock->pxPreviousPhysicalBlock == pxPrevious );
+
+			xSize = pxBlock->xBlockSize & ~xBlockAllocatedBit;
+			xFree = ( ( pxBlock->xBlockSize & xBlockAllocatedBit ) == 0 ) ? pdTRUE : pdFALSE;
+
+			if( xSize == 0 )
+			{
+				/* The end marker, which is never free. */
+				benchCHECK( xFree == pdFALSE );
+				benchCHECK( ( ( uint8_t * ) pxBlock + xHeapStructSize ) <= pucEnd );
+				break;
+			}
+
+			benchCHECK( ( ( uint8_t * ) pxBlock + xSize ) <= pucEnd );
+			benchCHECK( ( xSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+			benchCHECK( ( xSize >= xMinimumBlockSize ) && ( xSize < heapMAX_BLOCK_SIZE ) );
+
+			if( xSize < xMinimumBlockSize )
+			{
+				/* Walking on would not end. */
+				vBenchExit();
+			}
+
+			if( xFree != pdFALSE )
+			{
+				xFreeBytes += xSize;
+				xFreeBlocks++;
+
+				/* Neighbours are only left apart when together they would be
+				too large for one block. */
+				benchCHECK( ( xPreviousFree == pdFALSE ) || ( ( xPreviousSize + xSize ) >= heapMAX_BLOCK_SIZE ) );
+
+				prvMapBlockSize( xSize, &uxMappedFL, &uxMappedSL );
+
+				for( pxListed = pxFreeLists[ uxMappedFL ][ uxMappedSL ]; ( pxListed != NULL ) && ( pxListed != pxBlock ); pxListed = pxListed->pxNextFreeBlock )
+				{
+				}
+
+				benchCHECK( pxListed == pxBlock );
+			}
+
+			xPreviousFree = xFree;
+			xPreviousSize = xSize;
+			pxPrevious = pxBlock;
+			pxBlock = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+		}
+	}
+
+	benchCHECK( xFreeBytes == xFreeBytesRemaining );
+
+	for( uxFL = 0; uxFL < heapFL_INDEX_COUNT; uxFL++ )
+	{
+		benchCHECK( ( ( ulFLBitmap >> uxFL ) & 1UL ) == ( ( ulSLBitmaps[ uxFL ] != 0UL ) ? 1UL : 0UL ) );
+
+		for( uxSL = 0; uxSL < heapSL_INDEX_COUNT; uxSL++ )
+		{
+			benchCHECK( ( ( ulSLBitmaps[ uxFL ] >> uxSL ) & 1UL ) == ( ( pxFreeLists[ uxFL ][ uxSL ] != NULL ) ? 1UL : 0UL ) );
+
+			for( pxListed = pxFreeLists[ uxFL ][ uxSL ]; pxListed != NULL; pxListed = pxListed->pxNextFreeBlock )
+			{
+				xListed++;
+				prvMapBlockSize( pxListed->xBlockSize, &uxMappedFL, &uxMappedSL );
+				benchCHECK( ( uxMappedFL == uxFL ) && ( uxMappedSL == uxSL ) );
+
+				if( pxListed->pxNextFreeBlock != NULL )
+				{
+					benchCHECK( pxListed->pxNextFreeBlock->pxPreviousFreeBlock == pxListed );
+				}
+			}
+		}
+	}
+
+	benchCHECK( xListed == xFreeBlocks );
+
+	vPortGetHeapStats( &xStats );
+	benchCHECK( xStats.xNumberOfFreeBlocks == xFreeBlocks );
+	benchCHECK( xStats.xAvailableHeapSpaceInBytes == xFreeBytes );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+unsigned long ulOperation, ulFailed = 0, ulCorrupted = 0;
+UBaseType_t uxSlot;
+size_t xSize, xOffset, xFreeAtStart;
+HeapStats_t xStats;
+
+	printf( "heap_6 consistency, largest block 2^%d bytes\n", configHEAP_6_MAX_BLOCK_SIZE_LOG2 );
+
+	vPortDefineHeapRegions( xRegions );
+	prvCheckHeap();
+	xFreeAtStart = xPortGetFreeHeapSize();
+
+	for( ulOperation = 0; ulOperation < benchOPERATIONS; ulOperation++ )
+	{
+		uxSlot = prvRandom() % benchSLOTS;
+
+		if( pvSlots[ uxSlot ] != NULL )
+		{
+			for( xOffset = 0; xOffset < xSizes[ uxSlot ]; xOffset++ )
+			{
+				if( ( ( uint8_t * ) pvSlots[ uxSlot ] )[ xOffset ] != ucPatterns[ uxSlot ] )
+				{
+					ulCorrupted++;
+					break;
+				}
+			}
+
+			vPortFree( pvSlots[ uxSlot ] );
+			pvSlots[ uxSlot ] = NULL;
+		}
+		else
+		{
+			if( ( prvRandom() % 5000 ) == 0 )
+			{
+				xSize = heapMAX_BLOCK_SIZE + ( prvRandom() % 1000 );
+			}
+			else if( ( prvRandom() % 4 ) == 0 )
+			{
+				xSize = 1 + ( prvRandom() % 20000 );
+			}
+			else
+			{
+				xSize = 1 + ( prvRandom() % 200 );
+			}
+
+			pvSlots[ uxSlot ] = pvPortMalloc( xSize );
+
+			if( pvSlots[ uxSlot ] != NULL )
+			{
+				benchCHECK( ( ( size_t ) pvSlots[ uxSlot ] & portBYTE_ALIGNMENT_MASK ) == 0 );
+				xSizes[ uxSlot ] = xSize;
+				ucPatterns[ uxSlot ] = ( uint8_t ) prvRandom();
+				memset( pvSlots[ uxSlot ], ucPatterns[ uxSlot ], xSize );
+			}
+			else
+			{
+				ulFailed++;
+			}
+		}
+
+		if( ( ulOperation % benchCHECK_EVERY ) == 0 )
+		{
+			prvCheckHeap();
+		}
+	}
+
+	benchCHECK( ulCorrupted == 0 );
+
+	/* Requests no block can hold. */
+	benchCHECK( pvPortMalloc( 0 ) == NULL );
+	benchCHECK( pvPortMalloc( heapMAX_BLOCK_SIZE ) == NULL );
+	benchCHECK( pvPortMalloc( ( size_t ) -1 ) == NULL );
+
+	for( uxSlot = 0; uxSlot < benchSLOTS; uxSlot++ )
+	{
+		vPortFree( pvSlots[ uxSlot ] );
+		pvSlots[ uxSlot ] = NULL;
+	}
+
+	prvCheckHeap();
+	benchCHECK( xPortGetFreeHeapSize() == xFreeAtStart );
+
+	vPortGetHeapStats( &xStats );
+	printf( "  %lu operations, %lu allocations failed, %lu corrupted; after freeing all %lu free blocks, largest %lu bytes\n",
+			benchOPERATIONS, ulFailed, ulCorrupted, ( unsigned long ) xStats.xNumberOfFreeBlocks,
+			( unsigned long ) xStats.xSizeOfLargestFreeBlockInBytes );
+	vBenchExit();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,227 @@
+/*
+ * Heap benchmark, built with heap_4.c and with heap_6.c (build/bench/heap_4
+ * and build/bench/heap_6), each with a 1 MB heap.  The scheduler is not
+ * started.
+ *
+ * Random workloads of 2M operations over a fixed number of slots: an empty
+ * slot is filled by pvPortMalloc() and a full one emptied by vPortFree().
+ * The workloads are small blocks of 16 to 255 bytes only, then small blocks
+ * with 5 % and with 10 % of large blocks of 1 KB and more.  Last, 8000 blocks
+ * of 64 bytes are allocated and every other one freed, leaving 4000 holes in
+ * front of the rest of the heap, and 200 byte blocks are allocated behind
+ * them.  heap_4.c walks the holes on each allocation, heap_6.c does not.
+ *
+ * The time of each call is reported.  It includes the vTaskSuspendAll() and
+ * xTaskResumeAll() both heaps make, which are timed on their own first.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchOPERATIONS			( 2000000UL )
+#define benchMAX_SLOTS			( 8000 )
+#define benchSUSPENDS			( 100000UL )
+#define benchHOLES				( 4000 )
+#define benchBEHIND_HOLES		( 1000 )
+
+#if ( benchUSE_HEAP_6 == 1 )
+	#define benchHEAP_SIZE		( ( size_t ) 1024 * 1024 )
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void * pvSlots[ benchMAX_SLOTS ];
+static void * pvBehind[ benchBEHIND_HOLES ];
+static unsigned long ulMalloc[ benchOPERATIONS ];
+static unsigned long ulFree[ benchOPERATIONS ];
+static unsigned long ulSuspend[ benchSUSPENDS ];
+static unsigned long ulSeed;
+
+#if ( benchUSE_HEAP_6 == 1 )
+	static uint8_t ucRegion[ benchHEAP_SIZE ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void prvRun( const char * pcName, UBaseType_t uxSlots, unsigned long ulLargePercent, size_t xLargeRange );
+static void prvHoles( void );
+static unsigned long prvRandom( void );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+	return ( ulSeed >> 8 ) & 0xffffffUL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRun( const char * pcName, UBaseType_t uxSlots, unsigned long ulLargePercent, size_t xLargeRange )
+{
+unsigned long ulOperation, ulMallocs = 0, ulFrees = 0, ulFailed = 0;
+UBaseType_t uxSlot;
+unsigned long long ullStart;
+size_t xSize;
+HeapStats_t xStats;
+char cWhat[ 48 ];
+
+	ulSeed = 7;
+
+	for( ulOperation = 0; ulOperation < benchOPERATIONS; ulOperation++ )
+	{
+		uxSlot = prvRandom() % uxSlots;
+
+		if( pvSlots[ uxSlot ] != NULL )
+		{
+			ullStart = ullBenchCycles();
+			vPortFree( pvSlots[ uxSlot ] );
+			ulFree[ ulFrees++ ] = ( unsigned long ) ( ullBenchCycles() - ullStart );
+			pvSlots[ uxSlot ] = NULL;
+		}
+		else
+		{
+			if( ( prvRandom() % 100 ) < ulLargePercent )
+			{
+				xSize = 1024 + ( prvRandom() % xLargeRange );
+			}
+			else
+			{
+				xSize = 16 + ( prvRandom() % 240 );
+			}
+
+			ullStart = ullBenchCycles();
+			pvSlots[ uxSlot ] = pvPortMalloc( xSize );
+
+			if( pvSlots[ uxSlot ] != NULL )
+			{
+				ulMalloc[ ulMallocs++ ] = ( unsigned long ) ( ullBenchCycles() - ullStart );
+			}
+			else
+			{
+				ulFailed++;
+			}
+		}
+	}
+
+	vPortGetHeapStats( &xStats );
+	printf( "  %s, %lu slots, %lu %% large: %lu free blocks at the end, %lu failed\n", pcName, ( unsigned long ) uxSlots,
+			ulLargePercent, ( unsigned long ) xStats.xNumberOfFreeBlocks, ulFailed );
+	snprintf( cWhat, sizeof( cWhat ), "malloc, %s %lu %%", pcName, ulLargePercent );
+	vBenchReport( cWhat, ulMalloc, ulMallocs, pcBenchCycleUnit );
+	snprintf( cWhat, sizeof( cWhat ), "free, %s %lu %%", pcName, ulLargePercent );
+	vBenchReport( cWhat, ulFree, ulFrees, pcBenchCycleUnit );
+
+	for( uxSlot = 0; uxSlot < uxSlots; uxSlot++ )
+	{
+		vPortFree( pvSlots[ uxSlot ] );
+		pvSlots[ uxSlot ] = NULL;
+	}
+
+	benchCHECK( ulMallocs > 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHoles( void )
+{
+UBaseType_t uxIndex;
+unsigned long ulCount = 0;
+unsigned long long ullStart;
+
+	for( uxIndex = 0; uxIndex < ( 2 * benchHOLES ); uxIndex++ )
+	{
+		pvSlots[ uxIndex ] = pvPortMalloc( 64 );
+		benchCHECK( pvSlots[ uxIndex ] != NULL );
+	}
+
+	for( uxIndex = 0; uxIndex < ( 2 * benchHOLES ); uxIndex += 2 )
+	{
+		vPortFree( pvSlots[ uxIndex ] );
+		pvSlots[ uxIndex ] = NULL;
+	}
+
+	for( uxIndex = 0; uxIndex < benchBEHIND_HOLES; uxIndex++ )
+	{
+		ullStart = ullBenchCycles();
+		pvBehind[ uxIndex ] = pvPortMalloc( 200 );
+		ulMalloc[ ulCount++ ] = ( unsigned long ) ( ullBenchCycles() - ullStart );
+		benchCHECK( pvBehind[ uxIndex ] != NULL );
+	}
+
+	printf( "  200 byte blocks behind %d free 64 byte blocks\n", benchHOLES );
+	vBenchReport( "malloc, behind holes", ulMalloc, ulCount, pcBenchCycleUnit );
+
+	for( ulCount = 0, uxIndex = 1; uxIndex < ( 2 * benchHOLES ); uxIndex += 2 )
+	{
+		ullStart = ullBenchCycles();
+		vPortFree( pvSlots[ uxIndex ] );
+		ulFree[ ulCount++ ] = ( unsigned long ) ( ullBenchCycles() - ullStart );
+		pvSlots[ uxIndex ] = NULL;
+	}
+
+	vBenchReport( "free, between holes", ulFree, ulCount, pcBenchCycleUnit );
+
+	for( uxIndex = 0; uxIndex < benchBEHIND_HOLES; uxIndex++ )
+	{
+		vPortFree( pvBehind[ uxIndex ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t uxIndex;
+unsigned long long ullStart;
+size_t xFreeAtStart;
+
+	#if ( benchUSE_HEAP_6 == 1 )
+	{
+		const HeapRegion_t xRegions[] =
+		{
+			{ ucRegion, sizeof( ucRegion ) },
+			{ NULL,     0                  }
+		};
+
+		vPortDefineHeapRegions( xRegions );
+		printf( "heap_6, %lu byte heap\n", ( unsigned long ) sizeof( ucRegion ) );
+	}
+	#else
+	{
+		printf( "heap_4, %lu byte heap\n", ( unsigned long ) configTOTAL_HEAP_SIZE );
+	}
+	#endif
+
+	for( uxIndex = 0; uxIndex < benchSUSPENDS; uxIndex++ )
+	{
+		ullStart = ullBenchCycles();
+		vTaskSuspendAll();
+		( void ) xTaskResumeAll();
+		ulSuspend[ uxIndex ] = ( unsigned long ) ( ullBenchCycles() - ullStart );
+	}
+
+	vBenchReport( "suspend and resume all", ulSuspend, benchSUSPENDS, pcBenchCycleUnit );
+
+	/* heap_4.c only sets the heap up on the first allocation. */
+	vPortFree( pvPortMalloc( 16 ) );
+	xFreeAtStart = xPortGetFreeHeapSize();
+
+	prvRun( "small", 1000, 0, 1 );
+	prvRun( "mixed", 3000, 5, 8192 );
+	prvRun( "mixed", 3000, 10, 16384 );
+	prvHoles();
+
+	/* Everything was freed, and combined again. */
+	benchCHECK( xPortGetFreeHeapSize() == xFreeAtStart );
+	vBenchExit();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
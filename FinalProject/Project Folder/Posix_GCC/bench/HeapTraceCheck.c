@@ -0,0 +1,379 @@
+/*
+ * Check of heap tracing, built with heap_4.c and with heap_6.c
+ * (build/bench/heaptrace_4 and heaptrace_6).
+ *
+ * Checks that:
+ *
+ *   - the allocations made before the scheduler starts are recorded first,
+ *     numbered from 0 and with no task, and the heap size is the free bytes
+ *     before the first of them;
+ *   - each allocation and free records its address, the running task and its
+ *     call site, a size that accounts for the change in the free bytes, and
+ *     the free bytes and largest free block of xPortGetFreeHeapSize() and
+ *     vPortGetHeapStats();
+ *   - a failed allocation records the requested size and is counted;
+ *   - once the ring overflows it holds the most recent events, numbered on
+ *     from the earlier ones, while the low water marks still cover them all;
+ *   - the text holds a heapinfo line and one heap line per event, and a
+ *     buffer too short for all of them only loses whole lines at the end;
+ *   - clearing drops the events and restarts the marks, but not the numbers.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_trace.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchBLOCKS				( 16 )
+#define benchCHURN				( 4 * configHEAP_TRACE_LENGTH )
+#define benchPEAK_SIZE			( 20000 )
+#define benchFAILED_SIZE		( ( size_t ) 0x7fffffffUL )
+#define benchTEXT_LENGTH		( ( configHEAP_TRACE_LENGTH + 1 ) * heaptraceTEXT_LINE_LENGTH )
+#define benchSHORT_TEXT_LENGTH	( 5 * heaptraceTEXT_LINE_LENGTH / 2 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+
+#ifndef benchUSE_HEAP_6
+	#define benchUSE_HEAP_6		( 0 )
+#endif
+
+#if ( benchUSE_HEAP_6 == 1 )
+	#define benchHEAP_SIZE		( ( size_t ) 1024 * 1024 )
+#endif
+
+/*-----------------------------------------------------------*/
+
+static HeapTraceEvent_t xEvents[ configHEAP_TRACE_LENGTH ];
+static void * pvBlocks[ benchBLOCKS ];
+static char cText[ benchTEXT_LENGTH ];
+
+#if ( benchUSE_HEAP_6 == 1 )
+	static uint8_t ucRegion[ benchHEAP_SIZE ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static const HeapTraceEvent_t * prvLastEvent( void );
+static void prvCheckState( const HeapTraceEvent_t * pxEvent );
+static void prvCheckStart( void );
+static void prvCheckEvents( void );
+static void prvCheckFailed( void );
+static void prvCheckOverflow( void );
+static void prvCheckText( void );
+static void prvCheckClear( void );
+static UBaseType_t prvCountLines( const char * pcText );
+
+/*-----------------------------------------------------------*/
+
+static const HeapTraceEvent_t * prvLastEvent( void )
+{
+UBaseType_t uxCount;
+
+	uxCount = uxHeapTraceGetEvents( xEvents, configHEAP_TRACE_LENGTH, NULL );
+	configASSERT( uxCount > 0 );
+
+	return &( xEvents[ uxCount - 1 ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckState( const HeapTraceEvent_t * pxEvent )
+{
+HeapStats_t xHeapStats;
+
+	vPortGetHeapStats( &xHeapStats );
+	benchCHECK( pxEvent->xFreeBytes == xPortGetFreeHeapSize() );
+	benchCHECK( pxEvent->xLargestFreeBlock == xHeapStats.xSizeOfLargestFreeBlockInBytes );
+	benchCHECK( pxEvent->xTask == xTaskGetCurrentTaskHandle() );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStart( void )
+{
+HeapTraceStats_t xStats;
+UBaseType_t uxCount, uxIndex;
+uint32_t ulFirst;
+
+	/* Nothing has overflowed the ring yet, so it still holds the tasks and
+	the timer queue created by main() and vTaskStartScheduler(). */
+	uxCount = uxHeapTraceGetEvents( xEvents, configHEAP_TRACE_LENGTH, &ulFirst );
+	vHeapTraceGetStats( &xStats );
+
+	printf( "  %lu events before the control task ran, heap size %lu\n",
+			( unsigned long ) uxCount, ( unsigned long ) xStats.xHeapSize );
+	benchCHECK( ulFirst == 0 );
+	benchCHECK( uxCount == xStats.ulEvents );
+	benchCHECK( uxCount >= 4 );
+	benchCHECK( xEvents[ 0 ].ucEvent == eHeapTraceMalloc );
+	benchCHECK( xEvents[ 0 ].xTask == NULL );
+	benchCHECK( xStats.xHeapSize == ( xEvents[ 0 ].xFreeBytes + xEvents[ 0 ].xSize ) );
+
+	for( uxIndex = 1; uxIndex < uxCount; uxIndex++ )
+	{
+		benchCHECK( xEvents[ uxIndex ].ucEvent == eHeapTraceMalloc );
+		benchCHECK( xEvents[ uxIndex ].xFreeBytes == ( xEvents[ uxIndex - 1 ].xFreeBytes - xEvents[ uxIndex ].xSize ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckEvents( void )
+{
+const HeapTraceEvent_t * pxEvent;
+void * pvCaller = NULL;
+size_t xFreeBefore;
+UBaseType_t uxIndex, uxBlock;
+
+	for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+	{
+		xFreeBefore = xPortGetFreeHeapSize();
+		pvBlocks[ uxIndex ] = pvPortMalloc( ( uxIndex + 1 ) * 24 );
+		configASSERT( pvBlocks[ uxIndex ] );
+
+		pxEvent = prvLastEvent();
+		benchCHECK( pxEvent->ucEvent == eHeapTraceMalloc );
+		benchCHECK( pxEvent->pvAddress == pvBlocks[ uxIndex ] );
+		benchCHECK( pxEvent->xSize >= ( ( uxIndex + 1 ) * 24 ) );
+		benchCHECK( pxEvent->xSize == ( xFreeBefore - xPortGetFreeHeapSize() ) );
+		benchCHECK( pxEvent->pvCaller != NULL );
+		prvCheckState( pxEvent );
+
+		/* Every allocation came from the same call. */
+		if( uxIndex == 0 )
+		{
+			pvCaller = pxEvent->pvCaller;
+		}
+
+		benchCHECK( pxEvent->pvCaller == pvCaller );
+	}
+
+	/* Free every other block, so that the free bytes are not all in one
+	block, then the rest. */
+	for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+	{
+		uxBlock = ( uxIndex < ( benchBLOCKS / 2 ) ) ? ( uxIndex * 2 ) : ( ( ( uxIndex - ( benchBLOCKS / 2 ) ) * 2 ) + 1 );
+		xFreeBefore = xPortGetFreeHeapSize();
+		vPortFree( pvBlocks[ uxBlock ] );
+
+		pxEvent = prvLastEvent();
+		benchCHECK( pxEvent->ucEvent == eHeapTraceFree );
+		benchCHECK( pxEvent->pvAddress == pvBlocks[ uxBlock ] );
+		benchCHECK( pxEvent->xSize == ( xPortGetFreeHeapSize() - xFreeBefore ) );
+		benchCHECK( pxEvent->pvCaller != NULL );
+		benchCHECK( pxEvent->pvCaller != pvCaller );
+		prvCheckState( pxEvent );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckFailed( void )
+{
+const HeapTraceEvent_t * pxEvent;
+HeapTraceStats_t xStats;
+
+	benchCHECK( pvPortMalloc( benchFAILED_SIZE ) == NULL );
+
+	pxEvent = prvLastEvent();
+	benchCHECK( pxEvent->ucEvent == eHeapTraceMallocFailed );
+	benchCHECK( pxEvent->pvAddress == NULL );
+	benchCHECK( pxEvent->xSize == benchFAILED_SIZE );
+	prvCheckState( pxEvent );
+
+	vHeapTraceGetStats( &xStats );
+	benchCHECK( xStats.ulFailedMallocs == 1 );
+	benchCHECK( xStats.xLargestFailedMalloc == benchFAILED_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOverflow( void )
+{
+HeapTraceStats_t xBefore, xAfter;
+void * pvPeak;
+size_t xFreeAtPeak;
+UBaseType_t uxRound, uxIndex, uxCount;
+uint32_t ulFirst;
+
+	vHeapTraceGetStats( &xBefore );
+
+	/* A peak whose events are overwritten by the ones that follow. */
+	pvPeak = pvPortMalloc( benchPEAK_SIZE );
+	configASSERT( pvPeak );
+	xFreeAtPeak = xPortGetFreeHeapSize();
+	vPortFree( pvPeak );
+
+	for( uxRound = 0; uxRound < ( benchCHURN / benchBLOCKS ); uxRound++ )
+	{
+		for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+		{
+			pvBlocks[ uxIndex ] = pvPortMalloc( ( ( uxRound + uxIndex ) % 7 + 1 ) * 40 );
+			configASSERT( pvBlocks[ uxIndex ] );
+		}
+
+		for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+		{
+			vPortFree( pvBlocks[ uxIndex ] );
+		}
+	}
+
+	uxCount = uxHeapTraceGetEvents( xEvents, configHEAP_TRACE_LENGTH, &ulFirst );
+	vHeapTraceGetStats( &xAfter );
+
+	printf( "  %lu events recorded, %lu held from event %lu, minimum ever free %lu bytes\n",
+			( unsigned long ) xAfter.ulEvents, ( unsigned long ) uxCount,
+			( unsigned long ) ulFirst, ( unsigned long ) xAfter.xMinimumEverFreeBytes );
+	benchCHECK( xAfter.ulEvents == ( xBefore.ulEvents + 2 + ( 2 * benchCHURN ) ) );
+	benchCHECK( uxCount == configHEAP_TRACE_LENGTH );
+	benchCHECK( ulFirst == ( xAfter.ulEvents - configHEAP_TRACE_LENGTH ) );
+	benchCHECK( xEvents[ uxCount - 1 ].ucEvent == eHeapTraceFree );
+	prvCheckState( &( xEvents[ uxCount - 1 ] ) );
+
+	for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+	{
+		benchCHECK( xEvents[ uxIndex ].xFreeBytes > xFreeAtPeak );
+	}
+
+	benchCHECK( xAfter.xMinimumEverFreeBytes <= xFreeAtPeak );
+	benchCHECK( xAfter.uxMaximumEverFragmentation >= xAfter.uxFragmentation );
+	benchCHECK( xAfter.ulFailedMallocs == 1 );
+
+	/* Fewer than held. */
+	uxCount = uxHeapTraceGetEvents( xEvents, 3, &ulFirst );
+	benchCHECK( uxCount == 3 );
+	benchCHECK( ulFirst == ( xAfter.ulEvents - 3 ) );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCountLines( const char * pcText )
+{
+UBaseType_t uxLines = 0;
+
+	while( ( pcText = strchr( pcText, '\n' ) ) != NULL )
+	{
+		uxLines++;
+		pcText++;
+	}
+
+	return uxLines;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckText( void )
+{
+HeapTraceStats_t xStats;
+unsigned long ulHeapSize, ulEvents, ulFailed, ulFirst, ulTime;
+size_t xLength;
+char cEvent[ 8 ];
+
+	vHeapTraceGetText( cText, sizeof( cText ) );
+	vHeapTraceGetStats( &xStats );
+	xLength = strlen( cText );
+
+	benchCHECK( prvCountLines( cText ) == ( configHEAP_TRACE_LENGTH + 1 ) );
+	benchCHECK( ( xLength > 0 ) && ( cText[ xLength - 1 ] == '\n' ) );
+	benchCHECK( sscanf( cText, "heapinfo %lu %lu %lu", &ulHeapSize, &ulEvents, &ulFailed ) == 3 );
+	benchCHECK( ulHeapSize == xStats.xHeapSize );
+	benchCHECK( ulEvents == xStats.ulEvents );
+	benchCHECK( ulFailed == xStats.ulFailedMallocs );
+	benchCHECK( sscanf( strchr( cText, '\n' ) + 1, "heap %lu %lu %7s", &ulFirst, &ulTime, cEvent ) == 3 );
+	benchCHECK( ulFirst == ( xStats.ulEvents - configHEAP_TRACE_LENGTH ) );
+
+	/* Room for the heapinfo line and one or two heap lines, but not for
+	half a line more. */
+	memset( cText, 'x', sizeof( cText ) );
+	vHeapTraceGetText( cText, benchSHORT_TEXT_LENGTH );
+	xLength = strlen( cText );
+
+	printf( "  text of %lu lines, %lu of them in %d bytes\n",
+			( unsigned long ) ( configHEAP_TRACE_LENGTH + 1 ), ( unsigned long ) prvCountLines( cText ),
+			benchSHORT_TEXT_LENGTH );
+	benchCHECK( xLength < benchSHORT_TEXT_LENGTH );
+	benchCHECK( prvCountLines( cText ) >= 2 );
+	benchCHECK( prvCountLines( cText ) < ( configHEAP_TRACE_LENGTH + 1 ) );
+	benchCHECK( cText[ xLength - 1 ] == '\n' );
+	benchCHECK( strncmp( cText, "heapinfo ", 9 ) == 0 );
+	benchCHECK( cText[ benchSHORT_TEXT_LENGTH ] == 'x' );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckClear( void )
+{
+HeapTraceStats_t xBefore, xAfter;
+uint32_t ulFirst;
+void * pvBlock;
+
+	vHeapTraceGetStats( &xBefore );
+	vHeapTraceClear();
+	vHeapTraceGetStats( &xAfter );
+
+	benchCHECK( uxHeapTraceGetEvents( xEvents, configHEAP_TRACE_LENGTH, &ulFirst ) == 0 );
+	benchCHECK( ulFirst == xBefore.ulEvents );
+	benchCHECK( xAfter.ulEvents == xBefore.ulEvents );
+	benchCHECK( xAfter.xHeapSize == xBefore.xHeapSize );
+	benchCHECK( xAfter.xMinimumEverFreeBytes == xPortGetFreeHeapSize() );
+	benchCHECK( xAfter.xMinimumEverLargestFreeBlock == xAfter.xLargestFreeBlock );
+	benchCHECK( xAfter.uxMaximumEverFragmentation == xAfter.uxFragmentation );
+	benchCHECK( xAfter.ulFailedMallocs == 0 );
+	benchCHECK( xAfter.xLargestFailedMalloc == 0 );
+
+	pvBlock = pvPortMalloc( 100 );
+	configASSERT( pvBlock );
+	vPortFree( pvBlock );
+
+	benchCHECK( uxHeapTraceGetEvents( xEvents, configHEAP_TRACE_LENGTH, &ulFirst ) == 2 );
+	benchCHECK( ulFirst == xBefore.ulEvents );
+	benchCHECK( xEvents[ 0 ].pvAddress == pvBlock );
+	benchCHECK( xEvents[ 1 ].pvAddress == pvBlock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+size_t xFreeBefore;
+
+	( void ) pvParameters;
+
+	printf( "heap trace of %s\n", ( benchUSE_HEAP_6 == 1 ) ? "heap_6.c" : "heap_4.c" );
+
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	prvCheckStart();
+	prvCheckEvents();
+	prvCheckFailed();
+	prvCheckOverflow();
+	prvCheckText();
+	prvCheckClear();
+
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	#if ( benchUSE_HEAP_6 == 1 )
+	{
+		const HeapRegion_t xRegions[] =
+		{
+			{ ucRegion, sizeof( ucRegion ) },
+			{ NULL,     0                  }
+		};
+
+		vPortDefineHeapRegions( xRegions );
+	}
+	#endif
+
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,360 @@
+/*
+ * Check of the high resolution timers (build/bench/hrtimer).  The scheduler is
+ * not started.
+ *
+ * The check includes hrtimer.c, with configUSE_HR_TIMERS set here rather than
+ * for the whole program, so that the port's own counter is left out.  The
+ * check stands in for it with a counter it steps itself, and calls
+ * xHrTimerProcessCompare() as the compare interrupt whenever the counter has
+ * reached the compare value while the compare is enabled.  Checks that:
+ *
+ *   - timers are called back in the order they expire, those that expire at
+ *     the same count in the order they were started, including across a wrap
+ *     of the counter, and the compare is disabled once none are active;
+ *   - a periodic timer expires a whole number of periods after it started;
+ *   - a periodic timer whose callback takes longer than its period is called
+ *     back once per interrupt, every interrupt returns, and each period is
+ *     either called back or counted as an overrun;
+ *   - a timer that expires while another's callback runs is called back by
+ *     the next interrupt, not lost;
+ *   - a timer can stop itself and restart itself from its callback.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* The timers themselves, for their private list. */
+#define configUSE_HR_TIMERS    1
+#include "hrtimer.c"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* More interrupts than this on one count of the counter means the interrupt
+is raised again each time it returns. */
+#define benchMAX_INTERRUPTS_PER_COUNT	( 100 )
+
+#define benchORDER_TIMERS		( 4 )
+#define benchSLOW_PERIOD		( 10U )
+#define benchSLOW_CALLBACK		( 25U )
+#define benchSLOW_INTERRUPTS	( 50 )
+
+/*-----------------------------------------------------------*/
+
+/* The stand-in for the port's counter and compare channel. */
+static uint32_t ulCounter;
+static uint32_t ulCompare;
+static BaseType_t xCompareEnabled = pdFALSE;
+
+static unsigned long ulInterrupts;
+static unsigned long ulCallbacksThisInterrupt;
+static char cOrder[ 16 ];
+static unsigned long ulOrdered;
+static uint32_t ulCalledAt[ 16 ];
+static unsigned long ulCalled;
+
+/*-----------------------------------------------------------*/
+
+static void prvRunTo( uint32_t ulTime );
+static BaseType_t prvRaiseCompare( void );
+static void prvRecordCallback( HrTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken );
+static void prvSlowCallback( HrTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken );
+static void prvStopSelfCallback( HrTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken );
+static void prvRestartSelfCallback( HrTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken );
+static void prvCheckOrder( uint32_t ulStart );
+static void prvCheckPeriodic( void );
+static void prvCheckSlowCallback( void );
+static void prvCheckSelf( void );
+
+/*-----------------------------------------------------------*/
+
+void vPortHrTimerSetup( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortHrTimerGetCount( void )
+{
+	return ulCounter;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHrTimerSetCompare( uint32_t ulCount )
+{
+	ulCompare = ulCount;
+	xCompareEnabled = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHrTimerDisableCompare( void )
+{
+	xCompareEnabled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRaiseCompare( void )
+{
+BaseType_t xRaised = pdFALSE;
+
+	/* As the port does, the interrupt is raised once the counter has reached
+	the compare value, straight away if it is already past it. */
+	if( ( xCompareEnabled != pdFALSE ) && ( hrtimerIS_BEFORE( ulCounter, ulCompare ) == pdFALSE ) )
+	{
+		xCompareEnabled = pdFALSE;
+		ulInterrupts++;
+		ulCallbacksThisInterrupt = 0;
+		( void ) xHrTimerProcessCompare();
+		xRaised = pdTRUE;
+	}
+
+	return xRaised;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTo( uint32_t ulTime )
+{
+unsigned long ulRaised;
+
+	while( ulCounter != ulTime )
+	{
+		ulCounter++;
+
+		for( ulRaised = 0; prvRaiseCompare() != pdFALSE; ulRaised++ )
+		{
+			if( ulRaised >= benchMAX_INTERRUPTS_PER_COUNT )
+			{
+				benchCHECK( pdFALSE );
+				break;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordCallback( HrTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken )
+{
+	( void ) pxHigherPriorityTaskWoken;
+
+	ulCallbacksThisInterrupt++;
+
+	if( ulOrdered < ( sizeof( cOrder ) - 1 ) )
+	{
+		cOrder[ ulOrdered++ ] = ( char ) ( size_t ) pvHrTimerGetTimerID( xTimer );
+	}
+
+	if( ulCalled < ( sizeof( ulCalledAt ) / sizeof( ulCalledAt[ 0 ] ) ) )
+	{
+		ulCalledAt[ ulCalled++ ] = ulCounter;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlowCallback( HrTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken )
+{
+	( void ) pxHigherPriorityTaskWoken;
+
+	/* Takes longer than the timer's period. */
+	ulCallbacksThisInterrupt++;
+	ulCalled++;
+	ulCounter += benchSLOW_CALLBACK;
+
+	if( ulCallbacksThisInterrupt > 2 )
+	{
+		/* The interrupt would not return, stop it. */
+		benchCHECK( pdFALSE );
+		vHrTimerStopFromISR( xTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopSelfCallback( HrTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken )
+{
+	( void ) pxHigherPriorityTaskWoken;
+
+	if( ++ulCalled == 3 )
+	{
+		vHrTimerStopFromISR( xTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRestartSelfCallback( HrTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken )
+{
+	( void ) pxHigherPriorityTaskWoken;
+
+	if( ulCalled < ( sizeof( ulCalledAt ) / sizeof( ulCalledAt[ 0 ] ) ) )
+	{
+		ulCalledAt[ ulCalled++ ] = ulCounter;
+	}
+
+	if( ulCalled < 4 )
+	{
+		vHrTimerStartFromISR( xTimer, 7, 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOrder( uint32_t ulStart )
+{
+HrTimerHandle_t xTimers[ benchORDER_TIMERS ];
+static const uint32_t ulDelays[ benchORDER_TIMERS ] = { 300, 100, 200, 200 };
+UBaseType_t uxIndex;
+
+	ulCounter = ulStart;
+	ulOrdered = 0;
+	ulCalled = 0;
+
+	/* 'C' and 'D' expire at the same count, 'C' was started first. */
+	for( uxIndex = 0; uxIndex < benchORDER_TIMERS; uxIndex++ )
+	{
+		xTimers[ uxIndex ] = xHrTimerCreate( prvRecordCallback, ( void * ) ( size_t ) ( 'A' + uxIndex ) );
+		configASSERT( xTimers[ uxIndex ] );
+		vHrTimerStart( xTimers[ uxIndex ], ulDelays[ uxIndex ], 0 );
+	}
+
+	benchCHECK( xCompareEnabled != pdFALSE );
+	benchCHECK( ulCompare == ( uint32_t ) ( ulStart + 100U ) );
+
+	prvRunTo( ulStart + 1000U );
+	cOrder[ ulOrdered ] = '\0';
+	printf( "  from count %lu, timers called back in the order %s\n", ( unsigned long ) ulStart, cOrder );
+
+	benchCHECK( ulOrdered == benchORDER_TIMERS );
+	benchCHECK( ( cOrder[ 0 ] == 'B' ) && ( cOrder[ 1 ] == 'C' ) && ( cOrder[ 2 ] == 'D' ) && ( cOrder[ 3 ] == 'A' ) );
+	benchCHECK( ulCalledAt[ 0 ] == ( uint32_t ) ( ulStart + 100U ) );
+	benchCHECK( ulCalledAt[ 1 ] == ( uint32_t ) ( ulStart + 200U ) );
+	benchCHECK( ulCalledAt[ 3 ] == ( uint32_t ) ( ulStart + 300U ) );
+	benchCHECK( xCompareEnabled == pdFALSE );
+
+	for( uxIndex = 0; uxIndex < benchORDER_TIMERS; uxIndex++ )
+	{
+		benchCHECK( xHrTimerIsTimerActive( xTimers[ uxIndex ] ) == pdFALSE );
+		vHrTimerDelete( xTimers[ uxIndex ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckPeriodic( void )
+{
+HrTimerHandle_t xTimer;
+UBaseType_t uxIndex;
+
+	ulCounter = 5000;
+	ulCalled = 0;
+
+	xTimer = xHrTimerCreate( prvRecordCallback, ( void * ) ( size_t ) 'P' );
+	configASSERT( xTimer );
+	vHrTimerStart( xTimer, 50, 100 );
+	prvRunTo( 5000U + 50U + ( 9U * 100U ) );
+
+	benchCHECK( ulCalled == 10 );
+
+	for( uxIndex = 0; uxIndex < ulCalled; uxIndex++ )
+	{
+		benchCHECK( ulCalledAt[ uxIndex ] == ( uint32_t ) ( 5050U + ( uxIndex * 100U ) ) );
+	}
+
+	benchCHECK( ulHrTimerGetOverrunCount( xTimer ) == 0 );
+	benchCHECK( xHrTimerIsTimerActive( xTimer ) != pdFALSE );
+
+	vHrTimerStop( xTimer );
+	benchCHECK( xHrTimerIsTimerActive( xTimer ) == pdFALSE );
+	benchCHECK( xCompareEnabled == pdFALSE );
+	vHrTimerDelete( xTimer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckSlowCallback( void )
+{
+HrTimerHandle_t xSlow, xOther;
+unsigned long ulInterrupt, ulOverruns, ulOtherCalls;
+
+	ulCounter = 0;
+	ulCalled = 0;
+	ulOrdered = 0;
+	ulInterrupts = 0;
+
+	xSlow = xHrTimerCreate( prvSlowCallback, NULL );
+	xOther = xHrTimerCreate( prvRecordCallback, ( void * ) ( size_t ) 'O' );
+	configASSERT( xSlow && xOther );
+
+	/* The other timer expires while the first slow callback runs. */
+	vHrTimerStart( xSlow, benchSLOW_PERIOD, benchSLOW_PERIOD );
+	vHrTimerStart( xOther, benchSLOW_PERIOD + 5U, 0 );
+
+	ulCounter = benchSLOW_PERIOD;
+
+	for( ulInterrupt = 0; ulInterrupt < benchSLOW_INTERRUPTS; ulInterrupt++ )
+	{
+		/* Each interrupt returns, with the compare already due again. */
+		benchCHECK( prvRaiseCompare() != pdFALSE );
+
+		/* The other timer is called back with the slow one by the second
+		interrupt. */
+		benchCHECK( ulCallbacksThisInterrupt == ( ( ulInterrupt == 1 ) ? 2UL : 1UL ) );
+	}
+
+	ulOtherCalls = ulOrdered;
+	ulOverruns = ulHrTimerGetOverrunCount( xSlow );
+	printf( "  callback of %u counts, period %u: %lu interrupts, %lu callbacks, %lu overruns\n",
+			benchSLOW_CALLBACK, benchSLOW_PERIOD, ulInterrupts, ulCalled - ulOtherCalls, ulOverruns );
+
+	benchCHECK( ulOtherCalls == 1 );
+	benchCHECK( ( ulCalled - ulOtherCalls ) == benchSLOW_INTERRUPTS );
+	benchCHECK( ulOverruns > 0 );
+
+	/* Every period up to the next expiry was either called back or skipped. */
+	benchCHECK( xSlow->ulExpiryTime == ( uint32_t ) ( benchSLOW_PERIOD * ( 1U + ( ulCalled - ulOtherCalls ) + ulOverruns ) ) );
+	benchCHECK( hrtimerIS_BEFORE( ulCounter, xSlow->ulExpiryTime ) == pdFALSE );
+
+	vHrTimerDelete( xSlow );
+	vHrTimerDelete( xOther );
+	benchCHECK( xCompareEnabled == pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckSelf( void )
+{
+HrTimerHandle_t xTimer;
+
+	ulCounter = 0;
+	ulCalled = 0;
+
+	xTimer = xHrTimerCreate( prvStopSelfCallback, NULL );
+	configASSERT( xTimer );
+	vHrTimerStart( xTimer, 10, 10 );
+	prvRunTo( 200 );
+	benchCHECK( ulCalled == 3 );
+	benchCHECK( xHrTimerIsTimerActive( xTimer ) == pdFALSE );
+	vHrTimerDelete( xTimer );
+
+	ulCounter = 0;
+	ulCalled = 0;
+
+	xTimer = xHrTimerCreate( prvRestartSelfCallback, NULL );
+	configASSERT( xTimer );
+	vHrTimerStart( xTimer, 10, 0 );
+	prvRunTo( 200 );
+	benchCHECK( ulCalled == 4 );
+	benchCHECK( ( ulCalledAt[ 0 ] == 10U ) && ( ulCalledAt[ 1 ] == 17U ) && ( ulCalledAt[ 2 ] == 24U ) && ( ulCalledAt[ 3 ] == 31U ) );
+	benchCHECK( xHrTimerIsTimerActive( xTimer ) == pdFALSE );
+	vHrTimerDelete( xTimer );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	printf( "high resolution timers\n" );
+
+	prvCheckOrder( 1000 );
+	prvCheckOrder( 0xffffff00UL );
+	prvCheckPeriodic();
+	prvCheckSlowCallback();
+	prvCheckSelf();
+	vBenchExit();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,249 @@
+/*
+ * Check of the software timers whose callbacks run from the tick interrupt
+ * (build/bench/isrtimer).
+ *
+ * Checks that:
+ *
+ *   - a periodic timer expires on the ticks its period gives, and a one-shot
+ *     timer once;
+ *   - the callbacks run on time while a task above the timer service task
+ *     keeps the processor, when the callbacks of a timer of the timer service
+ *     task do not run at all;
+ *   - stop, change period and delete commands take effect, and a deleted
+ *     timer is freed by the timer service task;
+ *   - commands never block, and fail once the command ring is full while the
+ *     scheduler, and with it the tick, is held back.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchMAX_CALLS			( 64 )
+#define benchPERIOD				( 5 )
+#define benchBUSY_TICKS			( 50 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchBUSY_PRIORITY		( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+/* The ticks at which the callbacks of the ISR timer and of the timer of the
+timer service task ran. */
+static volatile TickType_t xIsrCalls[ benchMAX_CALLS ];
+static volatile unsigned long ulIsrCalls;
+static volatile unsigned long ulTaskCalls;
+
+static volatile TickType_t xBusyStart, xBusyEnd;
+static volatile unsigned long ulIsrCallsBusyStart, ulIsrCallsBusyEnd;
+static volatile unsigned long ulTaskCallsBusyStart, ulTaskCallsBusyEnd;
+static volatile BaseType_t xBusyDone;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvBusyTask( void * pvParameters );
+static void prvIsrCallback( TimerHandle_t xTimer );
+static void prvTaskCallback( TimerHandle_t xTimer );
+static TimerHandle_t prvCreateIsrTimer( TickType_t xPeriod, UBaseType_t uxAutoReload );
+static void prvCheckPeriods( TickType_t xStart, TickType_t xPeriod, unsigned long ulFirst, unsigned long ulLast );
+
+/*-----------------------------------------------------------*/
+
+static void prvIsrCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+
+	if( ulIsrCalls < benchMAX_CALLS )
+	{
+		xIsrCalls[ ulIsrCalls ] = xTaskGetTickCountFromISR();
+	}
+
+	ulIsrCalls++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+
+	ulTaskCalls++;
+}
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t prvCreateIsrTimer( TickType_t xPeriod, UBaseType_t uxAutoReload )
+{
+TimerHandle_t xTimer;
+
+	xTimer = xTimerCreate( "isr", xPeriod, uxAutoReload, NULL, prvIsrCallback );
+	configASSERT( xTimer );
+	vTimerSetIsrCallback( xTimer, pdTRUE );
+	ulIsrCalls = 0;
+
+	return xTimer;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckPeriods( TickType_t xStart, TickType_t xPeriod, unsigned long ulFirst, unsigned long ulLast )
+{
+unsigned long ulCall;
+
+	for( ulCall = ulFirst; ( ulCall < ulLast ) && ( ulCall < benchMAX_CALLS ); ulCall++ )
+	{
+		benchCHECK( xIsrCalls[ ulCall ] == ( xStart + ( ( TickType_t ) ( ulCall - ulFirst + 1 ) * xPeriod ) ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	/* Keeps the processor from the timer service task. */
+	xBusyStart = xTaskGetTickCount();
+	ulIsrCallsBusyStart = ulIsrCalls;
+	ulTaskCallsBusyStart = ulTaskCalls;
+
+	while( ( xTaskGetTickCount() - xBusyStart ) < benchBUSY_TICKS )
+	{
+	}
+
+	xBusyEnd = xTaskGetTickCount();
+	ulIsrCallsBusyEnd = ulIsrCalls;
+	ulTaskCallsBusyEnd = ulTaskCalls;
+	xBusyDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+TimerHandle_t xTimer, xTaskTimer;
+TickType_t xStart;
+unsigned long ulCalls, ulCall, ulLate = 0;
+size_t xFreeBefore;
+UBaseType_t uxCommand;
+BaseType_t xResult;
+
+	( void ) pvParameters;
+
+	printf( "software timers run from the tick interrupt\n" );
+
+	/* A periodic timer, then a stop. */
+	xTimer = prvCreateIsrTimer( benchPERIOD, pdTRUE );
+	vTaskDelay( 1 );
+	xStart = xTaskGetTickCount();
+	benchCHECK( xTimerStart( xTimer, 0 ) == pdPASS );
+	vTaskDelay( ( 10 * benchPERIOD ) + 2 );
+	benchCHECK( ulIsrCalls == 10 );
+	prvCheckPeriods( xStart, benchPERIOD, 0, ulIsrCalls );
+
+	benchCHECK( xTimerStop( xTimer, 0 ) == pdPASS );
+	vTaskDelay( 2 );
+	ulCalls = ulIsrCalls;
+	vTaskDelay( 3 * benchPERIOD );
+	benchCHECK( ulIsrCalls == ulCalls );
+	benchCHECK( xTimerIsTimerActive( xTimer ) == pdFALSE );
+
+	/* A change of period starts the timer again with the new period, from the
+	tick the command is applied on. */
+	ulIsrCalls = 0;
+	xStart = xTaskGetTickCount() + 1;
+	benchCHECK( xTimerChangePeriod( xTimer, 3, 0 ) == pdPASS );
+	vTaskDelay( ( 6 * 3 ) + 2 );
+	benchCHECK( ulIsrCalls == 6 );
+	prvCheckPeriods( xStart, 3, 0, ulIsrCalls );
+	( void ) xTimerStop( xTimer, 0 );
+	vTaskDelay( 2 );
+
+	/* A one-shot timer. */
+	benchCHECK( xTimerDelete( xTimer, 0 ) == pdPASS );
+	xTimer = prvCreateIsrTimer( benchPERIOD, pdFALSE );
+	xStart = xTaskGetTickCount();
+	benchCHECK( xTimerStart( xTimer, 0 ) == pdPASS );
+	vTaskDelay( 4 * benchPERIOD );
+	benchCHECK( ulIsrCalls == 1 );
+	benchCHECK( xIsrCalls[ 0 ] == ( xStart + benchPERIOD ) );
+	benchCHECK( xTimerIsTimerActive( xTimer ) == pdFALSE );
+
+	/* On time while a task above the timer service task keeps the
+	processor. */
+	( void ) xTimerChangePeriod( xTimer, benchPERIOD, 0 );
+	vTimerSetReloadMode( xTimer, pdTRUE );
+	xTaskTimer = xTimerCreate( "task", 1, pdTRUE, NULL, prvTaskCallback );
+	configASSERT( xTaskTimer );
+	vTaskDelay( benchPERIOD + 2 );
+	benchCHECK( xTimerStart( xTaskTimer, 0 ) == pdPASS );
+	vTaskDelay( 2 );
+
+	ulIsrCalls = 0;
+	xBusyDone = pdFALSE;
+
+	/* The busy task runs above this one, so it is done by the time this one
+	runs again. */
+	xTaskCreate( prvBusyTask, "busy", configMINIMAL_STACK_SIZE, NULL, benchBUSY_PRIORITY, NULL );
+	benchCHECK( xBusyDone == pdTRUE );
+
+	for( ulCall = 0; ( ulCall < ulIsrCalls ) && ( ulCall < benchMAX_CALLS ); ulCall++ )
+	{
+		if( ( ulCall > 0 ) && ( xIsrCalls[ ulCall ] != ( xIsrCalls[ ulCall - 1 ] + benchPERIOD ) ) )
+		{
+			ulLate++;
+		}
+	}
+
+	ulCalls = ulTaskCallsBusyEnd - ulTaskCallsBusyStart;
+	printf( "  while a task above the timer service task ran for %lu ticks: %lu ISR timer callbacks, %lu off period, %lu timer service task callbacks\n",
+			( unsigned long ) ( xBusyEnd - xBusyStart ), ulIsrCallsBusyEnd - ulIsrCallsBusyStart, ulLate, ulCalls );
+	benchCHECK( ( ulIsrCallsBusyEnd - ulIsrCallsBusyStart ) >= ( ( benchBUSY_TICKS / benchPERIOD ) - 1 ) );
+	benchCHECK( ulLate == 0 );
+	benchCHECK( ulCalls == 0 );
+	( void ) xTimerStop( xTaskTimer, 0 );
+	( void ) xTimerStop( xTimer, 0 );
+	vTaskDelay( 2 );
+
+	/* Commands fail, without blocking, once the ring is full and the tick is
+	held back. */
+	vTaskSuspendAll();
+	{
+		for( uxCommand = 0; uxCommand < configTIMER_ISR_COMMAND_QUEUE_LENGTH; uxCommand++ )
+		{
+			benchCHECK( xTimerReset( xTimer, portMAX_DELAY ) == pdPASS );
+		}
+
+		xResult = xTimerReset( xTimer, portMAX_DELAY );
+	}
+	( void ) xTaskResumeAll();
+	benchCHECK( xResult == pdFAIL );
+
+	vTaskDelay( 2 );
+	benchCHECK( xTimerStop( xTimer, 0 ) == pdPASS );
+	vTaskDelay( 2 );
+
+	/* A deleted timer is freed by the timer service task. */
+	xFreeBefore = xPortGetFreeHeapSize();
+	benchCHECK( xTimerDelete( xTimer, 0 ) == pdPASS );
+	vTaskDelay( 5 );
+	benchCHECK( xPortGetFreeHeapSize() > xFreeBefore );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,203 @@
+/*
+ * Check of the task mailboxes (build/bench/mailbox).
+ *
+ * The control task owns a mailbox of four words at notification index 1.
+ * Checks that:
+ *
+ *   - a message arrives whole, a send to a full mailbox without overwrite
+ *     fails at once with no block time, and an overwrite replaces it;
+ *   - a send with a block time waits until the message before it is
+ *     received, and the messages arrive in order;
+ *   - a send to a mailbox that is never read times out after its block time,
+ *     including when it is woken early by a receive from another mailbox;
+ *   - a receive with nothing pending times out.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchINDEX				( 1 )
+#define benchWORDS				( 4 )
+#define benchMESSAGES			( 50 )
+#define benchSTUCK_WAIT			( 30 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchSENDER_PRIORITY	( 3 )
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xControlTask, xIdleOwner;
+static volatile unsigned long ulSent, ulSendFailed;
+static volatile TickType_t xStuckElapsed;
+static volatile BaseType_t xStuckResult, xStuckDone;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvSenderTask( void * pvParameters );
+static void prvStuckSenderTask( void * pvParameters );
+static void prvIdleOwnerTask( void * pvParameters );
+static void prvFill( uint32_t * pulWords, uint32_t ulMessage );
+
+/*-----------------------------------------------------------*/
+
+static void prvFill( uint32_t * pulWords, uint32_t ulMessage )
+{
+UBaseType_t uxWord;
+
+	for( uxWord = 0; uxWord < benchWORDS; uxWord++ )
+	{
+		pulWords[ uxWord ] = ( ulMessage << 8 ) | ( uint32_t ) uxWord;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSenderTask( void * pvParameters )
+{
+uint32_t ulWords[ benchWORDS ];
+uint32_t ulMessage;
+
+	( void ) pvParameters;
+
+	/* Runs above the control task, so every send after the first finds the
+	mailbox full and waits for the control task to receive. */
+	for( ulMessage = 0; ulMessage < benchMESSAGES; ulMessage++ )
+	{
+		prvFill( ulWords, ulMessage );
+
+		if( xTaskMailboxSend( xControlTask, benchINDEX, ulWords, benchWORDS, pdFALSE, portMAX_DELAY ) == pdPASS )
+		{
+			ulSent++;
+		}
+		else
+		{
+			ulSendFailed++;
+		}
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleOwnerTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	/* Owns a mailbox that is never read. */
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStuckSenderTask( void * pvParameters )
+{
+uint32_t ulWords[ benchWORDS ] = { 0 };
+TickType_t xStart;
+
+	( void ) pvParameters;
+
+	( void ) xTaskMailboxSend( xIdleOwner, benchINDEX, ulWords, benchWORDS, pdFALSE, 0 );
+
+	xStart = xTaskGetTickCount();
+	xStuckResult = xTaskMailboxSend( xIdleOwner, benchINDEX, ulWords, benchWORDS, pdFALSE, benchSTUCK_WAIT );
+	xStuckElapsed = xTaskGetTickCount() - xStart;
+	xStuckDone = pdTRUE;
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+uint32_t ulWords[ benchWORDS ], ulExpected[ benchWORDS ];
+uint32_t ulMessage;
+unsigned long ulWrong = 0;
+UBaseType_t uxWord;
+TickType_t xStart;
+
+	( void ) pvParameters;
+
+	printf( "task mailboxes\n" );
+
+	/* Without blocking. */
+	prvFill( ulWords, 1 );
+	benchCHECK( xTaskMailboxSend( xControlTask, benchINDEX, ulWords, benchWORDS, pdFALSE, 0 ) == pdPASS );
+	prvFill( ulWords, 2 );
+	benchCHECK( xTaskMailboxSend( xControlTask, benchINDEX, ulWords, benchWORDS, pdFALSE, 0 ) == pdFAIL );
+	prvFill( ulWords, 3 );
+	benchCHECK( xTaskMailboxSend( xControlTask, benchINDEX, ulWords, benchWORDS, pdTRUE, 0 ) == pdPASS );
+	benchCHECK( xTaskMailboxReceive( benchINDEX, ulWords, benchWORDS, 0 ) == pdPASS );
+	prvFill( ulExpected, 3 );
+
+	for( uxWord = 0; uxWord < benchWORDS; uxWord++ )
+	{
+		benchCHECK( ulWords[ uxWord ] == ulExpected[ uxWord ] );
+	}
+
+	benchCHECK( xTaskMailboxReceive( benchINDEX, ulWords, benchWORDS, 0 ) == pdFAIL );
+
+	/* A receive that times out. */
+	xStart = xTaskGetTickCount();
+	benchCHECK( xTaskMailboxReceive( benchINDEX, ulWords, benchWORDS, 10 ) == pdFAIL );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+
+	/* A sender that waits on a mailbox nobody reads, woken by every receive
+	below. */
+	xTaskCreate( prvIdleOwnerTask, "owner", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, &xIdleOwner );
+	xTaskCreate( prvStuckSenderTask, "stuck", configMINIMAL_STACK_SIZE, NULL, benchSENDER_PRIORITY, NULL );
+
+	/* Senders that wait for this task to receive. */
+	xTaskCreate( prvSenderTask, "sender", configMINIMAL_STACK_SIZE, NULL, benchSENDER_PRIORITY, NULL );
+
+	for( ulMessage = 0; ulMessage < benchMESSAGES; ulMessage++ )
+	{
+		if( xTaskMailboxReceive( benchINDEX, ulWords, benchWORDS, 100 ) != pdPASS )
+		{
+			ulWrong++;
+			continue;
+		}
+
+		prvFill( ulExpected, ulMessage );
+
+		for( uxWord = 0; uxWord < benchWORDS; uxWord++ )
+		{
+			if( ulWords[ uxWord ] != ulExpected[ uxWord ] )
+			{
+				ulWrong++;
+				break;
+			}
+		}
+	}
+
+	printf( "  %lu messages sent with waits, %lu send failures, %lu received wrong\n", ulSent, ulSendFailed, ulWrong );
+	benchCHECK( ulSent == benchMESSAGES );
+	benchCHECK( ulSendFailed == 0 );
+	benchCHECK( ulWrong == 0 );
+
+	vTaskDelay( benchSTUCK_WAIT + 10 );
+	printf( "  send to a mailbox never read: %s after %lu ticks of %d\n", ( xStuckResult == pdPASS ) ? "sent" : "failed",
+			( unsigned long ) xStuckElapsed, benchSTUCK_WAIT );
+	benchCHECK( xStuckDone == pdTRUE );
+	benchCHECK( xStuckResult == pdFAIL );
+	benchCHECK( xStuckElapsed >= benchSTUCK_WAIT );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
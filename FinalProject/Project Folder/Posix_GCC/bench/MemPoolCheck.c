@@ -0,0 +1,393 @@
+/*
+ * Check of the fixed-size block memory pools (build/bench/mempool with fixed
+ * priorities, build/bench/mempool_edf with the EDF scheduler).
+ *
+ * Checks that:
+ *
+ *   - a pool hands out the number of blocks it was created with, distinct and
+ *     aligned, after which an allocation fails at once with no block time and
+ *     after its block time with one, and the counts of free blocks follow;
+ *   - a block freed from the tick interrupt goes to a task blocked on the
+ *     empty pool within a tick;
+ *   - tasks blocked on the empty pool get the blocks freed in the order of
+ *     their priorities, or under EDF of their deadlines;
+ *   - tasks that yield between allocating and freeing, and the tick interrupt
+ *     doing the same, are never handed a block that is in use;
+ *   - deleting a pool returns all of its heap memory.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mem_pool.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchBLOCK_SIZE			( 20 )
+#define benchBLOCKS				( 4 )
+#define benchWAITERS			( 3 )
+#define benchSTRESS_TASKS		( 4 )
+#define benchSTRESS_BLOCKS		( 8 )
+#define benchSTRESS_TICKS		( 200 )
+
+/* The tag the tick interrupt writes in the blocks it holds. */
+#define benchTICK_TAG			( 0xffUL )
+
+/* Under fixed priorities the control task runs above every other task.  Under
+EDF it has a period of one tick, so each time it wakes its deadline is the next
+tick and it runs ahead of the other tasks as well.  Their deadlines are ahead of
+that of the idle task, EDF_IDLE_PERIOD ticks from now. */
+#define benchCONTROL_PRIORITY	( 4 )
+#define benchCONTROL_PERIOD		( 1 )
+#define benchHELPER_PRIORITY	( 1 )
+#define benchSTRESS_PERIOD		( 50 )
+
+/*-----------------------------------------------------------*/
+
+static MemPoolHandle_t xPool;
+
+/* The block the tick hook frees and the ticks at which it was freed and taken
+by the task blocked on the pool. */
+static void * volatile pvTickFree;
+static volatile TickType_t xFreedTick, xTakenTick;
+static void * volatile pvTaken;
+
+/* The indexes of the waiters in the order they got a block, and the blocks. */
+static volatile UBaseType_t uxOrder[ benchWAITERS ];
+static volatile UBaseType_t uxServed;
+static void * volatile pvWaiterBlocks[ benchWAITERS ];
+
+/* The tick hook allocates and frees while xTickStressing is pdTRUE. */
+static volatile BaseType_t xTickStressing, xStressDone;
+static volatile unsigned long ulAllocations, ulCorrupted, ulStressTasksDone;
+static uint32_t * volatile pulTickBlock;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvAllocTask( void * pvParameters );
+static void prvWaiterTask( void * pvParameters );
+static void prvStressTask( void * pvParameters );
+static void prvYield( void );
+static BaseType_t prvCreateTask( TaskFunction_t pxTaskCode, const char * const pcName, void * const pvParameters,
+								 UBaseType_t uxPriority, TickType_t xPeriod );
+static void prvCheckLimits( void );
+static void prvCheckFreeFromISR( void );
+static void prvCheckWaiters( void );
+static void prvCheckStress( void );
+void vApplicationTickHook( void );
+
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	if( pvTickFree != NULL )
+	{
+		xFreedTick = xTaskGetTickCountFromISR();
+		vMemPoolFreeFromISR( xPool, pvTickFree, NULL );
+		pvTickFree = NULL;
+	}
+
+	if( xTickStressing != pdFALSE )
+	{
+		/* Hold a block from one tick to the next. */
+		if( pulTickBlock != NULL )
+		{
+			if( *pulTickBlock != benchTICK_TAG )
+			{
+				ulCorrupted++;
+			}
+
+			vMemPoolFreeFromISR( xPool, pulTickBlock, NULL );
+		}
+
+		pulTickBlock = ( uint32_t * ) pvMemPoolAllocFromISR( xPool );
+
+		if( pulTickBlock != NULL )
+		{
+			*pulTickBlock = benchTICK_TAG;
+			ulAllocations++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCreateTask( TaskFunction_t pxTaskCode, const char * const pcName, void * const pvParameters,
+								 UBaseType_t uxPriority, TickType_t xPeriod )
+{
+BaseType_t xReturn;
+
+	/* Under EDF a task created by xTaskCreate() has no deadline and never
+	runs ahead of the idle task. */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+		xReturn = xTaskPeriodicCreate( pxTaskCode, pcName, configMINIMAL_STACK_SIZE, pvParameters, uxPriority, NULL, xPeriod );
+	#else
+		( void ) xPeriod;
+		xReturn = xTaskCreate( pxTaskCode, pcName, configMINIMAL_STACK_SIZE, pvParameters, uxPriority, NULL );
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckLimits( void )
+{
+void * pvBlocks[ benchBLOCKS ];
+UBaseType_t uxIndex, uxOther;
+TickType_t xStart;
+
+	benchCHECK( uxMemPoolGetFreeBlocks( xPool ) == benchBLOCKS );
+
+	for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+	{
+		pvBlocks[ uxIndex ] = pvMemPoolAlloc( xPool, 0 );
+		benchCHECK( pvBlocks[ uxIndex ] != NULL );
+		benchCHECK( ( ( size_t ) pvBlocks[ uxIndex ] & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		for( uxOther = 0; uxOther < uxIndex; uxOther++ )
+		{
+			benchCHECK( pvBlocks[ uxOther ] != pvBlocks[ uxIndex ] );
+		}
+	}
+
+	benchCHECK( uxMemPoolGetFreeBlocks( xPool ) == 0 );
+	benchCHECK( uxMemPoolGetMinimumEverFreeBlocks( xPool ) == 0 );
+	benchCHECK( pvMemPoolAlloc( xPool, 0 ) == NULL );
+	benchCHECK( pvMemPoolAllocFromISR( xPool ) == NULL );
+	xStart = xTaskGetTickCount();
+	benchCHECK( pvMemPoolAlloc( xPool, 10 ) == NULL );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+
+	for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+	{
+		vMemPoolFree( xPool, pvBlocks[ uxIndex ] );
+	}
+
+	benchCHECK( uxMemPoolGetFreeBlocks( xPool ) == benchBLOCKS );
+	benchCHECK( uxMemPoolGetMinimumEverFreeBlocks( xPool ) == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAllocTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	pvTaken = pvMemPoolAlloc( xPool, portMAX_DELAY );
+	xTakenTick = xTaskGetTickCount();
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckFreeFromISR( void )
+{
+void * pvBlocks[ benchBLOCKS ];
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+	{
+		pvBlocks[ uxIndex ] = pvMemPoolAlloc( xPool, 0 );
+		configASSERT( pvBlocks[ uxIndex ] );
+	}
+
+	/* Let the task block on the empty pool, then have the tick free a
+	block. */
+	pvTaken = NULL;
+	benchCHECK( prvCreateTask( prvAllocTask, "alloc", NULL, benchHELPER_PRIORITY, benchBLOCKS ) == pdPASS );
+	vTaskDelay( 5 );
+	benchCHECK( pvTaken == NULL );
+	pvTickFree = pvBlocks[ 0 ];
+	vTaskDelay( 5 );
+
+	printf( "  a block freed from the tick was taken %lu ticks later\n", ( unsigned long ) ( xTakenTick - xFreedTick ) );
+	benchCHECK( pvTaken == pvBlocks[ 0 ] );
+	/* Usually in the same tick, on the Posix port at times in the next. */
+	benchCHECK( ( xTakenTick - xFreedTick ) <= 1 );
+
+	for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+	{
+		vMemPoolFree( xPool, pvBlocks[ uxIndex ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void * pvParameters )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) ( size_t ) pvParameters;
+
+	pvWaiterBlocks[ uxIndex ] = pvMemPoolAlloc( xPool, portMAX_DELAY );
+	uxOrder[ uxServed ] = uxIndex;
+	uxServed++;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckWaiters( void )
+{
+/* The waiters are created in this order, the second one first in priority
+and in deadline. */
+static const UBaseType_t uxPriorities[ benchWAITERS ] = { 1, 3, 2 };
+static const TickType_t xPeriods[ benchWAITERS ] = { 30, 10, 20 };
+void * pvBlocks[ benchBLOCKS ];
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < benchBLOCKS; uxIndex++ )
+	{
+		pvBlocks[ uxIndex ] = pvMemPoolAlloc( xPool, 0 );
+		configASSERT( pvBlocks[ uxIndex ] );
+	}
+
+	uxServed = 0;
+
+	for( uxIndex = 0; uxIndex < benchWAITERS; uxIndex++ )
+	{
+		benchCHECK( prvCreateTask( prvWaiterTask, "waiter", ( void * ) ( size_t ) uxIndex, uxPriorities[ uxIndex ], xPeriods[ uxIndex ] ) == pdPASS );
+	}
+
+	vTaskDelay( 5 );
+	benchCHECK( uxServed == 0 );
+
+	/* Each free wakes one waiter, which runs while this task is delayed. */
+	for( uxIndex = 0; uxIndex < benchWAITERS; uxIndex++ )
+	{
+		vMemPoolFree( xPool, pvBlocks[ uxIndex ] );
+		vTaskDelay( 5 );
+	}
+
+	benchCHECK( uxServed == benchWAITERS );
+	benchCHECK( ( uxOrder[ 0 ] == 1 ) && ( uxOrder[ 1 ] == 2 ) && ( uxOrder[ 2 ] == 0 ) );
+
+	for( uxIndex = 0; uxIndex < benchWAITERS; uxIndex++ )
+	{
+		vMemPoolFree( xPool, pvWaiterBlocks[ uxIndex ] );
+	}
+
+	vMemPoolFree( xPool, pvBlocks[ benchBLOCKS - 1 ] );
+	benchCHECK( uxMemPoolGetFreeBlocks( xPool ) == benchBLOCKS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYield( void )
+{
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+		/* A yield runs the task with the earliest deadline, so first move this
+		one behind the others.  That also keeps it later than the deadline the
+		control task gets each time it wakes. */
+		vTaskSetDeadline( NULL, xTaskGetTickCount() + benchSTRESS_PERIOD );
+	#endif
+
+	taskYIELD();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStressTask( void * pvParameters )
+{
+const uint32_t ulTag = ( uint32_t ) ( size_t ) pvParameters;
+uint32_t * pulBlock;
+
+	while( xStressDone == pdFALSE )
+	{
+		pulBlock = ( uint32_t * ) pvMemPoolAlloc( xPool, 0 );
+
+		if( pulBlock != NULL )
+		{
+			*pulBlock = ulTag;
+			ulAllocations++;
+		}
+
+		prvYield();
+
+		if( pulBlock != NULL )
+		{
+			if( *pulBlock != ulTag )
+			{
+				ulCorrupted++;
+			}
+
+			vMemPoolFree( xPool, pulBlock );
+		}
+	}
+
+	ulStressTasksDone++;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStress( void )
+{
+size_t x;
+
+	/* The tasks share a priority, or under EDF take turns at the earliest
+	deadline, so each yield lets the next one run. */
+	xStressDone = pdFALSE;
+
+	for( x = 0; x < benchSTRESS_TASKS; x++ )
+	{
+		benchCHECK( prvCreateTask( prvStressTask, "stress", ( void * ) x, benchHELPER_PRIORITY, benchSTRESS_PERIOD ) == pdPASS );
+	}
+
+	xTickStressing = pdTRUE;
+	vTaskDelay( benchSTRESS_TICKS );
+	xTickStressing = pdFALSE;
+	xStressDone = pdTRUE;
+	vTaskDelay( 2 );
+
+	if( pulTickBlock != NULL )
+	{
+		vMemPoolFree( xPool, pulTickBlock );
+		pulTickBlock = NULL;
+	}
+
+	printf( "  %lu allocations by %d tasks and the tick over %d ticks, %lu blocks handed out while in use\n",
+			ulAllocations, benchSTRESS_TASKS, benchSTRESS_TICKS, ulCorrupted );
+	benchCHECK( ulStressTasksDone == benchSTRESS_TASKS );
+	benchCHECK( ulAllocations > benchSTRESS_TICKS );
+	benchCHECK( ulCorrupted == 0 );
+	benchCHECK( uxMemPoolGetFreeBlocks( xPool ) == benchSTRESS_BLOCKS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+size_t xFreeBefore;
+
+	( void ) pvParameters;
+
+	printf( "fixed-size block memory pools (%s)\n", ( configUSE_EDF_SCHEDULER == 1 ) ? "EDF" : "fixed priorities" );
+
+	xFreeBefore = xPortGetFreeHeapSize();
+	xPool = xMemPoolCreate( benchBLOCK_SIZE, benchBLOCKS );
+	configASSERT( xPool );
+	benchCHECK( ( xFreeBefore - xPortGetFreeHeapSize() ) >= mempoolSTORAGE_SIZE( benchBLOCK_SIZE, benchBLOCKS ) );
+
+	prvCheckLimits();
+	prvCheckFreeFromISR();
+	prvCheckWaiters();
+	vMemPoolDelete( xPool );
+
+	xPool = xMemPoolCreate( benchBLOCK_SIZE, benchSTRESS_BLOCKS );
+	configASSERT( xPool );
+	prvCheckStress();
+	vMemPoolDelete( xPool );
+
+	/* Give the idle task the chance to free the helper tasks. */
+	vTaskDelay( 2 );
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvCreateTask( prvControlTask, "control", NULL, benchCONTROL_PRIORITY, benchCONTROL_PERIOD );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,261 @@
+/*
+ * Check of the multi-producer single consumer queues (build/bench/mpscqueue).
+ *
+ * Checks that:
+ *
+ *   - a queue holds the number of items it was created for, and a send to a
+ *     full queue fails at once with no block time and after its block time
+ *     with one, as does a receive from an empty queue;
+ *   - a consumer blocked on the queue is woken by a send;
+ *   - items sent by three tasks of different priorities, which block while
+ *     the queue is full, and by the tick interrupt all arrive, in order for
+ *     each producer.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mpsc_queue.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchLENGTH				( 8 )
+#define benchPRODUCERS			( 3 )
+#define benchPER_PRODUCER		( 20000UL )
+
+/* The tick interrupt is the producer after the tasks. */
+#define benchTICK_PRODUCER		( benchPRODUCERS )
+#define benchITEM( ulProducer, ulSequence )		( ( ( uint32_t ) ( ulProducer ) << 24 ) | ( uint32_t ) ( ulSequence ) )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchHELPER_PRIORITY	( 3 )
+
+/*-----------------------------------------------------------*/
+
+static MpscQueueHandle_t xQueue;
+static volatile uint32_t ulHelperItem;
+static volatile BaseType_t xHelperDone;
+static volatile unsigned long ulSendFailed;
+
+/* The tick hook sends while xTickSending is pdTRUE. */
+static volatile BaseType_t xTickSending;
+static volatile uint32_t ulTickSent, ulTickDropped;
+
+static const UBaseType_t uxProducerPriorities[ benchPRODUCERS ] = { 1, 2, 3 };
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvReceiveTask( void * pvParameters );
+static void prvProducerTask( void * pvParameters );
+static void prvCheckLimits( void );
+static void prvCheckProducers( void );
+void vApplicationTickHook( void );
+
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+uint32_t ulItem;
+
+	if( xTickSending != pdFALSE )
+	{
+		ulItem = benchITEM( benchTICK_PRODUCER, ulTickSent );
+
+		if( xMpscQueueSendFromISR( xQueue, &ulItem, NULL ) == pdPASS )
+		{
+			ulTickSent++;
+		}
+		else
+		{
+			ulTickDropped++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveTask( void * pvParameters )
+{
+uint32_t ulItem = 0;
+
+	( void ) pvParameters;
+
+	( void ) xMpscQueueReceive( xQueue, &ulItem, portMAX_DELAY );
+	ulHelperItem = ulItem;
+	xHelperDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckLimits( void )
+{
+uint32_t ulItem;
+UBaseType_t uxIndex;
+TickType_t xStart;
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		ulItem = ( uint32_t ) uxIndex;
+		benchCHECK( xMpscQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	}
+
+	benchCHECK( uxMpscQueueMessagesWaiting( xQueue ) == benchLENGTH );
+	benchCHECK( xMpscQueueSend( xQueue, &ulItem, 0 ) == errQUEUE_FULL );
+	benchCHECK( xMpscQueueSendFromISR( xQueue, &ulItem, NULL ) == errQUEUE_FULL );
+	xStart = xTaskGetTickCount();
+	benchCHECK( xMpscQueueSend( xQueue, &ulItem, 10 ) == errQUEUE_FULL );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		benchCHECK( xMpscQueueReceive( xQueue, &ulItem, 0 ) == pdPASS );
+		benchCHECK( ulItem == ( uint32_t ) uxIndex );
+	}
+
+	benchCHECK( xMpscQueueReceive( xQueue, &ulItem, 0 ) == pdFAIL );
+	xStart = xTaskGetTickCount();
+	benchCHECK( xMpscQueueReceive( xQueue, &ulItem, 10 ) == pdFAIL );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+
+	/* The consumer runs above this task, so it blocks as soon as it is
+	created and runs again as soon as it is woken. */
+	xHelperDone = pdFALSE;
+	xTaskCreate( prvReceiveTask, "receive", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+	benchCHECK( xHelperDone == pdFALSE );
+	ulItem = 42;
+	benchCHECK( xMpscQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	benchCHECK( xHelperDone == pdTRUE );
+	benchCHECK( ulHelperItem == 42 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+const uint32_t ulProducer = ( uint32_t ) ( size_t ) pvParameters;
+uint32_t ulSequence, ulItem;
+
+	for( ulSequence = 0; ulSequence < benchPER_PRODUCER; ulSequence++ )
+	{
+		ulItem = benchITEM( ulProducer, ulSequence );
+
+		if( xMpscQueueSend( xQueue, &ulItem, portMAX_DELAY ) != pdPASS )
+		{
+			ulSendFailed++;
+		}
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckProducers( void )
+{
+uint32_t ulNext[ benchPRODUCERS + 1 ] = { 0 };
+uint32_t ulItem, ulProducer;
+unsigned long ulReceived = 0, ulWrong = 0, ulTaskItems = 0;
+size_t x;
+
+	xTickSending = pdTRUE;
+
+	for( x = 0; x < benchPRODUCERS; x++ )
+	{
+		xTaskCreate( prvProducerTask, "producer", configMINIMAL_STACK_SIZE, ( void * ) x, uxProducerPriorities[ x ], NULL );
+	}
+
+	/* Until every task item is in, then what the tick sent after. */
+	while( ulTaskItems < ( benchPRODUCERS * benchPER_PRODUCER ) )
+	{
+		if( xMpscQueueReceive( xQueue, &ulItem, 100 ) != pdPASS )
+		{
+			break;
+		}
+
+		ulProducer = ulItem >> 24;
+
+		if( ( ulProducer > benchTICK_PRODUCER ) || ( ( ulItem & 0xffffffUL ) != ulNext[ ulProducer ] ) )
+		{
+			ulWrong++;
+		}
+		else
+		{
+			ulNext[ ulProducer ]++;
+		}
+
+		if( ulProducer < benchTICK_PRODUCER )
+		{
+			ulTaskItems++;
+		}
+
+		ulReceived++;
+	}
+
+	xTickSending = pdFALSE;
+	vTaskDelay( 2 );
+
+	while( xMpscQueueReceive( xQueue, &ulItem, 0 ) == pdPASS )
+	{
+		if( ( ( ulItem >> 24 ) != benchTICK_PRODUCER ) || ( ( ulItem & 0xffffffUL ) != ulNext[ benchTICK_PRODUCER ] ) )
+		{
+			ulWrong++;
+		}
+		else
+		{
+			ulNext[ benchTICK_PRODUCER ]++;
+		}
+
+		ulReceived++;
+	}
+
+	printf( "  %lu items from %d tasks and %lu from the tick (%lu dropped on a full queue), %lu out of order, %lu task sends failed\n",
+			ulTaskItems, benchPRODUCERS, ( unsigned long ) ulNext[ benchTICK_PRODUCER ], ( unsigned long ) ulTickDropped, ulWrong, ulSendFailed );
+
+	for( x = 0; x < benchPRODUCERS; x++ )
+	{
+		benchCHECK( ulNext[ x ] == benchPER_PRODUCER );
+	}
+
+	benchCHECK( ulNext[ benchTICK_PRODUCER ] == ulTickSent );
+	benchCHECK( ulReceived == ( ( benchPRODUCERS * benchPER_PRODUCER ) + ulTickSent ) );
+	benchCHECK( ulWrong == 0 );
+	benchCHECK( ulSendFailed == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+size_t xFreeBefore;
+
+	( void ) pvParameters;
+
+	printf( "multi-producer single consumer queues\n" );
+
+	xFreeBefore = xPortGetFreeHeapSize();
+	xQueue = xMpscQueueCreate( benchLENGTH, sizeof( uint32_t ) );
+	configASSERT( xQueue );
+
+	prvCheckLimits();
+	prvCheckProducers();
+
+	/* Give the idle task the chance to free the helper tasks. */
+	vTaskDelay( 2 );
+	vMpscQueueDelete( xQueue );
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,322 @@
+/*
+ * Check of the batched queue send and receive (build/bench/queuebatch).
+ *
+ * Checks that:
+ *
+ *   - a batch larger than the free space sends what fits and returns that
+ *     count, and one sent to a full queue returns 0 at once with no block time
+ *     and after its block time with one;
+ *   - items keep their order across the wrap of the queue storage, mixed with
+ *     single item sends and receives, from tasks and from the ISR versions;
+ *   - a receive returns what is waiting when that is less than asked for, and
+ *     0 from an empty queue;
+ *   - a blocked batch receive returns as soon as one item is sent, and a
+ *     blocked batch send as soon as there is room, with as much as fits;
+ *   - a batch wakes as many of the tasks waiting to receive as it has items.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchLENGTH				( 5 )
+#define benchBATCH				( 8 )
+#define benchROUNDS				( 200 )
+#define benchRECEIVERS			( 2 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchHELPER_PRIORITY	( 3 )
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xQueue;
+static volatile UBaseType_t uxHelperCount;
+static volatile uint32_t ulHelperItems[ benchBATCH ];
+static volatile unsigned long ulHelpersDone;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvBatchReceiveTask( void * pvParameters );
+static void prvBatchSendTask( void * pvParameters );
+static void prvReceiveTask( void * pvParameters );
+static void prvCheckPartial( void );
+static void prvCheckOrder( void );
+static void prvCheckBlocking( void );
+static void prvCheckWakeAll( void );
+static void prvEmpty( void );
+
+/*-----------------------------------------------------------*/
+
+static void prvEmpty( void )
+{
+uint32_t ulItem;
+
+	while( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckPartial( void )
+{
+uint32_t ulItems[ benchBATCH ], ulReceived[ benchBATCH ];
+UBaseType_t uxIndex;
+TickType_t xStart;
+
+	for( uxIndex = 0; uxIndex < benchBATCH; uxIndex++ )
+	{
+		ulItems[ uxIndex ] = ( uint32_t ) uxIndex + 100U;
+	}
+
+	benchCHECK( uxQueueSendMultiple( xQueue, ulItems, 2, 0 ) == 2 );
+	benchCHECK( uxQueueSendMultiple( xQueue, &( ulItems[ 2 ] ), benchBATCH - 2, 0 ) == ( benchLENGTH - 2 ) );
+	benchCHECK( uxQueueMessagesWaiting( xQueue ) == benchLENGTH );
+	benchCHECK( uxQueueSendMultiple( xQueue, ulItems, benchBATCH, 0 ) == 0 );
+	xStart = xTaskGetTickCount();
+	benchCHECK( uxQueueSendMultiple( xQueue, ulItems, benchBATCH, 10 ) == 0 );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+
+	/* Less waiting than asked for. */
+	benchCHECK( uxQueueReceiveMultiple( xQueue, ulReceived, benchBATCH, 0 ) == benchLENGTH );
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		benchCHECK( ulReceived[ uxIndex ] == ulItems[ uxIndex ] );
+	}
+
+	benchCHECK( uxQueueReceiveMultiple( xQueue, ulReceived, benchBATCH, 0 ) == 0 );
+	xStart = xTaskGetTickCount();
+	benchCHECK( uxQueueReceiveMultiple( xQueue, ulReceived, benchBATCH, 10 ) == 0 );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+	benchCHECK( uxQueueSendMultiple( xQueue, ulItems, 0, 0 ) == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOrder( void )
+{
+uint32_t ulItems[ benchBATCH ], ulReceived[ benchBATCH ];
+uint32_t ulNextSent = 0, ulNextReceived = 0;
+UBaseType_t uxIndex, uxCount, uxRound, uxMoved;
+unsigned long ulWrong = 0;
+BaseType_t xWoken = pdFALSE;
+
+	/* Batches and single items of varying counts, so the read and write
+	positions move round the storage and the batches split at its end in
+	every place. */
+	for( uxRound = 0; uxRound < benchROUNDS; uxRound++ )
+	{
+		uxCount = ( uxRound % benchBATCH ) + 1;
+
+		for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+		{
+			ulItems[ uxIndex ] = ulNextSent + ( uint32_t ) uxIndex;
+		}
+
+		switch( uxRound % 3 )
+		{
+			case 0:
+				uxMoved = uxQueueSendMultiple( xQueue, ulItems, uxCount, 0 );
+				break;
+
+			case 1:
+				uxMoved = uxQueueSendMultipleFromISR( xQueue, ulItems, uxCount, &xWoken );
+				break;
+
+			default:
+				for( uxMoved = 0; uxMoved < uxCount; uxMoved++ )
+				{
+					if( xQueueSend( xQueue, &( ulItems[ uxMoved ] ), 0 ) != pdPASS )
+					{
+						break;
+					}
+				}
+
+				break;
+		}
+
+		ulNextSent += ( uint32_t ) uxMoved;
+
+		uxCount = ( ( uxRound * 5 ) % benchBATCH ) + 1;
+
+		if( ( uxRound % 2 ) == 0 )
+		{
+			uxMoved = uxQueueReceiveMultiple( xQueue, ulReceived, uxCount, 0 );
+		}
+		else
+		{
+			uxMoved = uxQueueReceiveMultipleFromISR( xQueue, ulReceived, uxCount, &xWoken );
+		}
+
+		for( uxIndex = 0; uxIndex < uxMoved; uxIndex++ )
+		{
+			if( ulReceived[ uxIndex ] != ulNextReceived++ )
+			{
+				ulWrong++;
+			}
+		}
+
+		/* A single receive now and then. */
+		if( ( ( uxRound % 7 ) == 0 ) && ( xQueueReceive( xQueue, &( ulReceived[ 0 ] ), 0 ) == pdPASS ) )
+		{
+			if( ulReceived[ 0 ] != ulNextReceived++ )
+			{
+				ulWrong++;
+			}
+		}
+
+		if( uxQueueMessagesWaiting( xQueue ) != ( UBaseType_t ) ( ulNextSent - ulNextReceived ) )
+		{
+			ulWrong++;
+		}
+	}
+
+	printf( "  %lu items sent and %lu received in mixed batches, %lu out of order\n", ( unsigned long ) ulNextSent,
+			( unsigned long ) ulNextReceived, ulWrong );
+	benchCHECK( ulWrong == 0 );
+	benchCHECK( ulNextSent > ( benchROUNDS * 2 ) );
+	benchCHECK( xWoken == pdFALSE );
+	prvEmpty();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchReceiveTask( void * pvParameters )
+{
+uint32_t ulReceived[ benchBATCH ];
+UBaseType_t uxIndex;
+
+	( void ) pvParameters;
+
+	uxHelperCount = uxQueueReceiveMultiple( xQueue, ulReceived, benchBATCH, portMAX_DELAY );
+
+	for( uxIndex = 0; uxIndex < uxHelperCount; uxIndex++ )
+	{
+		ulHelperItems[ uxIndex ] = ulReceived[ uxIndex ];
+	}
+
+	ulHelpersDone++;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchSendTask( void * pvParameters )
+{
+uint32_t ulItems[ benchBATCH ];
+UBaseType_t uxIndex;
+
+	( void ) pvParameters;
+
+	for( uxIndex = 0; uxIndex < benchBATCH; uxIndex++ )
+	{
+		ulItems[ uxIndex ] = ( uint32_t ) uxIndex + 200U;
+	}
+
+	uxHelperCount = uxQueueSendMultiple( xQueue, ulItems, benchBATCH, portMAX_DELAY );
+	ulHelpersDone++;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveTask( void * pvParameters )
+{
+uint32_t ulItem;
+
+	( void ) pvParameters;
+
+	if( xQueueReceive( xQueue, &ulItem, 50 ) == pdPASS )
+	{
+		ulHelpersDone++;
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBlocking( void )
+{
+uint32_t ulItems[ benchLENGTH ], ulItem;
+UBaseType_t uxIndex;
+
+	/* The helpers run above this task, so they block as soon as they are
+	created and run again as soon as they are woken. */
+	ulHelpersDone = 0;
+	xTaskCreate( prvBatchReceiveTask, "receive", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+	benchCHECK( ulHelpersDone == 0 );
+	ulItem = 7;
+	benchCHECK( xQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	benchCHECK( ulHelpersDone == 1 );
+	benchCHECK( uxHelperCount == 1 );
+	benchCHECK( ulHelperItems[ 0 ] == 7 );
+
+	/* Full but for nothing, then room for two. */
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		ulItems[ uxIndex ] = ( uint32_t ) uxIndex;
+	}
+
+	benchCHECK( uxQueueSendMultiple( xQueue, ulItems, benchLENGTH, 0 ) == benchLENGTH );
+	ulHelpersDone = 0;
+	xTaskCreate( prvBatchSendTask, "send", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+	benchCHECK( ulHelpersDone == 0 );
+	benchCHECK( uxQueueReceiveMultiple( xQueue, ulItems, 2, 0 ) == 2 );
+	benchCHECK( ulHelpersDone == 1 );
+	benchCHECK( uxHelperCount == 2 );
+	benchCHECK( uxQueueReceiveMultiple( xQueue, ulItems, benchLENGTH, 0 ) == benchLENGTH );
+	benchCHECK( ( ulItems[ 0 ] == 2 ) && ( ulItems[ 2 ] == 4 ) && ( ulItems[ 3 ] == 200 ) && ( ulItems[ 4 ] == 201 ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckWakeAll( void )
+{
+uint32_t ulItems[ benchRECEIVERS ] = { 1, 2 };
+UBaseType_t uxIndex;
+
+	ulHelpersDone = 0;
+
+	for( uxIndex = 0; uxIndex < benchRECEIVERS; uxIndex++ )
+	{
+		xTaskCreate( prvReceiveTask, "receive", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+	}
+
+	benchCHECK( uxQueueSendMultiple( xQueue, ulItems, benchRECEIVERS, 0 ) == benchRECEIVERS );
+	printf( "  a batch of %d woke %lu of %d waiting receivers\n", benchRECEIVERS, ulHelpersDone, benchRECEIVERS );
+	benchCHECK( ulHelpersDone == benchRECEIVERS );
+	benchCHECK( uxQueueMessagesWaiting( xQueue ) == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	printf( "batched queue send and receive\n" );
+
+	xQueue = xQueueCreate( benchLENGTH, sizeof( uint32_t ) );
+	configASSERT( xQueue );
+
+	prvCheckPartial();
+	prvCheckOrder();
+	prvCheckBlocking();
+	prvCheckWakeAll();
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
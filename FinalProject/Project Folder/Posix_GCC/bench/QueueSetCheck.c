@@ -0,0 +1,224 @@
+/*
+ * Check of the queue sets (build/bench/queueset).
+ *
+ * Checks that:
+ *
+ *   - xQueueCreateSet() still takes the total length of the members, and a
+ *     length above the number of bits of a UBaseType_t makes a set of that
+ *     many members rather than failing;
+ *   - xQueueCreateSetBitmap() holds the number of members it was made for,
+ *     and xQueueAddToSet() then fails;
+ *   - members that stay ready are selected in turn, so one that is read an
+ *     item at a time does not hide the others, and an emptied member is not
+ *     selected again;
+ *   - a member read without being selected, or removed from the set, is not
+ *     selected;
+ *   - a task blocked on a set is woken by a send to a member, and times out
+ *     when there is none.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchMEMBERS			( 3 )
+#define benchMEMBER_LENGTH		( 3 )
+#define benchBITS				( sizeof( UBaseType_t ) * 8U )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchSELECT_PRIORITY	( 3 )
+
+/*-----------------------------------------------------------*/
+
+static QueueSetHandle_t xSet;
+static QueueHandle_t xMembers[ benchMEMBERS ];
+static SemaphoreHandle_t xSemaphores[ benchBITS + 1 ];
+static volatile QueueSetMemberHandle_t xSelected;
+static volatile BaseType_t xSelectDone;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvSelectTask( void * pvParameters );
+static void prvCheckSizes( void );
+static void prvCheckOrder( void );
+static void prvCheckBlocking( void );
+
+/*-----------------------------------------------------------*/
+
+static void prvCheckSizes( void )
+{
+QueueSetHandle_t xLarge, xSmall;
+UBaseType_t uxIndex;
+unsigned long ulAdded = 0;
+
+	/* The old usage, the total length of the members. */
+	xLarge = xQueueCreateSet( 100 );
+	benchCHECK( xLarge != NULL );
+
+	for( uxIndex = 0; uxIndex <= benchBITS; uxIndex++ )
+	{
+		xSemaphores[ uxIndex ] = xSemaphoreCreateBinary();
+		configASSERT( xSemaphores[ uxIndex ] );
+
+		if( xQueueAddToSet( xSemaphores[ uxIndex ], xLarge ) == pdPASS )
+		{
+			ulAdded++;
+		}
+	}
+
+	printf( "  xQueueCreateSet( 100 ) took %lu members of %lu\n", ulAdded, ( unsigned long ) benchBITS + 1 );
+	benchCHECK( ulAdded == benchBITS );
+
+	xSmall = xQueueCreateSetBitmap( 4 );
+	benchCHECK( xSmall != NULL );
+
+	for( uxIndex = 0; uxIndex <= benchBITS; uxIndex++ )
+	{
+		( void ) xQueueRemoveFromSet( xSemaphores[ uxIndex ], xLarge );
+	}
+
+	for( ulAdded = 0, uxIndex = 0; uxIndex < 5; uxIndex++ )
+	{
+		if( xQueueAddToSet( xSemaphores[ uxIndex ], xSmall ) == pdPASS )
+		{
+			ulAdded++;
+		}
+	}
+
+	printf( "  xQueueCreateSetBitmap( 4 ) took %lu members of 5\n", ulAdded );
+	benchCHECK( ulAdded == 4 );
+
+	/* A member of one set cannot join another. */
+	benchCHECK( xQueueAddToSet( xSemaphores[ 0 ], xLarge ) == pdFAIL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOrder( void )
+{
+UBaseType_t uxIndex, uxItem, uxMember;
+QueueSetMemberHandle_t xMember;
+uint32_t ulItem;
+char cOrder[ ( benchMEMBERS * benchMEMBER_LENGTH ) + 1 ];
+unsigned long ulSelected = 0;
+
+	/* The old usage again, three members of three items. */
+	xSet = xQueueCreateSet( benchMEMBERS * benchMEMBER_LENGTH );
+	configASSERT( xSet );
+
+	for( uxIndex = 0; uxIndex < benchMEMBERS; uxIndex++ )
+	{
+		xMembers[ uxIndex ] = xQueueCreate( benchMEMBER_LENGTH, sizeof( uint32_t ) );
+		configASSERT( xMembers[ uxIndex ] );
+		benchCHECK( xQueueAddToSet( xMembers[ uxIndex ], xSet ) == pdPASS );
+
+		for( uxItem = 0; uxItem < benchMEMBER_LENGTH; uxItem++ )
+		{
+			ulItem = ( uint32_t ) uxIndex;
+			( void ) xQueueSend( xMembers[ uxIndex ], &ulItem, 0 );
+		}
+	}
+
+	/* Each selected member gives up one item. */
+	while( ( xMember = xQueueSelectFromSet( xSet, 0 ) ) != NULL )
+	{
+		benchCHECK( xQueueReceive( ( QueueHandle_t ) xMember, &ulItem, 0 ) == pdPASS );
+		benchCHECK( ulSelected < ( benchMEMBERS * benchMEMBER_LENGTH ) );
+
+		if( ulSelected < ( benchMEMBERS * benchMEMBER_LENGTH ) )
+		{
+			cOrder[ ulSelected++ ] = ( char ) ( 'A' + ulItem );
+		}
+	}
+
+	cOrder[ ulSelected ] = '\0';
+	printf( "  members selected in the order %s\n", cOrder );
+
+	/* Each member in turn, none twice in a row. */
+	benchCHECK( ulSelected == ( benchMEMBERS * benchMEMBER_LENGTH ) );
+
+	for( uxIndex = 0; uxIndex < ulSelected; uxIndex++ )
+	{
+		uxMember = ( UBaseType_t ) ( cOrder[ uxIndex ] - 'A' );
+		benchCHECK( uxMember == ( benchMEMBERS - 1 - ( uxIndex % benchMEMBERS ) ) );
+	}
+
+	/* A member emptied without being selected, and one removed. */
+	ulItem = 0;
+	( void ) xQueueSend( xMembers[ 0 ], &ulItem, 0 );
+	( void ) xQueueSend( xMembers[ 1 ], &ulItem, 0 );
+	( void ) xQueueReceive( xMembers[ 0 ], &ulItem, 0 );
+	benchCHECK( xQueueRemoveFromSet( xMembers[ 1 ], xSet ) == pdPASS );
+	benchCHECK( xQueueSelectFromSet( xSet, 0 ) == NULL );
+	benchCHECK( xQueueRemoveFromSet( xMembers[ 1 ], xSet ) == pdFAIL );
+
+	/* Added back while it holds an item, it is ready straight away. */
+	benchCHECK( xQueueAddToSet( xMembers[ 1 ], xSet ) == pdPASS );
+	benchCHECK( xQueueSelectFromSet( xSet, 0 ) == xMembers[ 1 ] );
+	( void ) xQueueReceive( xMembers[ 1 ], &ulItem, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSelectTask( void * pvParameters )
+{
+TickType_t xWait = ( TickType_t ) ( size_t ) pvParameters;
+
+	xSelected = xQueueSelectFromSet( xSet, xWait );
+	xSelectDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBlocking( void )
+{
+uint32_t ulItem = 0;
+
+	/* The select task runs above this one, so it blocks as soon as it is
+	created. */
+	xSelectDone = pdFALSE;
+	xTaskCreate( prvSelectTask, "select", configMINIMAL_STACK_SIZE, ( void * ) ( size_t ) portMAX_DELAY, benchSELECT_PRIORITY, NULL );
+	benchCHECK( xSelectDone == pdFALSE );
+	( void ) xQueueSend( xMembers[ 2 ], &ulItem, 0 );
+	benchCHECK( xSelectDone == pdTRUE );
+	benchCHECK( xSelected == xMembers[ 2 ] );
+	( void ) xQueueReceive( xMembers[ 2 ], &ulItem, 0 );
+
+	xSelectDone = pdFALSE;
+	xTaskCreate( prvSelectTask, "select", configMINIMAL_STACK_SIZE, ( void * ) ( size_t ) 20, benchSELECT_PRIORITY, NULL );
+	vTaskDelay( 40 );
+	benchCHECK( xSelectDone == pdTRUE );
+	benchCHECK( xSelected == NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	printf( "queue sets\n" );
+
+	prvCheckSizes();
+	prvCheckOrder();
+	prvCheckBlocking();
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
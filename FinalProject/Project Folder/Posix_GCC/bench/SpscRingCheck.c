@@ -0,0 +1,296 @@
+/*
+ * Check of the single producer single consumer rings (build/bench/spscring).
+ *
+ * Checks that:
+ *
+ *   - a ring holds the number of items it was created for, and a send to a
+ *     full ring fails and drops the item;
+ *   - a receive returns what is waiting, up to the most asked for, oldest
+ *     first and in order across the wrap of the storage;
+ *   - a receive from an empty ring returns 0 at once with no block time and
+ *     after its block time with one;
+ *   - a consumer blocked on the ring is woken by a send from a task;
+ *   - a stream sent from the tick interrupt, the producer the ring is made
+ *     for, arrives whole and in order at a consumer that blocks between
+ *     items.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_ring.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchLENGTH				( 5 )
+#define benchMAX_ITEMS			( 8 )
+#define benchROUNDS				( 200 )
+#define benchPER_TICK			( 3 )
+#define benchSTREAM_TICKS		( 200 )
+#define benchSTREAM_LENGTH		( 16 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchCONSUMER_PRIORITY	( 3 )
+
+/*-----------------------------------------------------------*/
+
+static SpscRingHandle_t xRing;
+static volatile UBaseType_t uxConsumerCount;
+static volatile uint32_t ulConsumerItem;
+static volatile BaseType_t xConsumerDone;
+
+/* The tick hook sends while xTickSending is pdTRUE. */
+static volatile BaseType_t xTickSending;
+static volatile uint32_t ulTickSent, ulTickDropped;
+static volatile unsigned long ulStreamReceived, ulStreamWrong;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvConsumerTask( void * pvParameters );
+static void prvStreamConsumerTask( void * pvParameters );
+static void prvCheckCapacity( void );
+static void prvCheckOrder( void );
+static void prvCheckBlocking( void );
+static void prvCheckStream( void );
+void vApplicationTickHook( void );
+
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+UBaseType_t uxItem;
+uint32_t ulItem;
+
+	if( xTickSending != pdFALSE )
+	{
+		for( uxItem = 0; uxItem < benchPER_TICK; uxItem++ )
+		{
+			ulItem = ulTickSent;
+
+			if( xSpscRingSendFromISR( xRing, &ulItem, &xHigherPriorityTaskWoken ) == pdPASS )
+			{
+				ulTickSent++;
+			}
+			else
+			{
+				ulTickDropped++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckCapacity( void )
+{
+uint32_t ulItem, ulItems[ benchMAX_ITEMS ];
+UBaseType_t uxIndex;
+TickType_t xStart;
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		ulItem = ( uint32_t ) uxIndex;
+		benchCHECK( xSpscRingSend( xRing, &ulItem ) == pdPASS );
+	}
+
+	ulItem = 99;
+	benchCHECK( xSpscRingSend( xRing, &ulItem ) == errQUEUE_FULL );
+	benchCHECK( xSpscRingSendFromISR( xRing, &ulItem, NULL ) == errQUEUE_FULL );
+	benchCHECK( uxSpscRingItemsWaiting( xRing ) == benchLENGTH );
+
+	benchCHECK( uxSpscRingReceive( xRing, ulItems, benchMAX_ITEMS, 0 ) == benchLENGTH );
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		benchCHECK( ulItems[ uxIndex ] == ( uint32_t ) uxIndex );
+	}
+
+	benchCHECK( uxSpscRingItemsWaiting( xRing ) == 0 );
+	benchCHECK( uxSpscRingReceive( xRing, ulItems, benchMAX_ITEMS, 0 ) == 0 );
+	xStart = xTaskGetTickCount();
+	benchCHECK( uxSpscRingReceive( xRing, ulItems, benchMAX_ITEMS, 10 ) == 0 );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOrder( void )
+{
+uint32_t ulItems[ benchMAX_ITEMS ];
+uint32_t ulNextSent = 0, ulNextReceived = 0;
+UBaseType_t uxIndex, uxCount, uxRound, uxReceived;
+unsigned long ulWrong = 0;
+
+	/* Sends and receives of varying counts, so the indexes move round the
+	storage and a receive splits at its end in every place. */
+	for( uxRound = 0; uxRound < benchROUNDS; uxRound++ )
+	{
+		uxCount = ( uxRound % benchLENGTH ) + 1;
+
+		for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+		{
+			if( xSpscRingSendFromISR( xRing, &ulNextSent, NULL ) == pdPASS )
+			{
+				ulNextSent++;
+			}
+		}
+
+		uxCount = ( ( uxRound * 3 ) % benchMAX_ITEMS ) + 1;
+		uxReceived = uxSpscRingReceive( xRing, ulItems, uxCount, 0 );
+
+		if( uxReceived > uxCount )
+		{
+			ulWrong++;
+			uxReceived = uxCount;
+		}
+
+		for( uxIndex = 0; uxIndex < uxReceived; uxIndex++ )
+		{
+			if( ulItems[ uxIndex ] != ulNextReceived++ )
+			{
+				ulWrong++;
+			}
+		}
+
+		if( uxSpscRingItemsWaiting( xRing ) != ( UBaseType_t ) ( ulNextSent - ulNextReceived ) )
+		{
+			ulWrong++;
+		}
+	}
+
+	printf( "  %lu items sent and %lu received round the storage, %lu out of order\n", ( unsigned long ) ulNextSent,
+			( unsigned long ) ulNextReceived, ulWrong );
+	benchCHECK( ulWrong == 0 );
+	benchCHECK( ulNextSent > benchROUNDS );
+
+	( void ) uxSpscRingReceive( xRing, ulItems, benchMAX_ITEMS, 0 );
+	benchCHECK( uxSpscRingItemsWaiting( xRing ) == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+uint32_t ulItems[ benchMAX_ITEMS ];
+
+	( void ) pvParameters;
+
+	uxConsumerCount = uxSpscRingReceive( xRing, ulItems, benchMAX_ITEMS, portMAX_DELAY );
+	ulConsumerItem = ulItems[ 0 ];
+	xConsumerDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBlocking( void )
+{
+uint32_t ulItem = 42;
+
+	/* The consumer runs above this task, so it blocks as soon as it is
+	created and runs again as soon as it is woken. */
+	xConsumerDone = pdFALSE;
+	xTaskCreate( prvConsumerTask, "consumer", configMINIMAL_STACK_SIZE, NULL, benchCONSUMER_PRIORITY, NULL );
+	benchCHECK( xConsumerDone == pdFALSE );
+	benchCHECK( xSpscRingSend( xRing, &ulItem ) == pdPASS );
+	benchCHECK( xConsumerDone == pdTRUE );
+	benchCHECK( uxConsumerCount == 1 );
+	benchCHECK( ulConsumerItem == 42 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamConsumerTask( void * pvParameters )
+{
+uint32_t ulItems[ benchMAX_ITEMS ];
+uint32_t ulNext = 0;
+UBaseType_t uxReceived, uxIndex;
+
+	( void ) pvParameters;
+
+	for( ; ; )
+	{
+		uxReceived = uxSpscRingReceive( xRing, ulItems, benchMAX_ITEMS, 20 );
+
+		if( uxReceived == 0 )
+		{
+			break;
+		}
+
+		for( uxIndex = 0; uxIndex < uxReceived; uxIndex++ )
+		{
+			if( ulItems[ uxIndex ] != ulNext++ )
+			{
+				ulStreamWrong++;
+			}
+		}
+
+		ulStreamReceived += uxReceived;
+	}
+
+	xConsumerDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStream( void )
+{
+	xConsumerDone = pdFALSE;
+	xTaskCreate( prvStreamConsumerTask, "stream", configMINIMAL_STACK_SIZE, NULL, benchCONSUMER_PRIORITY, NULL );
+
+	xTickSending = pdTRUE;
+	vTaskDelay( benchSTREAM_TICKS );
+	xTickSending = pdFALSE;
+
+	/* The consumer gives up once the ring stays empty. */
+	vTaskDelay( 40 );
+
+	printf( "  %lu items sent from the tick, %lu dropped, %lu received, %lu out of order\n", ( unsigned long ) ulTickSent,
+			( unsigned long ) ulTickDropped, ulStreamReceived, ulStreamWrong );
+	benchCHECK( xConsumerDone == pdTRUE );
+	benchCHECK( ulTickSent >= ( ( benchSTREAM_TICKS - 1 ) * benchPER_TICK ) );
+	benchCHECK( ulTickDropped == 0 );
+	benchCHECK( ulStreamReceived == ulTickSent );
+	benchCHECK( ulStreamWrong == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+size_t xFreeBefore;
+
+	( void ) pvParameters;
+
+	printf( "single producer single consumer rings\n" );
+
+	xFreeBefore = xPortGetFreeHeapSize();
+	xRing = xSpscRingCreate( benchLENGTH, sizeof( uint32_t ) );
+	configASSERT( xRing );
+
+	prvCheckCapacity();
+	prvCheckOrder();
+	prvCheckBlocking();
+
+	vTaskDelay( 2 );
+	vSpscRingDelete( xRing );
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	xRing = xSpscRingCreate( benchSTREAM_LENGTH, sizeof( uint32_t ) );
+	configASSERT( xRing );
+	prvCheckStream();
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
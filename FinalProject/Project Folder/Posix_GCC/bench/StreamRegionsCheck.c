@@ -0,0 +1,434 @@
+/*
+ * Check of the in-place writes and reads of stream and message buffers
+ * (build/bench/streamregions).
+ *
+ * Checks that:
+ *
+ *   - a stream buffer reserves what space there is, up to the length asked
+ *     for, as two regions where the space wraps, and nothing is visible to
+ *     the reader until it is committed;
+ *   - bytes written in place, committed in part or abandoned, and mixed with
+ *     xStreamBufferSend() and xStreamBufferReceive(), are read back in order
+ *     by acquires that are released in part;
+ *   - a reader blocked in an acquire is woken by the commit that reaches the
+ *     trigger level and not before, and a writer blocked in a reserve by a
+ *     release;
+ *   - a message buffer reserves the whole message or nothing, and an acquire
+ *     describes the next message only.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchSIZE				( 16 )
+#define benchTRIGGER			( 4 )
+#define benchROUNDS				( 300 )
+#define benchMESSAGE_SIZE		( 40 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchHELPER_PRIORITY	( 3 )
+
+/*-----------------------------------------------------------*/
+
+static StreamBufferHandle_t xStream;
+static volatile size_t xHelperBytes;
+static volatile BaseType_t xHelperDone;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvAcquireTask( void * pvParameters );
+static void prvReserveTask( void * pvParameters );
+static void prvWriteRegions( const StreamBufferRegions_t * pxRegions, size_t xCount, uint8_t ucFirst );
+static BaseType_t prvRegionsHold( const StreamBufferRegions_t * pxRegions, size_t xCount, uint8_t ucFirst );
+static void prvCheckReserve( void );
+static void prvCheckOrder( void );
+static void prvCheckBlocking( void );
+static void prvCheckMessages( void );
+
+/*-----------------------------------------------------------*/
+
+static void prvWriteRegions( const StreamBufferRegions_t * pxRegions, size_t xCount, uint8_t ucFirst )
+{
+size_t xByte;
+
+	for( xByte = 0; xByte < xCount; xByte++ )
+	{
+		if( xByte < pxRegions->xFirstLengthBytes )
+		{
+			pxRegions->pucFirst[ xByte ] = ( uint8_t ) ( ucFirst + xByte );
+		}
+		else
+		{
+			pxRegions->pucSecond[ xByte - pxRegions->xFirstLengthBytes ] = ( uint8_t ) ( ucFirst + xByte );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRegionsHold( const StreamBufferRegions_t * pxRegions, size_t xCount, uint8_t ucFirst )
+{
+size_t xByte;
+uint8_t ucByte;
+BaseType_t xReturn = pdTRUE;
+
+	if( ( pxRegions->xFirstLengthBytes + pxRegions->xSecondLengthBytes ) != xCount )
+	{
+		xReturn = pdFALSE;
+	}
+	else if( ( pxRegions->xSecondLengthBytes != 0 ) && ( pxRegions->pucSecond == NULL ) )
+	{
+		xReturn = pdFALSE;
+	}
+	else
+	{
+		for( xByte = 0; xByte < xCount; xByte++ )
+		{
+			if( xByte < pxRegions->xFirstLengthBytes )
+			{
+				ucByte = pxRegions->pucFirst[ xByte ];
+			}
+			else
+			{
+				ucByte = pxRegions->pucSecond[ xByte - pxRegions->xFirstLengthBytes ];
+			}
+
+			if( ucByte != ( uint8_t ) ( ucFirst + xByte ) )
+			{
+				xReturn = pdFALSE;
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckReserve( void )
+{
+StreamBufferRegions_t xRegions, xRead;
+uint8_t ucBytes[ benchSIZE ];
+
+	/* Nothing is visible before the commit, and an abandoned write leaves
+	nothing behind. */
+	benchCHECK( xStreamBufferSendReserve( xStream, 6, &xRegions, 0 ) == 6 );
+	benchCHECK( xRegions.xFirstLengthBytes == 6 );
+	benchCHECK( xRegions.pucSecond == NULL );
+	prvWriteRegions( &xRegions, 6, 0 );
+	benchCHECK( xStreamBufferBytesAvailable( xStream ) == 0 );
+	benchCHECK( xStreamBufferReceiveAcquire( xStream, &xRead, 0 ) == 0 );
+	benchCHECK( xStreamBufferSendCommit( xStream, 0 ) == 0 );
+	benchCHECK( xStreamBufferBytesAvailable( xStream ) == 0 );
+
+	/* What space there is, then none. */
+	benchCHECK( xStreamBufferSend( xStream, ucBytes, benchSIZE - 5, 0 ) == ( benchSIZE - 5 ) );
+	benchCHECK( xStreamBufferSendReserve( xStream, 8, &xRegions, 0 ) == 5 );
+	prvWriteRegions( &xRegions, 5, 0 );
+	benchCHECK( xStreamBufferSendCommit( xStream, 5 ) == 5 );
+	benchCHECK( xStreamBufferSendReserve( xStream, 8, &xRegions, 0 ) == 0 );
+	benchCHECK( xStreamBufferSendReserveFromISR( xStream, 8, &xRegions ) == 0 );
+
+	/* Emptied, the next reserve starts where the last write stopped and
+	wraps. */
+	benchCHECK( xStreamBufferReceive( xStream, ucBytes, benchSIZE, 0 ) == benchSIZE );
+	benchCHECK( xStreamBufferSendReserve( xStream, benchSIZE, &xRegions, 0 ) == benchSIZE );
+	benchCHECK( xRegions.pucSecond != NULL );
+	benchCHECK( ( xRegions.xFirstLengthBytes + xRegions.xSecondLengthBytes ) == benchSIZE );
+	printf( "  a reserve of %d bytes after %d written came back as regions of %lu and %lu bytes\n", benchSIZE, benchSIZE,
+			( unsigned long ) xRegions.xFirstLengthBytes, ( unsigned long ) xRegions.xSecondLengthBytes );
+	prvWriteRegions( &xRegions, benchSIZE, 100 );
+	benchCHECK( xStreamBufferSendCommit( xStream, benchSIZE ) == benchSIZE );
+	benchCHECK( xStreamBufferReceiveAcquire( xStream, &xRead, 0 ) == benchSIZE );
+	benchCHECK( prvRegionsHold( &xRead, benchSIZE, 100 ) == pdTRUE );
+	benchCHECK( xStreamBufferReceiveRelease( xStream, benchSIZE ) == benchSIZE );
+	benchCHECK( xStreamBufferIsEmpty( xStream ) == pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOrder( void )
+{
+StreamBufferRegions_t xRegions;
+uint8_t ucBytes[ benchSIZE ];
+uint8_t ucNextWritten = 0, ucNextRead = 0;
+size_t xCount, xDone, xByte;
+unsigned long ulWrong = 0, ulWrapped = 0, ulRound;
+BaseType_t xWoken = pdFALSE;
+
+	/* Writes and reads of varying lengths, in place and copied, so the
+	regions split at the end of the storage in every place. */
+	for( ulRound = 0; ulRound < benchROUNDS; ulRound++ )
+	{
+		xCount = ( ulRound % 7 ) + 1;
+
+		if( ( ulRound % 4 ) == 3 )
+		{
+			for( xByte = 0; xByte < xCount; xByte++ )
+			{
+				ucBytes[ xByte ] = ( uint8_t ) ( ucNextWritten + xByte );
+			}
+
+			xDone = xStreamBufferSend( xStream, ucBytes, xCount, 0 );
+		}
+		else
+		{
+			if( ( ulRound % 2 ) == 0 )
+			{
+				xDone = xStreamBufferSendReserve( xStream, xCount, &xRegions, 0 );
+			}
+			else
+			{
+				xDone = xStreamBufferSendReserveFromISR( xStream, xCount, &xRegions );
+			}
+
+			if( xRegions.xSecondLengthBytes != 0 )
+			{
+				ulWrapped++;
+			}
+
+			prvWriteRegions( &xRegions, xDone, ucNextWritten );
+
+			/* Now and then commit less than was reserved. */
+			if( ( ( ulRound % 5 ) == 0 ) && ( xDone > 1 ) )
+			{
+				xDone--;
+			}
+
+			if( ( ulRound % 2 ) == 0 )
+			{
+				xDone = xStreamBufferSendCommit( xStream, xDone );
+			}
+			else
+			{
+				xDone = xStreamBufferSendCommitFromISR( xStream, xDone, &xWoken );
+			}
+		}
+
+		ucNextWritten = ( uint8_t ) ( ucNextWritten + xDone );
+
+		if( ( ulRound % 3 ) == 2 )
+		{
+			xDone = xStreamBufferReceive( xStream, ucBytes, ( ulRound % 5 ) + 1, 0 );
+
+			for( xByte = 0; xByte < xDone; xByte++ )
+			{
+				if( ucBytes[ xByte ] != ucNextRead++ )
+				{
+					ulWrong++;
+				}
+			}
+		}
+		else
+		{
+			if( ( ulRound % 2 ) == 0 )
+			{
+				xCount = xStreamBufferReceiveAcquire( xStream, &xRegions, 0 );
+			}
+			else
+			{
+				xCount = xStreamBufferReceiveAcquireFromISR( xStream, &xRegions );
+			}
+
+			if( prvRegionsHold( &xRegions, xCount, ucNextRead ) == pdFALSE )
+			{
+				ulWrong++;
+			}
+
+			/* Release part, the rest is read again next time. */
+			xCount = configMIN( xCount, ( size_t ) ( ulRound % 6 ) );
+
+			if( ( ulRound % 2 ) == 0 )
+			{
+				xDone = xStreamBufferReceiveRelease( xStream, xCount );
+			}
+			else
+			{
+				xDone = xStreamBufferReceiveReleaseFromISR( xStream, xCount, &xWoken );
+			}
+
+			ucNextRead = ( uint8_t ) ( ucNextRead + xDone );
+		}
+
+		if( xStreamBufferBytesAvailable( xStream ) != ( size_t ) ( uint8_t ) ( ucNextWritten - ucNextRead ) )
+		{
+			ulWrong++;
+		}
+	}
+
+	printf( "  %lu rounds of in-place and copied writes and reads, %lu reserves wrapped, %lu wrong\n", ulRound, ulWrapped, ulWrong );
+	benchCHECK( ulWrong == 0 );
+	benchCHECK( ulWrapped > 0 );
+	benchCHECK( xWoken == pdFALSE );
+	benchCHECK( xStreamBufferReset( xStream ) == pdPASS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAcquireTask( void * pvParameters )
+{
+StreamBufferRegions_t xRegions;
+
+	( void ) pvParameters;
+
+	xHelperBytes = xStreamBufferReceiveAcquire( xStream, &xRegions, portMAX_DELAY );
+	( void ) xStreamBufferReceiveRelease( xStream, xHelperBytes );
+	xHelperDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReserveTask( void * pvParameters )
+{
+StreamBufferRegions_t xRegions;
+
+	( void ) pvParameters;
+
+	xHelperBytes = xStreamBufferSendReserve( xStream, 8, &xRegions, portMAX_DELAY );
+	prvWriteRegions( &xRegions, xHelperBytes, 0 );
+	( void ) xStreamBufferSendCommit( xStream, xHelperBytes );
+	xHelperDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBlocking( void )
+{
+StreamBufferRegions_t xRegions;
+uint8_t ucBytes[ benchSIZE ] = { 0 };
+
+	/* The helpers run above this task, so they block as soon as they are
+	created and run again as soon as they are woken. */
+	xHelperDone = pdFALSE;
+	xTaskCreate( prvAcquireTask, "acquire", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+	benchCHECK( xHelperDone == pdFALSE );
+	benchCHECK( xStreamBufferSendReserve( xStream, 2, &xRegions, 0 ) == 2 );
+	benchCHECK( xStreamBufferSendCommit( xStream, 2 ) == 2 );
+	benchCHECK( xHelperDone == pdFALSE );
+	benchCHECK( xStreamBufferSendReserve( xStream, 2, &xRegions, 0 ) == 2 );
+	benchCHECK( xStreamBufferSendCommit( xStream, 2 ) == 2 );
+	benchCHECK( xHelperDone == pdTRUE );
+	benchCHECK( xHelperBytes == benchTRIGGER );
+	benchCHECK( xStreamBufferIsEmpty( xStream ) == pdTRUE );
+
+	/* A full buffer, then room for the whole reserve. */
+	benchCHECK( xStreamBufferSend( xStream, ucBytes, benchSIZE, 0 ) == benchSIZE );
+	xHelperDone = pdFALSE;
+	xTaskCreate( prvReserveTask, "reserve", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+	benchCHECK( xHelperDone == pdFALSE );
+	benchCHECK( xStreamBufferReceiveAcquire( xStream, &xRegions, 0 ) == benchSIZE );
+	benchCHECK( xStreamBufferReceiveRelease( xStream, 8 ) == 8 );
+	benchCHECK( xHelperDone == pdTRUE );
+	benchCHECK( xHelperBytes == 8 );
+	benchCHECK( xStreamBufferBytesAvailable( xStream ) == benchSIZE );
+	benchCHECK( xStreamBufferReset( xStream ) == pdPASS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckMessages( void )
+{
+MessageBufferHandle_t xMessages;
+StreamBufferRegions_t xRegions;
+uint8_t ucMessage[ benchMESSAGE_SIZE ];
+uint8_t ucNext = 0;
+size_t xLength, xByte;
+unsigned long ulWrong = 0, ulRound;
+
+	xMessages = xMessageBufferCreate( benchMESSAGE_SIZE );
+	configASSERT( xMessages );
+
+	/* A message that does not fit is not reserved at all. */
+	benchCHECK( xMessageBufferSendReserve( xMessages, benchMESSAGE_SIZE, &xRegions, 0 ) == 0 );
+
+	for( ulRound = 0; ulRound < benchROUNDS; ulRound++ )
+	{
+		/* Two messages of different lengths, one in place and one copied,
+		then the first read in place. */
+		xLength = ( ulRound % 9 ) + 1;
+
+		if( xMessageBufferSendReserve( xMessages, xLength, &xRegions, 0 ) != xLength )
+		{
+			ulWrong++;
+			break;
+		}
+
+		prvWriteRegions( &xRegions, xLength, ucNext );
+		( void ) xMessageBufferSendCommit( xMessages, xLength );
+
+		for( xByte = 0; xByte < 3; xByte++ )
+		{
+			ucMessage[ xByte ] = ( uint8_t ) ( ucNext + xLength + xByte );
+		}
+
+		( void ) xMessageBufferSend( xMessages, ucMessage, 3, 0 );
+
+		if( ( xMessageBufferReceiveAcquire( xMessages, &xRegions, 0 ) != xLength ) ||
+			( prvRegionsHold( &xRegions, xLength, ucNext ) == pdFALSE ) )
+		{
+			ulWrong++;
+		}
+
+		( void ) xMessageBufferReceiveRelease( xMessages, xLength );
+
+		if( ( xMessageBufferReceive( xMessages, ucMessage, sizeof( ucMessage ), 0 ) != 3 ) ||
+			( ucMessage[ 0 ] != ( uint8_t ) ( ucNext + xLength ) ) || ( ucMessage[ 2 ] != ( uint8_t ) ( ucNext + xLength + 2 ) ) )
+		{
+			ulWrong++;
+		}
+
+		ucNext = ( uint8_t ) ( ucNext + 7 );
+	}
+
+	/* Full but for less than a whole message. */
+	benchCHECK( xMessageBufferSendReserve( xMessages, benchMESSAGE_SIZE - 10, &xRegions, 0 ) == ( benchMESSAGE_SIZE - 10 ) );
+	prvWriteRegions( &xRegions, benchMESSAGE_SIZE - 10, 0 );
+	benchCHECK( xMessageBufferSendCommit( xMessages, benchMESSAGE_SIZE - 10 ) == ( benchMESSAGE_SIZE - 10 ) );
+	benchCHECK( xMessageBufferSendReserve( xMessages, 8, &xRegions, 0 ) == 0 );
+	benchCHECK( xMessageBufferSendReserveFromISR( xMessages, 8, &xRegions ) == 0 );
+
+	printf( "  %lu message rounds, %lu wrong\n", ulRound, ulWrong );
+	benchCHECK( ulWrong == 0 );
+
+	vMessageBufferDelete( xMessages );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	printf( "stream buffer reserve/commit and acquire/release\n" );
+
+	xStream = xStreamBufferCreate( benchSIZE, 1 );
+	configASSERT( xStream );
+	prvCheckReserve();
+	prvCheckOrder();
+	vStreamBufferDelete( xStream );
+
+	xStream = xStreamBufferCreate( benchSIZE, benchTRIGGER );
+	configASSERT( xStream );
+	prvCheckBlocking();
+	vStreamBufferDelete( xStream );
+
+	prvCheckMessages();
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
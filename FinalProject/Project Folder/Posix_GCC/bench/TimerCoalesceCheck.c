@@ -0,0 +1,314 @@
+/*
+ * Check of the coalescing of software timer commands
+ * (build/bench/timercoalesce).
+ *
+ * Checks that:
+ *
+ *   - a burst of resets to one timer, sent by a task above the timer service
+ *     task, never fails however much longer than the timer command queue it
+ *     is, and the timer then expires once, a period after the last reset;
+ *   - a change period command that was replaced by a stop and a reset still
+ *     sets the period, and a stop sent after a reset wins;
+ *   - the timers with commands waiting are processed in the order they got
+ *     their first one;
+ *   - a timer deleted with a reset pending is freed;
+ *   - resets from the tick interrupt keep a timer from expiring;
+ *   - pended function calls still run.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchTIMERS				( 7 )
+#define benchRESETS				( 200000UL )
+#define benchPERIOD				( 10 )
+#define benchLONG_PERIOD		( 30 )
+#define benchTICK_RESETS		( 100 )
+#define benchMAX_ORDER			( 8 )
+
+/* The timers, by the index that is also their ID. */
+#define benchBURST				( 0 )
+#define benchREPLACED			( 1 )
+#define benchSTOPPED			( 2 )
+#define benchFIRST_ORDERED		( 3 )
+#define benchORDERED			( 3 )
+#define benchTICK_RESET			( 6 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchSENDER_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xTimers[ benchTIMERS ];
+
+/* How many times the callback of each timer ran, the tick it last ran on, and
+the order in which the callbacks ran. */
+static volatile unsigned long ulCalls[ benchTIMERS ];
+static volatile TickType_t xCallTicks[ benchTIMERS ];
+static volatile UBaseType_t uxOrder[ benchMAX_ORDER ];
+static volatile UBaseType_t uxOrderCount;
+
+static volatile unsigned long ulSendFailed;
+static volatile TickType_t xLastReset;
+static volatile BaseType_t xSenderDone;
+static volatile uint32_t ulPendedValue;
+
+/* The tick hook resets its timer while xTickResetting is pdTRUE. */
+static volatile BaseType_t xTickResetting;
+static volatile unsigned long ulTickResetFailed;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvSenderTask( void * pvParameters );
+static void prvCallback( TimerHandle_t xTimer );
+static void prvPendedFunction( void * pvParameter1, uint32_t ulParameter2 );
+static void prvCheckBurst( void );
+static void prvCheckReplaced( void );
+static void prvCheckOrder( void );
+static void prvCheckDelete( void );
+static void prvCheckTickResets( void );
+static void prvCheckPendedCall( void );
+void vApplicationTickHook( void );
+
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	if( xTickResetting != pdFALSE )
+	{
+		if( xTimerResetFromISR( xTimers[ benchTICK_RESET ], NULL ) != pdPASS )
+		{
+			ulTickResetFailed++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCallback( TimerHandle_t xTimer )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) ( size_t ) pvTimerGetTimerID( xTimer );
+
+	ulCalls[ uxIndex ]++;
+	xCallTicks[ uxIndex ] = xTaskGetTickCount();
+
+	if( uxOrderCount < benchMAX_ORDER )
+	{
+		uxOrder[ uxOrderCount ] = uxIndex;
+	}
+
+	uxOrderCount++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPendedFunction( void * pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+
+	ulPendedValue = ulParameter2;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSenderTask( void * pvParameters )
+{
+unsigned long ulReset;
+
+	( void ) pvParameters;
+
+	/* The timer service task cannot run until this task is done, so without
+	coalescing the timer command queue would fill after its length. */
+	for( ulReset = 0; ulReset < benchRESETS; ulReset++ )
+	{
+		if( xTimerReset( xTimers[ benchBURST ], portMAX_DELAY ) != pdPASS )
+		{
+			ulSendFailed++;
+		}
+	}
+
+	xLastReset = xTaskGetTickCount();
+	xSenderDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBurst( void )
+{
+	xSenderDone = pdFALSE;
+	xTaskCreate( prvSenderTask, "sender", configMINIMAL_STACK_SIZE, NULL, benchSENDER_PRIORITY, NULL );
+	benchCHECK( xSenderDone == pdTRUE );
+
+	vTaskDelay( benchPERIOD * 3 );
+
+	printf( "  %lu resets from a task above the timer service task, %lu failed, %lu expiries %lu ticks after the last\n",
+			benchRESETS, ulSendFailed, ulCalls[ benchBURST ], ( unsigned long ) ( xCallTicks[ benchBURST ] - xLastReset ) );
+	benchCHECK( ulSendFailed == 0 );
+	benchCHECK( ulCalls[ benchBURST ] == 1 );
+	benchCHECK( ( xCallTicks[ benchBURST ] - xLastReset ) >= benchPERIOD );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckReplaced( void )
+{
+TickType_t xStart;
+
+	/* The timer service task runs above this task, so with the scheduler
+	suspended the commands are all pending when it next runs. */
+	vTaskSuspendAll();
+	{
+		xStart = xTaskGetTickCount();
+		benchCHECK( xTimerChangePeriod( xTimers[ benchREPLACED ], benchLONG_PERIOD, 0 ) == pdPASS );
+		benchCHECK( xTimerStop( xTimers[ benchREPLACED ], 0 ) == pdPASS );
+		benchCHECK( xTimerReset( xTimers[ benchREPLACED ], 0 ) == pdPASS );
+
+		benchCHECK( xTimerReset( xTimers[ benchSTOPPED ], 0 ) == pdPASS );
+		benchCHECK( xTimerStop( xTimers[ benchSTOPPED ], 0 ) == pdPASS );
+	}
+	( void ) xTaskResumeAll();
+
+	benchCHECK( xTimerGetPeriod( xTimers[ benchREPLACED ] ) == benchLONG_PERIOD );
+	benchCHECK( xTimerIsTimerActive( xTimers[ benchREPLACED ] ) != pdFALSE );
+	benchCHECK( xTimerIsTimerActive( xTimers[ benchSTOPPED ] ) == pdFALSE );
+
+	vTaskDelay( benchLONG_PERIOD + benchPERIOD );
+
+	benchCHECK( ulCalls[ benchREPLACED ] == 1 );
+	benchCHECK( ( xCallTicks[ benchREPLACED ] - xStart ) >= benchLONG_PERIOD );
+	benchCHECK( ulCalls[ benchSTOPPED ] == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOrder( void )
+{
+UBaseType_t uxIndex;
+
+	/* Started last to first in the same tick, so they expire together and
+	their callbacks run in the order the commands were processed.  The reset
+	of the first one started does not move it. */
+	uxOrderCount = 0;
+	vTaskSuspendAll();
+	{
+		for( uxIndex = benchORDERED; uxIndex > 0; uxIndex-- )
+		{
+			benchCHECK( xTimerStart( xTimers[ benchFIRST_ORDERED + uxIndex - 1 ], 0 ) == pdPASS );
+		}
+
+		benchCHECK( xTimerReset( xTimers[ benchFIRST_ORDERED + benchORDERED - 1 ], 0 ) == pdPASS );
+	}
+	( void ) xTaskResumeAll();
+
+	vTaskDelay( benchPERIOD * 2 );
+
+	benchCHECK( uxOrderCount == benchORDERED );
+
+	for( uxIndex = 0; uxIndex < benchORDERED; uxIndex++ )
+	{
+		benchCHECK( uxOrder[ uxIndex ] == ( benchFIRST_ORDERED + benchORDERED - 1 - uxIndex ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckDelete( void )
+{
+TimerHandle_t xTimer;
+size_t xFreeBefore;
+
+	xFreeBefore = xPortGetFreeHeapSize();
+	xTimer = xTimerCreate( "deleted", benchPERIOD, pdFALSE, ( void * ) benchBURST, prvCallback );
+	configASSERT( xTimer );
+
+	vTaskSuspendAll();
+	{
+		benchCHECK( xTimerReset( xTimer, 0 ) == pdPASS );
+		benchCHECK( xTimerDelete( xTimer, 0 ) == pdPASS );
+	}
+	( void ) xTaskResumeAll();
+
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTickResets( void )
+{
+TickType_t xStopped;
+
+	benchCHECK( xTimerStart( xTimers[ benchTICK_RESET ], 0 ) == pdPASS );
+	xTickResetting = pdTRUE;
+	vTaskDelay( benchTICK_RESETS );
+	xTickResetting = pdFALSE;
+	xStopped = xTaskGetTickCount();
+
+	benchCHECK( ulCalls[ benchTICK_RESET ] == 0 );
+	vTaskDelay( benchPERIOD * 2 );
+
+	printf( "  resets from the tick for %d ticks, %lu failed, %lu expiries, the first %lu ticks after they stopped\n",
+			benchTICK_RESETS, ulTickResetFailed, ulCalls[ benchTICK_RESET ],
+			( unsigned long ) ( xCallTicks[ benchTICK_RESET ] - xStopped ) );
+	benchCHECK( ulTickResetFailed == 0 );
+	benchCHECK( ulCalls[ benchTICK_RESET ] == 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckPendedCall( void )
+{
+	benchCHECK( xTimerPendFunctionCall( prvPendedFunction, NULL, 42, 0 ) == pdPASS );
+
+	/* The timer service task runs above this task. */
+	benchCHECK( ulPendedValue == 42 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+size_t xFreeBefore;
+UBaseType_t uxIndex;
+
+	( void ) pvParameters;
+
+	printf( "coalesced software timer commands\n" );
+
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	for( uxIndex = 0; uxIndex < benchTIMERS; uxIndex++ )
+	{
+		xTimers[ uxIndex ] = xTimerCreate( "timer", benchPERIOD, pdFALSE, ( void * ) ( size_t ) uxIndex, prvCallback );
+		configASSERT( xTimers[ uxIndex ] );
+	}
+
+	prvCheckBurst();
+	prvCheckReplaced();
+	prvCheckOrder();
+	prvCheckDelete();
+	prvCheckTickResets();
+	prvCheckPendedCall();
+
+	for( uxIndex = 0; uxIndex < benchTIMERS; uxIndex++ )
+	{
+		benchCHECK( xTimerDelete( xTimers[ uxIndex ], 0 ) == pdPASS );
+	}
+
+	/* Give the idle task the chance to free the sender task. */
+	vTaskDelay( 2 );
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,207 @@
+/*
+ * Timer slack benchmark, built with configUSE_TIMER_SLACK on and the timers
+ * kept in the sorted lists or in the timing wheel (build/bench/slack_list and
+ * build/bench/slack_wheel).
+ *
+ * 13 auto-reload timers run for 10000 ticks: the 333, 666 and 999 tick
+ * periods of the flash timers of the board demo, seven keep-alives with
+ * periods between 97 and 127 ticks, and timers of 50, 250 and 1000 ticks.
+ * This is done with no slack, then with a slack of a tenth and of a quarter
+ * of each period.  The timer service task's tag counts the ticks at which it
+ * is switched in, which are its wake-ups, and they are reported per second of
+ * a 1 ms tick with the mean gap between them.
+ *
+ * Every callback is checked: none may run before the timer was due, and every
+ * timer must expire its nominal number of times to within one.  The callbacks
+ * that run after their slack are counted with the most ticks any ran late by,
+ * but not checked.  The tick of the Posix port comes from a host timer and
+ * the tasks are host threads, so on a busy host the timer service task now
+ * and then runs a tick or two after it was woken.
+ *
+ * The tick runs faster than the 1 ms it stands for to keep the run short, see
+ * the Makefile.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchTIMERS				( 13 )
+#define benchRUN_TICKS			( 10000 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+
+/*-----------------------------------------------------------*/
+
+static const TickType_t xPeriods[ benchTIMERS ] = { 333, 666, 999, 97, 101, 103, 107, 109, 113, 127, 50, 250, 1000 };
+
+static TimerHandle_t xTimers[ benchTIMERS ];
+static TickType_t xStarted[ benchTIMERS ];
+static TickType_t xSlack[ benchTIMERS ];
+static volatile unsigned long ulExpiries[ benchTIMERS ];
+static volatile unsigned long ulEarly, ulLate;
+static volatile TickType_t xMostLate;
+
+/* Written by prvCountWakeUp() in the context switch. */
+static volatile BaseType_t xCounting = pdFALSE;
+static volatile unsigned long ulWakeUps;
+static volatile TickType_t xLastWakeUp, xGaps;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvTimerCallback( TimerHandle_t xTimer );
+static BaseType_t prvCountWakeUp( void * pvParameter );
+static void prvRun( UBaseType_t uxSlackDivisor );
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCountWakeUp( void * pvParameter )
+{
+TickType_t xNow = xTaskGetTickCountFromISR();
+
+	( void ) pvParameter;
+
+	/* The timer service task can be switched in more than once in a tick, to
+	process commands, count the ticks. */
+	if( ( xCounting != pdFALSE ) && ( ( ulWakeUps == 0 ) || ( xNow != xLastWakeUp ) ) )
+	{
+		if( ulWakeUps != 0 )
+		{
+			xGaps += xNow - xLastWakeUp;
+		}
+
+		xLastWakeUp = xNow;
+		ulWakeUps++;
+	}
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( size_t ) pvTimerGetTimerID( xTimer );
+TickType_t xNow = xTaskGetTickCount();
+TickType_t xDue;
+
+	ulExpiries[ uxIndex ]++;
+	xDue = xStarted[ uxIndex ] + ( ( TickType_t ) ulExpiries[ uxIndex ] * xPeriods[ uxIndex ] );
+
+	if( xNow < xDue )
+	{
+		ulEarly++;
+	}
+	else if( xNow > ( xDue + xSlack[ uxIndex ] ) )
+	{
+		ulLate++;
+
+		if( ( xNow - ( xDue + xSlack[ uxIndex ] ) ) > xMostLate )
+		{
+			xMostLate = xNow - ( xDue + xSlack[ uxIndex ] );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRun( UBaseType_t uxSlackDivisor )
+{
+UBaseType_t uxIndex;
+TickType_t xStart, xElapsed;
+unsigned long ulNominal = 0, ulExpired = 0, ulMiscounted = 0;
+
+	ulEarly = ulLate = 0;
+	xMostLate = 0;
+	ulWakeUps = 0;
+	xGaps = 0;
+
+	for( uxIndex = 0; uxIndex < benchTIMERS; uxIndex++ )
+	{
+		xSlack[ uxIndex ] = ( uxSlackDivisor != 0 ) ? ( xPeriods[ uxIndex ] / uxSlackDivisor ) : 0;
+		ulExpiries[ uxIndex ] = 0;
+		xTimers[ uxIndex ] = xTimerCreate( "slack", xPeriods[ uxIndex ], pdTRUE, ( void * ) ( size_t ) uxIndex, prvTimerCallback );
+		configASSERT( xTimers[ uxIndex ] );
+		vTimerSetSlack( xTimers[ uxIndex ], xSlack[ uxIndex ] );
+	}
+
+	/* The timer service task runs above this task, so each start is
+	processed at the tick it is sent. */
+	xCounting = pdTRUE;
+
+	for( uxIndex = 0; uxIndex < benchTIMERS; uxIndex++ )
+	{
+		xStarted[ uxIndex ] = xTaskGetTickCount();
+		( void ) xTimerStart( xTimers[ uxIndex ], portMAX_DELAY );
+	}
+
+	xStart = xTaskGetTickCount();
+	vTaskDelay( benchRUN_TICKS );
+	xCounting = pdFALSE;
+	xElapsed = xTaskGetTickCount() - xStart;
+
+	for( uxIndex = 0; uxIndex < benchTIMERS; uxIndex++ )
+	{
+		( void ) xTimerDelete( xTimers[ uxIndex ], portMAX_DELAY );
+
+		ulNominal += ( unsigned long ) ( xElapsed / xPeriods[ uxIndex ] );
+		ulExpired += ulExpiries[ uxIndex ];
+
+		if( ( ( ulExpiries[ uxIndex ] + 1 ) < ( xElapsed / xPeriods[ uxIndex ] ) ) ||
+			( ulExpiries[ uxIndex ] > ( ( xElapsed / xPeriods[ uxIndex ] ) + 1 ) ) )
+		{
+			ulMiscounted++;
+		}
+	}
+
+	if( uxSlackDivisor != 0 )
+	{
+		printf( "  slack of 1/%lu of the period: ", ( unsigned long ) uxSlackDivisor );
+	}
+	else
+	{
+		printf( "  no slack:                     " );
+	}
+
+	printf( "%5.1f wake-ups per second, mean gap %4.1f ticks, %lu expiries (%lu nominal), %lu early, %lu after the slack (at most %lu ticks)\n",
+			( ( double ) ulWakeUps * 1000.0 ) / ( double ) xElapsed,
+			( ulWakeUps > 1 ) ? ( ( double ) xGaps / ( double ) ( ulWakeUps - 1 ) ) : 0.0,
+			ulExpired, ulNominal, ulEarly, ulLate, ( unsigned long ) xMostLate );
+
+	benchCHECK( ulWakeUps > 0 );
+	benchCHECK( ulEarly == 0 );
+	benchCHECK( ulMiscounted == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	printf( "timer slack, %s\n", ( configUSE_TIMER_WHEEL == 1 ) ? "timing wheel" : "sorted lists" );
+	vTaskSetApplicationTaskTag( xTimerGetTimerDaemonTaskHandle(), prvCountWakeUp );
+	vTaskDelay( 5 );
+
+	prvRun( 0 );
+	prvRun( 10 );
+	prvRun( 4 );
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
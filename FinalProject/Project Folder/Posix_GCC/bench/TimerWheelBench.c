@@ -0,0 +1,248 @@
+/*
+ * Software timer benchmark, built with configUSE_TIMER_WHEEL off and on
+ * (build/bench/timers_list and build/bench/timers_wheel), and both again
+ * starting 1500 ticks before the tick count wraps (timers_list_wrap and
+ * timers_wheel_wrap).
+ *
+ * First 1000 timers, auto-reload and one-shot, with periods of 1 to 3000
+ * ticks are started and then reset and stopped at random for 3000 ticks.
+ * Every callback is checked against the tick its timer was due: none may run
+ * early or for a timer that is stopped.  The callbacks that run more than a
+ * tick late are counted with the most ticks any ran late by, but not checked,
+ * as the tick of the Posix port comes from a host timer and on a busy host the
+ * timer service task now and then runs a tick or two after it was woken.  The
+ * resets and stops are made from the timer service task, with
+ * xTimerPendFunctionCall(), so that the expected expiry is recorded in the
+ * same order as the commands are processed.
+ *
+ * Then all 1000 timers are given periods long enough not to expire, and
+ * xTimerReset() is called in bursts of 500 on random timers.  The timer
+ * service task runs below this task, so a burst queues up and is then
+ * processed in one go.  The time of a burst, sending and processing, is
+ * reported per reset.  With the sorted lists each reset walks the active
+ * timers, with the wheel it does not.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "semphr.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchTIMERS				( 1000 )
+#define benchMAX_PERIOD			( 3000 )
+#define benchSTORM_TICKS		( 3000 )
+#define benchDRAIN_TICKS		( 1000 )
+#define benchBURSTS				( 200 )
+#define benchRESETS_PER_BURST	( 500 )
+
+#define benchCONTROL_PRIORITY	( configTIMER_TASK_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xTimers[ benchTIMERS ];
+static TickType_t xPeriods[ benchTIMERS ];
+
+/* Tick each timer is due next, and whether it is running.  Only written in
+the timer service task, by prvStartTimer(), prvStopTimer() and the callbacks,
+so the expectations change in the order the commands are processed. */
+static TickType_t xDue[ benchTIMERS ];
+static BaseType_t xArmed[ benchTIMERS ];
+
+static volatile unsigned long ulFired = 0, ulEarly = 0, ulLate = 0, ulSpurious = 0;
+static volatile TickType_t xMostLate = 0;
+static unsigned long ulBurst[ benchBURSTS ];
+static SemaphoreHandle_t xDrained;
+static unsigned long ulSeed = 12345;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvTimerCallback( TimerHandle_t xTimer );
+static void prvDrained( void * pvParameter1, uint32_t ulParameter2 );
+static void prvStartTimer( void * pvParameter1, uint32_t ulParameter2 );
+static void prvStopTimer( void * pvParameter1, uint32_t ulParameter2 );
+static void prvWaitForTimerTask( void );
+static unsigned long prvRandom( void );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+	return ( ulSeed >> 8 ) & 0xffffffUL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( size_t ) pvTimerGetTimerID( xTimer );
+TickType_t xNow = xTaskGetTickCount();
+
+	if( xArmed[ uxIndex ] == pdFALSE )
+	{
+		ulSpurious++;
+		return;
+	}
+
+	if( ( TickType_t ) ( xNow - xDue[ uxIndex ] ) > ( TickType_t ) 1 )
+	{
+		/* Negative differences wrap to large values. */
+		if( ( TickType_t ) ( xDue[ uxIndex ] - xNow ) <= ( TickType_t ) benchMAX_PERIOD )
+		{
+			ulEarly++;
+		}
+		else
+		{
+			ulLate++;
+
+			if( ( TickType_t ) ( xNow - xDue[ uxIndex ] ) > xMostLate )
+			{
+				xMostLate = xNow - xDue[ uxIndex ];
+			}
+		}
+	}
+
+	ulFired++;
+
+	if( xTimerIsTimerActive( xTimer ) != pdFALSE )
+	{
+		xDue[ uxIndex ] += xPeriods[ uxIndex ];
+	}
+	else
+	{
+		xArmed[ uxIndex ] = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvDrained( void * pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+	( void ) ulParameter2;
+
+	xSemaphoreGive( xDrained );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTimer( void * pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+
+	/* The reset is processed before the timer service task looks at the
+	timers again, and takes the current tick as its start. */
+	xDue[ ulParameter2 ] = xTaskGetTickCount() + xPeriods[ ulParameter2 ];
+	xArmed[ ulParameter2 ] = pdTRUE;
+	( void ) xTimerReset( xTimers[ ulParameter2 ], 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTimer( void * pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+
+	xArmed[ ulParameter2 ] = pdFALSE;
+	( void ) xTimerStop( xTimers[ ulParameter2 ], 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForTimerTask( void )
+{
+	/* Queued behind every command sent so far. */
+	( void ) xTimerPendFunctionCall( prvDrained, NULL, 0, portMAX_DELAY );
+	( void ) xSemaphoreTake( xDrained, portMAX_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+UBaseType_t uxIndex, uxBurst, uxReset;
+TickType_t xStart;
+unsigned long ulOperations = 0;
+unsigned long long ullStart;
+
+	( void ) pvParameters;
+
+	printf( "software timers, %s, from tick %lu\n", ( configUSE_TIMER_WHEEL == 1 ) ? "timing wheel" : "sorted lists",
+			( unsigned long ) xTaskGetTickCount() );
+	xDrained = xSemaphoreCreateBinary();
+
+	for( uxIndex = 0; uxIndex < benchTIMERS; uxIndex++ )
+	{
+		xPeriods[ uxIndex ] = 1 + ( prvRandom() % benchMAX_PERIOD );
+		xTimers[ uxIndex ] = xTimerCreate( "bench", xPeriods[ uxIndex ], ( ( uxIndex % 3 ) != 0 ) ? pdTRUE : pdFALSE,
+										   ( void * ) ( size_t ) uxIndex, prvTimerCallback );
+		configASSERT( xTimers[ uxIndex ] );
+	}
+
+	/* The timers are started and stopped from the timer service task, which
+	records what it expects at the same time, see prvStartTimer(). */
+	for( uxIndex = 0; uxIndex < benchTIMERS; uxIndex++ )
+	{
+		( void ) xTimerPendFunctionCall( prvStartTimer, NULL, ( uint32_t ) uxIndex, portMAX_DELAY );
+	}
+
+	xStart = xTaskGetTickCount();
+
+	while( ( xTaskGetTickCount() - xStart ) < benchSTORM_TICKS )
+	{
+		for( uxReset = 0; uxReset < 20; uxReset++, ulOperations++ )
+		{
+			uxIndex = prvRandom() % benchTIMERS;
+			( void ) xTimerPendFunctionCall( ( ( prvRandom() % 8 ) == 0 ) ? prvStopTimer : prvStartTimer, NULL,
+											 ( uint32_t ) uxIndex, portMAX_DELAY );
+		}
+
+		vTaskDelay( 1 + ( prvRandom() % 3 ) );
+	}
+
+	vTaskDelay( benchDRAIN_TICKS );
+
+	printf( "  %lu resets and stops, %lu callbacks, %lu early, %lu late (at most %lu ticks), %lu for stopped timers, end tick %lu\n",
+			ulOperations, ulFired, ulEarly, ulLate, ( unsigned long ) xMostLate, ulSpurious, ( unsigned long ) xTaskGetTickCount() );
+	benchCHECK( ulFired > 0 );
+	benchCHECK( ulEarly == 0 );
+	benchCHECK( ulSpurious == 0 );
+
+	/* None of these expire during the measurement. */
+	for( uxIndex = 0; uxIndex < benchTIMERS; uxIndex++ )
+	{
+		( void ) xTimerChangePeriod( xTimers[ uxIndex ], 100000 + ( prvRandom() % 100000 ), portMAX_DELAY );
+	}
+
+	prvWaitForTimerTask();
+
+	for( uxBurst = 0; uxBurst < benchBURSTS; uxBurst++ )
+	{
+		ullStart = ullBenchNanoseconds();
+
+		for( uxReset = 0; uxReset < benchRESETS_PER_BURST; uxReset++ )
+		{
+			( void ) xTimerReset( xTimers[ prvRandom() % benchTIMERS ], portMAX_DELAY );
+		}
+
+		prvWaitForTimerTask();
+		ulBurst[ uxBurst ] = ( unsigned long ) ( ( ullBenchNanoseconds() - ullStart ) / benchRESETS_PER_BURST );
+	}
+
+	vBenchReport( "reset, 1000 active", ulBurst, benchBURSTS, "ns per reset" );
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
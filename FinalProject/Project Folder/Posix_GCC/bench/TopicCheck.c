@@ -0,0 +1,343 @@
+/*
+ * Check of the publish/subscribe topics (build/bench/topic).
+ *
+ * Checks that:
+ *
+ *   - a topicBACKPRESSURE topic holds a whole ring for its slowest
+ *     subscriber, after which a publish fails at once with no block time and
+ *     after its block time with one, and a receive with nothing published
+ *     does the same;
+ *   - on a topicOVERWRITE topic, an item overwritten while it is held makes
+ *     its release fail, and the items skipped are counted as missed;
+ *   - four subscribers at two priorities receive every item of a
+ *     topicBACKPRESSURE topic, in order, with none missed;
+ *   - with the tick interrupt publishing to a topicOVERWRITE topic, each item
+ *     reaches a subscriber, fast or slow, either received in order or counted
+ *     as missed.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "topic.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchLENGTH				( 4 )
+#define benchITEMS				( 20000UL )
+#define benchSUBSCRIBERS		( 4 )
+#define benchPER_TICK			( 3 )
+#define benchTICKS				( 200 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchLOW_PRIORITY		( 1 )
+#define benchHIGH_PRIORITY		( 3 )
+
+/*-----------------------------------------------------------*/
+
+/* What one subscriber task saw. */
+typedef struct
+{
+	volatile BaseType_t xSlow;
+	volatile BaseType_t xSubscribed;
+	volatile BaseType_t xDone;
+	volatile unsigned long ulReceived;
+	volatile unsigned long ulWrong;
+	volatile unsigned long ulMissed;
+	volatile unsigned long ulOverwritten;
+} BenchSubscriber_t;
+
+/*-----------------------------------------------------------*/
+
+static TopicHandle_t xTopic;
+static BenchSubscriber_t xSubscribers[ benchSUBSCRIBERS ];
+
+/* The tick hook publishes while xTickPublishing is pdTRUE. */
+static volatile BaseType_t xTickPublishing;
+static volatile uint32_t ulTickPublished;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvSubscriberTask( void * pvParameters );
+static void prvStartSubscribers( UBaseType_t uxCount );
+static void prvCheckLimits( void );
+static void prvCheckBackpressure( void );
+static void prvCheckOverwrite( void );
+void vApplicationTickHook( void );
+
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+UBaseType_t uxItem;
+uint32_t ulItem;
+
+	if( xTickPublishing != pdFALSE )
+	{
+		for( uxItem = 0; uxItem < benchPER_TICK; uxItem++ )
+		{
+			ulItem = ulTickPublished;
+
+			if( xTopicPublishFromISR( xTopic, &ulItem, NULL ) == pdPASS )
+			{
+				ulTickPublished++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSubscriberTask( void * pvParameters )
+{
+BenchSubscriber_t * const pxSubscriber = ( BenchSubscriber_t * ) pvParameters;
+TopicSubscriberHandle_t xSubscription;
+const uint32_t * pulItem;
+uint32_t ulNext = 0, ulItem;
+UBaseType_t uxMissed;
+
+	xSubscription = xTopicSubscribe( xTopic );
+	configASSERT( xSubscription );
+	pxSubscriber->xSubscribed = pdTRUE;
+
+	/* Until nothing has been published for a while. */
+	while( ( pulItem = ( const uint32_t * ) pvTopicReceive( xSubscription, 50 ) ) != NULL )
+	{
+		ulItem = *pulItem;
+
+		/* Skipped items come before the one received. */
+		uxMissed = uxTopicGetMissed( xSubscription );
+		ulNext += ( uint32_t ) ( uxMissed - pxSubscriber->ulMissed );
+		pxSubscriber->ulMissed = uxMissed;
+
+		if( xTopicRelease( xSubscription ) != pdPASS )
+		{
+			/* What was read may be part of a newer item. */
+			pxSubscriber->ulOverwritten++;
+		}
+		else if( ulItem != ulNext )
+		{
+			pxSubscriber->ulWrong++;
+		}
+
+		ulNext++;
+		pxSubscriber->ulReceived++;
+
+		if( ( pxSubscriber->xSlow != pdFALSE ) && ( ( pxSubscriber->ulReceived % 10 ) == 0 ) )
+		{
+			vTaskDelay( 3 );
+		}
+	}
+
+	vTopicUnsubscribe( xSubscription );
+	pxSubscriber->xDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartSubscribers( UBaseType_t uxCount )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+	{
+		xTaskCreate( prvSubscriberTask, "subscriber", configMINIMAL_STACK_SIZE, &( xSubscribers[ uxIndex ] ),
+					 ( ( uxIndex % 2 ) == 0 ) ? benchHIGH_PRIORITY : benchLOW_PRIORITY, NULL );
+	}
+
+	/* The subscriptions start with the next item published, so wait for the
+	low priority subscribers to have made theirs. */
+	for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+	{
+		while( xSubscribers[ uxIndex ].xSubscribed == pdFALSE )
+		{
+			vTaskDelay( 1 );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckLimits( void )
+{
+TopicSubscriberHandle_t xSubscription;
+const uint32_t * pulItem;
+uint32_t ulItem;
+UBaseType_t uxIndex;
+TickType_t xStart;
+
+	/* This task subscribes and does not receive, so it is the slowest
+	subscriber. */
+	xTopic = xTopicCreate( benchLENGTH, sizeof( uint32_t ), topicBACKPRESSURE );
+	configASSERT( xTopic );
+	xSubscription = xTopicSubscribe( xTopic );
+	configASSERT( xSubscription );
+
+	benchCHECK( pvTopicReceive( xSubscription, 0 ) == NULL );
+	xStart = xTaskGetTickCount();
+	benchCHECK( pvTopicReceive( xSubscription, 10 ) == NULL );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		ulItem = ( uint32_t ) uxIndex;
+		benchCHECK( xTopicPublish( xTopic, &ulItem, 0 ) == pdPASS );
+	}
+
+	benchCHECK( xTopicPublish( xTopic, &ulItem, 0 ) == errQUEUE_FULL );
+	benchCHECK( xTopicPublishFromISR( xTopic, &ulItem, NULL ) == errQUEUE_FULL );
+	xStart = xTaskGetTickCount();
+	benchCHECK( xTopicPublish( xTopic, &ulItem, 10 ) == errQUEUE_FULL );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+
+	/* One received makes room for one more. */
+	pulItem = ( const uint32_t * ) pvTopicReceive( xSubscription, 0 );
+	benchCHECK( ( pulItem != NULL ) && ( *pulItem == 0 ) );
+	benchCHECK( xTopicRelease( xSubscription ) == pdPASS );
+	benchCHECK( xTopicPublish( xTopic, &ulItem, 0 ) == pdPASS );
+	benchCHECK( xTopicPublish( xTopic, &ulItem, 0 ) == errQUEUE_FULL );
+
+	vTopicUnsubscribe( xSubscription );
+	vTopicDelete( xTopic );
+
+	/* On an overwrite topic publishing never fails, and the subscriber that
+	falls behind misses items. */
+	xTopic = xTopicCreate( benchLENGTH, sizeof( uint32_t ), topicOVERWRITE );
+	configASSERT( xTopic );
+	xSubscription = xTopicSubscribe( xTopic );
+	configASSERT( xSubscription );
+
+	ulItem = 0;
+	benchCHECK( xTopicPublish( xTopic, &ulItem, 0 ) == pdPASS );
+	pulItem = ( const uint32_t * ) pvTopicReceive( xSubscription, 0 );
+	benchCHECK( ( pulItem != NULL ) && ( *pulItem == 0 ) );
+
+	for( ulItem = 1; ulItem <= ( benchLENGTH + 2 ); ulItem++ )
+	{
+		benchCHECK( xTopicPublish( xTopic, &ulItem, 0 ) == pdPASS );
+	}
+
+	benchCHECK( xTopicRelease( xSubscription ) == pdFAIL );
+	pulItem = ( const uint32_t * ) pvTopicReceive( xSubscription, 0 );
+	benchCHECK( ( pulItem != NULL ) && ( *pulItem == 3 ) );
+	benchCHECK( xTopicRelease( xSubscription ) == pdPASS );
+	benchCHECK( uxTopicGetMissed( xSubscription ) == 2 );
+
+	vTopicUnsubscribe( xSubscription );
+	vTopicDelete( xTopic );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBackpressure( void )
+{
+uint32_t ulItem;
+unsigned long ulPublishFailed = 0;
+UBaseType_t uxIndex;
+
+	xTopic = xTopicCreate( benchLENGTH, sizeof( uint32_t ), topicBACKPRESSURE );
+	configASSERT( xTopic );
+	memset( xSubscribers, 0, sizeof( xSubscribers ) );
+	prvStartSubscribers( benchSUBSCRIBERS );
+
+	for( ulItem = 0; ulItem < benchITEMS; ulItem++ )
+	{
+		if( xTopicPublish( xTopic, &ulItem, portMAX_DELAY ) != pdPASS )
+		{
+			ulPublishFailed++;
+		}
+	}
+
+	for( uxIndex = 0; uxIndex < benchSUBSCRIBERS; uxIndex++ )
+	{
+		while( xSubscribers[ uxIndex ].xDone == pdFALSE )
+		{
+			vTaskDelay( 10 );
+		}
+
+		printf( "  backpressure subscriber %lu: %lu received, %lu missed, %lu out of order\n", ( unsigned long ) uxIndex,
+				xSubscribers[ uxIndex ].ulReceived, xSubscribers[ uxIndex ].ulMissed, xSubscribers[ uxIndex ].ulWrong );
+		benchCHECK( xSubscribers[ uxIndex ].ulReceived == benchITEMS );
+		benchCHECK( xSubscribers[ uxIndex ].ulMissed == 0 );
+		benchCHECK( xSubscribers[ uxIndex ].ulWrong == 0 );
+		benchCHECK( xSubscribers[ uxIndex ].ulOverwritten == 0 );
+	}
+
+	benchCHECK( ulPublishFailed == 0 );
+	vTopicDelete( xTopic );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOverwrite( void )
+{
+UBaseType_t uxIndex;
+
+	xTopic = xTopicCreate( benchLENGTH, sizeof( uint32_t ), topicOVERWRITE );
+	configASSERT( xTopic );
+	memset( xSubscribers, 0, sizeof( xSubscribers ) );
+	xSubscribers[ 1 ].xSlow = pdTRUE;
+	prvStartSubscribers( 2 );
+
+	xTickPublishing = pdTRUE;
+	vTaskDelay( benchTICKS );
+	xTickPublishing = pdFALSE;
+
+	for( uxIndex = 0; uxIndex < 2; uxIndex++ )
+	{
+		while( xSubscribers[ uxIndex ].xDone == pdFALSE )
+		{
+			vTaskDelay( 10 );
+		}
+
+		printf( "  %s overwrite subscriber: %lu of %lu received (%lu overwritten while held), %lu missed, %lu out of order\n",
+				( xSubscribers[ uxIndex ].xSlow != pdFALSE ) ? "slow" : "fast", xSubscribers[ uxIndex ].ulReceived,
+				( unsigned long ) ulTickPublished, xSubscribers[ uxIndex ].ulOverwritten, xSubscribers[ uxIndex ].ulMissed,
+				xSubscribers[ uxIndex ].ulWrong );
+		benchCHECK( ( xSubscribers[ uxIndex ].ulReceived + xSubscribers[ uxIndex ].ulMissed ) == ulTickPublished );
+		benchCHECK( xSubscribers[ uxIndex ].ulWrong == 0 );
+	}
+
+	/* The slow subscriber falls behind.  The fast one can too when the
+	simulated ticks bunch up on a loaded host, but by far less. */
+	benchCHECK( xSubscribers[ 1 ].ulMissed > 0 );
+	benchCHECK( xSubscribers[ 0 ].ulMissed < xSubscribers[ 1 ].ulMissed );
+	benchCHECK( ulTickPublished >= ( ( benchTICKS - 1 ) * benchPER_TICK ) );
+	vTopicDelete( xTopic );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+size_t xFreeBefore;
+
+	( void ) pvParameters;
+
+	printf( "publish/subscribe topics\n" );
+
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	prvCheckLimits();
+	prvCheckBackpressure();
+	prvCheckOverwrite();
+
+	/* Give the idle task the chance to free the subscriber tasks. */
+	vTaskDelay( 2 );
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
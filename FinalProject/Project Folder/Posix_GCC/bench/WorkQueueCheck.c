@@ -0,0 +1,333 @@
+/*
+ * Check of the work queues, and of the task deadlines they use under EDF
+ * (build/bench/workqueue with fixed priorities, build/bench/workqueue_edf
+ * with the EDF scheduler).
+ *
+ * Checks that:
+ *
+ *   - items run in the order of their deadlines, in the order they were
+ *     submitted for equal deadlines, and after all others if they have none;
+ *   - a work queue holds the number of items it was created for, after which
+ *     a submission fails, from a task and from an interrupt;
+ *   - items submitted from the tick interrupt run within a tick while a task
+ *     below the worker, or under EDF with a later deadline, keeps the
+ *     processor;
+ *   - under EDF, tasks blocked on a semaphore whose deadlines are changed
+ *     while they wait are woken in the order of their new deadlines.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "workqueue.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchLENGTH				( 8 )
+#define benchMAX_LOG			( 16 )
+#define benchORDERED			( 6 )
+#define benchBUSY_TICKS			( 8 )
+#define benchBUSY_PERIOD		( 20 )
+#define benchWAITERS			( 3 )
+
+/* Under fixed priorities the control task runs above the worker, and the
+worker above the busy task.  Under EDF the control task has a period of one
+tick, so each time it wakes its deadline is the next tick and it is the most
+urgent task as well, and the busy task has a deadline later than those of the
+items submitted while it runs. */
+#define benchCONTROL_PRIORITY	( 3 )
+#define benchWORKER_PRIORITY	( 2 )
+#define benchBUSY_PRIORITY		( 1 )
+#define benchCONTROL_PERIOD		( 1 )
+
+/*-----------------------------------------------------------*/
+
+static WorkQueueHandle_t xWorkQueue;
+
+/* The tags of the items and tasks in the order they ran. */
+static volatile uint32_t ulLog[ benchMAX_LOG ];
+static volatile UBaseType_t uxLogged;
+
+/* The tick hook submits while xTickSubmitting is pdTRUE. */
+static volatile BaseType_t xTickSubmitting;
+static volatile unsigned long ulTickSubmitted, ulTickFailed, ulTickRan;
+static volatile TickType_t xLongestWait;
+static volatile BaseType_t xBusyDone;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvBusyTask( void * pvParameters );
+static void prvLogItem( void * pvParameter1, uint32_t ulParameter2 );
+static void prvTickItem( void * pvParameter1, uint32_t ulParameter2 );
+static void prvLog( uint32_t ulTag );
+static BaseType_t prvCreateTask( TaskFunction_t pxTaskCode, const char * const pcName, void * const pvParameters,
+								 UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, TickType_t xPeriod );
+static void prvCheckOrder( void );
+static void prvCheckFull( void );
+static void prvCheckTickSubmissions( void );
+void vApplicationTickHook( void );
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	static void prvWaiterTask( void * pvParameters );
+	static void prvCheckWaitingDeadlines( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	if( xTickSubmitting != pdFALSE )
+	{
+		if( xWorkQueueSubmitFromISR( xWorkQueue, prvTickItem, NULL, ( uint32_t ) xTaskGetTickCountFromISR(), 2, NULL ) == pdPASS )
+		{
+			ulTickSubmitted++;
+		}
+		else
+		{
+			ulTickFailed++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCreateTask( TaskFunction_t pxTaskCode, const char * const pcName, void * const pvParameters,
+								 UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, TickType_t xPeriod )
+{
+BaseType_t xReturn;
+
+	/* Under EDF a task created by xTaskCreate() has no deadline and never
+	runs ahead of the idle task. */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+		xReturn = xTaskPeriodicCreate( pxTaskCode, pcName, configMINIMAL_STACK_SIZE, pvParameters, uxPriority, pxCreatedTask, xPeriod );
+	#else
+		( void ) xPeriod;
+		xReturn = xTaskCreate( pxTaskCode, pcName, configMINIMAL_STACK_SIZE, pvParameters, uxPriority, pxCreatedTask );
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLog( uint32_t ulTag )
+{
+	if( uxLogged < benchMAX_LOG )
+	{
+		ulLog[ uxLogged ] = ulTag;
+	}
+
+	uxLogged++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLogItem( void * pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+
+	prvLog( ulParameter2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickItem( void * pvParameter1, uint32_t ulParameter2 )
+{
+const TickType_t xWait = xTaskGetTickCount() - ( TickType_t ) ulParameter2;
+
+	( void ) pvParameter1;
+
+	if( xWait > xLongestWait )
+	{
+		xLongestWait = xWait;
+	}
+
+	ulTickRan++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckOrder( void )
+{
+static const TickType_t xDeadlines[ benchORDERED ] = { 30, 10, 20, 10, workqueueNO_DEADLINE, 5 };
+static const uint32_t ulExpected[ benchORDERED ] = { 5, 1, 3, 2, 0, 4 };
+UBaseType_t uxIndex;
+
+	/* The worker cannot run until this task blocks, so it takes every item
+	before it runs any. */
+	uxLogged = 0;
+
+	for( uxIndex = 0; uxIndex < benchORDERED; uxIndex++ )
+	{
+		benchCHECK( xWorkQueueSubmit( xWorkQueue, prvLogItem, NULL, ( uint32_t ) uxIndex, xDeadlines[ uxIndex ], 0 ) == pdPASS );
+	}
+
+	benchCHECK( uxLogged == 0 );
+	vTaskDelay( 2 );
+
+	benchCHECK( uxLogged == benchORDERED );
+
+	for( uxIndex = 0; uxIndex < benchORDERED; uxIndex++ )
+	{
+		benchCHECK( ulLog[ uxIndex ] == ulExpected[ uxIndex ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckFull( void )
+{
+UBaseType_t uxIndex;
+
+	uxLogged = 0;
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		benchCHECK( xWorkQueueSubmit( xWorkQueue, prvLogItem, NULL, ( uint32_t ) uxIndex, 10, 0 ) == pdPASS );
+	}
+
+	benchCHECK( xWorkQueueSubmit( xWorkQueue, prvLogItem, NULL, benchLENGTH, 10, 0 ) == errQUEUE_FULL );
+	benchCHECK( xWorkQueueSubmitFromISR( xWorkQueue, prvLogItem, NULL, benchLENGTH, 10, NULL ) == errQUEUE_FULL );
+	vTaskDelay( 2 );
+
+	/* The deadlines are equal, or later for an item submitted after a tick. */
+	benchCHECK( uxLogged == benchLENGTH );
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		benchCHECK( ulLog[ uxIndex ] == ( uint32_t ) uxIndex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyTask( void * pvParameters )
+{
+TickType_t xStart;
+
+	( void ) pvParameters;
+
+	xStart = xTaskGetTickCount();
+	xTickSubmitting = pdTRUE;
+
+	while( ( xTaskGetTickCount() - xStart ) < benchBUSY_TICKS )
+	{
+	}
+
+	xTickSubmitting = pdFALSE;
+	xBusyDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTickSubmissions( void )
+{
+	xBusyDone = pdFALSE;
+	benchCHECK( prvCreateTask( prvBusyTask, "busy", NULL, benchBUSY_PRIORITY, NULL, benchBUSY_PERIOD ) == pdPASS );
+	vTaskDelay( benchBUSY_TICKS + 5 );
+
+	printf( "  %lu items submitted from the tick while a task was busy for %d ticks, %lu failed, %lu ran, the longest after %lu ticks\n",
+			ulTickSubmitted, benchBUSY_TICKS, ulTickFailed, ulTickRan, ( unsigned long ) xLongestWait );
+	benchCHECK( xBusyDone == pdTRUE );
+	benchCHECK( ulTickSubmitted >= ( benchBUSY_TICKS - 1 ) );
+	benchCHECK( ulTickFailed == 0 );
+	benchCHECK( ulTickRan == ulTickSubmitted );
+	benchCHECK( xLongestWait <= 1 );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static SemaphoreHandle_t xSemaphore;
+
+	static void prvWaiterTask( void * pvParameters )
+	{
+		if( xSemaphoreTake( xSemaphore, portMAX_DELAY ) == pdPASS )
+		{
+			prvLog( ( uint32_t ) ( size_t ) pvParameters );
+		}
+
+		vTaskDelete( NULL );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckWaitingDeadlines( void )
+	{
+	TaskHandle_t xWaiters[ benchWAITERS ];
+	TickType_t xNow;
+	UBaseType_t uxIndex;
+
+		xSemaphore = xSemaphoreCreateBinary();
+		configASSERT( xSemaphore );
+		uxLogged = 0;
+
+		/* Created with the deadlines 10, 20 and 30 ticks from now, so they
+		block in that order once this task lets them run. */
+		for( uxIndex = 0; uxIndex < benchWAITERS; uxIndex++ )
+		{
+			benchCHECK( prvCreateTask( prvWaiterTask, "waiter", ( void * ) ( size_t ) uxIndex, benchBUSY_PRIORITY,
+									   &( xWaiters[ uxIndex ] ), ( uxIndex + 1 ) * 10 ) == pdPASS );
+		}
+
+		vTaskDelay( 1 );
+
+		/* Reverse the order while they wait. */
+		xNow = xTaskGetTickCount();
+		vTaskSetDeadline( xWaiters[ 0 ], xNow + 60 );
+		vTaskRaiseDeadline( xWaiters[ 2 ], xNow + 5 );
+
+		/* Each give wakes one waiter, which runs while this task is
+		delayed. */
+		for( uxIndex = 0; uxIndex < benchWAITERS; uxIndex++ )
+		{
+			benchCHECK( xSemaphoreGive( xSemaphore ) == pdPASS );
+			vTaskDelay( 2 );
+		}
+
+		benchCHECK( uxLogged == benchWAITERS );
+		benchCHECK( ( ulLog[ 0 ] == 2 ) && ( ulLog[ 1 ] == 1 ) && ( ulLog[ 2 ] == 0 ) );
+
+		vSemaphoreDelete( xSemaphore );
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+size_t xFreeBefore;
+
+	( void ) pvParameters;
+
+	printf( "work queues (%s)\n", ( configUSE_EDF_SCHEDULER == 1 ) ? "EDF" : "fixed priorities" );
+
+	/* Work queues are not deleted. */
+	xWorkQueue = xWorkQueueCreate( "worker", configMINIMAL_STACK_SIZE, benchWORKER_PRIORITY, benchLENGTH );
+	configASSERT( xWorkQueue );
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	prvCheckOrder();
+	prvCheckFull();
+	prvCheckTickSubmissions();
+
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+		prvCheckWaitingDeadlines();
+	#endif
+
+	/* Give the idle task the chance to free the helper tasks. */
+	vTaskDelay( 2 );
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvCreateTask( prvControlTask, "control", NULL, benchCONTROL_PRIORITY, NULL, benchCONTROL_PERIOD );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
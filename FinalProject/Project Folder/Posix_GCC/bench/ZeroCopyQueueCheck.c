@@ -0,0 +1,332 @@
+/*
+ * Check of the zero copy queues (build/bench/zerocopy).
+ *
+ * Checks that:
+ *
+ *   - the buffers of a queue are distinct and aligned, every one of them can
+ *     be acquired, and an acquire with none free fails at once with no block
+ *     time and times out with one;
+ *   - buffers are received in the order they were committed, holding what was
+ *     written in place, and can be released in any order;
+ *   - a sender blocked in pvQueueAcquire() is woken by a release, and a
+ *     receiver blocked in pvQueueReceiveZeroCopy() by a commit;
+ *   - a stream of messages from a sender to a receiver above it arrives whole
+ *     and in order;
+ *   - deleting the queue gives back all of its memory.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "Bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchLENGTH				( 4 )
+#define benchWORDS				( 13 )
+#define benchMESSAGES			( 500 )
+
+#define benchCONTROL_PRIORITY	( 2 )
+#define benchHELPER_PRIORITY	( 3 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct
+{
+	uint32_t ulSequence;
+	uint32_t ulWords[ benchWORDS ];
+} BenchMessage_t;
+
+/*-----------------------------------------------------------*/
+
+static ZeroCopyQueueHandle_t xQueue;
+static void * volatile pvHelperItem;
+static volatile BaseType_t xHelperDone;
+static volatile unsigned long ulReceived, ulWrong;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvAcquireTask( void * pvParameters );
+static void prvReceiveTask( void * pvParameters );
+static void prvStreamReceiveTask( void * pvParameters );
+static void prvFill( BenchMessage_t * pxMessage, uint32_t ulSequence );
+static BaseType_t prvIsWhole( const BenchMessage_t * pxMessage, uint32_t ulSequence );
+static void prvCheckBuffers( void );
+static void prvCheckBlocking( void );
+static void prvCheckStream( void );
+
+/*-----------------------------------------------------------*/
+
+static void prvFill( BenchMessage_t * pxMessage, uint32_t ulSequence )
+{
+UBaseType_t uxWord;
+
+	pxMessage->ulSequence = ulSequence;
+
+	for( uxWord = 0; uxWord < benchWORDS; uxWord++ )
+	{
+		pxMessage->ulWords[ uxWord ] = ( ulSequence << 8 ) | ( uint32_t ) uxWord;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsWhole( const BenchMessage_t * pxMessage, uint32_t ulSequence )
+{
+UBaseType_t uxWord;
+BaseType_t xReturn = pdTRUE;
+
+	if( pxMessage->ulSequence != ulSequence )
+	{
+		xReturn = pdFALSE;
+	}
+
+	for( uxWord = 0; uxWord < benchWORDS; uxWord++ )
+	{
+		if( pxMessage->ulWords[ uxWord ] != ( ( ulSequence << 8 ) | ( uint32_t ) uxWord ) )
+		{
+			xReturn = pdFALSE;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBuffers( void )
+{
+BenchMessage_t * pxBuffers[ benchLENGTH ];
+BenchMessage_t * pxMessage;
+UBaseType_t uxIndex, uxOther;
+TickType_t xStart;
+
+	/* Every buffer, each distinct and aligned, then none. */
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		pxBuffers[ uxIndex ] = pvQueueAcquire( xQueue, 0 );
+		benchCHECK( pxBuffers[ uxIndex ] != NULL );
+		benchCHECK( ( ( size_t ) pxBuffers[ uxIndex ] & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		for( uxOther = 0; uxOther < uxIndex; uxOther++ )
+		{
+			benchCHECK( pxBuffers[ uxOther ] != pxBuffers[ uxIndex ] );
+		}
+	}
+
+	benchCHECK( pvQueueAcquire( xQueue, 0 ) == NULL );
+	benchCHECK( pvQueueAcquireFromISR( xQueue ) == NULL );
+	xStart = xTaskGetTickCount();
+	benchCHECK( pvQueueAcquire( xQueue, 10 ) == NULL );
+	benchCHECK( ( xTaskGetTickCount() - xStart ) >= 10 );
+
+	/* Committed in an order of their own, received in that order. */
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		pxMessage = pxBuffers[ benchLENGTH - 1 - uxIndex ];
+		prvFill( pxMessage, ( uint32_t ) uxIndex );
+		benchCHECK( xQueueCommit( xQueue, pxMessage ) == pdPASS );
+	}
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		pxMessage = pvQueueReceiveZeroCopy( xQueue, 0 );
+		benchCHECK( pxMessage == pxBuffers[ benchLENGTH - 1 - uxIndex ] );
+
+		if( pxMessage != NULL )
+		{
+			benchCHECK( prvIsWhole( pxMessage, ( uint32_t ) uxIndex ) == pdTRUE );
+		}
+	}
+
+	benchCHECK( pvQueueReceiveZeroCopy( xQueue, 0 ) == NULL );
+	benchCHECK( pvQueueReceiveZeroCopyFromISR( xQueue ) == NULL );
+
+	/* Released out of order, every buffer can be acquired again. */
+	vQueueRelease( xQueue, pxBuffers[ 2 ] );
+	vQueueRelease( xQueue, pxBuffers[ 0 ] );
+	vQueueRelease( xQueue, pxBuffers[ 3 ] );
+	vQueueRelease( xQueue, pxBuffers[ 1 ] );
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		pxMessage = pvQueueAcquire( xQueue, 0 );
+		benchCHECK( pxMessage != NULL );
+
+		if( pxMessage != NULL )
+		{
+			vQueueRelease( xQueue, pxMessage );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvAcquireTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	pvHelperItem = pvQueueAcquire( xQueue, portMAX_DELAY );
+	xHelperDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveTask( void * pvParameters )
+{
+	( void ) pvParameters;
+
+	pvHelperItem = pvQueueReceiveZeroCopy( xQueue, portMAX_DELAY );
+	xHelperDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBlocking( void )
+{
+void * pvBuffers[ benchLENGTH ];
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		pvBuffers[ uxIndex ] = pvQueueAcquire( xQueue, 0 );
+		configASSERT( pvBuffers[ uxIndex ] );
+	}
+
+	/* The helpers run above this task, so they block as soon as they are
+	created and run again as soon as they are woken. */
+	xHelperDone = pdFALSE;
+	pvHelperItem = NULL;
+	xTaskCreate( prvAcquireTask, "acquire", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+	benchCHECK( xHelperDone == pdFALSE );
+	vQueueRelease( xQueue, pvBuffers[ 1 ] );
+	benchCHECK( xHelperDone == pdTRUE );
+	benchCHECK( pvHelperItem == pvBuffers[ 1 ] );
+
+	xHelperDone = pdFALSE;
+	pvHelperItem = NULL;
+	xTaskCreate( prvReceiveTask, "receive", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+	benchCHECK( xHelperDone == pdFALSE );
+	benchCHECK( xQueueCommit( xQueue, pvBuffers[ 2 ] ) == pdPASS );
+	benchCHECK( xHelperDone == pdTRUE );
+	benchCHECK( pvHelperItem == pvBuffers[ 2 ] );
+
+	for( uxIndex = 0; uxIndex < benchLENGTH; uxIndex++ )
+	{
+		vQueueRelease( xQueue, pvBuffers[ uxIndex ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamReceiveTask( void * pvParameters )
+{
+BenchMessage_t * pxMessage;
+uint32_t ulSequence;
+
+	( void ) pvParameters;
+
+	for( ulSequence = 0; ulSequence < benchMESSAGES; ulSequence++ )
+	{
+		pxMessage = pvQueueReceiveZeroCopy( xQueue, 100 );
+
+		if( pxMessage == NULL )
+		{
+			ulWrong++;
+			continue;
+		}
+
+		if( prvIsWhole( pxMessage, ulSequence ) == pdFALSE )
+		{
+			ulWrong++;
+		}
+
+		/* Scribble over the buffer, the sender must fill all of it again. */
+		prvFill( pxMessage, 0xffffffUL );
+		vQueueRelease( xQueue, pxMessage );
+		ulReceived++;
+
+		/* Let the sender get ahead now and then, so the queue fills. */
+		if( ( ulSequence % 50 ) == 0 )
+		{
+			vTaskDelay( 2 );
+		}
+	}
+
+	xHelperDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStream( void )
+{
+BenchMessage_t * pxMessage;
+uint32_t ulSequence;
+unsigned long ulAcquireFailed = 0;
+
+	xHelperDone = pdFALSE;
+	xTaskCreate( prvStreamReceiveTask, "stream", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, NULL );
+
+	for( ulSequence = 0; ulSequence < benchMESSAGES; ulSequence++ )
+	{
+		pxMessage = pvQueueAcquire( xQueue, 100 );
+
+		if( pxMessage == NULL )
+		{
+			ulAcquireFailed++;
+			continue;
+		}
+
+		prvFill( pxMessage, ulSequence );
+		( void ) xQueueCommit( xQueue, pxMessage );
+	}
+
+	vTaskDelay( 10 );
+	printf( "  %lu messages received, %lu wrong or missing, %lu acquires failed\n", ulReceived, ulWrong, ulAcquireFailed );
+	benchCHECK( xHelperDone == pdTRUE );
+	benchCHECK( ulReceived == benchMESSAGES );
+	benchCHECK( ulWrong == 0 );
+	benchCHECK( ulAcquireFailed == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+size_t xFreeBefore;
+
+	( void ) pvParameters;
+
+	printf( "zero copy queues\n" );
+
+	/* Let the idle task free anything left from starting up. */
+	vTaskDelay( 2 );
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	xQueue = xQueueCreateZeroCopy( benchLENGTH, sizeof( BenchMessage_t ) );
+	configASSERT( xQueue );
+
+	prvCheckBuffers();
+	prvCheckBlocking();
+	prvCheckStream();
+
+	vQueueDeleteZeroCopy( xQueue );
+
+	/* Give the idle task the chance to free the helper tasks. */
+	vTaskDelay( 2 );
+	benchCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	vBenchExit();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
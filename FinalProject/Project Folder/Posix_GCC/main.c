@@ -0,0 +1,855 @@
+/*
+ * FreeRTOS V202112.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Kernel-in-the-loop schedule runner.
+ *
+ * Reads a task set description, creates one periodic task per entry (with
+ * xTaskPeriodicCreate() when the EDF scheduler is built in, or xTaskCreate()
+ * otherwise), runs the kernel for the requested number of ticks, and prints
+ * the dispatch sequence and the completed jobs on stdout.  The output is
+ * compared against a reference schedule by FinalProject/Tools/schedverify.py.
+ *
+ * Time is virtual.  The port's interval timer is stopped as soon as the first
+ * task runs and the tick interrupt (SIGALRM) is raised by the running context
+ * instead: a task raises one tick for every tick of work it has to execute,
+ * and the idle hook raises ticks while nothing is ready.  The tick hook charges
+ * each tick to the task that raised it.  The resulting schedule is quantised
+ * to the tick, does not depend on the speed or the load of the host, and is
+ * exactly what the kernel decided to run.
+ *
+ * The task set file has one directive per line, all times in ticks:
+ *
+ *   duration <ticks>
+ *   task <name> <offset> <wcet> <period> <deadline> <priority>
+ *   resolution <units per tick>
+ *   overhead <context switch> <tick interrupt>
+ *   scheduler <EDF|FP>
+ *   semaphore <name>
+ *   take <task> <semaphore>
+ *   give <task> <semaphore> <units>
+ *
+ * Blank lines and lines starting with '#' are ignored.  Only duration and task
+ * are required.  scheduler names the kernel the set was written for, and the
+ * runner refuses a set for the other one.  With a resolution the wcet field and both overheads
+ * are given in that many units per tick: a job that completes part way
+ * through a tick hands the rest of the tick to the next task, as on the
+ * target, and every context switch and every tick interrupt consumes its
+ * overhead before any task makes progress.  All the times printed are then in
+ * units too, and a final line
+ *
+ *   units <resolution> <total> <overhead> <idle>
+ *
+ * tells how the simulated time was spent.
+ *
+ * A semaphore is a binary semaphore, created empty.  A task that takes one
+ * blocks on it at the start of each of its jobs, before it executes anything.
+ * A task that gives one gives it once each of its jobs has executed the given
+ * number of units (at most its wcet, several give lines make several gives),
+ * and then goes on with the job unless the give preempted it.  They are
+ * declared after the tasks and semaphores they name, and let a task set check
+ * the order in which the kernel wakes the tasks blocked on an event.
+ *
+ * The kernel's job time statistics (configGENERATE_JOB_TIME_STATS) use the
+ * virtual clock as run time counter.  They are printed per task as
+ *
+ *   jobtime <name> <period> <jobs> <min> <max> <mean> <bin0,bin1,...> <bin width>
+ *
+ * and can be turned into a SimSo task set with FinalProject/Tools/wcetstats.py.
+ *
+ * The critical sections and scheduler suspensions of the kernel and of the
+ * runner (configGENERATE_CRITICAL_SECTION_STATS) are timed in host nanoseconds
+ * and printed per call site, longest first, as
+ *
+ *   section <file:line> <crit|susp> <count> <max> <mean> <bin0,bin1,...> <first bin width>
+ *
+ * The allocations and frees of the heap (configGENERATE_HEAP_TRACE) come last,
+ * as written by vHeapTraceGetText(), preceded by the names of the tasks:
+ *
+ *   heaptask <handle> <name>
+ *   heapinfo ...
+ *   heap ...
+ *
+ * FinalProject/Tools/heaptrace.py replays them.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "heap_trace.h"
+
+/* Simulator includes. */
+#include "SchedTrace.h"
+
+/*-----------------------------------------------------------*/
+
+#define mainMAX_LINE_LEN		( 256 )
+
+/* Idle loop passes allowed before the idle hook lets a tick pass while some
+task still has work pending. */
+#define mainIDLE_SPINS_BEFORE_TICK	( 2 )
+
+/* Exit status when a tick of the real interval timer got through, see
+prvStartVirtualTime().  The run can simply be repeated. */
+#define mainEXIT_REAL_TICK			( 3 )
+
+/* Limits of the semaphore directives. */
+#define mainMAX_SEMAPHORES			( 8 )
+#define mainMAX_GIVES				( 8 )
+
+/*-----------------------------------------------------------*/
+/*                   User-Defined-Types			                 */
+/*-----------------------------------------------------------*/
+
+typedef struct SIM_SEMAPHORE
+{
+	char * pcName;
+	SemaphoreHandle_t xHandle;
+} SimSemaphore_t;
+
+typedef struct SIM_TASK
+{
+	char * pcName;
+	TickType_t xOffset;
+	TickType_t xWcet;				/*< In units, see ulResolution. */
+	TickType_t xPeriod;
+	TickType_t xDeadline;
+	UBaseType_t uxPriority;
+
+	/* Updated from the tick hook and prvExecute(). */
+	volatile TickType_t xBacklog;	/*< Released but not yet executed units. */
+	TickType_t xNextRelease;		/*< Tick of the next job release. */
+	TickType_t xCharged;			/*< Units executed by the oldest pending job. */
+	TickType_t xJobsDone;			/*< Number of completed jobs. */
+
+	/* Semaphores taken at the start of each job and given part way through,
+	after xGiveAt[] units in ascending order. */
+	SimSemaphore_t * pxTake;
+	SimSemaphore_t * pxGive[ mainMAX_GIVES ];
+	TickType_t xGiveAt[ mainMAX_GIVES ];
+	UBaseType_t uxGives;
+	BaseType_t xTaken;				/*< The current job has taken pxTake. */
+	SimSemaphore_t * pxGiveDue;		/*< Reached by prvExecute(), not yet given. */
+
+	TaskHandle_t xHandle;
+} SimTask_t;
+
+/*-----------------------------------------------------------*/
+/*                   User-Defined-Global-Variables           */
+/*-----------------------------------------------------------*/
+
+static SimTask_t xSimTasks[ schedtraceMAX_TASKS ];
+static UBaseType_t uxSimTaskCount = 0;
+static SimSemaphore_t xSimSemaphores[ mainMAX_SEMAPHORES ];
+static UBaseType_t uxSimSemaphoreCount = 0;
+static TickType_t xSimDuration = 0;
+static UBaseType_t uxIdleSpins = 0;
+static volatile BaseType_t xTickRaised = pdFALSE;
+
+/* Virtual time.  A tick is divided into ulResolution units, ulTickUsed of which
+have been consumed by tasks or overheads since the last tick interrupt. */
+static unsigned long ulResolution = 1;
+static unsigned long ulSwitchOverhead = 0;
+static unsigned long ulTickOverhead = 0;
+static TickType_t xSimTick = 0;
+static unsigned long ulTickUsed = 0;
+static unsigned long ulOverheadDue = 0;
+static unsigned long ulLastTag = ~0UL;
+
+/* Where the simulated time went, in units. */
+static unsigned long ulOverheadUnits = 0;
+static unsigned long ulIdleUnits = 0;
+
+/* See configJOB_TIME_HISTOGRAM_BIN_WIDTH, set from the longest wcet. */
+unsigned long ulSimHistogramBinWidth = 1;
+
+/*-----------------------------------------------------------*/
+/*                   User-Defined-Prototypes                 */
+/*-----------------------------------------------------------*/
+
+static int prvReadTaskSet( const char * pcFileName );
+static int prvReadSemaphoreUse( const char * pcLine );
+static SimTask_t * prvFindTask( const char * pcName );
+static SimSemaphore_t * prvFindSemaphore( const char * pcName );
+static int prvCreateTasks( void );
+static void prvPeriodicTask( void * pvParameters );
+static void prvStartVirtualTime( void );
+static unsigned long prvExecute( SimTask_t * pxTask );
+static void prvRaiseTick( void );
+static void prvPrintJobTimeStats( void );
+static void prvPrintCriticalSectionStats( void );
+static void prvPrintHeapTrace( void );
+
+/*-----------------------------------------------------------*/
+/*                   User-Defined-Tasks                      */
+/*-----------------------------------------------------------*/
+
+/*-----------------------------------------------------------
+** Task_Name: prvPeriodicTask
+** Task_Description: Executes the released work of one task set entry
+** Task_Periodicity: SimTask_t.xPeriod
+** Task_Independent_Execution_Time: SimTask_t.xWcet <units>
+------------------------------------------------------------*/
+static void prvPeriodicTask( void * pvParameters )
+{
+SimTask_t * pxTask = ( SimTask_t * ) pvParameters;
+TickType_t xLastWakeTime = 0;
+
+	prvStartVirtualTime();
+
+	if( pxTask->xOffset != 0 )
+	{
+		vTaskDelayUntil( &xLastWakeTime, pxTask->xOffset );
+
+		/* That was not a job. */
+		vTaskResetJobTimeStats( NULL );
+	}
+
+	for( ;; )
+	{
+		/* Execute what is left of the current tick, and raise the next tick
+		once it is used up, until all the released work is done.  The tick may
+		switch to another task, this one then continues from here when it is
+		selected again. */
+		while( pxTask->xBacklog != 0 )
+		{
+			if( ( pxTask->pxTake != NULL ) && ( pxTask->xTaken == pdFALSE ) )
+			{
+				( void ) xSemaphoreTake( pxTask->pxTake->xHandle, portMAX_DELAY );
+				pxTask->xTaken = pdTRUE;
+			}
+
+			if( prvExecute( pxTask ) == 0 )
+			{
+				prvRaiseTick();
+			}
+
+			/* Given outside the critical section so that a task it wakes
+			can preempt this one straight away. */
+			if( pxTask->pxGiveDue != NULL )
+			{
+				( void ) xSemaphoreGive( pxTask->pxGiveDue->xHandle );
+				pxTask->pxGiveDue = NULL;
+			}
+		}
+
+		/* Does not block if the next release has already passed, in which
+		case the job is late and the loop continues with it straight away. */
+		vTaskDelayUntil( &xLastWakeTime, pxTask->xPeriod );
+	}
+}
+
+/*-----------------------------------------------------------*/
+/*                   User-Defined-Functions                  */
+/*-----------------------------------------------------------*/
+
+static void prvStartVirtualTime( void )
+{
+static volatile BaseType_t xStarted = pdFALSE;
+struct itimerval xStop;
+
+	/* Called by the first context to run, which is normally well within the
+	first real tick period.  On a loaded host it may not be, the tick hook
+	then notices a tick nobody raised and the run is abandoned. */
+	if( xStarted == pdFALSE )
+	{
+		xStarted = pdTRUE;
+		memset( &xStop, 0, sizeof( xStop ) );
+		( void ) setitimer( ITIMER_REAL, &xStop, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRaiseTick( void )
+{
+	xTickRaised = pdTRUE;
+	raise( SIGALRM );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvExecute( SimTask_t * pxTask )
+{
+unsigned long ulBudget, ulWork = 0, ulOverhead;
+UBaseType_t uxGive = 0;
+
+	taskENTER_CRITICAL();
+	{
+		ulBudget = ulResolution - ulTickUsed;
+
+		/* Outstanding switch and tick overheads are paid first. */
+		ulOverhead = ( ulOverheadDue < ulBudget ) ? ulOverheadDue : ulBudget;
+		ulOverheadDue -= ulOverhead;
+		ulOverheadUnits += ulOverhead;
+		ulBudget -= ulOverhead;
+		ulTickUsed += ulOverhead;
+
+		/* Then the oldest pending job of the task, up to its completion or its
+		next give, whichever comes first. */
+		if( ( pxTask != NULL ) && ( pxTask->xBacklog != 0 ) )
+		{
+			ulWork = pxTask->xWcet - pxTask->xCharged;
+
+			while( ( uxGive < pxTask->uxGives ) && ( pxTask->xGiveAt[ uxGive ] <= pxTask->xCharged ) )
+			{
+				uxGive++;
+			}
+
+			if( ( uxGive < pxTask->uxGives ) && ( ulWork > pxTask->xGiveAt[ uxGive ] - pxTask->xCharged ) )
+			{
+				ulWork = pxTask->xGiveAt[ uxGive ] - pxTask->xCharged;
+			}
+
+			if( ulWork > ulBudget )
+			{
+				ulWork = ulBudget;
+			}
+
+			pxTask->xBacklog -= ulWork;
+			pxTask->xCharged += ulWork;
+			ulTickUsed += ulWork;
+
+			if( ( uxGive < pxTask->uxGives ) && ( pxTask->xGiveAt[ uxGive ] == pxTask->xCharged ) )
+			{
+				pxTask->pxGiveDue = pxTask->pxGive[ uxGive ];
+			}
+
+			if( pxTask->xCharged == pxTask->xWcet )
+			{
+				vSchedTraceJob( ( unsigned long ) ( pxTask - xSimTasks ) + 1UL,
+								( pxTask->xOffset + ( pxTask->xJobsDone * pxTask->xPeriod ) ) * ulResolution,
+								( xSimTick * ulResolution ) + ulTickUsed );
+				pxTask->xJobsDone++;
+				pxTask->xCharged = 0;
+				pxTask->xTaken = pdFALSE;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return ulWork;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimRunTimeCounter( void )
+{
+	return ( xSimTick * ulResolution ) + ulTickUsed;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimHostNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( unsigned long ) xNow.tv_sec * 1000000000UL ) + ( unsigned long ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+void vSimTaskSwitchedIn( unsigned long uxTag )
+{
+	/* Called from vTaskSwitchContext() on every tick, also when the same task
+	is selected again, which costs no switch. */
+	if( uxTag != ulLastTag )
+	{
+		ulLastTag = uxTag;
+		ulOverheadDue += ulSwitchOverhead;
+		vSchedTraceSwitchedIn( uxTag, ( xSimTick * ulResolution ) + ulTickUsed );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+UBaseType_t uxIndex;
+
+	prvStartVirtualTime();
+
+	/* Overheads are paid by whatever runs, the idle task included. */
+	( void ) prvExecute( NULL );
+
+	/* The idle task can be selected for an instant while work is pending,
+	under EDF when its deadline is earlier than that of the released jobs.  On
+	the target that costs a fraction of a tick, so give the idle loop another
+	pass to yield before letting a whole tick pass. */
+	for( uxIndex = 0; uxIndex < uxSimTaskCount; uxIndex++ )
+	{
+		if( xSimTasks[ uxIndex ].xBacklog != 0 )
+		{
+			if( uxIdleSpins++ < mainIDLE_SPINS_BEFORE_TICK )
+			{
+				return;
+			}
+
+			break;
+		}
+	}
+
+	prvRaiseTick();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+TickType_t xNow = xTaskGetTickCountFromISR();
+UBaseType_t uxIndex;
+SimTask_t * pxTask;
+
+	if( xTickRaised == pdFALSE )
+	{
+		fprintf( stderr, "real timer tick at %lu, virtual time was not started in time\n", ( unsigned long ) xNow );
+		_exit( mainEXIT_REAL_TICK );
+	}
+
+	xTickRaised = pdFALSE;
+	uxIdleSpins = 0;
+
+	/* Tasks only raise the tick once they have used it up, so whatever is
+	left of the elapsed tick was spent in the idle task. */
+	ulIdleUnits += ulResolution - ulTickUsed;
+	ulTickUsed = 0;
+	xSimTick = xNow;
+	ulOverheadDue += ulTickOverhead;
+
+	/* Release the jobs that become due at this tick. */
+	for( uxIndex = 0; uxIndex < uxSimTaskCount; uxIndex++ )
+	{
+		pxTask = &xSimTasks[ uxIndex ];
+
+		while( pxTask->xNextRelease <= xNow )
+		{
+			pxTask->xBacklog += pxTask->xWcet;
+			pxTask->xNextRelease += pxTask->xPeriod;
+		}
+	}
+
+	if( xNow >= xSimDuration )
+	{
+		vTaskEndScheduler();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintJobTimeStats( void )
+{
+TaskJobTimeStats_t xStats;
+UBaseType_t uxIndex, uxBin;
+
+	for( uxIndex = 0; uxIndex < uxSimTaskCount; uxIndex++ )
+	{
+		vTaskGetJobTimeStats( xSimTasks[ uxIndex ].xHandle, &xStats );
+
+		if( xStats.ulJobs == 0 )
+		{
+			continue;
+		}
+
+		printf( "jobtime %s %lu %lu %lu %lu %lu ", xSimTasks[ uxIndex ].pcName, ( unsigned long ) xStats.xPeriod,
+				( unsigned long ) xStats.ulJobs, ( unsigned long ) xStats.ulMinTime, ( unsigned long ) xStats.ulMaxTime,
+				( unsigned long ) ( xStats.ulTotalTime / xStats.ulJobs ) );
+
+		for( uxBin = 0; uxBin < configJOB_TIME_HISTOGRAM_BINS; uxBin++ )
+		{
+			printf( ( uxBin == 0 ) ? "%lu" : ",%lu", ( unsigned long ) xStats.ulHistogram[ uxBin ] );
+		}
+
+		printf( " %lu\n", ulSimHistogramBinWidth );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintCriticalSectionStats( void )
+{
+static TaskSectionStats_t xStats[ configCRITICAL_SECTION_SITES ];
+UBaseType_t uxCount, uxIndex, uxBin;
+const char * pcName;
+
+	uxCount = uxTaskGetCriticalSectionStats( xStats, configCRITICAL_SECTION_SITES );
+
+	for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+	{
+		pcName = ( xStats[ uxIndex ].pcFile != NULL ) ? strrchr( xStats[ uxIndex ].pcFile, '/' ) : NULL;
+		pcName = ( pcName != NULL ) ? pcName + 1 : ( ( xStats[ uxIndex ].pcFile != NULL ) ? xStats[ uxIndex ].pcFile : "other" );
+
+		printf( "section %s:%lu %s %lu %lu %lu ", pcName, ( unsigned long ) xStats[ uxIndex ].ulLine,
+				( xStats[ uxIndex ].eKind == eCriticalSection ) ? "crit" : "susp",
+				( unsigned long ) xStats[ uxIndex ].ulCount, ( unsigned long ) xStats[ uxIndex ].ulMaxTime,
+				( unsigned long ) ( xStats[ uxIndex ].ulTotalTime / xStats[ uxIndex ].ulCount ) );
+
+		for( uxBin = 0; uxBin < configCRITICAL_SECTION_HISTOGRAM_BINS; uxBin++ )
+		{
+			printf( ( uxBin == 0 ) ? "%lu" : ",%lu", ( unsigned long ) xStats[ uxIndex ].ulHistogram[ uxBin ] );
+		}
+
+		printf( " %lu\n", ( unsigned long ) configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintHeapTrace( void )
+{
+const size_t xLength = ( configHEAP_TRACE_LENGTH + 1 ) * heaptraceTEXT_LINE_LENGTH;
+char * pcText;
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < uxSimTaskCount; uxIndex++ )
+	{
+		printf( "heaptask %lx %s\n", ( unsigned long ) ( size_t ) xSimTasks[ uxIndex ].xHandle, xSimTasks[ uxIndex ].pcName );
+	}
+
+	pcText = malloc( xLength );
+
+	if( pcText != NULL )
+	{
+		vHeapTraceGetText( pcText, xLength );
+		fputs( pcText, stdout );
+		free( pcText );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int prvReadTaskSet( const char * pcFileName )
+{
+FILE * pxFile;
+char cLine[ mainMAX_LINE_LEN ];
+char cName[ mainMAX_LINE_LEN ];
+char cScheduler[ 4 ];
+unsigned long ulOffset, ulWcet, ulPeriod, ulDeadline, ulPriority, ulDuration;
+SimTask_t * pxTask;
+int iLine = 0, iReturn;
+
+	pxFile = fopen( pcFileName, "r" );
+
+	if( pxFile == NULL )
+	{
+		perror( pcFileName );
+		return -1;
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+	{
+		iLine++;
+
+		if( ( cLine[ 0 ] == '#' ) || ( cLine[ strspn( cLine, " \t\r\n" ) ] == '\0' ) )
+		{
+			continue;
+		}
+
+		if( sscanf( cLine, "duration %lu", &ulDuration ) == 1 )
+		{
+			xSimDuration = ( TickType_t ) ulDuration;
+		}
+		else if( sscanf( cLine, "resolution %lu", &ulResolution ) == 1 )
+		{
+			if( ulResolution == 0 )
+			{
+				fprintf( stderr, "%s:%d: invalid resolution\n", pcFileName, iLine );
+				break;
+			}
+		}
+		else if( sscanf( cLine, "overhead %lu %lu", &ulSwitchOverhead, &ulTickOverhead ) == 2 )
+		{
+			/* Checked against the resolution once the whole file is read. */
+		}
+		else if( sscanf( cLine, "scheduler %3s", cScheduler ) == 1 )
+		{
+			if( strcmp( cScheduler, ( configUSE_EDF_SCHEDULER == 1 ) ? "EDF" : "FP" ) != 0 )
+			{
+				fprintf( stderr, "%s:%d: the set is for the %s scheduler, this runner was built for %s\n", pcFileName, iLine,
+						 cScheduler, ( configUSE_EDF_SCHEDULER == 1 ) ? "EDF" : "FP" );
+				break;
+			}
+		}
+		else if( sscanf( cLine, "semaphore %255s", cName ) == 1 )
+		{
+			if( ( uxSimSemaphoreCount >= mainMAX_SEMAPHORES ) || ( prvFindSemaphore( cName ) != NULL ) )
+			{
+				fprintf( stderr, "%s:%d: duplicate semaphore or more than %d\n", pcFileName, iLine, mainMAX_SEMAPHORES );
+				break;
+			}
+
+			xSimSemaphores[ uxSimSemaphoreCount++ ].pcName = strdup( cName );
+		}
+		else if( ( strncmp( cLine, "take ", 5 ) == 0 ) || ( strncmp( cLine, "give ", 5 ) == 0 ) )
+		{
+			if( prvReadSemaphoreUse( cLine ) != 0 )
+			{
+				fprintf( stderr, "%s:%d: invalid '%.4s', unknown task or semaphore\n", pcFileName, iLine, cLine );
+				break;
+			}
+		}
+		else if( sscanf( cLine, "task %255s %lu %lu %lu %lu %lu", cName, &ulOffset, &ulWcet, &ulPeriod, &ulDeadline, &ulPriority ) == 6 )
+		{
+			if( uxSimTaskCount >= schedtraceMAX_TASKS )
+			{
+				fprintf( stderr, "%s:%d: more than %d tasks\n", pcFileName, iLine, schedtraceMAX_TASKS );
+				break;
+			}
+
+			if( ( ulWcet == 0 ) || ( ulPeriod == 0 ) || ( ulPriority >= configMAX_PRIORITIES ) )
+			{
+				fprintf( stderr, "%s:%d: invalid task parameters\n", pcFileName, iLine );
+				break;
+			}
+
+			pxTask = &xSimTasks[ uxSimTaskCount++ ];
+			pxTask->pcName = strdup( cName );
+			pxTask->xOffset = ( TickType_t ) ulOffset;
+			pxTask->xWcet = ( TickType_t ) ulWcet;
+			pxTask->xPeriod = ( TickType_t ) ulPeriod;
+			pxTask->xDeadline = ( TickType_t ) ulDeadline;
+			pxTask->uxPriority = ( UBaseType_t ) ulPriority;
+		}
+		else
+		{
+			fprintf( stderr, "%s:%d: cannot parse '%s'\n", pcFileName, iLine, cLine );
+			break;
+		}
+	}
+
+	iReturn = ( feof( pxFile ) && ( xSimDuration != 0 ) && ( uxSimTaskCount != 0 ) ) ? 0 : -1;
+	fclose( pxFile );
+
+	/* A tick interrupt that takes the whole tick leaves no time to run. */
+	if( ( iReturn == 0 ) && ( ulTickOverhead >= ulResolution ) )
+	{
+		fprintf( stderr, "%s: tick overhead must be less than the resolution\n", pcFileName );
+		iReturn = -1;
+	}
+
+	return iReturn;
+}
+/*-----------------------------------------------------------*/
+
+static int prvReadSemaphoreUse( const char * pcLine )
+{
+char cTask[ mainMAX_LINE_LEN ];
+char cSemaphore[ mainMAX_LINE_LEN ];
+unsigned long ulUnits;
+SimTask_t * pxTask;
+SimSemaphore_t * pxSemaphore;
+UBaseType_t uxIndex;
+
+	if( sscanf( pcLine, "take %255s %255s", cTask, cSemaphore ) == 2 )
+	{
+		pxTask = prvFindTask( cTask );
+		pxSemaphore = prvFindSemaphore( cSemaphore );
+
+		if( ( pxTask == NULL ) || ( pxSemaphore == NULL ) || ( pxTask->pxTake != NULL ) )
+		{
+			return -1;
+		}
+
+		pxTask->pxTake = pxSemaphore;
+		return 0;
+	}
+
+	if( sscanf( pcLine, "give %255s %255s %lu", cTask, cSemaphore, &ulUnits ) == 3 )
+	{
+		pxTask = prvFindTask( cTask );
+		pxSemaphore = prvFindSemaphore( cSemaphore );
+
+		if( ( pxTask == NULL ) || ( pxSemaphore == NULL ) || ( pxTask->uxGives >= mainMAX_GIVES ) ||
+			( ulUnits == 0 ) || ( ulUnits > pxTask->xWcet ) )
+		{
+			return -1;
+		}
+
+		/* Keep the gives in the order the job reaches them. */
+		for( uxIndex = pxTask->uxGives; ( uxIndex > 0 ) && ( pxTask->xGiveAt[ uxIndex - 1 ] > ulUnits ); uxIndex-- )
+		{
+			pxTask->xGiveAt[ uxIndex ] = pxTask->xGiveAt[ uxIndex - 1 ];
+			pxTask->pxGive[ uxIndex ] = pxTask->pxGive[ uxIndex - 1 ];
+		}
+
+		if( ( uxIndex > 0 ) && ( pxTask->xGiveAt[ uxIndex - 1 ] == ulUnits ) )
+		{
+			return -1;
+		}
+
+		pxTask->xGiveAt[ uxIndex ] = ( TickType_t ) ulUnits;
+		pxTask->pxGive[ uxIndex ] = pxSemaphore;
+		pxTask->uxGives++;
+		return 0;
+	}
+
+	return -1;
+}
+/*-----------------------------------------------------------*/
+
+static SimTask_t * prvFindTask( const char * pcName )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < uxSimTaskCount; uxIndex++ )
+	{
+		if( strcmp( xSimTasks[ uxIndex ].pcName, pcName ) == 0 )
+		{
+			return &xSimTasks[ uxIndex ];
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static SimSemaphore_t * prvFindSemaphore( const char * pcName )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < uxSimSemaphoreCount; uxIndex++ )
+	{
+		if( strcmp( xSimSemaphores[ uxIndex ].pcName, pcName ) == 0 )
+		{
+			return &xSimSemaphores[ uxIndex ];
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCreateTasks( void )
+{
+UBaseType_t uxIndex;
+SimTask_t * pxTask;
+TaskHandle_t xHandle;
+BaseType_t xReturn;
+unsigned long ulJobs = 0, ulLongest = 0;
+
+	for( uxIndex = 0; uxIndex < uxSimSemaphoreCount; uxIndex++ )
+	{
+		xSimSemaphores[ uxIndex ].xHandle = xSemaphoreCreateBinary();
+
+		if( xSimSemaphores[ uxIndex ].xHandle == NULL )
+		{
+			return -1;
+		}
+	}
+
+	for( uxIndex = 0; uxIndex < uxSimTaskCount; uxIndex++ )
+	{
+		pxTask = &xSimTasks[ uxIndex ];
+
+		/* Jobs released at tick zero are due before the first tick. */
+		if( pxTask->xOffset == 0 )
+		{
+			pxTask->xBacklog = pxTask->xWcet;
+			pxTask->xNextRelease = pxTask->xPeriod;
+		}
+		else
+		{
+			pxTask->xNextRelease = pxTask->xOffset;
+		}
+
+		ulJobs += ( xSimDuration / pxTask->xPeriod ) + 1;
+
+		if( pxTask->xWcet > ulLongest )
+		{
+			ulLongest = pxTask->xWcet;
+		}
+
+		#if configUSE_EDF_SCHEDULER == 1
+
+			xReturn = xTaskPeriodicCreate(
+								prvPeriodicTask,		/* Function that Implements the Task */
+								pxTask->pcName,			/* Task Descriptive Name */
+								configMINIMAL_STACK_SIZE,	/* Stack Word Size */
+								pxTask,					/* Address To passed Parameter */
+								1,						/* Priority, all EDF tasks share one */
+								&xHandle,				/* Used to pass out the the created task's handle . */
+								pxTask->xPeriod
+							);
+
+		#else
+
+			xReturn = xTaskCreate(
+								prvPeriodicTask,		/* Function that Implements the Task */
+								pxTask->pcName,			/* Task Descriptive Name */
+								configMINIMAL_STACK_SIZE,	/* Stack Word Size */
+								pxTask,					/* Address To passed Parameter */
+								pxTask->uxPriority,		/* Priority */
+								&xHandle				/* Used to pass out the the created task's handle . */
+							);
+
+		#endif
+
+		if( xReturn != pdPASS )
+		{
+			return -1;
+		}
+
+		vTaskSetApplicationTaskTag( xHandle, ( TaskHookFunction_t ) ( uxIndex + 1 ) );
+		pxTask->xHandle = xHandle;
+	}
+
+	/* The histogram spans twice the longest execution time, which leaves room
+	for the overheads. */
+	ulSimHistogramBinWidth = ( ( 2UL * ulLongest ) + configJOB_TIME_HISTOGRAM_BINS - 1UL ) / configJOB_TIME_HISTOGRAM_BINS;
+
+	/* Each tick can switch out of the running task and into another one, and
+	so can each job completion. */
+	return xSchedTraceInit( ( 2UL * ( xSimDuration + ulJobs ) ) + 16UL, ulJobs );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char ** argv )
+{
+	if( argc != 2 )
+	{
+		fprintf( stderr, "usage: %s <task set file>\n", argv[ 0 ] );
+		return 2;
+	}
+
+	if( ( prvReadTaskSet( argv[ 1 ] ) != 0 ) || ( prvCreateTasks() != 0 ) )
+	{
+		return 2;
+	}
+
+	/* Returns once the tick hook ends the scheduler after xSimDuration. */
+	vTaskStartScheduler();
+
+	vSchedTraceDump( stdout );
+
+	printf( "units %lu %lu %lu %lu\n", ulResolution, ( unsigned long ) xSimDuration * ulResolution,
+			ulOverheadUnits, ulIdleUnits );
+	prvPrintJobTimeStats();
+	prvPrintCriticalSectionStats();
+	prvPrintHeapTrace();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
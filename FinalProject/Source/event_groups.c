@@ -54,17 +54,24 @@
     #define eventUNBLOCKED_DUE_TO_BIT_SET    0x0200U
     #define eventWAIT_FOR_ALL_BITS           0x0400U
     #define eventEVENT_BITS_CONTROL_BYTES    0xff00U
+    #define eventNUMBER_OF_BITS              8U
 #else
     #define eventCLEAR_EVENTS_ON_EXIT_BIT    0x01000000UL
     #define eventUNBLOCKED_DUE_TO_BIT_SET    0x02000000UL
     #define eventWAIT_FOR_ALL_BITS           0x04000000UL
     #define eventEVENT_BITS_CONTROL_BYTES    0xff000000UL
+    #define eventNUMBER_OF_BITS              24U
 #endif
 
 typedef struct EventGroupDef_t
 {
     EventBits_t uxEventBits;
-    List_t xTasksWaitingForBits; /*< List of tasks waiting for a bit to be set. */
+    List_t xTasksWaitingForBits; /*< List of tasks waiting for a bit to be set.  With the waiter index, only the tasks waiting for any one of several bits. */
+
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        EventBits_t uxBitsWaitedForAny;                       /*< The bits waited for by the tasks in xTasksWaitingForBits, possibly some more. */
+        List_t xTasksWaitingForBit[ eventNUMBER_OF_BITS ];    /*< The other waiting tasks, each in the list of a bit that it needs and that is clear. */
+    #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxEventGroupNumber;
@@ -89,6 +96,33 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called with the scheduler suspended to block the calling task on the event
+ * group.  uxBitsToWaitFor includes the control bits.
+ */
+static void prvPlaceOnWaitingList( EventGroup_t * pxEventBits,
+                                   const EventBits_t uxBitsToWaitFor,
+                                   const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the task that owns pxListItem if the event bits now meet its wait
+ * condition, adding the bits it waited for to *puxBitsToClear if it asked for
+ * them to be cleared.  Returns pdTRUE if the task was unblocked.
+ */
+static BaseType_t prvUnblockTaskIfMatched( EventGroup_t * pxEventBits,
+                                           ListItem_t * pxListItem,
+                                           EventBits_t * puxBitsToClear ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+
+/*
+ * Returns the list of the lowest bit set in uxBits, which must not be 0.
+ */
+    static List_t * prvListForLowestBit( EventGroup_t * pxEventBits,
+                                         EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -118,6 +152,19 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+                {
+                    UBaseType_t uxBit;
+
+                    pxEventBits->uxBitsWaitedForAny = 0;
+
+                    for( uxBit = 0; uxBit < ( UBaseType_t ) eventNUMBER_OF_BITS; uxBit++ )
+                    {
+                        vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+                    }
+                }
+            #endif
+
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note that
@@ -169,6 +216,19 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+                {
+                    UBaseType_t uxBit;
+
+                    pxEventBits->uxBitsWaitedForAny = 0;
+
+                    for( uxBit = 0; uxBit < ( UBaseType_t ) eventNUMBER_OF_BITS; uxBit++ )
+                    {
+                        vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+                    }
+                }
+            #endif
+
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note this
@@ -235,7 +295,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                prvPlaceOnWaitingList( pxEventBits, ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                 /* This assignment is obsolete as uxReturn will get set after
                  * the task unblocks, but some compilers mistakenly generate a
@@ -394,7 +454,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             /* Store the bits that the calling task is waiting for in the
              * task's event list item so the kernel knows when a match is
              * found.  Then enter the blocked state. */
-            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            prvPlaceOnWaitingList( pxEventBits, ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
             /* This is obsolete as it will get set after the task unblocks, but
              * some compilers mistakenly generate a warning about the variable
@@ -536,9 +596,13 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
     ListItem_t * pxListItem, * pxNext;
     ListItem_t const * pxListEnd;
     List_t const * pxList;
-    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+    EventBits_t uxBitsToClear = 0;
     EventGroup_t * pxEventBits = xEventGroup;
-    BaseType_t xMatchFound = pdFALSE;
+
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        EventBits_t uxBitsToVisit, uxBitsWaitedForAny = 0, uxBitsStillClear;
+        UBaseType_t uxBit;
+    #endif
 
     /* Check the user is not attempting to set the bits used by the kernel
      * itself. */
@@ -551,69 +615,102 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
     {
         traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-        pxListItem = listGET_HEAD_ENTRY( pxList );
-
         /* Set the bits. */
         pxEventBits->uxEventBits |= uxBitsToSet;
 
-        /* See if the new bit value should unblock any tasks. */
-        while( pxListItem != pxListEnd )
-        {
-            pxNext = listGET_NEXT( pxListItem );
-            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-            xMatchFound = pdFALSE;
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+            {
+                /* A blocked task's wait condition was not met by the bits as
+                 * they were, so only the lists of the bits just set can hold tasks
+                 * that are now unblocked. */
+                uxBitsToVisit = uxBitsToSet;
 
-            /* Split the bits waited for from the control bits. */
-            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+                for( uxBit = 0; uxBitsToVisit != ( EventBits_t ) 0; uxBit++ )
+                {
+                    if( ( uxBitsToVisit & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+                    {
+                        pxListItem = listGET_HEAD_ENTRY( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+                        pxListEnd = listGET_END_MARKER( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+                        while( pxListItem != pxListEnd )
+                        {
+                            pxNext = listGET_NEXT( pxListItem );
+
+                            if( prvUnblockTaskIfMatched( pxEventBits, pxListItem, &uxBitsToClear ) == pdFALSE )
+                            {
+                                /* Waiting for all of its bits and another one is
+                                 * still clear, wait in the list of that bit.  It is
+                                 * not set by this call, so its list is not visited
+                                 * again below. */
+                                uxBitsStillClear = listGET_LIST_ITEM_VALUE( pxListItem ) & ~( pxEventBits->uxEventBits | eventEVENT_BITS_CONTROL_BYTES );
+                                ( void ) uxListRemove( pxListItem );
+                                vListInsertEnd( prvListForLowestBit( pxEventBits, uxBitsStillClear ), pxListItem );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            pxListItem = pxNext;
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-            {
-                /* Just looking for single bit being set. */
-                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+                    uxBitsToVisit >>= 1;
+                }
+
+                /* Tasks waiting for any one of several bits. */
+                if( ( uxBitsToSet & pxEventBits->uxBitsWaitedForAny ) != ( EventBits_t ) 0 )
                 {
-                    xMatchFound = pdTRUE;
+                    pxListItem = listGET_HEAD_ENTRY( pxList );
+                    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+                    while( pxListItem != pxListEnd )
+                    {
+                        pxNext = listGET_NEXT( pxListItem );
+
+                        if( prvUnblockTaskIfMatched( pxEventBits, pxListItem, &uxBitsToClear ) == pdFALSE )
+                        {
+                            uxBitsWaitedForAny |= listGET_LIST_ITEM_VALUE( pxListItem );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        pxListItem = pxNext;
+                    }
+
+                    /* Drop the bits of the tasks that were unblocked, and of
+                     * those that timed out since the last walk. */
+                    pxEventBits->uxBitsWaitedForAny = uxBitsWaitedForAny & ~eventEVENT_BITS_CONTROL_BYTES;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-            {
-                /* All bits are set. */
-                xMatchFound = pdTRUE;
-            }
-            else
+        #else /* if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) */
             {
-                /* Need all bits to be set, but not all the bits were set. */
-            }
+                pxListItem = listGET_HEAD_ENTRY( pxList );
 
-            if( xMatchFound != pdFALSE )
-            {
-                /* The bits match.  Should the bits be cleared on exit? */
-                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-                {
-                    uxBitsToClear |= uxBitsWaitedFor;
-                }
-                else
+                /* See if the new bit value should unblock any tasks. */
+                while( pxListItem != pxListEnd )
                 {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                    pxNext = listGET_NEXT( pxListItem );
 
-                /* Store the actual event flag value in the task's event list
-                 * item before removing the task from the event list.  The
-                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                 * that is was unblocked due to its required bits matching, rather
-                 * than because it timed out. */
-                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-            }
+                    ( void ) prvUnblockTaskIfMatched( pxEventBits, pxListItem, &uxBitsToClear );
 
-            /* Move onto the next list item.  Note pxListItem->pxNext is not
-             * used here as the list item may have been removed from the event list
-             * and inserted into the ready/pending reading list. */
-            pxListItem = pxNext;
-        }
+                    /* Move onto the next list item.  Note pxListItem->pxNext is not
+                     * used here as the list item may have been removed from the event list
+                     * and inserted into the ready/pending reading list. */
+                    pxListItem = pxNext;
+                }
+            }
+        #endif /* if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) */
 
         /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
          * bit was set in the control word. */
@@ -625,6 +722,126 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
 }
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvUnblockTaskIfMatched( EventGroup_t * pxEventBits,
+                                           ListItem_t * pxListItem,
+                                           EventBits_t * puxBitsToClear )
+{
+    EventBits_t uxBitsWaitedFor, uxControlBits;
+    BaseType_t xMatchFound = pdFALSE;
+
+    uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+
+    /* Split the bits waited for from the control bits. */
+    uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+    uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+    if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+    {
+        /* Just looking for single bit being set. */
+        if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+        {
+            xMatchFound = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+    {
+        /* All bits are set. */
+        xMatchFound = pdTRUE;
+    }
+    else
+    {
+        /* Need all bits to be set, but not all the bits were set. */
+    }
+
+    if( xMatchFound != pdFALSE )
+    {
+        /* The bits match.  Should the bits be cleared on exit? */
+        if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+        {
+            *puxBitsToClear |= uxBitsWaitedFor;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Store the actual event flag value in the task's event list
+         * item before removing the task from the event list.  The
+         * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+         * that is was unblocked due to its required bits matching, rather
+         * than because it timed out. */
+        vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xMatchFound;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPlaceOnWaitingList( EventGroup_t * pxEventBits,
+                                   const EventBits_t uxBitsToWaitFor,
+                                   const TickType_t xTicksToWait )
+{
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        {
+            const EventBits_t uxBits = uxBitsToWaitFor & ~eventEVENT_BITS_CONTROL_BYTES;
+            const EventBits_t uxBitsClear = uxBits & ~( pxEventBits->uxEventBits );
+            List_t * pxList;
+
+            if( ( ( uxBitsToWaitFor & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 ) && ( uxBitsClear != ( EventBits_t ) 0 ) )
+            {
+                /* Nothing can unblock the task before this bit is set. */
+                pxList = prvListForLowestBit( pxEventBits, uxBitsClear );
+            }
+            else if( ( uxBits & ( uxBits - ( EventBits_t ) 1 ) ) == ( EventBits_t ) 0 )
+            {
+                /* Waiting for a single bit, all or any is the same. */
+                pxList = prvListForLowestBit( pxEventBits, uxBits );
+            }
+            else
+            {
+                pxList = &( pxEventBits->xTasksWaitingForBits );
+                pxEventBits->uxBitsWaitedForAny |= uxBits;
+            }
+
+            vTaskPlaceOnUnorderedEventList( pxList, uxBitsToWaitFor, xTicksToWait );
+        }
+    #else
+        {
+            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), uxBitsToWaitFor, xTicksToWait );
+        }
+    #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+
+    static List_t * prvListForLowestBit( EventGroup_t * pxEventBits,
+                                         EventBits_t uxBits )
+    {
+        UBaseType_t uxBit = 0;
+
+        configASSERT( ( uxBits & ~eventEVENT_BITS_CONTROL_BYTES ) != ( EventBits_t ) 0 );
+
+        while( ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+        {
+            uxBits >>= 1;
+            uxBit++;
+        }
+
+        return &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+    }
+
+#endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+/*-----------------------------------------------------------*/
+
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
     EventGroup_t * pxEventBits = xEventGroup;
@@ -646,6 +863,22 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
             vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
         }
 
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+            {
+                UBaseType_t uxBit;
+
+                for( uxBit = 0; uxBit < ( UBaseType_t ) eventNUMBER_OF_BITS; uxBit++ )
+                {
+                    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+                    while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                    {
+                        vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                    }
+                }
+            }
+        #endif
+
         #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
             {
                 /* The event group can only have been allocated dynamically - free
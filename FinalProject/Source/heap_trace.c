@@ -0,0 +1,330 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_trace.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include heap tracing. */
+#if ( configGENERATE_HEAP_TRACE == 1 )
+
+    #if ( configHEAP_TRACE_LENGTH < 1 )
+        #error configHEAP_TRACE_LENGTH must be at least 1.
+    #endif
+
+/* Free byte counts above this are scaled down before they are multiplied by
+ * 1000 in prvFragmentation(). */
+    #define heaptraceMAX_UNSCALED    ( ( ~( size_t ) 0U ) / ( size_t ) 1000U )
+
+/* The ring of events.  uxNextEvent is where the next one goes and uxEventsHeld
+ * how many of those before it are valid. */
+    PRIVILEGED_DATA static HeapTraceEvent_t xEvents[ configHEAP_TRACE_LENGTH ];
+    PRIVILEGED_DATA static UBaseType_t uxNextEvent = 0U;
+    PRIVILEGED_DATA static UBaseType_t uxEventsHeld = 0U;
+
+    PRIVILEGED_DATA static HeapTraceStats_t xStats;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The share of xFreeBytes that is not in the largest free block, in
+ * thousandths.
+ */
+    static UBaseType_t prvFragmentation( size_t xFreeBytes,
+                                         size_t xLargestFreeBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Restarts the low water marks from the state of the heap after the last
+ * event.
+ */
+    static void prvResetMarks( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvFragmentation( size_t xFreeBytes,
+                                         size_t xLargestFreeBlock )
+    {
+        UBaseType_t uxFragmentation = 0U;
+
+        if( xFreeBytes != ( size_t ) 0U )
+        {
+            while( xFreeBytes > heaptraceMAX_UNSCALED )
+            {
+                xFreeBytes >>= 1;
+                xLargestFreeBlock >>= 1;
+            }
+
+            uxFragmentation = ( UBaseType_t ) ( ( ( xFreeBytes - xLargestFreeBlock ) * ( size_t ) 1000U ) / xFreeBytes );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxFragmentation;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvResetMarks( void )
+    {
+        xStats.xMinimumEverFreeBytes = xStats.xFreeBytes;
+        xStats.xMinimumEverLargestFreeBlock = xStats.xLargestFreeBlock;
+        xStats.uxMaximumEverFragmentation = xStats.uxFragmentation;
+        xStats.ulFailedMallocs = 0U;
+        xStats.xLargestFailedMalloc = 0U;
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceRecord( eHeapTraceEvent eEvent,
+                           void * pvAddress,
+                           size_t xSize,
+                           void * pvCaller,
+                           size_t xFreeBytes,
+                           size_t xLargestFreeBlock )
+    {
+        HeapTraceEvent_t * pxEvent = &( xEvents[ uxNextEvent ] );
+
+        pxEvent->ulTime = ( uint32_t ) portGET_HEAP_TRACE_TIME();
+        pxEvent->pvAddress = pvAddress;
+        pxEvent->pvCaller = pvCaller;
+        pxEvent->xTask = ( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED ) ? NULL : xTaskGetCurrentTaskHandle();
+        pxEvent->xSize = xSize;
+        pxEvent->xFreeBytes = xFreeBytes;
+        pxEvent->xLargestFreeBlock = xLargestFreeBlock;
+        pxEvent->ucEvent = ( uint8_t ) eEvent;
+
+        uxNextEvent++;
+
+        if( uxNextEvent >= ( UBaseType_t ) configHEAP_TRACE_LENGTH )
+        {
+            uxNextEvent = 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( uxEventsHeld < ( UBaseType_t ) configHEAP_TRACE_LENGTH )
+        {
+            uxEventsHeld++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xStats.xFreeBytes = xFreeBytes;
+        xStats.xLargestFreeBlock = xLargestFreeBlock;
+        xStats.uxFragmentation = prvFragmentation( xFreeBytes, xLargestFreeBlock );
+
+        if( xStats.ulEvents == 0U )
+        {
+            /* The heap is not initialised before the first allocation, so that
+             * is the first event seen. */
+            xStats.xHeapSize = xFreeBytes + ( ( eEvent == eHeapTraceMalloc ) ? xSize : ( size_t ) 0U );
+            prvResetMarks();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xStats.ulEvents++;
+
+        if( xFreeBytes < xStats.xMinimumEverFreeBytes )
+        {
+            xStats.xMinimumEverFreeBytes = xFreeBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xLargestFreeBlock < xStats.xMinimumEverLargestFreeBlock )
+        {
+            xStats.xMinimumEverLargestFreeBlock = xLargestFreeBlock;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xStats.uxFragmentation > xStats.uxMaximumEverFragmentation )
+        {
+            xStats.uxMaximumEverFragmentation = xStats.uxFragmentation;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( eEvent == eHeapTraceMallocFailed )
+        {
+            xStats.ulFailedMallocs++;
+
+            if( xSize > xStats.xLargestFailedMalloc )
+            {
+                xStats.xLargestFailedMalloc = xSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxHeapTraceGetEvents( HeapTraceEvent_t * pxEvents,
+                                      UBaseType_t uxMaxEvents,
+                                      uint32_t * pulFirstEvent )
+    {
+        UBaseType_t uxCount, uxIndex, uxSource;
+
+        /* The heaps record with the scheduler suspended. */
+        vTaskSuspendAll();
+        {
+            uxCount = ( uxMaxEvents < uxEventsHeld ) ? uxMaxEvents : uxEventsHeld;
+            uxSource = ( uxNextEvent + ( UBaseType_t ) configHEAP_TRACE_LENGTH - uxCount ) % ( UBaseType_t ) configHEAP_TRACE_LENGTH;
+
+            for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+            {
+                pxEvents[ uxIndex ] = xEvents[ uxSource ];
+                uxSource = ( uxSource + 1U ) % ( UBaseType_t ) configHEAP_TRACE_LENGTH;
+            }
+
+            if( pulFirstEvent != NULL )
+            {
+                *pulFirstEvent = xStats.ulEvents - ( uint32_t ) uxCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceGetStats( HeapTraceStats_t * pxStats )
+    {
+        vTaskSuspendAll();
+        {
+            *pxStats = xStats;
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceClear( void )
+    {
+        vTaskSuspendAll();
+        {
+            uxEventsHeld = 0U;
+            prvResetMarks();
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 )
+
+        void vHeapTraceGetText( char * pcWriteBuffer,
+                                size_t xBufferLength )
+        {
+            static const char * const pcEventNames[] = { "malloc", "free", "failed" };
+            const HeapTraceEvent_t * pxEvent;
+            UBaseType_t uxIndex, uxSource;
+            size_t xUsed;
+            int iLength;
+
+            configASSERT( ( pcWriteBuffer != NULL ) && ( xBufferLength > 0U ) );
+
+            vTaskSuspendAll();
+            {
+                iLength = snprintf( pcWriteBuffer, xBufferLength, "heapinfo %lu %lu %lu %lu %lu %lu\n",
+                                    ( unsigned long ) xStats.xHeapSize, ( unsigned long ) xStats.ulEvents,
+                                    ( unsigned long ) xStats.ulFailedMallocs, ( unsigned long ) xStats.xMinimumEverFreeBytes,
+                                    ( unsigned long ) xStats.xMinimumEverLargestFreeBlock,
+                                    ( unsigned long ) xStats.uxMaximumEverFragmentation );
+                xUsed = ( ( iLength > 0 ) && ( ( size_t ) iLength < xBufferLength ) ) ? ( size_t ) iLength : ( size_t ) 0U;
+                pcWriteBuffer[ xUsed ] = ( char ) 0x00;
+
+                uxSource = ( uxNextEvent + ( UBaseType_t ) configHEAP_TRACE_LENGTH - uxEventsHeld ) % ( UBaseType_t ) configHEAP_TRACE_LENGTH;
+
+                for( uxIndex = 0U; ( uxIndex < uxEventsHeld ) && ( xUsed != 0U ); uxIndex++ )
+                {
+                    pxEvent = &( xEvents[ uxSource ] );
+                    iLength = snprintf( &( pcWriteBuffer[ xUsed ] ), xBufferLength - xUsed, "heap %lu %lu %s %lx %lx %lx %lu %lu %lu\n",
+                                        ( unsigned long ) ( xStats.ulEvents - ( uint32_t ) ( uxEventsHeld - uxIndex ) ),
+                                        ( unsigned long ) pxEvent->ulTime, pcEventNames[ pxEvent->ucEvent ],
+                                        ( unsigned long ) ( size_t ) pxEvent->xTask, ( unsigned long ) ( size_t ) pxEvent->pvCaller,
+                                        ( unsigned long ) ( size_t ) pxEvent->pvAddress, ( unsigned long ) pxEvent->xSize,
+                                        ( unsigned long ) pxEvent->xFreeBytes, ( unsigned long ) pxEvent->xLargestFreeBlock );
+
+                    if( ( iLength > 0 ) && ( ( size_t ) iLength < ( xBufferLength - xUsed ) ) )
+                    {
+                        xUsed += ( size_t ) iLength;
+                    }
+                    else
+                    {
+                        /* Leave out the line that did not fit, and the rest. */
+                        pcWriteBuffer[ xUsed ] = ( char ) 0x00;
+                        break;
+                    }
+
+                    uxSource = ( uxSource + 1U ) % ( UBaseType_t ) configHEAP_TRACE_LENGTH;
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+    #endif /* configUSE_STATS_FORMATTING_FUNCTIONS */
+
+#endif /* configGENERATE_HEAP_TRACE */
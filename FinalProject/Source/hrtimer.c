@@ -0,0 +1,473 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hrtimer.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+
+/* This entire source file will be skipped if the application is not configured
+ * to include high resolution timers.  This #if is closed at the very bottom of
+ * this file.  If you want to include high resolution timers then ensure
+ * configUSE_HR_TIMERS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_HR_TIMERS == 1 )
+
+/* Counts are compared by the sign of their difference, which orders two
+ * counts across a wrap of the counter as long as they are less than half its
+ * range apart. */
+    #define hrtimerMAX_TIME    ( ( uint32_t ) 0x7fffffffUL )
+    #define hrtimerIS_BEFORE( ulTime, ulOther )    ( ( int32_t ) ( ( ulTime ) - ( ulOther ) ) < ( int32_t ) 0 )
+
+    typedef struct HrTimerDef_t
+    {
+        struct HrTimerDef_t * pxNext;                   /* The timer that expires after this one, while active. */
+        uint32_t ulExpiryTime;                          /* The count the timer expires at, while active. */
+        uint32_t ulPeriod;                              /* Zero for a one-shot timer. */
+        uint32_t ulOverruns;                            /* Expiries skipped since the timer was started. */
+        BaseType_t xActive;
+        HrTimerCallbackFunction_t pxCallbackFunction;
+        void * pvTimerID;
+    } HrTimer_t;
+
+/* The active timers, in the order they expire.  The compare channel is set to
+ * the expiry time of the first one.  Only changed with interrupts masked. */
+    PRIVILEGED_DATA static HrTimer_t * pxActiveTimers = NULL;
+
+/* pdTRUE while xHrTimerProcessCompare() calls callbacks.  The callbacks may
+ * start and stop timers, and the compare channel is set once, after the last
+ * of them. */
+    PRIVILEGED_DATA static BaseType_t xProcessingCompare = pdFALSE;
+
+    PRIVILEGED_DATA static BaseType_t xCounterIsSetUp = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts the timer into pxActiveTimers, after the timers that expire at the
+ * same count.  Must be called with interrupts masked, which it leaves masked
+ * for a walk of the active timers.
+ */
+    static void prvInsertTimer( HrTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes the timer from pxActiveTimers if it is active.  Must be called with
+ * interrupts masked.
+ */
+    static void prvRemoveTimer( HrTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets the compare channel to the expiry time of the first active timer, or
+ * disables it if there are none.  Must be called with interrupts masked.
+ */
+    static void prvSetCompare( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The parts of vHrTimerStart() and vHrTimerStop() common to their FromISR
+ * versions.  Must be called with interrupts masked.
+ */
+    static void prvStartTimer( HrTimer_t * const pxTimer,
+                               uint32_t ulDelay,
+                               uint32_t ulPeriod ) PRIVILEGED_FUNCTION;
+    static void prvStopTimer( HrTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes the first active timer if it expired at or before ulNow and returns
+ * it, having reinserted it at its first expiry after ulNow if it is periodic.
+ * Returns NULL if the first timer has not expired by ulNow.
+ */
+    static HrTimer_t * prvPopExpiredTimer( const uint32_t ulNow ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        HrTimerHandle_t xHrTimerCreate( HrTimerCallbackFunction_t pxCallbackFunction,
+                                        void * pvTimerID )
+        {
+            HrTimer_t * pxNewTimer;
+
+            configASSERT( pxCallbackFunction );
+
+            pxNewTimer = ( HrTimer_t * ) pvPortMalloc( sizeof( HrTimer_t ) );
+
+            if( pxNewTimer != NULL )
+            {
+                pxNewTimer->pxNext = NULL;
+                pxNewTimer->ulExpiryTime = 0U;
+                pxNewTimer->ulPeriod = 0U;
+                pxNewTimer->ulOverruns = 0U;
+                pxNewTimer->xActive = pdFALSE;
+                pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+                pxNewTimer->pvTimerID = pvTimerID;
+
+                /* The counter is set up by the first timer rather than when
+                 * the scheduler starts, so an application that has none leaves
+                 * it to itself. */
+                taskENTER_CRITICAL();
+                {
+                    if( xCounterIsSetUp == pdFALSE )
+                    {
+                        vPortHrTimerSetup();
+                        xCounterIsSetUp = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxNewTimer;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vHrTimerDelete( HrTimerHandle_t xTimer )
+    {
+        configASSERT( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            prvStopTimer( xTimer );
+        }
+        taskEXIT_CRITICAL();
+
+        vPortFree( ( void * ) xTimer );
+    }
+/*-----------------------------------------------------------*/
+
+    void vHrTimerStart( HrTimerHandle_t xTimer,
+                        uint32_t ulDelay,
+                        uint32_t ulPeriod )
+    {
+        configASSERT( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            prvStartTimer( xTimer, ulDelay, ulPeriod );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vHrTimerStartFromISR( HrTimerHandle_t xTimer,
+                               uint32_t ulDelay,
+                               uint32_t ulPeriod )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTimer );
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvStartTimer( xTimer, ulDelay, ulPeriod );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vHrTimerStop( HrTimerHandle_t xTimer )
+    {
+        configASSERT( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            prvStopTimer( xTimer );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vHrTimerStopFromISR( HrTimerHandle_t xTimer )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTimer );
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvStopTimer( xTimer );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xHrTimerIsTimerActive( HrTimerHandle_t xTimer )
+    {
+        BaseType_t xReturn;
+
+        configASSERT( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            xReturn = xTimer->xActive;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    } /*lint !e818 Can't be pointer to const due to the typedef. */
+/*-----------------------------------------------------------*/
+
+    void * pvHrTimerGetTimerID( HrTimerHandle_t xTimer )
+    {
+        configASSERT( xTimer );
+
+        return xTimer->pvTimerID;
+    } /*lint !e818 Can't be pointer to const due to the typedef. */
+/*-----------------------------------------------------------*/
+
+    uint32_t ulHrTimerGetOverrunCount( HrTimerHandle_t xTimer )
+    {
+        uint32_t ulReturn;
+
+        configASSERT( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            ulReturn = xTimer->ulOverruns;
+        }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
+    } /*lint !e818 Can't be pointer to const due to the typedef. */
+/*-----------------------------------------------------------*/
+
+    uint32_t ulHrTimerGetCount( void )
+    {
+        return ulPortHrTimerGetCount();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xHrTimerProcessCompare( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        HrTimer_t * pxTimer;
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t ulNow;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xProcessingCompare = pdTRUE;
+            ulNow = ulPortHrTimerGetCount();
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        /* Only the timers that had expired when the interrupt was entered are
+         * called back.  Those that expire while the callbacks run, including a
+         * periodic timer whose callback takes longer than its period, are left
+         * to the compare interrupt that prvSetCompare() raises straight away,
+         * so the callbacks cannot keep this interrupt from returning. */
+        for( pxTimer = prvPopExpiredTimer( ulNow ); pxTimer != NULL; pxTimer = prvPopExpiredTimer( ulNow ) )
+        {
+            pxTimer->pxCallbackFunction( pxTimer, &xHigherPriorityTaskWoken );
+        }
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xProcessingCompare = pdFALSE;
+            prvSetCompare();
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xHigherPriorityTaskWoken;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInsertTimer( HrTimer_t * const pxTimer )
+    {
+        HrTimer_t ** ppxPrevious = &pxActiveTimers;
+
+        while( ( *ppxPrevious != NULL ) && ( hrtimerIS_BEFORE( pxTimer->ulExpiryTime, ( *ppxPrevious )->ulExpiryTime ) == pdFALSE ) )
+        {
+            ppxPrevious = &( ( *ppxPrevious )->pxNext );
+        }
+
+        pxTimer->pxNext = *ppxPrevious;
+        *ppxPrevious = pxTimer;
+        pxTimer->xActive = pdTRUE;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRemoveTimer( HrTimer_t * const pxTimer )
+    {
+        HrTimer_t ** ppxPrevious = &pxActiveTimers;
+
+        if( pxTimer->xActive != pdFALSE )
+        {
+            while( *ppxPrevious != pxTimer )
+            {
+                ppxPrevious = &( ( *ppxPrevious )->pxNext );
+            }
+
+            *ppxPrevious = pxTimer->pxNext;
+            pxTimer->pxNext = NULL;
+            pxTimer->xActive = pdFALSE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSetCompare( void )
+    {
+        if( xProcessingCompare == pdFALSE )
+        {
+            if( pxActiveTimers != NULL )
+            {
+                /* The port raises the interrupt straight away if the counter
+                 * is already past the expiry time. */
+                vPortHrTimerSetCompare( pxActiveTimers->ulExpiryTime );
+            }
+            else
+            {
+                vPortHrTimerDisableCompare();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStartTimer( HrTimer_t * const pxTimer,
+                               uint32_t ulDelay,
+                               uint32_t ulPeriod )
+    {
+        const HrTimer_t * const pxFirstTimer = pxActiveTimers;
+
+        configASSERT( ulDelay <= hrtimerMAX_TIME );
+        configASSERT( ulPeriod <= hrtimerMAX_TIME );
+
+        prvRemoveTimer( pxTimer );
+        pxTimer->ulExpiryTime = ulPortHrTimerGetCount() + ulDelay;
+        pxTimer->ulPeriod = ulPeriod;
+        pxTimer->ulOverruns = 0U;
+        prvInsertTimer( pxTimer );
+
+        /* The compare channel only needs setting if the first timer changed,
+         * or if it is the timer that was restarted. */
+        if( ( pxFirstTimer == pxTimer ) || ( pxActiveTimers == pxTimer ) )
+        {
+            prvSetCompare();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStopTimer( HrTimer_t * const pxTimer )
+    {
+        if( pxActiveTimers == pxTimer )
+        {
+            prvRemoveTimer( pxTimer );
+            prvSetCompare();
+        }
+        else
+        {
+            prvRemoveTimer( pxTimer );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static HrTimer_t * prvPopExpiredTimer( const uint32_t ulNow )
+    {
+        HrTimer_t * pxTimer;
+        uint32_t ulLate, ulPeriodsLate;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxTimer = pxActiveTimers;
+
+            if( ( pxTimer != NULL ) && ( hrtimerIS_BEFORE( ulNow, pxTimer->ulExpiryTime ) == pdFALSE ) )
+            {
+                pxActiveTimers = pxTimer->pxNext;
+                pxTimer->pxNext = NULL;
+                pxTimer->xActive = pdFALSE;
+
+                if( pxTimer->ulPeriod != 0U )
+                {
+                    /* The next expiry is a whole number of periods on from
+                     * this one, so the latency of the interrupt does not
+                     * accumulate.  The expiries that have already passed are
+                     * skipped rather than called back late, in a burst. */
+                    ulLate = ulNow - pxTimer->ulExpiryTime;
+                    ulPeriodsLate = ulLate / pxTimer->ulPeriod;
+                    pxTimer->ulOverruns += ulPeriodsLate;
+                    pxTimer->ulExpiryTime += ( ulPeriodsLate + 1U ) * pxTimer->ulPeriod;
+
+                    /* Reinserted before the callback is called, so the
+                     * callback can stop it. */
+                    prvInsertTimer( pxTimer );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                pxTimer = NULL;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return pxTimer;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include high resolution timers.  If you want to include high resolution
+ * timers then ensure configUSE_HR_TIMERS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_HR_TIMERS == 1 */
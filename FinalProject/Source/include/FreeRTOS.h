@@ -828,6 +828,75 @@ void configTimer1(void);
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#ifndef configGENERATE_JOB_TIME_STATS
+    #define configGENERATE_JOB_TIME_STATS    0
+#endif
+
+#if ( configGENERATE_JOB_TIME_STATS == 1 )
+
+    #if ( configGENERATE_RUN_TIME_STATS != 1 )
+        #error configGENERATE_JOB_TIME_STATS requires configGENERATE_RUN_TIME_STATS, the job times are measured with the run time counter.
+    #endif
+
+    #if ( INCLUDE_xTaskDelayUntil != 1 )
+        #error configGENERATE_JOB_TIME_STATS requires INCLUDE_xTaskDelayUntil, a job ends when its task calls xTaskDelayUntil().
+    #endif
+
+/* Number of bins of the per task job time histogram.  The last bin also counts
+ * every longer job. */
+    #ifndef configJOB_TIME_HISTOGRAM_BINS
+        #define configJOB_TIME_HISTOGRAM_BINS    16
+    #endif
+
+/* Width of one histogram bin in run time counter units. */
+    #ifndef configJOB_TIME_HISTOGRAM_BIN_WIDTH
+        #define configJOB_TIME_HISTOGRAM_BIN_WIDTH    1
+    #endif
+
+#endif /* configGENERATE_JOB_TIME_STATS */
+
+#ifndef configGENERATE_CRITICAL_SECTION_STATS
+    #define configGENERATE_CRITICAL_SECTION_STATS    0
+#endif
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/* Time stamp used to measure critical sections and scheduler suspensions.  It
+ * is read twice per outermost section, so it should be cheap and at least as
+ * fine as the sections of interest.  Only differences are used, so it may
+ * wrap. */
+    #ifndef portGET_CRITICAL_SECTION_TIME
+        #if ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE )
+            #define portGET_CRITICAL_SECTION_TIME()    portGET_RUN_TIME_COUNTER_VALUE()
+        #else
+            #error configGENERATE_CRITICAL_SECTION_STATS requires portGET_CRITICAL_SECTION_TIME() to be defined in FreeRTOSConfig.h.
+        #endif
+    #endif
+
+/* Number of call sites that are recorded separately.  The sections entered
+ * from any further site are all counted in the last one. */
+    #ifndef configCRITICAL_SECTION_SITES
+        #define configCRITICAL_SECTION_SITES    16
+    #endif
+
+/* Number of bins of the per site duration histogram.  The first bin counts the
+ * sections shorter than configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH, every
+ * further bin is twice as wide as the one before and the last bin also counts
+ * every longer section. */
+    #ifndef configCRITICAL_SECTION_HISTOGRAM_BINS
+        #define configCRITICAL_SECTION_HISTOGRAM_BINS    8
+    #endif
+
+    #ifndef configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH
+        #define configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH    1
+    #endif
+
+    #if ( configCRITICAL_SECTION_SITES > 255 )
+        #error configCRITICAL_SECTION_SITES must not be greater than 255.
+    #endif
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -876,6 +945,100 @@ void configTimer1(void);
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_ZERO_COPY_QUEUES
+    #define configUSE_ZERO_COPY_QUEUES    0
+#endif
+
+#if ( ( configUSE_ZERO_COPY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+    #error configUSE_ZERO_COPY_QUEUES requires configSUPPORT_DYNAMIC_ALLOCATION, the buffers are allocated when the queue is created.
+#endif
+
+/* Set to 1 to give every event group a waiting list per event bit, so that
+ * xEventGroupSetBits() only looks at the tasks that wait for the bits it sets.
+ * It costs a List_t per bit (8 or 24 of them) in each event group. */
+#ifndef configUSE_EVENT_GROUP_WAITER_INDEX
+    #define configUSE_EVENT_GROUP_WAITER_INDEX    0
+#endif
+
+/* Set to 1 to keep active software timers in a hierarchical timing wheel
+ * instead of two sorted lists, so that starting, stopping and resetting a timer
+ * does not walk the other timers.  The wheel has 2^configTIMER_WHEEL_SLOT_BITS
+ * slots per level and as many levels as it takes to cover a TickType_t, each
+ * slot being a List_t. */
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+    #define configTIMER_WHEEL_SLOT_BITS    4
+#endif
+
+#if ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) )
+    #error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5, each level keeps its slots in a 32-bit bitmap.
+#endif
+
+/* Set to 1 to keep tasks that block for fewer than
+ * 2^configDELAYED_TASK_WHEEL_SLOT_BITS ticks in a timing wheel, one List_t per
+ * tick, instead of inserting them into the sorted delayed task list.  Longer
+ * delays still use the delayed task lists. */
+#ifndef configUSE_DELAYED_TASK_WHEEL
+    #define configUSE_DELAYED_TASK_WHEEL    0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOT_BITS
+    #define configDELAYED_TASK_WHEEL_SLOT_BITS    6
+#endif
+
+#if ( ( configDELAYED_TASK_WHEEL_SLOT_BITS < 1 ) || ( configDELAYED_TASK_WHEEL_SLOT_BITS > 10 ) )
+    #error configDELAYED_TASK_WHEEL_SLOT_BITS must be between 1 and 10, the slots are found through a two level 32-bit bitmap.
+#endif
+
+/* Set to 1 to allow software timers to run their callbacks from the tick
+ * interrupt instead of the timer service task, see vTimerSetIsrCallback().
+ * Commands for such timers do not go through the timer command queue but
+ * through a lock-free ring of configTIMER_ISR_COMMAND_QUEUE_LENGTH entries,
+ * which must be a power of two. */
+#ifndef configUSE_TIMER_ISR_CALLBACKS
+    #define configUSE_TIMER_ISR_CALLBACKS    0
+#endif
+
+#ifndef configTIMER_ISR_COMMAND_QUEUE_LENGTH
+    #define configTIMER_ISR_COMMAND_QUEUE_LENGTH    8
+#endif
+
+#if ( ( configTIMER_ISR_COMMAND_QUEUE_LENGTH < 1 ) || ( ( configTIMER_ISR_COMMAND_QUEUE_LENGTH & ( configTIMER_ISR_COMMAND_QUEUE_LENGTH - 1 ) ) != 0 ) )
+    #error configTIMER_ISR_COMMAND_QUEUE_LENGTH must be a power of two.
+#endif
+
+/* Set to 1 to have a software timer keep only the latest command sent to it
+ * until the timer service task processes it, instead of queueing every command
+ * in the timer command queue.  The timer service task then processes a batch
+ * of commands each time it runs, one per timer, and timer commands cannot fail
+ * or block however fast they are sent.  The timer command queue still carries
+ * pended function calls. */
+#ifndef configUSE_TIMER_COMMAND_COALESCING
+    #define configUSE_TIMER_COMMAND_COALESCING    0
+#endif
+
+/* Set to 1 to allow software timers to expire up to a set number of ticks
+ * late, see vTimerSetSlack(), so the timer service task can expire nearby
+ * timers together and wakes less often. */
+#ifndef configUSE_TIMER_SLACK
+    #define configUSE_TIMER_SLACK    0
+#endif
+
+/* Set to 1 to build hrtimer.c, timers that expire at a count of a free running
+ * hardware counter instead of at a tick, see hrtimer.h.  The port provides the
+ * counter and a compare channel on it (see vPortHrTimerSetup() in portable.h),
+ * and configHR_TIMER_COUNTS_PER_SECOND is the rate it counts at. */
+#ifndef configUSE_HR_TIMERS
+    #define configUSE_HR_TIMERS    0
+#endif
+
+#ifndef configHR_TIMER_COUNTS_PER_SECOND
+    #define configHR_TIMER_COUNTS_PER_SECOND    1000000UL
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -928,6 +1091,58 @@ void configTimer1(void);
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
 
+/* heap_6.c keeps free blocks in lists for size classes up to
+ * 2 ^ configHEAP_6_MAX_BLOCK_SIZE_LOG2 bytes.  Each power of two it covers
+ * costs 16 list heads.  Larger heap regions are split into blocks smaller than
+ * that. */
+#ifndef configHEAP_6_MAX_BLOCK_SIZE_LOG2
+    #define configHEAP_6_MAX_BLOCK_SIZE_LOG2    24
+#endif
+
+#ifndef configGENERATE_HEAP_TRACE
+    #define configGENERATE_HEAP_TRACE    0
+#endif
+
+#if ( configGENERATE_HEAP_TRACE == 1 )
+
+    #if ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 )
+        #error configGENERATE_HEAP_TRACE requires INCLUDE_xTaskGetSchedulerState, the allocations made before the scheduler starts belong to no task.
+    #endif
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 )
+        #error configGENERATE_HEAP_TRACE requires INCLUDE_xTaskGetCurrentTaskHandle, every event records the task that caused it.
+    #endif
+
+/* Number of allocation and free events kept, see heap_trace.h.  Once they are
+ * all used the oldest one is overwritten. */
+    #ifndef configHEAP_TRACE_LENGTH
+        #define configHEAP_TRACE_LENGTH    64
+    #endif
+
+/* Time stamp of each event.  The tick count is used when there is no run time
+ * counter. */
+    #ifndef portGET_HEAP_TRACE_TIME
+        #if ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE )
+            #define portGET_HEAP_TRACE_TIME()    portGET_RUN_TIME_COUNTER_VALUE()
+        #else
+            #define portGET_HEAP_TRACE_TIME()    xTaskGetTickCount()
+        #endif
+    #endif
+
+/* Return address of pvPortMalloc() and vPortFree(), recorded as the call site
+ * of each event.  NULL where the compiler cannot tell. */
+    #ifndef portGET_HEAP_TRACE_CALLER
+        #if defined( __GNUC__ )
+            #define portGET_HEAP_TRACE_CALLER()    __builtin_return_address( 0 )
+        #elif defined( __CC_ARM )
+            #define portGET_HEAP_TRACE_CALLER()    ( ( void * ) __return_address() )
+        #else
+            #define portGET_HEAP_TRACE_CALLER()    NULL
+        #endif
+    #endif
+
+#endif /* configGENERATE_HEAP_TRACE */
+
 #ifndef configUSE_TASK_NOTIFICATIONS
     #define configUSE_TASK_NOTIFICATIONS    1
 #endif
@@ -1320,6 +1535,7 @@ typedef struct xSTATIC_QUEUE
 
     #if ( configUSE_QUEUE_SETS == 1 )
         void * pvDummy7;
+        UBaseType_t uxDummy7;
     #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -1348,6 +1564,11 @@ typedef struct xSTATIC_EVENT_GROUP
     TickType_t xDummy1;
     StaticList_t xDummy2;
 
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        TickType_t xDummy5;
+        StaticList_t xDummy6[ ( configUSE_16_BIT_TICKS == 1 ) ? 8 : 24 ];
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
     #endif
@@ -1381,6 +1602,14 @@ typedef struct xSTATIC_TIMER
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy7;
     #endif
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+        void * pvDummy9;
+        TickType_t xDummy10[ 2 ];
+        BaseType_t xDummy11;
+    #endif
+    #if ( configUSE_TIMER_SLACK == 1 )
+        TickType_t xDummy12[ 2 ];
+    #endif
     uint8_t ucDummy8;
 } StaticTimer_t;
 
@@ -1411,6 +1640,20 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with the above, the structure that holds a memory pool created with
+ * xMemPoolCreateStatic(), see mem_pool.h.
+ */
+typedef struct xSTATIC_MEM_POOL
+{
+    uint32_t ulDummy1[ 3 ];
+    StaticList_t xDummy2;
+    void * pvDummy3;
+    size_t xDummy4;
+    UBaseType_t uxDummy5;
+    uint8_t ucDummy6;
+} StaticMemPool_t;
+
 
 
 
@@ -32,7 +32,9 @@
  *
  * This file implements atomic functions by disabling interrupts globally.
  * Implementations with architecture specific atomic instructions can be
- * provided under each compiler directory.
+ * provided under each compiler directory.  A port that defines
+ * portATOMIC_COMPARE_AND_SWAP_U32() in portmacro.h gets a real
+ * Atomic_CompareAndSwap_u32().
  */
 
 #ifndef ATOMIC_H
@@ -113,19 +115,25 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
 {
     uint32_t ulReturnValue;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        if( *pulDestination == ulComparand )
+    #if defined( portATOMIC_COMPARE_AND_SWAP_U32 )
+        /* The port has a compare-and-swap instruction, interrupts stay
+         * enabled. */
+        ulReturnValue = portATOMIC_COMPARE_AND_SWAP_U32( pulDestination, ulExchange, ulComparand );
+    #else
+        ATOMIC_ENTER_CRITICAL();
         {
-            *pulDestination = ulExchange;
-            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            if( *pulDestination == ulComparand )
+            {
+                *pulDestination = ulExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+            else
+            {
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+            }
         }
-        else
-        {
-            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
-        }
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_EXIT_CRITICAL();
+    #endif
 
     return ulReturnValue;
 }
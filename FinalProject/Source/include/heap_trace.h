@@ -0,0 +1,204 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Heap tracing records every call to pvPortMalloc() and vPortFree() of
+ * heap_1.c, heap_2.c, heap_4.c, heap_5.c and heap_6.c in a ring of
+ * configHEAP_TRACE_LENGTH events, together with the free bytes and the size of
+ * the largest free block left after it.  The ring keeps the most recent
+ * events, while the low water marks of HeapTraceStats_t cover all of them.
+ *
+ * Set configGENERATE_HEAP_TRACE to 1 in FreeRTOSConfig.h and build heap_trace.c
+ * to enable it.  An event takes 32 bytes on a 32 bit target.  The heaps record
+ * with the scheduler suspended, which they are in anyway, but finding the
+ * largest free block walks the whole free list in heap_2.c, heap_4.c and
+ * heap_5.c, so each call takes longer the more fragmented the heap is.
+ * heap_6.c only walks the list of its largest size class.
+ *
+ * The text written by vHeapTraceGetText() is read by
+ * FinalProject/Tools/heaptrace.py, which replays the events to show the peak
+ * usage of each task and the fragmentation over time, and suggests a size for
+ * configTOTAL_HEAP_SIZE.
+ */
+
+#ifndef HEAP_TRACE_H
+#define HEAP_TRACE_H
+
+#ifndef INC_TASK_H
+    #error "include FreeRTOS.h and task.h must appear in source files before include heap_trace.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Room needed by one line of vHeapTraceGetText(). */
+#define heaptraceTEXT_LINE_LENGTH    ( 192U )
+
+typedef enum
+{
+    eHeapTraceMalloc = 0,   /* A block was allocated. */
+    eHeapTraceFree,         /* A block was returned. */
+    eHeapTraceMallocFailed  /* pvPortMalloc() returned NULL. */
+} eHeapTraceEvent;
+
+typedef struct xHEAP_TRACE_EVENT
+{
+    uint32_t ulTime;           /* portGET_HEAP_TRACE_TIME() when the event was recorded. */
+    void * pvAddress;          /* The address returned by pvPortMalloc() or passed to vPortFree(), NULL for a failed allocation. */
+    void * pvCaller;           /* The code that called pvPortMalloc() or vPortFree(), see portGET_HEAP_TRACE_CALLER(). */
+    TaskHandle_t xTask;        /* The running task, NULL before the scheduler was started. */
+    size_t xSize;              /* The size of the block, including the heap's own header and padding.  The requested size for a failed allocation. */
+    size_t xFreeBytes;         /* The free bytes left after the event. */
+    size_t xLargestFreeBlock;  /* The size of the largest free block left after the event. */
+    uint8_t ucEvent;           /* An eHeapTraceEvent. */
+} HeapTraceEvent_t;
+
+typedef struct xHEAP_TRACE_STATS
+{
+    size_t xHeapSize;                      /* The free bytes before the first allocation. */
+    size_t xFreeBytes;                     /* The free bytes now. */
+    size_t xMinimumEverFreeBytes;
+    size_t xLargestFreeBlock;              /* The size of the largest free block now. */
+    size_t xMinimumEverLargestFreeBlock;
+    UBaseType_t uxFragmentation;           /* The share of the free bytes outside the largest free block now, in thousandths. */
+    UBaseType_t uxMaximumEverFragmentation;
+    uint32_t ulEvents;                     /* The number of events recorded, including those overwritten since. */
+    uint32_t ulFailedMallocs;
+    size_t xLargestFailedMalloc;           /* The largest size that pvPortMalloc() failed to allocate. */
+} HeapTraceStats_t;
+
+/*
+ * Called by the heaps, with the scheduler suspended, after each allocation,
+ * failed allocation and free.  Not for use by the application.
+ */
+void vHeapTraceRecord( eHeapTraceEvent eEvent,
+                       void * pvAddress,
+                       size_t xSize,
+                       void * pvCaller,
+                       size_t xFreeBytes,
+                       size_t xLargestFreeBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * UBaseType_t uxHeapTraceGetEvents( HeapTraceEvent_t * pxEvents, UBaseType_t uxMaxEvents, uint32_t * pulFirstEvent );
+ * @endcode
+ *
+ * Copies the most recent events, oldest first.
+ *
+ * @param pxEvents The array the events are copied to.
+ *
+ * @param uxMaxEvents The length of pxEvents.
+ *
+ * @param pulFirstEvent Set to the number of the first event copied, the events
+ * being numbered from 0 in the order they were recorded.  A gap to the number
+ * of the last event seen before means events were overwritten.  May be NULL.
+ *
+ * @return The number of events copied, at most configHEAP_TRACE_LENGTH.
+ *
+ * \defgroup uxHeapTraceGetEvents uxHeapTraceGetEvents
+ * \ingroup HeapTrace
+ */
+UBaseType_t uxHeapTraceGetEvents( HeapTraceEvent_t * pxEvents,
+                                  UBaseType_t uxMaxEvents,
+                                  uint32_t * pulFirstEvent ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * void vHeapTraceGetStats( HeapTraceStats_t * pxStats );
+ * @endcode
+ *
+ * Copies the low water marks kept over all the events recorded.
+ *
+ * \defgroup vHeapTraceGetStats vHeapTraceGetStats
+ * \ingroup HeapTrace
+ */
+void vHeapTraceGetStats( HeapTraceStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * void vHeapTraceClear( void );
+ * @endcode
+ *
+ * Drops the recorded events and restarts the low water marks from the state
+ * of the heap now, for example once the application has finished creating its
+ * tasks and queues.  The event numbers keep counting.
+ *
+ * \defgroup vHeapTraceClear vHeapTraceClear
+ * \ingroup HeapTrace
+ */
+void vHeapTraceClear( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * void vHeapTraceGetText( char * pcWriteBuffer, size_t xBufferLength );
+ * @endcode
+ *
+ * configUSE_STATS_FORMATTING_FUNCTIONS must be defined as 1 for this function
+ * to be available.
+ *
+ * Writes the statistics and the recorded events as text, one line each:
+ *
+ *  heapinfo <heap size> <events> <failed mallocs> <min ever free> <min ever largest free block> <max ever fragmentation>
+ *  heap <event number> <time> <malloc|free|failed> <task> <caller> <address> <size> <free> <largest free block>
+ *
+ * with the task, caller and address in hexadecimal.  The most recent events
+ * that do not fit in xBufferLength are left out, so a buffer of
+ * ( configHEAP_TRACE_LENGTH + 1 ) * heaptraceTEXT_LINE_LENGTH bytes holds all
+ * of them.  The scheduler is suspended while the text is written.
+ *
+ * The tasks are written as their handles.  The application can name them with
+ * further lines of the form
+ *
+ *  heaptask <task> <name>
+ *
+ * \defgroup vHeapTraceGetText vHeapTraceGetText
+ * \ingroup HeapTrace
+ */
+#if ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 )
+    void vHeapTraceGetText( char * pcWriteBuffer,
+                            size_t xBufferLength ) PRIVILEGED_FUNCTION;
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( HEAP_TRACE_H ) */
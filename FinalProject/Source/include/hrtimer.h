@@ -0,0 +1,340 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * High resolution timers expire at a count of a free running hardware counter
+ * instead of at a tick, so they are as precise as the counter whatever
+ * configTICK_RATE_HZ is.  The counter counts at configHR_TIMER_COUNTS_PER_SECOND
+ * and all the timers share one compare channel on it, which is always set to
+ * the earliest expiry time, so the hardware interrupts once per expiry and not
+ * periodically.  The port provides the counter and the compare channel, see
+ * vPortHrTimerSetup() in portable.h.  Software timers (timers.h), including
+ * those whose callbacks run from the tick interrupt, are not driven by the
+ * counter and keep expiring on ticks.
+ *
+ * ***NOTE***:  The callbacks run in the compare interrupt, with the other
+ * interrupts of its priority held off, so they must be short and may only call
+ * the FromISR API functions.  A callback that unblocks a task passes on the
+ * pxHigherPriorityTaskWoken it is given, and the port switches to that task
+ * when the interrupt returns.
+ *
+ * Each compare interrupt calls back only the timers that had expired when it
+ * was entered, and the timers that expire while it runs raise it again as
+ * soon as it returns.  The period of a periodic timer must therefore be longer
+ * than the time taken by its callback, and by the callbacks of the timers
+ * that expire with it.  Otherwise the interrupt is raised again each time it
+ * returns, leaving nothing of its priority or below time to run, and the
+ * expiries that cannot be kept up with are skipped and counted by
+ * ulHrTimerGetOverrunCount().
+ *
+ * The active timers are kept in a list sorted by expiry time.  Starting a
+ * timer, and each expiry of a periodic timer, walks that list with interrupts
+ * masked, which takes time proportional to the number of active timers and
+ * adds to the latency of every interrupt masked with it.  High resolution
+ * timers suit a few timers that need the precision, software timers
+ * (timers.h) suit many.
+ *
+ * Times are counts of the counter and must be less than 2^31 counts, so they
+ * can be compared across a wrap of the 32-bit counter.  hrtimerUS_TO_COUNTS()
+ * converts microseconds.
+ */
+
+#ifndef HRTIMER_H
+#define HRTIMER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include hrtimer.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Converts a time in microseconds to counts of the counter, rounding down. */
+#define hrtimerUS_TO_COUNTS( ulTimeInUs )    ( ( uint32_t ) ( ( ( uint64_t ) ( ulTimeInUs ) * ( uint64_t ) configHR_TIMER_COUNTS_PER_SECOND ) / ( uint64_t ) 1000000U ) )
+
+/**
+ * Type by which high resolution timers are referenced.  For example, a call to
+ * xHrTimerCreate() returns an HrTimerHandle_t variable that can then be used
+ * as a parameter to vHrTimerStart(), vHrTimerStop(), etc.
+ */
+struct HrTimerDef_t;
+typedef struct HrTimerDef_t * HrTimerHandle_t;
+
+/*
+ * Defines the prototype to which high resolution timer callbacks must conform.
+ */
+typedef void (* HrTimerCallbackFunction_t)( HrTimerHandle_t xTimer,
+                                            BaseType_t * pxHigherPriorityTaskWoken );
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * HrTimerHandle_t xHrTimerCreate( HrTimerCallbackFunction_t pxCallbackFunction,
+ *                                 void * pvTimerID );
+ * @endcode
+ *
+ * Creates a new high resolution timer and returns a handle by which it can be
+ * referenced.  The timer is created dormant, vHrTimerStart() starts it.  The
+ * timer is allocated with pvPortMalloc(), so configSUPPORT_DYNAMIC_ALLOCATION
+ * must be set to 1.  The first call also sets up the counter and its compare
+ * channel.
+ *
+ * @param pxCallbackFunction The function to call, from the compare interrupt,
+ * when the timer expires.
+ *
+ * @param pvTimerID An identifier returned by pvHrTimerGetTimerID(), so one
+ * callback can serve several timers.
+ *
+ * @return The handle of the timer, or NULL if there was not enough heap memory
+ * to create it.
+ *
+ * Example usage:
+ * @code{c}
+ * // Samples the sensor every 250us and releases the filter task every
+ * // fourth sample, without raising the tick rate.
+ * static TaskHandle_t xFilterTask;
+ * static uint16_t usSamples[ 4 ];
+ * static UBaseType_t uxSample;
+ *
+ * static void prvSampleCallback( HrTimerHandle_t xTimer,
+ *                                BaseType_t * pxHigherPriorityTaskWoken )
+ * {
+ *  usSamples[ uxSample ] = usReadAdc();
+ *  uxSample = ( uxSample + 1 ) & 3;
+ *
+ *  if( uxSample == 0 )
+ *  {
+ *      vTaskNotifyGiveFromISR( xFilterTask, pxHigherPriorityTaskWoken );
+ *  }
+ * }
+ *
+ * void vFilterTask( void * pvParameters )
+ * {
+ * HrTimerHandle_t xSampleTimer;
+ *
+ *  xFilterTask = xTaskGetCurrentTaskHandle();
+ *  xSampleTimer = xHrTimerCreate( prvSampleCallback, NULL );
+ *  vHrTimerStart( xSampleTimer, hrtimerUS_TO_COUNTS( 250 ), hrtimerUS_TO_COUNTS( 250 ) );
+ *
+ *  for( ;; )
+ *  {
+ *      ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+ *      vFilter( usSamples );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xHrTimerCreate xHrTimerCreate
+ * \ingroup HrTimerManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    HrTimerHandle_t xHrTimerCreate( HrTimerCallbackFunction_t pxCallbackFunction,
+                                    void * pvTimerID ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * void vHrTimerDelete( HrTimerHandle_t xTimer );
+ * @endcode
+ *
+ * Stops a timer created with xHrTimerCreate() and frees it.  Must not be
+ * called from the timer's own callback.
+ *
+ * \defgroup vHrTimerDelete vHrTimerDelete
+ * \ingroup HrTimerManagement
+ */
+void vHrTimerDelete( HrTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * void vHrTimerStart( HrTimerHandle_t xTimer,
+ *                     uint32_t ulDelay,
+ *                     uint32_t ulPeriod );
+ * @endcode
+ *
+ * Starts a timer, or restarts it if it is already active.
+ *
+ * @param xTimer The handle of the timer.
+ *
+ * @param ulDelay The number of counts from now to the first expiry.  A delay
+ * of zero expires the timer as soon as the compare interrupt can run.
+ *
+ * @param ulPeriod The number of counts between the expiries of a periodic
+ * timer, zero for a one-shot timer.  The expiries of a periodic timer are a
+ * whole number of periods apart, whatever the interrupt latency, and expiries
+ * it is too late for are skipped and counted by ulHrTimerGetOverrunCount().
+ * The period must be longer than the time its callback takes, see the note at
+ * the top of this file.
+ *
+ * \defgroup vHrTimerStart vHrTimerStart
+ * \ingroup HrTimerManagement
+ */
+void vHrTimerStart( HrTimerHandle_t xTimer,
+                    uint32_t ulDelay,
+                    uint32_t ulPeriod ) PRIVILEGED_FUNCTION;
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * void vHrTimerStartFromISR( HrTimerHandle_t xTimer,
+ *                            uint32_t ulDelay,
+ *                            uint32_t ulPeriod );
+ * @endcode
+ *
+ * A version of vHrTimerStart() that can be called from an interrupt service
+ * routine, including a timer callback.
+ *
+ * \defgroup vHrTimerStartFromISR vHrTimerStartFromISR
+ * \ingroup HrTimerManagement
+ */
+void vHrTimerStartFromISR( HrTimerHandle_t xTimer,
+                           uint32_t ulDelay,
+                           uint32_t ulPeriod ) PRIVILEGED_FUNCTION;
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * void vHrTimerStop( HrTimerHandle_t xTimer );
+ * @endcode
+ *
+ * Stops a timer.  Its callback is not called again until it is restarted.
+ * Stopping a dormant timer has no effect.
+ *
+ * \defgroup vHrTimerStop vHrTimerStop
+ * \ingroup HrTimerManagement
+ */
+void vHrTimerStop( HrTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * void vHrTimerStopFromISR( HrTimerHandle_t xTimer );
+ * @endcode
+ *
+ * A version of vHrTimerStop() that can be called from an interrupt service
+ * routine, including a timer callback.
+ *
+ * \defgroup vHrTimerStopFromISR vHrTimerStopFromISR
+ * \ingroup HrTimerManagement
+ */
+void vHrTimerStopFromISR( HrTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * BaseType_t xHrTimerIsTimerActive( HrTimerHandle_t xTimer );
+ * @endcode
+ *
+ * @return pdFALSE if the timer is dormant, that is a one-shot timer that has
+ * expired or any timer that was never started or was stopped, otherwise
+ * pdTRUE.
+ *
+ * \defgroup xHrTimerIsTimerActive xHrTimerIsTimerActive
+ * \ingroup HrTimerManagement
+ */
+BaseType_t xHrTimerIsTimerActive( HrTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * void * pvHrTimerGetTimerID( HrTimerHandle_t xTimer );
+ * @endcode
+ *
+ * @return The pvTimerID the timer was created with.
+ *
+ * \defgroup pvHrTimerGetTimerID pvHrTimerGetTimerID
+ * \ingroup HrTimerManagement
+ */
+void * pvHrTimerGetTimerID( HrTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * uint32_t ulHrTimerGetOverrunCount( HrTimerHandle_t xTimer );
+ * @endcode
+ *
+ * @return The number of expiries of a periodic timer that were skipped since
+ * it was last started, because its callback could not be called before the
+ * following expiry was due.
+ *
+ * \defgroup ulHrTimerGetOverrunCount ulHrTimerGetOverrunCount
+ * \ingroup HrTimerManagement
+ */
+uint32_t ulHrTimerGetOverrunCount( HrTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * hrtimer.h
+ *
+ * @code{c}
+ * uint32_t ulHrTimerGetCount( void );
+ * @endcode
+ *
+ * @return The current count of the counter the timers run from, for example
+ * to timestamp the samples taken by a callback.
+ *
+ * \defgroup ulHrTimerGetCount ulHrTimerGetCount
+ * \ingroup HrTimerManagement
+ */
+uint32_t ulHrTimerGetCount( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
+ *----------------------------------------------------------*/
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Called by the port from the compare interrupt, once the interrupt is
+ * cleared.  Calls the callbacks of the timers that had expired when it was
+ * called and sets the compare channel to the next expiry, which may already
+ * have passed.  Returns pdTRUE if a callback unblocked a task that should
+ * preempt the interrupted one.
+ */
+BaseType_t xHrTimerProcessCompare( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+#endif /* HRTIMER_H */
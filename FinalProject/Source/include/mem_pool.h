@@ -0,0 +1,337 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Memory pools hand out blocks of one fixed size from storage set aside when
+ * the pool is created, so they never search for a block and never touch the
+ * heap.  The free blocks form a stack linked through the blocks themselves.
+ * Taking or returning a block is a single Atomic_CompareAndSwap_u32() on the
+ * top of the stack, so it can be done from tasks and interrupts alike and,
+ * while no task has to block or be woken, takes no critical section.  On a
+ * port that defines portATOMIC_COMPARE_AND_SWAP_U32() it does not mask
+ * interrupts either; elsewhere only the compare-and-swap itself does.
+ *
+ * Tasks that find the pool empty can block until a block is returned, in
+ * priority order (deadline order under EDF), as on a queue.
+ *
+ * ***NOTE***:  A pool holds at most 65535 blocks.  The top of the stack carries
+ * a 16 bit count of changes so that a task preempted in the middle of taking a
+ * block does not take the wrong one when it resumes, unless exactly a multiple
+ * of 65536 blocks were taken or returned meanwhile.
+ */
+
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include mem_pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * The size of each block of a pool of uxBlockCount blocks of uxBlockSize
+ * bytes.  The size is rounded up to a multiple of portBYTE_ALIGNMENT, and to
+ * at least the size of a uint32_t, which holds the link to the next free block
+ * while the block is free.
+ */
+#define mempoolBLOCK_SIZE( uxBlockSize )                                                                                                  \
+    ( ( ( ( ( uxBlockSize ) < sizeof( uint32_t ) ) ? sizeof( uint32_t ) : ( size_t ) ( uxBlockSize ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & \
+      ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * The number of bytes of storage that must be passed to xMemPoolCreateStatic()
+ * for uxBlockCount blocks of uxBlockSize bytes.
+ */
+#define mempoolSTORAGE_SIZE( uxBlockSize, uxBlockCount )    ( mempoolBLOCK_SIZE( uxBlockSize ) * ( size_t ) ( uxBlockCount ) )
+
+/**
+ * Type by which memory pools are referenced.  For example, a call to
+ * xMemPoolCreate() returns a MemPoolHandle_t variable that can then be used as
+ * a parameter to pvMemPoolAlloc(), vMemPoolFree(), etc.
+ */
+struct MemPoolDef_t;
+typedef struct MemPoolDef_t * MemPoolHandle_t;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * MemPoolHandle_t xMemPoolCreate( UBaseType_t uxBlockSize, UBaseType_t uxBlockCount );
+ * @endcode
+ *
+ * Creates a new memory pool and returns a handle by which it can be
+ * referenced.  The pool and its blocks are allocated in a single call to
+ * pvPortMalloc(), so configSUPPORT_DYNAMIC_ALLOCATION must be set to 1.  See
+ * xMemPoolCreateStatic() for a pool that uses storage the application
+ * provides.
+ *
+ * @param uxBlockSize The size, in bytes, of each block.  Blocks are aligned to
+ * portBYTE_ALIGNMENT.
+ *
+ * @param uxBlockCount The number of blocks, at most 65535.
+ *
+ * @return The handle of the pool, or NULL if there was not enough heap memory
+ * to create it.
+ *
+ * \defgroup xMemPoolCreate xMemPoolCreate
+ * \ingroup MemPoolManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    MemPoolHandle_t xMemPoolCreate( UBaseType_t uxBlockSize,
+                                    UBaseType_t uxBlockCount ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * MemPoolHandle_t xMemPoolCreateStatic( UBaseType_t uxBlockSize,
+ *                                       UBaseType_t uxBlockCount,
+ *                                       uint8_t * pucPoolStorage,
+ *                                       StaticMemPool_t * pxStaticMemPool );
+ * @endcode
+ *
+ * Creates a new memory pool in memory provided by the application, so
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1.
+ *
+ * @param uxBlockSize The size, in bytes, of each block.
+ *
+ * @param uxBlockCount The number of blocks, at most 65535.
+ *
+ * @param pucPoolStorage The storage the blocks are taken from.  It must be
+ * aligned to portBYTE_ALIGNMENT and at least
+ * mempoolSTORAGE_SIZE( uxBlockSize, uxBlockCount ) bytes long.
+ *
+ * @param pxStaticMemPool A StaticMemPool_t variable that holds the pool's data
+ * structure.
+ *
+ * @return The handle of the pool, or NULL if pucPoolStorage or
+ * pxStaticMemPool is NULL.
+ *
+ * Example usage:
+ * @code{c}
+ * typedef struct
+ * {
+ *  uint16_t usLength;
+ *  uint8_t ucData[ 122 ];
+ * } Packet_t;
+ *
+ * #define mainPACKETS    16
+ *
+ * static uint8_t ucPacketStorage[ mempoolSTORAGE_SIZE( sizeof( Packet_t ), mainPACKETS ) ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+ * static StaticMemPool_t xPacketPoolStruct;
+ * static MemPoolHandle_t xPacketPool;
+ * static QueueHandle_t xRxQueue;
+ *
+ * void vEthernetRxISR( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ * Packet_t * pxPacket;
+ *
+ *  // Never blocks or uses the heap.
+ *  pxPacket = ( Packet_t * ) pvMemPoolAllocFromISR( xPacketPool );
+ *
+ *  if( pxPacket != NULL )
+ *  {
+ *      pxPacket->usLength = prvReadFrame( pxPacket->ucData );
+ *      xQueueSendFromISR( xRxQueue, &pxPacket, &xHigherPriorityTaskWoken );
+ *  }
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vNetworkTask( void * pvParameters )
+ * {
+ * Packet_t * pxPacket;
+ *
+ *  for( ;; )
+ *  {
+ *      xQueueReceive( xRxQueue, &pxPacket, portMAX_DELAY );
+ *      prvProcessPacket( pxPacket );
+ *      vMemPoolFree( xPacketPool, pxPacket );
+ *  }
+ * }
+ *
+ * void main( void )
+ * {
+ *  xPacketPool = xMemPoolCreateStatic( sizeof( Packet_t ), mainPACKETS, ucPacketStorage, &xPacketPoolStruct );
+ *  ...
+ * }
+ * @endcode
+ * \defgroup xMemPoolCreateStatic xMemPoolCreateStatic
+ * \ingroup MemPoolManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    MemPoolHandle_t xMemPoolCreateStatic( UBaseType_t uxBlockSize,
+                                          UBaseType_t uxBlockCount,
+                                          uint8_t * pucPoolStorage,
+                                          StaticMemPool_t * pxStaticMemPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void vMemPoolDelete( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * Deletes a pool, freeing its memory if it was created with xMemPoolCreate().
+ * No task may be blocked on the pool, and the blocks must no longer be used.
+ *
+ * \defgroup vMemPoolDelete vMemPoolDelete
+ * \ingroup MemPoolManagement
+ */
+void vMemPoolDelete( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void * pvMemPoolAlloc( MemPoolHandle_t xMemPool, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a block from the pool.  Only enters the kernel if the pool is empty
+ * and the caller has to block.
+ *
+ * @param xMemPool The handle of the pool.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a block to be returned should the pool be empty.
+ *
+ * @return The block, or NULL if the pool was still empty when xTicksToWait
+ * expired.
+ *
+ * \defgroup pvMemPoolAlloc pvMemPoolAlloc
+ * \ingroup MemPoolManagement
+ */
+void * pvMemPoolAlloc( MemPoolHandle_t xMemPool,
+                       TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void * pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * As pvMemPoolAlloc(), from an interrupt service routine.  It never blocks.
+ *
+ * @return The block, or NULL if the pool was empty.
+ *
+ * \defgroup pvMemPoolAllocFromISR pvMemPoolAllocFromISR
+ * \ingroup MemPoolManagement
+ */
+void * pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void vMemPoolFree( MemPoolHandle_t xMemPool, void * pvBlock );
+ * @endcode
+ *
+ * Returns a block to the pool it was taken from.  Only enters the kernel if a
+ * task is blocked on the pool, in which case the first one is unblocked.
+ *
+ * @param xMemPool The handle of the pool.
+ *
+ * @param pvBlock The block, as returned by pvMemPoolAlloc() or
+ * pvMemPoolAllocFromISR().
+ *
+ * \defgroup vMemPoolFree vMemPoolFree
+ * \ingroup MemPoolManagement
+ */
+void vMemPoolFree( MemPoolHandle_t xMemPool,
+                   void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool,
+ *                           void * pvBlock,
+ *                           BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * As vMemPoolFree(), from an interrupt service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if returning the block
+ * unblocked a task that has a higher priority than the task that was
+ * interrupted, in which case a context switch should be requested before the
+ * interrupt is exited.  It can be NULL.
+ *
+ * \defgroup vMemPoolFreeFromISR vMemPoolFreeFromISR
+ * \ingroup MemPoolManagement
+ */
+void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool,
+                          void * pvBlock,
+                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * UBaseType_t uxMemPoolGetFreeBlocks( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * Returns the number of blocks in the pool.  Blocks being returned at the time
+ * may already be counted.
+ *
+ * \defgroup uxMemPoolGetFreeBlocks uxMemPoolGetFreeBlocks
+ * \ingroup MemPoolManagement
+ */
+UBaseType_t uxMemPoolGetFreeBlocks( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * UBaseType_t uxMemPoolGetMinimumEverFreeBlocks( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * Returns the lowest number of blocks there has been in the pool since it was
+ * created, the pool's high water mark.  As for uxMemPoolGetFreeBlocks(),
+ * blocks that were being returned at the time may have been counted.
+ *
+ * \defgroup uxMemPoolGetMinimumEverFreeBlocks uxMemPoolGetMinimumEverFreeBlocks
+ * \ingroup MemPoolManagement
+ */
+UBaseType_t uxMemPoolGetMinimumEverFreeBlocks( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MEM_POOL_H ) */
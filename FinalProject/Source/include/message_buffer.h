@@ -608,6 +608,68 @@ typedef void * MessageBufferHandle_t;
 #define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendReserve( MessageBufferHandle_t xMessageBuffer,
+ *                                   size_t xDataLengthBytes,
+ *                                   StreamBufferRegions_t * const pxRegions,
+ *                                   TickType_t xTicksToWait );
+ * size_t xMessageBufferSendCommit( MessageBufferHandle_t xMessageBuffer,
+ *                                  size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Write a message in place: reserve space for a whole message of
+ * xDataLengthBytes bytes (or nothing), fill the regions and commit the length
+ * actually written.  The reader sees the message when it is committed.  See
+ * xStreamBufferSendReserve() and xStreamBufferSendCommit().
+ *
+ * \defgroup xMessageBufferSendReserve xMessageBufferSendReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendReserve( xMessageBuffer, xDataLengthBytes, pxRegions, xTicksToWait ) \
+    xStreamBufferSendReserve( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes, pxRegions, xTicksToWait )
+
+#define xMessageBufferSendReserveFromISR( xMessageBuffer, xDataLengthBytes, pxRegions ) \
+    xStreamBufferSendReserveFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes, pxRegions )
+
+#define xMessageBufferSendCommit( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferSendCommit( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes )
+
+#define xMessageBufferSendCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendCommitFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveAcquire( MessageBufferHandle_t xMessageBuffer,
+ *                                      StreamBufferRegions_t * const pxRegions,
+ *                                      TickType_t xTicksToWait );
+ * size_t xMessageBufferReceiveRelease( MessageBufferHandle_t xMessageBuffer,
+ *                                      size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Read a message in place: acquire the next message, use it from the regions
+ * and release it, passing the length that the acquire returned.  See
+ * xStreamBufferReceiveAcquire() and xStreamBufferReceiveRelease().
+ *
+ * \defgroup xMessageBufferReceiveAcquire xMessageBufferReceiveAcquire
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveAcquire( xMessageBuffer, pxRegions, xTicksToWait ) \
+    xStreamBufferReceiveAcquire( ( StreamBufferHandle_t ) xMessageBuffer, pxRegions, xTicksToWait )
+
+#define xMessageBufferReceiveAcquireFromISR( xMessageBuffer, pxRegions ) \
+    xStreamBufferReceiveAcquireFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxRegions )
+
+#define xMessageBufferReceiveRelease( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferReceiveRelease( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes )
+
+#define xMessageBufferReceiveReleaseFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceiveReleaseFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken )
+
 /**
  * message_buffer.h
  *
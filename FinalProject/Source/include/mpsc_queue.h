@@ -0,0 +1,253 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * MPSC queues pass fixed size items from any number of producers, tasks or
+ * interrupts, to one consumer task.  Producers claim a slot by advancing the
+ * head index with Atomic_CompareAndSwap_u32(), copy the item in and then mark
+ * the slot as full.  The consumer is the only writer of the tail index.  So
+ * while no task has to block or be woken a send or a receive takes no critical
+ * section.  On a port that defines portATOMIC_COMPARE_AND_SWAP_U32() it does
+ * not mask interrupts either; elsewhere only the compare-and-swap itself does.
+ *
+ * Senders that find the queue full block in priority order (deadline order
+ * under EDF), as on a queue.  The consumer blocks on its direct to task
+ * notification, as uxSpscRingReceive() does.
+ *
+ * ***NOTE***:  Items are received in the order their slots were claimed.  A
+ * producer that is preempted between claiming a slot and filling it holds back
+ * the items behind it until it runs again.  Only one task may receive.
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include mpsc_queue.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which MPSC queues are referenced.  For example, a call to
+ * xMpscQueueCreate() returns an MpscQueueHandle_t variable that can then be
+ * used as a parameter to xMpscQueueSend(), xMpscQueueReceive(), etc.
+ */
+struct MpscQueueDef_t;
+typedef struct MpscQueueDef_t * MpscQueueHandle_t;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * MpscQueueHandle_t xMpscQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new MPSC queue and returns a handle by which it can be referenced.
+ * The queue and its storage are allocated in a single call to pvPortMalloc(),
+ * so configSUPPORT_DYNAMIC_ALLOCATION must be set to 1.
+ *
+ * @param uxLength The maximum number of items the queue can hold at any one
+ * time.  It must be a power of two.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return The handle of the queue, or NULL if there was not enough heap memory
+ * to create it.
+ *
+ * Example usage:
+ * @code{c}
+ * static MpscQueueHandle_t xUartTxQueue;
+ *
+ * // Any number of these can run.
+ * void vProducerTask( void * pvParameters )
+ * {
+ * const char * pcMessage = ( const char * ) pvParameters;
+ *
+ *  for( ;; )
+ *  {
+ *      // Only blocks if the queue is full.
+ *      xMpscQueueSend( xUartTxQueue, &pcMessage, portMAX_DELAY );
+ *      vTaskDelay( 100 );
+ *  }
+ * }
+ *
+ * void vUartTask( void * pvParameters )
+ * {
+ * const char * pcMessage;
+ *
+ *  for( ;; )
+ *  {
+ *      if( xMpscQueueReceive( xUartTxQueue, &pcMessage, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vSerialPutString( pcMessage );
+ *      }
+ *  }
+ * }
+ *
+ * void main( void )
+ * {
+ *  xUartTxQueue = xMpscQueueCreate( 8, sizeof( const char * ) );
+ *  ...
+ * }
+ * @endcode
+ * \defgroup xMpscQueueCreate xMpscQueueCreate
+ * \ingroup MpscQueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    MpscQueueHandle_t xMpscQueueCreate( UBaseType_t uxLength,
+                                        UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * void vMpscQueueDelete( MpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Deletes a queue created with xMpscQueueCreate().  No task may be using the
+ * queue or be blocked on it.
+ *
+ * \defgroup vMpscQueueDelete vMpscQueueDelete
+ * \ingroup MpscQueueManagement
+ */
+void vMpscQueueDelete( MpscQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xMpscQueueSend( MpscQueueHandle_t xQueue,
+ *                            const void * pvItemToQueue,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies one item to the back of the queue.  Only enters the kernel if the
+ * queue is full and the caller has to block, or if the consumer is blocked on
+ * the queue and has to be notified.
+ *
+ * @param xQueue The handle of the queue.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space should the queue be full.
+ *
+ * @return pdPASS if the item was copied, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xMpscQueueSend xMpscQueueSend
+ * \ingroup MpscQueueManagement
+ */
+BaseType_t xMpscQueueSend( MpscQueueHandle_t xQueue,
+                           const void * pvItemToQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xMpscQueueSendFromISR( MpscQueueHandle_t xQueue,
+ *                                   const void * pvItemToQueue,
+ *                                   BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * As xMpscQueueSend(), from an interrupt service routine.  It never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if notifying the consumer
+ * unblocked it and it has a higher priority than the task that was interrupted,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.  It can be NULL.
+ *
+ * @return pdPASS if the item was copied, or errQUEUE_FULL if the queue was
+ * full and the item was dropped.
+ *
+ * \defgroup xMpscQueueSendFromISR xMpscQueueSendFromISR
+ * \ingroup MpscQueueManagement
+ */
+BaseType_t xMpscQueueSendFromISR( MpscQueueHandle_t xQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xMpscQueueReceive( MpscQueueHandle_t xQueue,
+ *                               void * pvBuffer,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the item at the front of the queue to pvBuffer and frees its slot.
+ * If the queue is empty the calling task blocks, for at most xTicksToWait,
+ * until an item is sent.  Only enters the kernel to block, or to wake a sender
+ * that is blocked on the full queue.  Must only be called from the consumer
+ * task.
+ *
+ * @param xQueue The handle of the queue.
+ *
+ * @param pvBuffer The buffer the item is copied to.
+ *
+ * @param xTicksToWait The maximum amount of time to wait for an item should
+ * the queue be empty.
+ *
+ * @return pdPASS if an item was received, otherwise pdFAIL.
+ *
+ * \defgroup xMpscQueueReceive xMpscQueueReceive
+ * \ingroup MpscQueueManagement
+ */
+BaseType_t xMpscQueueReceive( MpscQueueHandle_t xQueue,
+                              void * pvBuffer,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *
+ * @code{c}
+ * UBaseType_t uxMpscQueueMessagesWaiting( MpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Returns the number of slots that producers have claimed and the consumer has
+ * not yet freed.  This includes slots that are still being filled.
+ *
+ * \defgroup uxMpscQueueMessagesWaiting uxMpscQueueMessagesWaiting
+ * \ingroup MpscQueueManagement
+ */
+UBaseType_t uxMpscQueueMessagesWaiting( MpscQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MPSC_QUEUE_H ) */
@@ -199,6 +199,24 @@ BaseType_t xPortStartScheduler( void ) PRIVILEGED_FUNCTION;
  */
 void vPortEndScheduler( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * The counter and compare channel used by the high resolution timers, see
+ * hrtimer.h.  vPortHrTimerSetup() is called when the first timer is created,
+ * after which ulPortHrTimerGetCount() returns the count of a free running
+ * 32-bit counter, counting at configHR_TIMER_COUNTS_PER_SECOND.
+ * vPortHrTimerSetCompare() makes the compare interrupt call
+ * xHrTimerProcessCompare() when the counter reaches ulCount, or as soon as it
+ * can if the counter is already up to 2^31 counts past ulCount, and
+ * vPortHrTimerDisableCompare() stops it from doing so.  They are called with
+ * interrupts masked.
+ */
+#if ( configUSE_HR_TIMERS == 1 )
+    void vPortHrTimerSetup( void ) PRIVILEGED_FUNCTION;
+    uint32_t ulPortHrTimerGetCount( void ) PRIVILEGED_FUNCTION;
+    void vPortHrTimerSetCompare( uint32_t ulCount ) PRIVILEGED_FUNCTION;
+    void vPortHrTimerDisableCompare( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * The structures and methods of manipulating the MPU are contained within the
  * port layer.
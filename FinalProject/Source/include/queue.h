@@ -64,6 +64,14 @@ typedef struct QueueDefinition   * QueueSetHandle_t;
  */
 typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 
+/**
+ * Type by which zero copy queues are referenced.  For example, a call to
+ * xQueueCreateZeroCopy() returns a ZeroCopyQueueHandle_t variable that can then
+ * be used as a parameter to pvQueueAcquire(), xQueueCommit(), etc.
+ */
+struct ZeroCopyQueueDefinition;
+typedef struct ZeroCopyQueueDefinition * ZeroCopyQueueHandle_t;
+
 /* For internal use only. */
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
@@ -1418,6 +1426,211 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultiple(
+ *                                QueueHandle_t xQueue,
+ *                                const void * const pvItemsToQueue,
+ *                                const UBaseType_t uxItemCount,
+ *                                TickType_t xTicksToWait
+ *                           );
+ * @endcode
+ *
+ * Post up to uxItemCount items to the back of a queue in one critical section.
+ * The items are laid out one after the other at pvItemsToQueue, each the size
+ * given when the queue was created, and are copied into the queue storage
+ * with at most two memcpy() calls.  A receiving task that is blocked on the
+ * queue is unblocked once for the whole batch rather than once per item
+ * (another is only unblocked for each further item if several are waiting).
+ *
+ * The call blocks, for at most xTicksToWait, only while the queue is full.  As
+ * soon as there is space for one item, as many of the items as fit are posted
+ * and the call returns, so a return value less than uxItemCount is not an
+ * error: the remaining items start at the returned index.
+ *
+ * Cannot be used on a semaphore or mutex.  Must not be called from an interrupt
+ * service routine.  See uxQueueSendMultipleFromISR() for an alternative which
+ * may be used in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to the first of the items to be placed on the
+ * queue.
+ *
+ * @param uxItemCount The number of items at pvItemsToQueue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it be full.
+ *
+ * @return The number of items posted, from the start of pvItemsToQueue.  0 if
+ * the queue stayed full for xTicksToWait.
+ *
+ * Example usage:
+ * @code{c}
+ * void vSamplerTask( void *pvParameters )
+ * {
+ * uint16_t usSamples[ 16 ];
+ * UBaseType_t uxSent;
+ *
+ *  for( ;; )
+ *  {
+ *      vReadSamples( usSamples, 16 );
+ *
+ *      // Hand the whole block over, waiting for space as needed.
+ *      for( uxSent = 0; uxSent < 16; )
+ *      {
+ *          uxSent += uxQueueSendMultiple( xQueue, &( usSamples[ uxSent ] ), 16 - uxSent, portMAX_DELAY );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItemsToQueue,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultipleFromISR(
+ *                                       QueueHandle_t xQueue,
+ *                                       const void * const pvItemsToQueue,
+ *                                       const UBaseType_t uxItemCount,
+ *                                       BaseType_t *pxHigherPriorityTaskWoken
+ *                                  );
+ * @endcode
+ *
+ * A version of uxQueueSendMultiple() that can be used in an interrupt service
+ * routine.  As many of the items as there is space for are posted, without
+ * blocking, and the number posted is returned.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to the first of the items to be placed on the
+ * queue.
+ *
+ * @param uxItemCount The number of items at pvItemsToQueue.
+ *
+ * @param pxHigherPriorityTaskWoken uxQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if posting the items unblocked a task
+ * with a priority higher than the currently running task, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * const pvItemsToQueue,
+                                        const UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultiple(
+ *                                   QueueHandle_t xQueue,
+ *                                   void * const pvBuffer,
+ *                                   const UBaseType_t uxItemCount,
+ *                                   TickType_t xTicksToWait
+ *                              );
+ * @endcode
+ *
+ * Receive up to uxItemCount items from a queue in one critical section.  The
+ * items are copied, oldest first, into consecutive item sized slots at
+ * pvBuffer with at most two memcpy() calls.  A sending task that is blocked on
+ * the queue is unblocked once for the whole batch.
+ *
+ * The call blocks, for at most xTicksToWait, only while the queue is empty.  It
+ * returns as soon as at least one item is available, with all the items that
+ * were waiting up to uxItemCount.
+ *
+ * Cannot be used on a semaphore or mutex.  Must not be called from an interrupt
+ * service routine.  See uxQueueReceiveMultipleFromISR() for an alternative
+ * which may be used in an ISR.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied.  It must have room for uxItemCount items.
+ *
+ * @param uxItemCount The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty at the time of the call.
+ *
+ * @return The number of items received.  0 if the queue stayed empty for
+ * xTicksToWait.
+ *
+ * Example usage:
+ * @code{c}
+ * void vLoggerTask( void *pvParameters )
+ * {
+ * LogRecord_t xRecords[ 8 ];
+ * UBaseType_t uxReceived, x;
+ *
+ *  for( ;; )
+ *  {
+ *      // Wait for the first record, then take everything that is there.
+ *      uxReceived = uxQueueReceiveMultiple( xQueue, xRecords, 8, portMAX_DELAY );
+ *
+ *      for( x = 0; x < uxReceived; x++ )
+ *      {
+ *          vWriteRecord( &( xRecords[ x ] ) );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxItemCount,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultipleFromISR(
+ *                                          QueueHandle_t xQueue,
+ *                                          void * const pvBuffer,
+ *                                          const UBaseType_t uxItemCount,
+ *                                          BaseType_t *pxHigherPriorityTaskWoken
+ *                                     );
+ * @endcode
+ *
+ * A version of uxQueueReceiveMultiple() that can be used in an interrupt
+ * service routine.  Everything that is waiting, up to uxItemCount items, is
+ * received without blocking.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied.  It must have room for uxItemCount items.
+ *
+ * @param uxItemCount The maximum number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if making space on the queue
+ * unblocked a task with a priority higher than the currently running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultipleFromISR uxQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * const pvBuffer,
+                                           const UBaseType_t uxItemCount,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1571,8 +1784,8 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * See FreeRTOS/Source/Demo/Common/Minimal/QueueSet.c for an example using this
  * function.
  *
- * A queue set must be explicitly created using a call to xQueueCreateSet()
- * before it can be used.  Once created, standard FreeRTOS queues and semaphores
+ * A queue set must be explicitly created using a call to xQueueCreateSet() or
+ * xQueueCreateSetBitmap() before it can be used.  Once created, standard FreeRTOS queues and semaphores
  * can be added to the set using calls to xQueueAddToSet().
  * xQueueSelectFromSet() is then used to determine which, if any, of the queues
  * or semaphores contained in the set is in a state where a queue read or
@@ -1585,13 +1798,19 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * Note 2:  Blocking on a queue set that contains a mutex will not cause the
  * mutex holder to inherit the priority of the blocked task.
  *
- * Note 3:  An additional 4 bytes of RAM is required for each space in a every
- * queue added to a queue set.  Therefore counting semaphores that have a high
- * maximum count value should not be added to a queue set.
+ * Note 3:  A queue set records which of its members may hold data in one bit
+ * per member, so adding a member costs a pointer in the set rather than a
+ * space per item, and sending to a member only sets its bit.  Members can
+ * therefore be counting semaphores with any maximum count.
+ *
+ * Note 4:  Readiness is checked when the set is read, so a member returned by
+ * xQueueSelectFromSet() always holds data at that time.  Members can also be
+ * read without first selecting them, a member emptied that way is simply not
+ * returned.
  *
- * Note 4:  A receive (in the case of a queue) or take (in the case of a
- * semaphore) operation must not be performed on a member of a queue set unless
- * a call to xQueueSelectFromSet() has first returned a handle to that set member.
+ * Note 5:  A queue set holds at most as many members as there are bits in a
+ * UBaseType_t (32, or 64 on ports with a 64-bit UBaseType_t).  xQueueAddToSet()
+ * fails once the set is full.
  *
  * @param uxEventQueueLength Queue sets store events that occur on
  * the queues and semaphores contained in the set.  uxEventQueueLength specifies
@@ -1599,31 +1818,39 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * certain that events are not lost uxEventQueueLength should be set to the
  * total sum of the length of the queues added to the set, where binary
  * semaphores and mutexes have a length of 1, and counting semaphores have a
- * length set by their maximum count value.  Examples:
- *  + If a queue set is to hold a queue of length 5, another queue of length 12,
- *    and a binary semaphore, then uxEventQueueLength should be set to
- *    (5 + 12 + 1), or 18.
- *  + If a queue set is to hold three binary semaphores then uxEventQueueLength
- *    should be set to (1 + 1 + 1 ), or 3.
- *  + If a queue set is to hold a counting semaphore that has a maximum count of
- *    5, and a counting semaphore that has a maximum count of 3, then
- *    uxEventQueueLength should be set to (5 + 3), or 8.
+ * length set by their maximum count value.  As every member has a length of at
+ * least 1 the set is made with room for that many members, or for as many as
+ * there are bits in a UBaseType_t if that is fewer.  Use
+ * xQueueCreateSetBitmap() to give the number of members instead.
  *
  * @return If the queue set is created successfully then a handle to the created
  * queue set is returned.  Otherwise NULL is returned.
  */
 QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength ) PRIVILEGED_FUNCTION;
 
+/*
+ * Creates a queue set as xQueueCreateSet() does, sized by the number of
+ * members rather than by the number of events.  Events are not stored, so the
+ * set takes a pointer per member whatever the lengths of the members.
+ *
+ * @param uxMaxMembers The maximum number of queues and semaphores the set can
+ * hold, at most the number of bits in a UBaseType_t (32, or 64 on ports with a
+ * 64-bit UBaseType_t).
+ *
+ * @return If the queue set is created successfully then a handle to the created
+ * queue set is returned.  Otherwise NULL is returned.
+ */
+QueueSetHandle_t xQueueCreateSetBitmap( const UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+
 /*
  * Adds a queue or semaphore to a queue set that was previously created by a
- * call to xQueueCreateSet().
+ * call to xQueueCreateSet() or xQueueCreateSetBitmap().
  *
  * See FreeRTOS/Source/Demo/Common/Minimal/QueueSet.c for an example using this
  * function.
  *
- * Note 1:  A receive (in the case of a queue) or take (in the case of a
- * semaphore) operation must not be performed on a member of a queue set unless
- * a call to xQueueSelectFromSet() has first returned a handle to that set member.
+ * Note 1:  A queue or semaphore that already holds data can be added, it is
+ * ready to be selected as soon as it is in the set.
  *
  * @param xQueueOrSemaphore The handle of the queue or semaphore being added to
  * the queue set (cast to an QueueSetMemberHandle_t type).
@@ -1633,15 +1860,16 @@ QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength ) PRIVILE
  *
  * @return If the queue or semaphore was successfully added to the queue set
  * then pdPASS is returned.  If the queue could not be successfully added to the
- * queue set because it is already a member of a different queue set then pdFAIL
- * is returned.
+ * queue set because it is already a member of a different queue set, or the
+ * set already holds as many members as it was created for, then pdFAIL is
+ * returned.
  */
 BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
                            QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
 /*
- * Removes a queue or semaphore from a queue set.  A queue or semaphore can only
- * be removed from a set if the queue or semaphore is empty.
+ * Removes a queue or semaphore from a queue set.  The queue or semaphore does
+ * not need to be empty.
  *
  * See FreeRTOS/Source/Demo/Common/Minimal/QueueSet.c for an example using this
  * function.
@@ -1653,8 +1881,8 @@ BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
  * is included.
  *
  * @return If the queue or semaphore was successfully removed from the queue set
- * then pdPASS is returned.  If the queue was not in the queue set, or the
- * queue (or semaphore) was not empty, then pdFAIL is returned.
+ * then pdPASS is returned.  If the queue was not in the queue set then pdFAIL
+ * is returned.
  */
 BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
                                 QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
@@ -1676,9 +1904,14 @@ BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
  * Note 2:  Blocking on a queue set that contains a mutex will not cause the
  * mutex holder to inherit the priority of the blocked task.
  *
- * Note 3:  A receive (in the case of a queue) or take (in the case of a
- * semaphore) operation must not be performed on a member of a queue set unless
- * a call to xQueueSelectFromSet() has first returned a handle to that set member.
+ * Note 3:  A member stays selectable until it is empty.  When several members
+ * hold data they are returned in turn: each call starts from the member after
+ * the one returned last, and a member that is not read until empty is only
+ * returned again once the other ready members have been.  Members are taken in
+ * the reverse of the order they were added (members take the lowest free slot
+ * in the set when they are added, and the highest ready slot below the last
+ * one is selected with a count leading zeros where the port provides one).
+ * Members have no priority over each other.
  *
  * @param xQueueSet The queue set on which the task will (potentially) block.
  *
@@ -1701,6 +1934,147 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/*
+ * Zero copy queues pass buffers by reference instead of copying every item
+ * into and out of the queue storage area.  configUSE_ZERO_COPY_QUEUES must be
+ * defined as 1 for these functions to be available.
+ *
+ * A zero copy queue owns uxQueueLength buffers of uxItemSize bytes.  A sender
+ * acquires a free buffer with pvQueueAcquire(), fills it in place and passes
+ * it to the receivers with xQueueCommit().  A receiver gets the oldest
+ * committed buffer with pvQueueReceiveZeroCopy() and gives it back with
+ * vQueueRelease() once it has finished with the contents.  Between acquire and
+ * commit, and between receive and release, the buffer belongs to the task (or
+ * interrupt) alone.
+ *
+ * Internally only buffer pointers are queued, so the time spent in critical
+ * sections does not depend on uxItemSize.  pvQueueAcquire() blocks while all
+ * buffers are in use and pvQueueReceiveZeroCopy() while none is committed,
+ * with the same semantics as xQueueSend() and xQueueReceive().  Buffers can be
+ * released in any order.  A buffer must not be committed or released twice.
+ *
+ * Example usage:
+ * @code{c}
+ * struct AMessage
+ * {
+ *  char ucMessageID;
+ *  char ucData[ 200 ];
+ * };
+ *
+ * ZeroCopyQueueHandle_t xQueue;
+ *
+ * void vCreate( void )
+ * {
+ *  xQueue = xQueueCreateZeroCopy( 4, sizeof( struct AMessage ) );
+ * }
+ *
+ * void vSender( void *pvParameters )
+ * {
+ * struct AMessage *pxMessage;
+ *
+ *  pxMessage = pvQueueAcquire( xQueue, portMAX_DELAY );
+ *  pxMessage->ucMessageID = 1;
+ *  // Fill pxMessage->ucData in place...
+ *  xQueueCommit( xQueue, pxMessage );
+ * }
+ *
+ * void vReceiver( void *pvParameters )
+ * {
+ * struct AMessage *pxMessage;
+ *
+ *  pxMessage = pvQueueReceiveZeroCopy( xQueue, portMAX_DELAY );
+ *  if( pxMessage != NULL )
+ *  {
+ *      // Use pxMessage...
+ *      vQueueRelease( xQueue, pxMessage );
+ *  }
+ * }
+ * @endcode
+ */
+
+/*
+ * Create a zero copy queue with uxQueueLength buffers of uxItemSize bytes each.
+ * The queue and its buffers are allocated in one block with pvPortMalloc().
+ * Every buffer is aligned to portBYTE_ALIGNMENT.
+ *
+ * @return The handle of the queue, or NULL if it could not be created.
+ */
+ZeroCopyQueueHandle_t xQueueCreateZeroCopy( const UBaseType_t uxQueueLength,
+                                            const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Delete a zero copy queue.  No task may be blocked on it and every buffer is
+ * freed with it, including those that are still acquired or received.
+ */
+void vQueueDeleteZeroCopy( ZeroCopyQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Acquire a free buffer of the queue to fill in place, waiting at most
+ * xTicksToWait for one to be released.
+ *
+ * @return The buffer, or NULL if none was free in time.
+ */
+void * pvQueueAcquire( ZeroCopyQueueHandle_t xQueue,
+                       TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of pvQueueAcquire() that can be called from an ISR.  It never
+ * blocks, and as nothing ever waits for a buffer to be taken it cannot unblock
+ * a task either.
+ */
+void * pvQueueAcquireFromISR( ZeroCopyQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pass a buffer returned by pvQueueAcquire() to the receivers.  Buffers are
+ * received in the order they are committed.  There is always room for every
+ * buffer of the queue, so this never blocks.
+ *
+ * @return pdPASS.
+ */
+BaseType_t xQueueCommit( ZeroCopyQueueHandle_t xQueue,
+                         void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of xQueueCommit() that can be called from an ISR.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if a receiver with a higher
+ * priority than the interrupted task was unblocked.
+ */
+BaseType_t xQueueCommitFromISR( ZeroCopyQueueHandle_t xQueue,
+                                void * pvItem,
+                                BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Receive the oldest committed buffer, waiting at most xTicksToWait for one.
+ * The buffer must be given back with vQueueRelease().
+ *
+ * @return The buffer, or NULL if none was committed in time.
+ */
+void * pvQueueReceiveZeroCopy( ZeroCopyQueueHandle_t xQueue,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of pvQueueReceiveZeroCopy() that can be called from an ISR.  Like
+ * pvQueueAcquireFromISR() it neither blocks nor unblocks a task.
+ */
+void * pvQueueReceiveZeroCopyFromISR( ZeroCopyQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give a received buffer back to the queue so it can be acquired again.  This
+ * never blocks.
+ */
+void vQueueRelease( ZeroCopyQueueHandle_t xQueue,
+                    void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of vQueueRelease() that can be called from an ISR.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if a sender waiting in
+ * pvQueueAcquire() with a higher priority than the interrupted task was
+ * unblocked.
+ */
+void vQueueReleaseFromISR( ZeroCopyQueueHandle_t xQueue,
+                           void * pvItem,
+                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
                                      TickType_t xTicksToWait,
@@ -0,0 +1,247 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * SPSC rings pass fixed size items from exactly one producer, typically an
+ * interrupt, to exactly one consumer task.  Unlike queues and stream buffers
+ * the data path never enters a critical section or masks interrupts: the
+ * producer only writes the head index and the consumer only writes the tail
+ * index, so plain ordered loads and stores are enough.  The consumer blocks on
+ * a direct to task notification, which the producer only sends when the
+ * consumer has said it is waiting.
+ *
+ * ***NOTE***:  As with stream buffers, it is not safe to have more than one
+ * producer or more than one consumer.  The producer never blocks - when the
+ * ring is full the item is not sent.  The consumer must be a task (it can
+ * block) and uses the task's notification, as xStreamBufferReceive() does.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_ring.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which SPSC rings are referenced.  For example, a call to
+ * xSpscRingCreate() returns an SpscRingHandle_t variable that can then be used
+ * as a parameter to xSpscRingSendFromISR(), uxSpscRingReceive(), etc.
+ */
+struct SpscRingDef_t;
+typedef struct SpscRingDef_t * SpscRingHandle_t;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new SPSC ring and returns a handle by which it can be referenced.
+ * The ring and its storage are allocated in a single call to pvPortMalloc(),
+ * so configSUPPORT_DYNAMIC_ALLOCATION must be set to 1.
+ *
+ * @param uxLength The maximum number of items the ring can hold at any one
+ * time.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return The handle of the ring, or NULL if there was not enough heap memory
+ * to create it.
+ *
+ * Example usage:
+ * @code{c}
+ * static SpscRingHandle_t xRxRing;
+ *
+ * void vUART_ISRHandler( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ * char cChar;
+ *
+ *  cChar = U1RBR;
+ *
+ *  // A full ring drops the character, there is nowhere to wait in an ISR.
+ *  ( void ) xSpscRingSendFromISR( xRxRing, &cChar, &xHigherPriorityTaskWoken );
+ *
+ *  VICVectAddr = 0;
+ *  portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vRxTask( void * pvParameters )
+ * {
+ * char cBuffer[ 16 ];
+ * UBaseType_t uxReceived;
+ *
+ *  xRxRing = xSpscRingCreate( 64, sizeof( char ) );
+ *
+ *  for( ;; )
+ *  {
+ *      // Wait for the first character, then take everything that is there.
+ *      uxReceived = uxSpscRingReceive( xRxRing, cBuffer, sizeof( cBuffer ), portMAX_DELAY );
+ *      vProcessCharacters( cBuffer, uxReceived );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSpscRingCreate xSpscRingCreate
+ * \ingroup SpscRingManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * void vSpscRingDelete( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * Deletes a ring created with xSpscRingCreate().  Neither side may be using
+ * the ring, and the consumer must not be blocked on it.
+ *
+ * \defgroup vSpscRingDelete vSpscRingDelete
+ * \ingroup SpscRingManagement
+ */
+void vSpscRingDelete( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+ *                                  const void * pvItem,
+ *                                  BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Copies one item into the ring from an interrupt service routine.  No
+ * interrupts are masked unless the consumer is blocked on the ring, in which
+ * case it is notified.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @param pvItem A pointer to the item to copy into the ring.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if notifying the consumer
+ * unblocked it and it has a higher priority than the task that was interrupted,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.  It can be NULL.
+ *
+ * @return pdPASS if the item was copied, or errQUEUE_FULL if the ring was full
+ * and the item was dropped.
+ *
+ * \defgroup xSpscRingSendFromISR xSpscRingSendFromISR
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItem,
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingSend( SpscRingHandle_t xRing, const void * pvItem );
+ * @endcode
+ *
+ * As xSpscRingSendFromISR(), for a producer that is a task.  A context switch
+ * happens at once if notifying the consumer unblocked it and it has a higher
+ * priority than the producer.  It never blocks.
+ *
+ * \defgroup xSpscRingSend xSpscRingSend
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingSend( SpscRingHandle_t xRing,
+                          const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * UBaseType_t uxSpscRingReceive( SpscRingHandle_t xRing,
+ *                                void * pvBuffer,
+ *                                UBaseType_t uxMaxItems,
+ *                                TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the items waiting in the ring, oldest first and up to uxMaxItems of
+ * them, to consecutive item sized slots at pvBuffer.  If the ring is empty the
+ * calling task blocks, for at most xTicksToWait, until the producer sends an
+ * item.  Must only be called from the consumer task.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @param pvBuffer The buffer the items are copied to.  It must have room for
+ * uxMaxItems items.
+ *
+ * @param uxMaxItems The most items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time to wait for an item should
+ * the ring be empty.
+ *
+ * @return The number of items received, 0 if none arrived within
+ * xTicksToWait.
+ *
+ * \defgroup uxSpscRingReceive uxSpscRingReceive
+ * \ingroup SpscRingManagement
+ */
+UBaseType_t uxSpscRingReceive( SpscRingHandle_t xRing,
+                               void * pvBuffer,
+                               UBaseType_t uxMaxItems,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * Returns the number of items in the ring.  Only the consumer can make it
+ * smaller and only the producer larger, so to the producer the value is an
+ * upper bound and to the consumer a lower bound.
+ *
+ * \defgroup uxSpscRingItemsWaiting uxSpscRingItemsWaiting
+ * \ingroup SpscRingManagement
+ */
+UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_RING_H ) */
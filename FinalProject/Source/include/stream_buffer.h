@@ -71,6 +71,21 @@
 struct StreamBufferDef_t;
 typedef struct StreamBufferDef_t * StreamBufferHandle_t;
 
+/**
+ * Describes bytes inside a stream buffer's storage area, as returned by
+ * xStreamBufferSendReserve() and xStreamBufferReceiveAcquire().  The bytes are
+ * the xFirstLengthBytes at pucFirst followed by the xSecondLengthBytes at
+ * pucSecond.  The second region is only used when the bytes wrap around to the
+ * start of the storage area, otherwise pucSecond is NULL.
+ */
+typedef struct xSTREAM_BUFFER_REGIONS
+{
+    uint8_t * pucFirst;
+    size_t xFirstLengthBytes;
+    uint8_t * pucSecond;
+    size_t xSecondLengthBytes;
+} StreamBufferRegions_t;
+
 
 /**
  * stream_buffer.h
@@ -594,6 +609,210 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
                                     size_t xBufferLengthBytes,
                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+ *                                  size_t xDataLengthBytes,
+ *                                  StreamBufferRegions_t * const pxRegions,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * The first half of a write that places the data straight into the stream
+ * buffer's storage area instead of copying it in from a caller's buffer.
+ * xStreamBufferSendReserve() finds space for up to xDataLengthBytes bytes and
+ * describes it in *pxRegions, as two regions if the space wraps around the end
+ * of the storage area.  The writer fills the regions, in order, and then calls
+ * xStreamBufferSendCommit() to make the bytes visible to the reader.  Nothing
+ * is visible until then, and another write must not be started in between.
+ *
+ * Blocking is as xStreamBufferSend(): the calling task waits, for at most
+ * xTicksToWait, until xDataLengthBytes bytes are free (or the whole buffer,
+ * if that is less).  On timeout a stream buffer reserves what space there is,
+ * a message buffer reserves the whole message or nothing.
+ *
+ * Use xStreamBufferSendReserveFromISR() in an interrupt service routine.  It
+ * does not block.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param xDataLengthBytes The number of bytes the writer wants to write.
+ *
+ * @param pxRegions Set to the reserved space.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for space to become available.
+ *
+ * @return The number of bytes reserved, the total length of the regions.
+ *
+ * Example use:
+ * @code{c}
+ * void vLog( const char * pcFormat, uint32_t ulValue )
+ * {
+ * StreamBufferRegions_t xRegions;
+ * char cLine[ 32 ];
+ * size_t xLength, xReserved;
+ *
+ *  xReserved = xStreamBufferSendReserve( xLogBuffer, sizeof( cLine ), &xRegions, portMAX_DELAY );
+ *
+ *  if( xRegions.xFirstLengthBytes == sizeof( cLine ) )
+ *  {
+ *      // Format straight into the buffer.
+ *      xLength = snprintf( ( char * ) xRegions.pucFirst, xRegions.xFirstLengthBytes, pcFormat, ulValue );
+ *  }
+ *  else
+ *  {
+ *      // The space wraps around, format once and split it over the regions.
+ *      xLength = configMIN( xReserved, ( size_t ) snprintf( cLine, sizeof( cLine ), pcFormat, ulValue ) );
+ *      memcpy( xRegions.pucFirst, cLine, configMIN( xLength, xRegions.xFirstLengthBytes ) );
+ *
+ *      if( xLength > xRegions.xFirstLengthBytes )
+ *      {
+ *          memcpy( xRegions.pucSecond, &( cLine[ xRegions.xFirstLengthBytes ] ), xLength - xRegions.xFirstLengthBytes );
+ *      }
+ *  }
+ *
+ *  xStreamBufferSendCommit( xLogBuffer, configMIN( xLength, xReserved ) );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSendReserve xStreamBufferSendReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xDataLengthBytes,
+                                 StreamBufferRegions_t * const pxRegions,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xDataLengthBytes,
+                                        StreamBufferRegions_t * const pxRegions ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+ *                                 size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Completes a write started with xStreamBufferSendReserve().  The first
+ * xDataLengthBytes bytes of the reserved regions become visible to the reader,
+ * which is unblocked if the trigger level is reached, exactly as if they had
+ * been written by xStreamBufferSend().  xDataLengthBytes can be less than was
+ * reserved, but not more.  Committing 0 bytes abandons the write.
+ *
+ * Use xStreamBufferSendCommitFromISR() in an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer written to.
+ *
+ * @param xDataLengthBytes The number of bytes written into the regions.
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferSendCommit xStreamBufferSendCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xDataLengthBytes,
+                                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+ *                                     StreamBufferRegions_t * const pxRegions,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * The first half of a read that uses the data where it lies in the stream
+ * buffer's storage area instead of copying it out.  *pxRegions is set to all
+ * the bytes in a stream buffer, or to the next message in a message buffer.
+ * The reader uses them and then calls xStreamBufferReceiveRelease() to hand
+ * the space back to the writer.  The bytes stay valid until then.
+ *
+ * Blocking is as xStreamBufferReceive(): if the buffer is empty the calling
+ * task waits, for at most xTicksToWait, to be unblocked by a write that
+ * reaches the trigger level.
+ *
+ * Use xStreamBufferReceiveAcquireFromISR() in an interrupt service routine.
+ * It does not block.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param pxRegions Set to the data.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data to become available.
+ *
+ * @return The number of bytes acquired, the total length of the regions.
+ *
+ * Example use:
+ * @code{c}
+ * void vUartTxTask( void * pvParameters )
+ * {
+ * StreamBufferRegions_t xRegions;
+ * size_t xLength;
+ *
+ *  for( ;; )
+ *  {
+ *      xLength = xStreamBufferReceiveAcquire( xTxBuffer, &xRegions, portMAX_DELAY );
+ *
+ *      // Send from the stream buffer itself, then free the space.
+ *      vUartWrite( xRegions.pucFirst, xRegions.xFirstLengthBytes );
+ *      vUartWrite( xRegions.pucSecond, xRegions.xSecondLengthBytes );
+ *      xStreamBufferReceiveRelease( xTxBuffer, xLength );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferReceiveAcquire xStreamBufferReceiveAcquire
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferRegions_t * const pxRegions,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           StreamBufferRegions_t * const pxRegions ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Completes a read started with xStreamBufferReceiveAcquire().  The first
+ * xDataLengthBytes of the acquired bytes are removed from the buffer, and a
+ * writer blocked waiting for space is unblocked, exactly as if they had been
+ * read by xStreamBufferReceive().  A stream buffer can release fewer bytes than
+ * were acquired, leaving the rest to be read again.  A message buffer must
+ * release the whole message, with the length xStreamBufferReceiveAcquire()
+ * returned.
+ *
+ * Use xStreamBufferReceiveReleaseFromISR() in an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer read from.
+ *
+ * @param xDataLengthBytes The number of bytes to remove.
+ *
+ * @return The number of bytes removed.
+ *
+ * \defgroup xStreamBufferReceiveRelease xStreamBufferReceiveRelease
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xDataLengthBytes,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -164,6 +164,51 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+#if ( configGENERATE_JOB_TIME_STATS == 1 )
+
+/* Used with vTaskGetJobTimeStats() to return the execution times of the jobs
+ * of a periodic task.  A job starts when the task first runs after its release
+ * and ends when it calls xTaskDelayUntil(); only the time the task spends in
+ * the Running state counts, so preemption is excluded.  Times are in run time
+ * counter units. */
+    typedef struct xTASK_JOB_TIME_STATS
+    {
+        TickType_t xPeriod;                                            /* The increment passed to the last xTaskDelayUntil() call, the task's period. */
+        uint32_t ulJobs;                                               /* Number of completed jobs. */
+        configRUN_TIME_COUNTER_TYPE ulLastTime;                        /* Execution time of the last job. */
+        configRUN_TIME_COUNTER_TYPE ulMinTime;                         /* Shortest job. */
+        configRUN_TIME_COUNTER_TYPE ulMaxTime;                         /* Longest job, the measured worst case execution time. */
+        configRUN_TIME_COUNTER_TYPE ulTotalTime;                       /* Sum of all jobs, for the mean.  Wraps like the run time counter itself. */
+        uint32_t ulHistogram[ configJOB_TIME_HISTOGRAM_BINS ];         /* Jobs per configJOB_TIME_HISTOGRAM_BIN_WIDTH wide bin, the last bin also counts longer jobs. */
+    } TaskJobTimeStats_t;
+
+#endif /* configGENERATE_JOB_TIME_STATS */
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/* The two kinds of section measured by configGENERATE_CRITICAL_SECTION_STATS. */
+    typedef enum
+    {
+        eCriticalSection = 0, /* taskENTER_CRITICAL() to taskEXIT_CRITICAL(), interrupts are disabled. */
+        eSchedulerSuspended   /* vTaskSuspendAll() to xTaskResumeAll(), context switches are held off. */
+    } eSectionKind;
+
+/* Used with uxTaskGetCriticalSectionStats() to return the durations of the
+ * outermost sections entered from one call site.  Times are in
+ * portGET_CRITICAL_SECTION_TIME() units. */
+    typedef struct xTASK_SECTION_STATS
+    {
+        const char * pcFile;                                          /* __FILE__ of the call site, NULL for the entry that counts the sites that did not fit in configCRITICAL_SECTION_SITES. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        uint32_t ulLine;                                              /* __LINE__ of the call site. */
+        eSectionKind eKind;                                           /* What the call site entered. */
+        uint32_t ulCount;                                             /* Number of sections measured. */
+        uint32_t ulMaxTime;                                           /* Longest section. */
+        uint32_t ulTotalTime;                                         /* Sum of all sections, for the mean.  Wraps. */
+        uint32_t ulHistogram[ configCRITICAL_SECTION_HISTOGRAM_BINS ]; /* Sections per bin, bins double in width from configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH. */
+    } TaskSectionStats_t;
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -201,7 +246,20 @@ typedef enum
  * \defgroup taskENTER_CRITICAL taskENTER_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskENTER_CRITICAL()               portENTER_CRITICAL()
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/* Each expansion tags the section with its file and line.  ucSite caches the
+ * slot of the call site in the statistics table, so recording a section does
+ * not have to search for it. */
+    #define taskENTER_CRITICAL()                                              \
+    do {                                                                      \
+        static uint8_t ucSite = 0U;                                           \
+        portENTER_CRITICAL();                                                 \
+        vTaskCriticalSectionEntered( __FILE__, ( uint32_t ) __LINE__, &ucSite ); \
+    } while( 0 )
+#else
+    #define taskENTER_CRITICAL()    portENTER_CRITICAL()
+#endif
 #define taskENTER_CRITICAL_FROM_ISR()      portSET_INTERRUPT_MASK_FROM_ISR()
 
 /**
@@ -216,7 +274,15 @@ typedef enum
  * \defgroup taskEXIT_CRITICAL taskEXIT_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    #define taskEXIT_CRITICAL()              \
+    do {                                     \
+        vTaskCriticalSectionExiting();       \
+        portEXIT_CRITICAL();                 \
+    } while( 0 )
+#else
+    #define taskEXIT_CRITICAL()    portEXIT_CRITICAL()
+#endif
 #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
 
 /**
@@ -1090,6 +1156,60 @@ void vTaskGetInfo( TaskHandle_t xTask,
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetDeadline( TaskHandle_t xTask, const TickType_t xDeadline );
+ * void vTaskRaiseDeadline( TaskHandle_t xTask, const TickType_t xDeadline );
+ * void vTaskRaiseDeadlineFromISR( TaskHandle_t xTask, const TickType_t xDeadline, BaseType_t * const pxHigherPriorityTaskWoken );
+ * TickType_t xTaskGetDeadline( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULER must be defined as 1 for these functions to be
+ * available.
+ *
+ * Under EDF the task with the earliest absolute deadline runs.  A periodic
+ * task gets its deadlines from xTaskPeriodicCreate() and xTaskDelayUntil(),
+ * other tasks have a deadline of portMAX_DELAY.  These functions let a task
+ * that serves aperiodic requests, such as the worker of a work queue, take
+ * the deadline of the request it is serving.
+ *
+ * vTaskSetDeadline() sets the deadline of a task.  vTaskRaiseDeadline() and
+ * vTaskRaiseDeadlineFromISR() only make it earlier, and leave it unchanged if
+ * it already is no later than xDeadline.  A ready task moves to its new place
+ * among the ready tasks, and a context switch occurs (or, from an interrupt,
+ * *pxHigherPriorityTaskWoken is set to pdTRUE) if the running task is no
+ * longer the most urgent.  A task blocked on a queue or semaphore is woken in
+ * deadline order, and vTaskSetDeadline() and vTaskRaiseDeadline() move it to
+ * the place of its new deadline among the tasks waiting with it.
+ * vTaskRaiseDeadlineFromISR() cannot change the order of the waiting tasks
+ * from an interrupt, so there the task keeps its place until it next blocks,
+ * and only runs with the new deadline once it is woken.
+ *
+ * @param xTask The handle of the task.  A NULL handle means the calling task,
+ * except for vTaskRaiseDeadlineFromISR().
+ *
+ * @param xDeadline The new absolute deadline, in ticks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a context switch should
+ * be requested before the interrupt is exited.  It can be NULL.
+ *
+ * @return xTaskGetDeadline() returns the absolute deadline of the task.
+ *
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+    void vTaskRaiseDeadline( TaskHandle_t xTask,
+                             const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+    void vTaskRaiseDeadlineFromISR( TaskHandle_t xTask,
+                                    const TickType_t xDeadline,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    TickType_t xTaskGetDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1371,6 +1491,18 @@ void vTaskEndScheduler( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
 
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/* Tags the suspension with its file and line, as taskENTER_CRITICAL() does.
+ * The function itself can still be called as ( vTaskSuspendAll )(), those
+ * suspensions are not measured. */
+    #define vTaskSuspendAll()                                           \
+    do {                                                                \
+        static uint8_t ucSite = 0U;                                     \
+        vTaskSuspendAllFrom( __FILE__, ( uint32_t ) __LINE__, &ucSite ); \
+    } while( 0 )
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1959,6 +2091,146 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetJobTimeStats( TaskHandle_t xTask, TaskJobTimeStats_t *pxJobTimeStats );
+ * void vTaskResetJobTimeStats( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configGENERATE_JOB_TIME_STATS must be defined as 1 for these functions to be
+ * available.  The job times are measured with the run time stats counter, so
+ * configGENERATE_RUN_TIME_STATS must be 1 as well.
+ *
+ * Each call to xTaskDelayUntil() ends a job of the calling task.  The net
+ * execution time of the job, the time the task spent in the Running state
+ * since the previous job ended, excluding the time it was preempted, is added
+ * to the task's statistics: minimum, maximum, mean and a histogram of
+ * configJOB_TIME_HISTOGRAM_BINS bins of configJOB_TIME_HISTOGRAM_BIN_WIDTH
+ * counter units.  Interrupts that run while the task is running are counted
+ * as part of the job.
+ *
+ * vTaskGetJobTimeStats() copies the statistics of xTask, vTaskResetJobTimeStats()
+ * clears them, for example after a start up phase or to leave out the first
+ * xTaskDelayUntil() of a task with an offset.
+ *
+ * @param xTask The handle of the task, or NULL for the calling task.
+ *
+ * @param pxJobTimeStats The structure the statistics are copied to.
+ *
+ * \defgroup vTaskGetJobTimeStats vTaskGetJobTimeStats
+ * \ingroup TaskUtils
+ */
+#if ( configGENERATE_JOB_TIME_STATS == 1 )
+    void vTaskGetJobTimeStats( TaskHandle_t xTask,
+                               TaskJobTimeStats_t * pxJobTimeStats ) PRIVILEGED_FUNCTION;
+    void vTaskResetJobTimeStats( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetJobTimeStatsText( char *pcWriteBuffer );
+ * @endcode
+ *
+ * configGENERATE_JOB_TIME_STATS, configUSE_STATS_FORMATTING_FUNCTIONS and
+ * configUSE_TRACE_FACILITY must all be defined as 1 for this function to be
+ * available.
+ *
+ * Writes one line per task that has completed at least one job:
+ *
+ *   name<TAB>period<TAB>jobs<TAB>min<TAB>max<TAB>mean<TAB>bin0,bin1,...
+ *
+ * with the period in ticks and the times in run time counter units.  The
+ * format is read by FinalProject/Tools/wcetstats.py, which turns it into a
+ * SimSo task set.  Like vTaskGetRunTimeStats() this is a debug aid that uses
+ * sprintf() and allocates a TaskStatus_t array with pvPortMalloc().
+ *
+ * @param pcWriteBuffer A buffer into which the statistics will be written, in
+ * ASCII form.  About 40 bytes per task plus 6 bytes per histogram bin should
+ * be sufficient.
+ *
+ * \defgroup vTaskGetJobTimeStatsText vTaskGetJobTimeStatsText
+ * \ingroup TaskUtils
+ */
+void vTaskGetJobTimeStatsText( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetCriticalSectionStats( TaskSectionStats_t * const pxSectionStats, const UBaseType_t uxArraySize );
+ * void vTaskResetCriticalSectionStats( void );
+ * @endcode
+ *
+ * configGENERATE_CRITICAL_SECTION_STATS must be defined as 1 for these
+ * functions to be available.
+ *
+ * Every outermost taskENTER_CRITICAL() / taskEXIT_CRITICAL() pair and every
+ * outermost vTaskSuspendAll() / xTaskResumeAll() pair is timed with
+ * portGET_CRITICAL_SECTION_TIME(), and the duration is recorded against the
+ * file and line of the call that entered the section: count, maximum, mean and
+ * a histogram of configCRITICAL_SECTION_HISTOGRAM_BINS bins, the first one
+ * configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH wide and each further one twice
+ * as wide as the one before.  The longest critical section bounds the
+ * interrupt latency, the longest suspension bounds how late a task that an
+ * interrupt made ready can start to run.
+ *
+ * A task that yields inside a critical section runs the next task with
+ * interrupts enabled, so the section is recorded as two: up to the yield, and
+ * from when the task runs again.  Critical sections of interrupt service
+ * routines and of the port layer are not measured.
+ *
+ * Recording costs two time stamps and a few comparisons per outermost section,
+ * and one byte of RAM per call site plus the table of
+ * configCRITICAL_SECTION_SITES entries, so it can be left enabled.
+ *
+ * uxTaskGetCriticalSectionStats() copies the recorded call sites into
+ * pxSectionStats, longest section first, and returns how many were copied.
+ * vTaskResetCriticalSectionStats() clears the statistics of every site.
+ *
+ * @param pxSectionStats An array of at least uxArraySize entries.
+ *
+ * @param uxArraySize The size of pxSectionStats.  configCRITICAL_SECTION_SITES
+ * entries are always sufficient.
+ *
+ * \defgroup uxTaskGetCriticalSectionStats uxTaskGetCriticalSectionStats
+ * \ingroup TaskUtils
+ */
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+    UBaseType_t uxTaskGetCriticalSectionStats( TaskSectionStats_t * const pxSectionStats,
+                                               const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+    void vTaskResetCriticalSectionStats( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetCriticalSectionStatsText( char *pcWriteBuffer );
+ * @endcode
+ *
+ * configGENERATE_CRITICAL_SECTION_STATS, configUSE_STATS_FORMATTING_FUNCTIONS
+ * and configSUPPORT_DYNAMIC_ALLOCATION must all be defined as 1 for this
+ * function to be available.
+ *
+ * Writes one line per call site, longest section first:
+ *
+ *   file:line<TAB>crit|susp<TAB>count<TAB>max<TAB>mean<TAB>bin0,bin1,...
+ *
+ * with the directory removed from the file name and the times in
+ * portGET_CRITICAL_SECTION_TIME() units.  The sites that did not fit in the
+ * table are reported together as "other:0".  Like vTaskGetRunTimeStats() this
+ * is a debug aid that uses sprintf() and allocates its working array with
+ * pvPortMalloc().
+ *
+ * @param pcWriteBuffer A buffer into which the statistics will be written, in
+ * ASCII form.  About 50 bytes per site plus 6 bytes per histogram bin should
+ * be sufficient.
+ *
+ * \defgroup vTaskGetCriticalSectionStatsText vTaskGetCriticalSectionStatsText
+ * \ingroup TaskUtils
+ */
+void vTaskGetCriticalSectionStatsText( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
 /**
  * task. h
  * @code{c}
@@ -2773,6 +3045,119 @@ uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
 #define ulTaskNotifyValueClearIndexed( xTask, uxIndexToClear, ulBitsToClear ) \
     ulTaskGenericNotifyValueClear( ( xTask ), ( uxIndexToClear ), ( ulBitsToClear ) )
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskMailboxSend( TaskHandle_t xTaskToNotify, UBaseType_t uxIndex, const uint32_t * pulWords, UBaseType_t uxWords, BaseType_t xOverwrite, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
+ * function to be available.
+ *
+ * Sends a message of up to a few 32-bit words to a task through its array of
+ * notification values, without a queue.  The message occupies the uxWords
+ * notification values starting at index uxIndex, and the notification state
+ * at uxIndex records whether a message is pending.  The task reads it with
+ * xTaskMailboxReceive().  Each task therefore has a one message mailbox per
+ * range of indexes set aside for it, which costs no RAM beyond the
+ * notification array and no heap.
+ *
+ * The indexes used by a mailbox must not be used with the other task
+ * notification API functions at the same time.  In particular index 0 is used
+ * by stream buffers and the other kernel objects built on notifications, so
+ * mailboxes are best placed at index 1 and above.
+ *
+ * @param xTaskToNotify The handle of the task the message is sent to.
+ *
+ * @param uxIndex The first notification index of the mailbox.  uxIndex plus
+ * uxWords must not exceed configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * @param pulWords The words to send.
+ *
+ * @param uxWords The number of words in the message, at least 1.  The sender
+ * and the receiver must agree on it.
+ *
+ * @param xOverwrite If a message is still pending, pdTRUE replaces it, as a
+ * queue of length one used with xQueueOverwrite(), and pdFALSE leaves it and
+ * waits for the task to receive it.
+ *
+ * @param xTicksToWait With xOverwrite pdFALSE, the maximum time to wait in the
+ * Blocked state for the pending message to be received, as xQueueSend() waits
+ * for space.  0 returns at once.  Not used with xOverwrite pdTRUE, which never
+ * waits.
+ *
+ * The tasks waiting to send are kept in one list for all mailboxes, so each
+ * message received wakes all of them to check their mailbox again, and those
+ * that find it still full block for the rest of their time.  The receiving
+ * task must not be deleted while a task waits to send to it, and a message
+ * discarded with xTaskNotifyStateClearIndexed() does not wake the senders.
+ *
+ * @return pdPASS if the message was sent, pdFAIL if xOverwrite was pdFALSE and
+ * a message was still pending when the time ran out.
+ *
+ * \defgroup xTaskMailboxSend xTaskMailboxSend
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskMailboxSend( TaskHandle_t xTaskToNotify,
+                             UBaseType_t uxIndex,
+                             const uint32_t * pulWords,
+                             UBaseType_t uxWords,
+                             BaseType_t xOverwrite,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskMailboxSendFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndex, const uint32_t * pulWords, UBaseType_t uxWords, BaseType_t xOverwrite, BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xTaskMailboxSend() that can be called from an interrupt service
+ * routine.  It never waits: with xOverwrite pdFALSE it fails if a message is
+ * pending.  *pxHigherPriorityTaskWoken is set to pdTRUE if the message
+ * unblocked a task of higher priority than the one interrupted, or under
+ * configUSE_EDF_SCHEDULER a task with an earlier deadline, in which case a
+ * context switch should be requested before the interrupt exits.
+ *
+ * \defgroup xTaskMailboxSendFromISR xTaskMailboxSendFromISR
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskMailboxSendFromISR( TaskHandle_t xTaskToNotify,
+                                    UBaseType_t uxIndex,
+                                    const uint32_t * pulWords,
+                                    UBaseType_t uxWords,
+                                    BaseType_t xOverwrite,
+                                    BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskMailboxReceive( UBaseType_t uxIndex, uint32_t * pulWords, UBaseType_t uxWords, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the message pending in the calling task's mailbox at notification
+ * index uxIndex, sent by xTaskMailboxSend() or xTaskMailboxSendFromISR(),
+ * waiting in the Blocked state for one to arrive if necessary.  The mailbox is
+ * empty again afterwards, and the tasks waiting to send are woken.
+ *
+ * @param uxIndex The first notification index of the mailbox.
+ *
+ * @param pulWords Where the uxWords words of the message are copied to.
+ *
+ * @param uxWords The number of words in the message.
+ *
+ * @param xTicksToWait The maximum time to wait for a message if none is
+ * pending.  0 returns at once.
+ *
+ * @return pdPASS if a message was received, pdFAIL if the time ran out first.
+ *
+ * \defgroup xTaskMailboxReceive xTaskMailboxReceive
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskMailboxReceive( UBaseType_t uxIndex,
+                                uint32_t * pulWords,
+                                UBaseType_t uxWords,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * task.h
  * @code{c}
@@ -3111,6 +3496,20 @@ TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Called by the taskENTER_CRITICAL(),
+ * taskEXIT_CRITICAL() and vTaskSuspendAll() macros when
+ * configGENERATE_CRITICAL_SECTION_STATS is 1.  pucSite points to the call
+ * site's cached slot in the statistics table, 0 until first used.
+ */
+void vTaskCriticalSectionEntered( const char * pcFile,
+                                  uint32_t ulLine,
+                                  uint8_t * pucSite ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+void vTaskCriticalSectionExiting( void ) PRIVILEGED_FUNCTION;
+void vTaskSuspendAllFrom( const char * pcFile,
+                          uint32_t ulLine,
+                          uint8_t * pucSite ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
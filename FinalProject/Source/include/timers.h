@@ -466,6 +466,12 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
  * code.  The length of the timer command queue is set by the
  * configTIMER_QUEUE_LENGTH configuration constant.
  *
+ * If configUSE_TIMER_COMMAND_COALESCING is set to 1 in FreeRTOSConfig.h then a
+ * command instead replaces any command sent to the same timer that the timer
+ * service task has not processed yet, so only the latest one is processed.
+ * The commands then always return pdPASS, never block, and xTicksToWait is
+ * ignored.
+ *
  * xTimerStart() starts a timer that was previously created using the
  * xTimerCreate() API function.  If the timer had already been started and was
  * already in the active state, then xTimerStart() has equivalent functionality
@@ -1269,6 +1275,124 @@ const char * pcTimerGetName( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION; /*lint
 void vTimerSetReloadMode( TimerHandle_t xTimer,
                           const UBaseType_t uxAutoReload ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetIsrCallback( TimerHandle_t xTimer, const BaseType_t xFromISR );
+ *
+ * configUSE_TIMER_ISR_CALLBACKS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Selects whether the callback of a timer runs in the timer service task, the
+ * default, or directly from the tick interrupt.  The latter saves the context
+ * switches to and from the timer service task for short callbacks, such as
+ * toggling an output or notifying a task, and the callback is not delayed by
+ * tasks of a priority above the timer service task.
+ *
+ * Commands for a timer whose callback runs from the tick interrupt
+ * (xTimerStart(), xTimerStop(), xTimerReset(), xTimerChangePeriod(),
+ * xTimerDelete() and their FromISR versions) do not use the timer command queue.
+ * They are written into a lock-free ring of configTIMER_ISR_COMMAND_QUEUE_LENGTH
+ * commands that the tick interrupt empties.  They never block, whatever block
+ * time is given, and fail if the ring is full.  A command takes effect on the
+ * next tick.  A command whose sender is interrupted before it finishes writing
+ * it holds back the commands behind it until the sender runs again.
+ *
+ * The callback runs with the restrictions of an interrupt service routine.  It
+ * must only call API functions that end in "FromISR", and must not block,
+ * suspend the scheduler or take long.  With configASSERT() defined, blocking
+ * and suspending the scheduler from the callback are caught.  A context switch
+ * requested through the pxHigherPriorityTaskWoken parameter of those functions,
+ * or by passing it as NULL, is performed when the tick interrupt returns.
+ * While the scheduler is suspended the callbacks are held back along with the
+ * tick, and they run, in a critical section, when it is resumed.
+ *
+ * Timers whose callbacks run from the tick interrupt are kept in a sorted
+ * list of their own, so they are intended to be few.  A timer can only be
+ * switched between the two modes while it is dormant.
+ *
+ * Either way the timer stays driven by the tick: it expires on a tick, with
+ * the resolution of configTICK_RATE_HZ, and it is not run from the compare
+ * interrupt of the high resolution timers even when configUSE_HR_TIMERS is 1.
+ * A callback that needs to run between ticks should use a high resolution
+ * timer instead, see hrtimer.h.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xFromISR pdTRUE to run the callback from the tick interrupt, pdFALSE
+ * to run it in the timer service task.
+ *
+ * Example usage:
+ * @code{c}
+ * void vLedToggleCallback( TimerHandle_t xTimer )
+ * {
+ *  vParTestToggleLED( 0 );
+ * }
+ *
+ * void vAFunction( void )
+ * {
+ * TimerHandle_t xLedTimer;
+ *
+ *  xLedTimer = xTimerCreate( "Led", pdMS_TO_TICKS( 5 ), pdTRUE, NULL, vLedToggleCallback );
+ *  vTimerSetIsrCallback( xLedTimer, pdTRUE );
+ *  xTimerStart( xLedTimer, 0 );
+ * }
+ * @endcode
+ */
+#if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+    void vTimerSetIsrCallback( TimerHandle_t xTimer,
+                               const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Sets how many ticks late a timer is allowed to expire.  Timers are created
+ * with no slack and expire at the exact tick.  A timer with slack expires at
+ * the tick in its window [expiry time, expiry time + slack] that is a multiple
+ * of the largest power of two, so timers whose windows overlap tend to expire
+ * at the same tick and the timer service task wakes once for all of them.
+ * This suits timers that do not need an exact expiry, such as keep-alives, LED
+ * flashers and statistics flushes, and means fewer and longer idle periods.
+ *
+ * The slack does not accumulate: the next expiry of an auto-reload timer is
+ * still one period after the expiry time without slack.  The slack should be
+ * less than the period, as an auto-reload timer that expires more than a
+ * period late has its callback called again at once to catch up.  The slack
+ * takes effect the next time the timer is started, reset or reloaded, and is
+ * ignored for timers whose callbacks run from the tick interrupt.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xSlackInTicks How late, in ticks, the timer may expire.
+ *
+ * Example usage:
+ * @code{c}
+ *  xTimer = xTimerCreate( "Flasher", pdMS_TO_TICKS( 333 ), pdTRUE, NULL, prvLEDTimerCallback );
+ *  vTimerSetSlack( xTimer, pdMS_TO_TICKS( 20 ) );
+ *  xTimerStart( xTimer, 0 );
+ * @endcode
+ */
+#if ( configUSE_TIMER_SLACK == 1 )
+    void vTimerSetSlack( TimerHandle_t xTimer,
+                         const TickType_t xSlackInTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The slack of the timer in ticks, see vTimerSetSlack().
+ */
+#if ( configUSE_TIMER_SLACK == 1 )
+    TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer );
  *
@@ -1299,7 +1423,8 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  *
  * Returns the time in ticks at which the timer will expire.  If this is less
  * than the current tick count then the expiry time has overflowed from the
- * current time.
+ * current time.  For a timer with slack (see vTimerSetSlack()) it is the time
+ * the timer will actually expire, slack included.
  *
  * @param xTimer The handle of the timer being queried.
  *
@@ -1320,6 +1445,16 @@ BaseType_t xTimerGenericCommand( TimerHandle_t xTimer,
                                  BaseType_t * const pxHigherPriorityTaskWoken,
                                  const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+
+/*
+ * Called by xTaskIncrementTick() on every tick that is not pended, to apply
+ * the commands for timers whose callbacks run from the tick interrupt and to
+ * run the callbacks of those that expire at xTimeNow.
+ */
+    void vTimerProcessIsrTimers( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_TRACE_FACILITY == 1 )
     void vTimerSetTimerNumber( TimerHandle_t xTimer,
                                UBaseType_t uxTimerNumber ) PRIVILEGED_FUNCTION;
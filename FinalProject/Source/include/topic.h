@@ -0,0 +1,331 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Topics broadcast fixed size items from any number of publishers, tasks or
+ * interrupts, to every task that has subscribed.  An item is copied once, into
+ * the topic's ring, and each subscriber reads it from there through its own
+ * cursor: pvTopicReceive() returns a pointer into the ring and xTopicRelease()
+ * moves the cursor on.  Publishing notifies the subscribers that are blocked
+ * waiting for an item, so the cost of an item is one copy plus one direct to
+ * task notification per waiting subscriber, whatever its size.
+ *
+ * When a subscriber falls a whole ring behind, a topic created with
+ * topicOVERWRITE overwrites the oldest item anyway and the subscriber misses
+ * it, while a topic created with topicBACKPRESSURE makes publishers wait (or
+ * fail) until the slowest subscriber releases it.
+ *
+ * ***NOTE***:  A subscriber blocks on its task's notification, as a task
+ * receiving from a stream buffer does, so it should not use that notification
+ * for anything else.  Only the task that subscribed may receive through the
+ * subscription, and a task needs one subscription per topic.
+ */
+
+#ifndef TOPIC_H
+#define TOPIC_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include topic.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* What a topic does when a subscriber is a whole ring behind. */
+#define topicBACKPRESSURE    ( ( BaseType_t ) 0 )
+#define topicOVERWRITE       ( ( BaseType_t ) 1 )
+
+/**
+ * Type by which topics are referenced.  For example, a call to xTopicCreate()
+ * returns a TopicHandle_t variable that can then be used as a parameter to
+ * xTopicPublish(), xTopicSubscribe(), etc.
+ */
+struct TopicDef_t;
+typedef struct TopicDef_t * TopicHandle_t;
+
+/**
+ * Type by which subscriptions are referenced.  xTopicSubscribe() returns one,
+ * it is then passed to pvTopicReceive() and xTopicRelease().
+ */
+struct TopicSubscriberDef_t;
+typedef struct TopicSubscriberDef_t * TopicSubscriberHandle_t;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * TopicHandle_t xTopicCreate( UBaseType_t uxLength,
+ *                             UBaseType_t uxItemSize,
+ *                             BaseType_t xWhenFull );
+ * @endcode
+ *
+ * Creates a new topic and returns a handle by which it can be referenced.  The
+ * topic and its ring are allocated in a single call to pvPortMalloc(), so
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1.
+ *
+ * @param uxLength The number of items the ring holds, which is how far a
+ * subscriber can fall behind.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Items are copied into
+ * the ring with interrupts masked, so keep them small - a pointer if need be.
+ *
+ * @param xWhenFull topicOVERWRITE to overwrite the oldest item when a
+ * subscriber is a whole ring behind, topicBACKPRESSURE to make the publisher
+ * wait for that subscriber instead.
+ *
+ * @return The handle of the topic, or NULL if there was not enough heap memory
+ * to create it.
+ *
+ * Example usage:
+ * @code{c}
+ * static TopicHandle_t xButtonTopic;
+ *
+ * void vButtonTask( void * pvParameters )
+ * {
+ * uint8_t ucEdge;
+ *
+ *  for( ;; )
+ *  {
+ *      ucEdge = ucWaitForButtonEdge();
+ *
+ *      // Copied once, however many tasks have subscribed.
+ *      xTopicPublish( xButtonTopic, &ucEdge, 0 );
+ *  }
+ * }
+ *
+ * void vLedTask( void * pvParameters )
+ * {
+ * TopicSubscriberHandle_t xSubscription;
+ * const uint8_t * pucEdge;
+ *
+ *  xSubscription = xTopicSubscribe( xButtonTopic );
+ *
+ *  for( ;; )
+ *  {
+ *      pucEdge = ( const uint8_t * ) pvTopicReceive( xSubscription, portMAX_DELAY );
+ *
+ *      if( pucEdge != NULL )
+ *      {
+ *          vSetLed( *pucEdge );
+ *          xTopicRelease( xSubscription );
+ *      }
+ *  }
+ * }
+ *
+ * void main( void )
+ * {
+ *  xButtonTopic = xTopicCreate( 4, sizeof( uint8_t ), topicOVERWRITE );
+ *  ...
+ * }
+ * @endcode
+ * \defgroup xTopicCreate xTopicCreate
+ * \ingroup TopicManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    TopicHandle_t xTopicCreate( UBaseType_t uxLength,
+                                UBaseType_t uxItemSize,
+                                BaseType_t xWhenFull ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * void vTopicDelete( TopicHandle_t xTopic );
+ * @endcode
+ *
+ * Deletes a topic created with xTopicCreate().  Every subscription must have
+ * been cancelled with vTopicUnsubscribe() and no publisher may be blocked on
+ * the topic.
+ *
+ * \defgroup vTopicDelete vTopicDelete
+ * \ingroup TopicManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    void vTopicDelete( TopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * BaseType_t xTopicPublish( TopicHandle_t xTopic,
+ *                           const void * pvItem,
+ *                           TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies one item into the topic's ring and notifies the subscribers that are
+ * waiting for one.
+ *
+ * @param xTopic The handle of the topic.
+ *
+ * @param pvItem A pointer to the item to publish.
+ *
+ * @param xTicksToWait How long to wait for the slowest subscriber should a
+ * topicBACKPRESSURE topic be full.  Not used by topicOVERWRITE topics, which
+ * are never full.
+ *
+ * @return pdPASS if the item was published, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xTopicPublish xTopicPublish
+ * \ingroup TopicManagement
+ */
+BaseType_t xTopicPublish( TopicHandle_t xTopic,
+                          const void * pvItem,
+                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * BaseType_t xTopicPublishFromISR( TopicHandle_t xTopic,
+ *                                  const void * pvItem,
+ *                                  BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * As xTopicPublish(), from an interrupt service routine.  It never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a subscriber that was
+ * notified has a higher priority than the task that was interrupted, in which
+ * case a context switch should be requested before the interrupt is exited.
+ * It can be NULL.
+ *
+ * \defgroup xTopicPublishFromISR xTopicPublishFromISR
+ * \ingroup TopicManagement
+ */
+BaseType_t xTopicPublishFromISR( TopicHandle_t xTopic,
+                                 const void * pvItem,
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic );
+ * @endcode
+ *
+ * Subscribes the calling task to a topic.  The subscription starts with the
+ * next item published.  It is allocated with pvPortMalloc(), so
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1.
+ *
+ * @return The handle of the subscription, or NULL if there was not enough
+ * heap memory.
+ *
+ * \defgroup xTopicSubscribe xTopicSubscribe
+ * \ingroup TopicManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * Cancels a subscription and frees it.  An item still held is released.
+ *
+ * \defgroup vTopicUnsubscribe vTopicUnsubscribe
+ * \ingroup TopicManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * const void * pvTopicReceive( TopicSubscriberHandle_t xSubscriber,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Returns a pointer to the oldest item the subscriber has not received,
+ * in the topic's ring.  If there is none the calling task blocks, for at most
+ * xTicksToWait, until one is published.  The item stays in the ring until
+ * xTopicRelease() is called, which must be done before receiving again.
+ *
+ * @param xSubscriber The subscription, made by the calling task.
+ *
+ * @param xTicksToWait The maximum amount of time to wait for an item.
+ *
+ * @return A pointer to the item, or NULL if none was published within
+ * xTicksToWait.
+ *
+ * \defgroup pvTopicReceive pvTopicReceive
+ * \ingroup TopicManagement
+ */
+const void * pvTopicReceive( TopicSubscriberHandle_t xSubscriber,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * BaseType_t xTopicRelease( TopicSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * Releases the item returned by the last call to pvTopicReceive().  On a
+ * topicBACKPRESSURE topic this may unblock a publisher.
+ *
+ * @return pdPASS, or pdFAIL if the topic is a topicOVERWRITE topic and the
+ * item was overwritten while it was held - what was read from it may be part
+ * of a newer item.
+ *
+ * \defgroup xTopicRelease xTopicRelease
+ * \ingroup TopicManagement
+ */
+BaseType_t xTopicRelease( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * UBaseType_t uxTopicGetMissed( TopicSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * Returns how many items a subscriber of a topicOVERWRITE topic has missed
+ * since it subscribed, because they were overwritten before it received them.
+ *
+ * \defgroup uxTopicGetMissed uxTopicGetMissed
+ * \ingroup TopicManagement
+ */
+UBaseType_t uxTopicGetMissed( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( TOPIC_H ) */
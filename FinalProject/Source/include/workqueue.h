@@ -0,0 +1,242 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Work queues defer work from interrupt service routines, or from tasks, to a
+ * worker task of their own, as xTimerPendFunctionCallFromISR() defers it to
+ * the timer service task.  Each work queue has its own worker with its own
+ * priority and stack, so work submitted to it is not held up behind timer
+ * callbacks, or behind the work of other work queues.  Create one work queue
+ * per worker context that is needed, for example one for UART reception at a
+ * high priority and one for housekeeping at a low priority.
+ *
+ * Submission copies a function and its parameters into an MPSC queue (see
+ * mpsc_queue.h), so it takes no critical section while the worker does not
+ * have to be woken.  Each item has a relative deadline.  The worker runs the
+ * items it has taken from the MPSC queue in order of absolute deadline, and in
+ * submission order for equal deadlines.  Under EDF (configUSE_EDF_SCHEDULER set
+ * to 1) the worker also runs with the deadline of its most urgent item, so it
+ * is scheduled against the other tasks as a job with that deadline would be.
+ * Submitting an item with an earlier deadline makes the worker more urgent at
+ * once, through vTaskRaiseDeadlineFromISR().  An idle worker has no deadline.
+ *
+ * ***NOTE***:  The worker takes up to uxLength items from the MPSC queue at a
+ * time.  The deadline of an item submitted while it holds that many only counts
+ * once the item is taken.  Items run to completion one after the other, so the
+ * latency of an item includes the item running when it is submitted.  The
+ * worker blocks on its direct to task notification, which items must not use.
+ */
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include workqueue.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The relative deadline of an item that has none.  Such items run after all
+ * items that have one.  Under EDF, where a task with no deadline would never be
+ * scheduled ahead of the idle task, they are given EDF_IDLE_PERIOD instead and
+ * so run as background work, like the idle task does. */
+#define workqueueNO_DEADLINE    portMAX_DELAY
+
+/**
+ * Type by which work queues are referenced.  For example, a call to
+ * xWorkQueueCreate() returns a WorkQueueHandle_t variable that can then be
+ * used as a parameter to xWorkQueueSubmitFromISR(), etc.
+ */
+struct WorkQueueDef_t;
+typedef struct WorkQueueDef_t * WorkQueueHandle_t;
+
+/*
+ * Defines the prototype to which work functions must conform.  It is the same
+ * as that of functions passed to xTimerPendFunctionCallFromISR().
+ */
+typedef void (* WorkFunction_t)( void *,
+                                 uint32_t );
+
+/**
+ * workqueue.h
+ * @code{c}
+ * WorkQueueHandle_t xWorkQueueCreate( const char * const pcName,
+ *                                     const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                     UBaseType_t uxPriority,
+ *                                     UBaseType_t uxLength );
+ * @endcode
+ *
+ * Creates a work queue and its worker task.  The work queue, its MPSC queue
+ * and the worker are allocated with pvPortMalloc(), so
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1.  Work queues are not
+ * deleted.
+ *
+ * @param pcName The name of the worker task.
+ *
+ * @param usStackDepth The stack depth of the worker task, in words.  The work
+ * functions run on this stack.
+ *
+ * @param uxPriority The priority of the worker task.  Under EDF the worker is
+ * scheduled by the deadlines of its items instead.
+ *
+ * @param uxLength The number of items that can be submitted and not yet run.
+ * It must be a power of two.  Up to uxLength further items can wait in the
+ * MPSC queue while the worker holds uxLength.
+ *
+ * @return The handle of the work queue, or NULL if there was not enough heap
+ * memory to create it.
+ *
+ * Example usage:
+ * @code{c}
+ * static WorkQueueHandle_t xUartWork;
+ *
+ * static void prvProcessRx( void * pvBuffer, uint32_t ulLength )
+ * {
+ *  // Runs in the worker task.
+ * }
+ *
+ * void vUartRxISR( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  // The bytes must be processed within 2 ms.
+ *  xWorkQueueSubmitFromISR( xUartWork, prvProcessRx, pvRxBuffer, ulRxLength, pdMS_TO_TICKS( 2 ), &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void main( void )
+ * {
+ *  xUartWork = xWorkQueueCreate( "UartWork", configMINIMAL_STACK_SIZE, configMAX_PRIORITIES - 1, 8 );
+ *  ...
+ * }
+ * @endcode
+ * \defgroup xWorkQueueCreate xWorkQueueCreate
+ * \ingroup WorkQueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const configSTACK_DEPTH_TYPE usStackDepth,
+                                        UBaseType_t uxPriority,
+                                        UBaseType_t uxLength ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * workqueue.h
+ * @code{c}
+ * BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+ *                              WorkFunction_t pxFunction,
+ *                              void * pvParameter1,
+ *                              uint32_t ulParameter2,
+ *                              TickType_t xRelativeDeadline,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Submits a call of pxFunction( pvParameter1, ulParameter2 ) to be made by the
+ * worker of the work queue.
+ *
+ * @param xWorkQueue The handle of the work queue.
+ *
+ * @param pxFunction The function to call.
+ *
+ * @param pvParameter1 The first parameter of the function.
+ *
+ * @param ulParameter2 The second parameter of the function.
+ *
+ * @param xRelativeDeadline The number of ticks from now by which the call
+ * should have been made, or workqueueNO_DEADLINE.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space should the work queue be full.
+ *
+ * @return pdPASS if the item was submitted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xWorkQueueSubmit xWorkQueueSubmit
+ * \ingroup WorkQueueManagement
+ */
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkFunction_t pxFunction,
+                             void * pvParameter1,
+                             uint32_t ulParameter2,
+                             TickType_t xRelativeDeadline,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+ *                                     WorkFunction_t pxFunction,
+ *                                     void * pvParameter1,
+ *                                     uint32_t ulParameter2,
+ *                                     TickType_t xRelativeDeadline,
+ *                                     BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * As xWorkQueueSubmit(), from an interrupt service routine.  It never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the worker should run
+ * before the interrupted task, in which case a context switch should be
+ * requested before the interrupt is exited.  It can be NULL.
+ *
+ * @return pdPASS if the item was submitted, or errQUEUE_FULL if the work
+ * queue was full and the item was dropped.
+ *
+ * \defgroup xWorkQueueSubmitFromISR xWorkQueueSubmitFromISR
+ * \ingroup WorkQueueManagement
+ */
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkFunction_t pxFunction,
+                                    void * pvParameter1,
+                                    uint32_t ulParameter2,
+                                    TickType_t xRelativeDeadline,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ * @code{c}
+ * TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue );
+ * @endcode
+ *
+ * Returns the handle of the worker task of the work queue, for example to
+ * change its priority.
+ *
+ * \defgroup xWorkQueueGetWorkerHandle xWorkQueueGetWorkerHandle
+ * \ingroup WorkQueueManagement
+ */
+TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( WORK_QUEUE_H ) */
@@ -0,0 +1,501 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "mem_pool.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* ulTop holds the index of the block at the top of the free stack in its low
+ * 16 bits, mempoolNO_BLOCK when the pool is empty, and a count of the changes
+ * made to it in its top 16 bits.  The count makes the compare-and-swap fail
+ * for a task that read ulTop before another task or interrupt took the block
+ * and put it back with a different block under it. */
+#define mempoolINDEX_MASK     ( ( uint32_t ) 0x0000FFFFUL )
+#define mempoolNO_BLOCK       mempoolINDEX_MASK
+#define mempoolCOUNT_ONE      ( ( uint32_t ) 0x00010000UL )
+#define mempoolMAX_BLOCKS     ( ( UBaseType_t ) 0xFFFFU )
+
+/* While a block is free its first uint32_t holds the index of the block under
+ * it on the free stack. */
+typedef struct MemPoolDef_t
+{
+    volatile uint32_t ulTop;                   /* The top of the free stack.  Only changed with Atomic_CompareAndSwap_u32(). */
+    volatile uint32_t ulFreeBlocks;            /* Incremented before a block is returned and decremented after one is taken, so never too low. */
+    volatile uint32_t ulMinimumEverFreeBlocks;
+    List_t xTasksWaitingToAllocate;            /* Tasks blocked on the empty pool. */
+    uint8_t * pucStorage;
+    size_t xBlockSize;                         /* Rounded up by mempoolBLOCK_SIZE(). */
+    UBaseType_t uxBlockCount;
+    uint8_t ucStaticallyAllocated;             /* Set to pdTRUE if the pool was created with xMemPoolCreateStatic(). */
+} MemPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Fills in a new pool and puts all of its blocks on the free stack.
+ */
+static void prvInitialiseNewMemPool( MemPool_t * const pxMemPool,
+                                     UBaseType_t uxBlockSize,
+                                     UBaseType_t uxBlockCount,
+                                     uint8_t * pucPoolStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes the block at the top of the free stack.  Returns NULL if the pool is
+ * empty.
+ */
+static void * prvTakeBlock( MemPool_t * const pxMemPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Puts pvBlock on top of the free stack.
+ */
+static void prvReturnBlock( MemPool_t * const pxMemPool,
+                            void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds lDelta to *pulCount and returns the result, using
+ * Atomic_CompareAndSwap_u32() so no critical section is needed where the port
+ * provides one.
+ */
+static uint32_t prvAddToCount( volatile uint32_t * pulCount,
+                               int32_t lDelta ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewMemPool( MemPool_t * const pxMemPool,
+                                     UBaseType_t uxBlockSize,
+                                     UBaseType_t uxBlockCount,
+                                     uint8_t * pucPoolStorage )
+{
+    UBaseType_t uxBlock;
+
+    pxMemPool->pucStorage = pucPoolStorage;
+    pxMemPool->xBlockSize = mempoolBLOCK_SIZE( uxBlockSize );
+    pxMemPool->uxBlockCount = uxBlockCount;
+    pxMemPool->ulFreeBlocks = ( uint32_t ) uxBlockCount;
+    pxMemPool->ulMinimumEverFreeBlocks = ( uint32_t ) uxBlockCount;
+    pxMemPool->ucStaticallyAllocated = ( uint8_t ) pdFALSE;
+    vListInitialise( &( pxMemPool->xTasksWaitingToAllocate ) );
+
+    /* Block 0 goes on top, and the last block at the bottom. */
+    for( uxBlock = ( UBaseType_t ) 0; uxBlock < uxBlockCount; uxBlock++ )
+    {
+        if( ( uxBlock + ( UBaseType_t ) 1 ) < uxBlockCount )
+        {
+            *( ( uint32_t * ) &( pucPoolStorage[ uxBlock * pxMemPool->xBlockSize ] ) ) = ( uint32_t ) uxBlock + ( uint32_t ) 1; /*lint !e9087 !e826 Blocks are aligned to portBYTE_ALIGNMENT. */
+        }
+        else
+        {
+            *( ( uint32_t * ) &( pucPoolStorage[ uxBlock * pxMemPool->xBlockSize ] ) ) = mempoolNO_BLOCK; /*lint !e9087 !e826 Blocks are aligned to portBYTE_ALIGNMENT. */
+        }
+    }
+
+    pxMemPool->ulTop = ( uint32_t ) 0;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    MemPoolHandle_t xMemPoolCreate( UBaseType_t uxBlockSize,
+                                    UBaseType_t uxBlockCount )
+    {
+        MemPool_t * pxMemPool;
+        size_t xHeaderBytes, xStorageBytes;
+
+        configASSERT( uxBlockSize > ( UBaseType_t ) 0 );
+        configASSERT( ( uxBlockCount > ( UBaseType_t ) 0 ) && ( uxBlockCount <= mempoolMAX_BLOCKS ) );
+
+        /* The blocks follow the structure, aligned to portBYTE_ALIGNMENT as
+         * pvPortMalloc() aligns the structure. */
+        xHeaderBytes = ( sizeof( MemPool_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+        xStorageBytes = mempoolSTORAGE_SIZE( uxBlockSize, uxBlockCount );
+
+        /* Check for multiplication and addition overflow. */
+        configASSERT( ( xStorageBytes / mempoolBLOCK_SIZE( uxBlockSize ) ) == ( size_t ) uxBlockCount );
+        configASSERT( ( xHeaderBytes + xStorageBytes ) > xStorageBytes );
+
+        pxMemPool = ( MemPool_t * ) pvPortMalloc( xHeaderBytes + xStorageBytes ); /*lint !e9087 !e9079 The pool and its storage are one allocation. */
+
+        if( pxMemPool != NULL )
+        {
+            prvInitialiseNewMemPool( pxMemPool, uxBlockSize, uxBlockCount, ( ( uint8_t * ) pxMemPool ) + xHeaderBytes ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxMemPool;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    MemPoolHandle_t xMemPoolCreateStatic( UBaseType_t uxBlockSize,
+                                          UBaseType_t uxBlockCount,
+                                          uint8_t * pucPoolStorage,
+                                          StaticMemPool_t * pxStaticMemPool )
+    {
+        MemPool_t * const pxMemPool = ( MemPool_t * ) pxStaticMemPool; /*lint !e740 !e9087 MemPool_t and StaticMemPool_t are guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+        MemPoolHandle_t xReturn = NULL;
+
+        configASSERT( pucPoolStorage );
+        configASSERT( pxStaticMemPool );
+        configASSERT( uxBlockSize > ( UBaseType_t ) 0 );
+        configASSERT( ( uxBlockCount > ( UBaseType_t ) 0 ) && ( uxBlockCount <= mempoolMAX_BLOCKS ) );
+        configASSERT( ( ( ( size_t ) pucPoolStorage ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == ( size_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticMemPool_t equals the size of the real
+                 * pool structure. */
+                volatile size_t xSize = sizeof( StaticMemPool_t );
+                configASSERT( xSize == sizeof( MemPool_t ) );
+            } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucPoolStorage != NULL ) && ( pxStaticMemPool != NULL ) )
+        {
+            prvInitialiseNewMemPool( pxMemPool, uxBlockSize, uxBlockCount, pucPoolStorage );
+            pxMemPool->ucStaticallyAllocated = ( uint8_t ) pdTRUE;
+            xReturn = pxMemPool;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vMemPoolDelete( MemPoolHandle_t xMemPool )
+{
+    configASSERT( xMemPool );
+    configASSERT( listLIST_IS_EMPTY( &( xMemPool->xTasksWaitingToAllocate ) ) != pdFALSE );
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            if( xMemPool->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFree( ( void * ) xMemPool );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvAddToCount( volatile uint32_t * pulCount,
+                               int32_t lDelta )
+{
+    uint32_t ulCount;
+
+    do
+    {
+        ulCount = *pulCount;
+    } while( Atomic_CompareAndSwap_u32( pulCount, ulCount + ( uint32_t ) lDelta, ulCount ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+    return ulCount + ( uint32_t ) lDelta;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvTakeBlock( MemPool_t * const pxMemPool )
+{
+    uint32_t ulTop, ulIndex, ulNext, ulFreeBlocks, ulMinimum;
+    void * pvReturn = NULL;
+
+    for( ; ; )
+    {
+        ulTop = pxMemPool->ulTop;
+        ulIndex = ulTop & mempoolINDEX_MASK;
+
+        if( ulIndex == mempoolNO_BLOCK )
+        {
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* If another task or interrupt takes the block first this reads
+         * whatever its new owner wrote there, but the swap below then fails as
+         * ulTop has changed. */
+        ulNext = *( ( volatile uint32_t * ) &( pxMemPool->pucStorage[ ulIndex * pxMemPool->xBlockSize ] ) ) & mempoolINDEX_MASK; /*lint !e9087 !e826 Blocks are aligned to portBYTE_ALIGNMENT. */
+
+        if( Atomic_CompareAndSwap_u32( &( pxMemPool->ulTop ), ( ( ulTop & ~mempoolINDEX_MASK ) + mempoolCOUNT_ONE ) | ulNext, ulTop ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            pvReturn = ( void * ) &( pxMemPool->pucStorage[ ulIndex * pxMemPool->xBlockSize ] );
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( pvReturn != NULL )
+    {
+        ulFreeBlocks = prvAddToCount( &( pxMemPool->ulFreeBlocks ), -1 );
+        ulMinimum = pxMemPool->ulMinimumEverFreeBlocks;
+
+        while( ulFreeBlocks < ulMinimum )
+        {
+            if( Atomic_CompareAndSwap_u32( &( pxMemPool->ulMinimumEverFreeBlocks ), ulFreeBlocks, ulMinimum ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+            {
+                break;
+            }
+            else
+            {
+                ulMinimum = pxMemPool->ulMinimumEverFreeBlocks;
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReturnBlock( MemPool_t * const pxMemPool,
+                            void * pvBlock )
+{
+    const size_t xOffset = ( size_t ) ( ( uint8_t * ) pvBlock - pxMemPool->pucStorage );
+    const uint32_t ulIndex = ( uint32_t ) ( xOffset / pxMemPool->xBlockSize );
+    uint32_t ulTop;
+
+    /* Check the block belongs to the pool. */
+    configASSERT( ( uint8_t * ) pvBlock >= pxMemPool->pucStorage );
+    configASSERT( ( xOffset % pxMemPool->xBlockSize ) == ( size_t ) 0 );
+    configASSERT( ulIndex < ( uint32_t ) pxMemPool->uxBlockCount );
+
+    ( void ) prvAddToCount( &( pxMemPool->ulFreeBlocks ), 1 );
+
+    do
+    {
+        ulTop = pxMemPool->ulTop;
+        *( ( volatile uint32_t * ) pvBlock ) = ulTop & mempoolINDEX_MASK;
+
+        /* The link must be in the block before the block can be taken. */
+        portMEMORY_BARRIER();
+    } while( Atomic_CompareAndSwap_u32( &( pxMemPool->ulTop ), ( ( ulTop & ~mempoolINDEX_MASK ) + mempoolCOUNT_ONE ) | ulIndex, ulTop ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemPoolAlloc( MemPoolHandle_t xMemPool,
+                       TickType_t xTicksToWait )
+{
+    MemPool_t * const pxMemPool = xMemPool;
+    void * pvReturn;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxMemPool );
+
+    pvReturn = prvTakeBlock( pxMemPool );
+
+    if( ( pvReturn == NULL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+            }
+        #endif
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* vMemPoolFree() and vMemPoolFreeFromISR() return the block before
+             * they look for a task to unblock, and do that with interrupts
+             * masked.  So either the block is seen here or this task is found
+             * in xTasksWaitingToAllocate. */
+            taskENTER_CRITICAL();
+            {
+                if( ( pxMemPool->ulTop & mempoolINDEX_MASK ) == mempoolNO_BLOCK )
+                {
+                    vTaskPlaceOnEventList( &( pxMemPool->xTasksWaitingToAllocate ), xTicksToWait );
+
+                    /* As in ulTaskGenericNotifyTake(), ports allow a yield
+                     * in a critical section. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            pvReturn = prvTakeBlock( pxMemPool );
+        } while( ( pvReturn == NULL ) &&
+                 ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool )
+{
+    configASSERT( xMemPool );
+
+    return prvTakeBlock( xMemPool );
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFree( MemPoolHandle_t xMemPool,
+                   void * pvBlock )
+{
+    MemPool_t * const pxMemPool = xMemPool;
+    BaseType_t xYieldRequired = pdFALSE;
+
+    configASSERT( pxMemPool );
+    configASSERT( pvBlock );
+
+    prvReturnBlock( pxMemPool, pvBlock );
+
+    if( listLIST_IS_EMPTY( &( pxMemPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* The task may have timed out since the check above. */
+            if( listLIST_IS_EMPTY( &( pxMemPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+            {
+                xYieldRequired = xTaskRemoveFromEventList( &( pxMemPool->xTasksWaitingToAllocate ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool,
+                          void * pvBlock,
+                          BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    MemPool_t * const pxMemPool = xMemPool;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxMemPool );
+    configASSERT( pvBlock );
+
+    prvReturnBlock( pxMemPool, pvBlock );
+
+    if( listLIST_IS_EMPTY( &( pxMemPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+    {
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( listLIST_IS_EMPTY( &( pxMemPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+            {
+                if( ( xTaskRemoveFromEventList( &( pxMemPool->xTasksWaitingToAllocate ) ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemPoolGetFreeBlocks( MemPoolHandle_t xMemPool )
+{
+    configASSERT( xMemPool );
+
+    return ( UBaseType_t ) xMemPool->ulFreeBlocks;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemPoolGetMinimumEverFreeBlocks( MemPoolHandle_t xMemPool )
+{
+    configASSERT( xMemPool );
+
+    return ( UBaseType_t ) xMemPool->ulMinimumEverFreeBlocks;
+}
@@ -0,0 +1,488 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "mpsc_queue.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build mpsc_queue.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* ulHead and ulTail count positions and are never wrapped, the slot of a
+ * position is ( position & ulMask ).  Each slot has a sequence number that says
+ * whose turn it is: equal to the position of the slot means free for the
+ * producer that claims that position, one more means it holds that position's
+ * item, and the consumer frees it for the next lap by adding the queue length.
+ * So a producer never has to look at ulTail and the consumer never has to look
+ * at ulHead. */
+typedef struct MpscQueueDef_t
+{
+    volatile uint32_t ulHead;                     /* Next position a producer claims.  Advanced with Atomic_CompareAndSwap_u32(). */
+    volatile uint32_t ulTail;                     /* Next position the consumer reads.  Only written by the consumer. */
+    volatile TaskHandle_t xTaskWaitingToReceive;  /* The consumer while it is about to block or blocked on the queue, otherwise NULL. */
+    List_t xTasksWaitingToSend;                   /* Senders blocked on the full queue.  Only changed by tasks. */
+    uint32_t ulMask;                              /* Queue length - 1, the length is a power of two. */
+    UBaseType_t uxItemSize;
+    volatile uint32_t * pulSequence;
+    uint8_t * pucStorage;
+} MpscQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Claims the next slot and copies pvItem into it if the queue is not full.
+ * Returns the consumer's handle if it must be notified, else NULL.
+ */
+static TaskHandle_t prvWriteItem( MpscQueue_t * const pxQueue,
+                                  const void * pvItem,
+                                  BaseType_t * const pxReturn ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the item at the front of the queue into pvBuffer and frees its slot.
+ * Returns pdFAIL if the front slot has not been filled yet.
+ */
+static BaseType_t prvReadItem( MpscQueue_t * const pxQueue,
+                               void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the first task waiting to send, if there is one, after a slot was
+ * freed.
+ */
+static void prvUnblockSender( MpscQueue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    MpscQueueHandle_t xMpscQueueCreate( UBaseType_t uxLength,
+                                        UBaseType_t uxItemSize )
+    {
+        MpscQueue_t * pxQueue;
+        size_t xSequenceBytes, xStorageBytes;
+        uint32_t ulSlot;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* A power of two, so that the slot of a position is unchanged when
+         * the position wraps, and small enough for the sequence numbers. */
+        configASSERT( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 );
+        configASSERT( ( uint32_t ) uxLength <= ( uint32_t ) 0x40000000UL );
+
+        xSequenceBytes = ( size_t ) uxLength * sizeof( uint32_t );
+        xStorageBytes = ( size_t ) uxLength * ( size_t ) uxItemSize;
+
+        /* Check for multiplication and addition overflow. */
+        configASSERT( ( xStorageBytes / uxItemSize ) == ( size_t ) uxLength );
+        configASSERT( ( sizeof( MpscQueue_t ) + xSequenceBytes + xStorageBytes ) > xStorageBytes );
+
+        /* The queue, its sequence numbers and its storage are allocated in one
+         * go.  The structure's size is a multiple of the alignment of the
+         * uint32_t that follow it. */
+        pxQueue = ( MpscQueue_t * ) pvPortMalloc( sizeof( MpscQueue_t ) + xSequenceBytes + xStorageBytes ); /*lint !e9087 !e9079 The queue and its storage are one allocation. */
+
+        if( pxQueue != NULL )
+        {
+            pxQueue->ulHead = ( uint32_t ) 0;
+            pxQueue->ulTail = ( uint32_t ) 0;
+            pxQueue->xTaskWaitingToReceive = NULL;
+            vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
+            pxQueue->ulMask = ( uint32_t ) uxLength - ( uint32_t ) 1;
+            pxQueue->uxItemSize = uxItemSize;
+            pxQueue->pulSequence = ( volatile uint32_t * ) ( ( ( uint8_t * ) pxQueue ) + sizeof( MpscQueue_t ) ); /*lint !e9016 !e9087 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+            pxQueue->pucStorage = ( ( uint8_t * ) pxQueue ) + sizeof( MpscQueue_t ) + xSequenceBytes; /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+
+            for( ulSlot = ( uint32_t ) 0; ulSlot <= pxQueue->ulMask; ulSlot++ )
+            {
+                pxQueue->pulSequence[ ulSlot ] = ulSlot;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vMpscQueueDelete( MpscQueueHandle_t xQueue )
+{
+    configASSERT( xQueue );
+    configASSERT( xQueue->xTaskWaitingToReceive == NULL );
+    configASSERT( listLIST_IS_EMPTY( &( xQueue->xTasksWaitingToSend ) ) != pdFALSE );
+
+    vPortFree( ( void * ) xQueue );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvWriteItem( MpscQueue_t * const pxQueue,
+                                  const void * pvItem,
+                                  BaseType_t * const pxReturn )
+{
+    uint32_t ulPosition, ulSlot;
+    int32_t lTurn;
+    TaskHandle_t xTaskToNotify = NULL;
+
+    *pxReturn = errQUEUE_FULL;
+    ulPosition = pxQueue->ulHead;
+
+    for( ; ; )
+    {
+        ulSlot = ulPosition & pxQueue->ulMask;
+        lTurn = ( int32_t ) ( pxQueue->pulSequence[ ulSlot ] - ulPosition );
+
+        if( lTurn == ( int32_t ) 0 )
+        {
+            /* The slot is free.  Claim it unless another producer, possibly
+             * an interrupt, has just done so. */
+            if( Atomic_CompareAndSwap_u32( &( pxQueue->ulHead ), ulPosition + ( uint32_t ) 1, ulPosition ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+            {
+                *pxReturn = pdPASS;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( lTurn < ( int32_t ) 0 )
+        {
+            /* The consumer has not freed the slot since the last lap. */
+            break;
+        }
+        else
+        {
+            /* ulPosition was claimed after ulHead was read. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ulPosition = pxQueue->ulHead;
+    }
+
+    if( *pxReturn == pdPASS )
+    {
+        ( void ) memcpy( ( void * ) &( pxQueue->pucStorage[ ulSlot * pxQueue->uxItemSize ] ), pvItem, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        /* The item must be in the slot before the consumer can see it. */
+        portMEMORY_BARRIER();
+        pxQueue->pulSequence[ ulSlot ] = ulPosition + ( uint32_t ) 1;
+
+        /* As in spsc_ring.c, the consumer publishes xTaskWaitingToReceive and
+         * then checks the slot again, so at least one side sees the other. */
+        portMEMORY_BARRIER();
+
+        if( pxQueue->xTaskWaitingToReceive != NULL )
+        {
+            xTaskToNotify = pxQueue->xTaskWaitingToReceive;
+            pxQueue->xTaskWaitingToReceive = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xTaskToNotify;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMpscQueueSend( MpscQueueHandle_t xQueue,
+                           const void * pvItemToQueue,
+                           TickType_t xTicksToWait )
+{
+    MpscQueue_t * const pxQueue = xQueue;
+    TaskHandle_t xTaskToNotify;
+    BaseType_t xReturn;
+    TimeOut_t xTimeOut;
+    uint32_t ulPosition;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemToQueue );
+
+    xTaskToNotify = prvWriteItem( pxQueue, pvItemToQueue, &xReturn );
+
+    if( ( xReturn == errQUEUE_FULL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+            }
+        #endif
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* The consumer frees slots and unblocks senders, and it cannot run
+             * while the scheduler is suspended.  So either it freed the slot
+             * before the check below, or it will find this task in
+             * xTasksWaitingToSend. */
+            vTaskSuspendAll();
+            ulPosition = pxQueue->ulHead;
+
+            if( ( int32_t ) ( pxQueue->pulSequence[ ulPosition & pxQueue->ulMask ] - ulPosition ) < ( int32_t ) 0 )
+            {
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                ( void ) xTaskResumeAll();
+            }
+
+            xTaskToNotify = prvWriteItem( pxQueue, pvItemToQueue, &xReturn );
+        } while( ( xReturn == errQUEUE_FULL ) &&
+                 ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xTaskToNotify != NULL )
+    {
+        ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMpscQueueSendFromISR( MpscQueueHandle_t xQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    MpscQueue_t * const pxQueue = xQueue;
+    TaskHandle_t xTaskToNotify;
+    BaseType_t xReturn;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemToQueue );
+
+    xTaskToNotify = prvWriteItem( pxQueue, pvItemToQueue, &xReturn );
+
+    if( xTaskToNotify != NULL )
+    {
+        ( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadItem( MpscQueue_t * const pxQueue,
+                               void * pvBuffer )
+{
+    uint32_t ulPosition = pxQueue->ulTail, ulSlot;
+    BaseType_t xReturn;
+
+    ulSlot = ulPosition & pxQueue->ulMask;
+
+    if( pxQueue->pulSequence[ ulSlot ] == ( ulPosition + ( uint32_t ) 1 ) )
+    {
+        /* Read the sequence number before the item it covers. */
+        portMEMORY_BARRIER();
+        ( void ) memcpy( pvBuffer, ( const void * ) &( pxQueue->pucStorage[ ulSlot * pxQueue->uxItemSize ] ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        /* The item must be copied out before a producer can reuse the slot. */
+        portMEMORY_BARRIER();
+        pxQueue->pulSequence[ ulSlot ] = ulPosition + pxQueue->ulMask + ( uint32_t ) 1;
+        pxQueue->ulTail = ulPosition + ( uint32_t ) 1;
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = pdFAIL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnblockSender( MpscQueue_t * const pxQueue )
+{
+    BaseType_t xYieldRequired = pdFALSE;
+
+    /* Reading the list length without a critical section is safe here: a
+     * sender only adds itself with the scheduler suspended, when this task
+     * cannot be running, and checks for a free slot first. */
+    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* The sender may have timed out since the check above. */
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMpscQueueReceive( MpscQueueHandle_t xQueue,
+                              void * pvBuffer,
+                              TickType_t xTicksToWait )
+{
+    MpscQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    TimeOut_t xTimeOut;
+    uint32_t ulPosition;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+
+    xReturn = prvReadItem( pxQueue, pvBuffer );
+
+    if( ( xReturn == pdFAIL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Drop any notification left over from an earlier wait, then say
+             * that this task is waiting and look once more, as a producer may
+             * have filled the slot just before xTaskWaitingToReceive was
+             * set. */
+            ( void ) xTaskNotifyStateClear( NULL );
+
+            /* Should only be one consumer. */
+            configASSERT( pxQueue->xTaskWaitingToReceive == NULL );
+            pxQueue->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            portMEMORY_BARRIER();
+
+            ulPosition = pxQueue->ulTail;
+
+            if( pxQueue->pulSequence[ ulPosition & pxQueue->ulMask ] != ( ulPosition + ( uint32_t ) 1 ) )
+            {
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Whether or not a producer cleared it. */
+            pxQueue->xTaskWaitingToReceive = NULL;
+
+            xReturn = prvReadItem( pxQueue, pvBuffer );
+        } while( ( xReturn == pdFAIL ) &&
+                 ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn == pdPASS )
+    {
+        prvUnblockSender( pxQueue );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMpscQueueMessagesWaiting( MpscQueueHandle_t xQueue )
+{
+    const MpscQueue_t * const pxQueue = xQueue;
+    uint32_t ulTail;
+
+    configASSERT( pxQueue );
+
+    /* Read ulTail first, so that the difference cannot be negative. */
+    ulTail = pxQueue->ulTail;
+    portMEMORY_BARRIER();
+
+    return ( UBaseType_t ) ( pxQueue->ulHead - ulTail );
+}
+/*-----------------------------------------------------------*/
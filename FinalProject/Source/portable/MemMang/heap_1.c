@@ -44,6 +44,10 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    #include "heap_trace.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
@@ -73,6 +77,11 @@ void * pvPortMalloc( size_t xWantedSize )
     void * pvReturn = NULL;
     static uint8_t * pucAlignedHeap = NULL;
 
+    #if ( configGENERATE_HEAP_TRACE == 1 )
+        void * const pvCaller = portGET_HEAP_TRACE_CALLER();
+        const size_t xRequestedSize = xWantedSize;
+    #endif
+
     /* Ensure that blocks are always aligned. */
     #if ( portBYTE_ALIGNMENT != 1 )
         {
@@ -111,6 +120,15 @@ void * pvPortMalloc( size_t xWantedSize )
         }
 
         traceMALLOC( pvReturn, xWantedSize );
+
+        #if ( configGENERATE_HEAP_TRACE == 1 )
+            {
+                /* All the free bytes are in one block. */
+                vHeapTraceRecord( ( pvReturn != NULL ) ? eHeapTraceMalloc : eHeapTraceMallocFailed, pvReturn,
+                                  ( pvReturn != NULL ) ? xWantedSize : xRequestedSize, pvCaller,
+                                  configADJUSTED_HEAP_SIZE - xNextFreeByte, configADJUSTED_HEAP_SIZE - xNextFreeByte );
+            }
+        #endif
     }
     ( void ) xTaskResumeAll();
 
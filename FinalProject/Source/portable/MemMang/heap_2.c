@@ -45,6 +45,10 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    #include "heap_trace.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
@@ -59,6 +63,13 @@
  */
 static void prvHeapInit( void );
 
+/*
+ * Returns the size of the largest free block, for the heap trace.
+ */
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    static size_t prvGetLargestFreeBlock( void );
+#endif
+
 /* Allocate the memory for the heap. */
 #if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
 
@@ -123,6 +134,11 @@ void * pvPortMalloc( size_t xWantedSize )
     static BaseType_t xHeapHasBeenInitialised = pdFALSE;
     void * pvReturn = NULL;
 
+    #if ( configGENERATE_HEAP_TRACE == 1 )
+        void * const pvCaller = portGET_HEAP_TRACE_CALLER();
+        const size_t xRequestedSize = xWantedSize;
+    #endif
+
     vTaskSuspendAll();
     {
         /* If this is the first call to malloc then the heap will require
@@ -204,6 +220,21 @@ void * pvPortMalloc( size_t xWantedSize )
         }
 
         traceMALLOC( pvReturn, xWantedSize );
+
+        #if ( configGENERATE_HEAP_TRACE == 1 )
+            {
+                if( pvReturn != NULL )
+                {
+                    vHeapTraceRecord( eHeapTraceMalloc, pvReturn, pxBlock->xBlockSize, pvCaller,
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+                else
+                {
+                    vHeapTraceRecord( eHeapTraceMallocFailed, NULL, xRequestedSize, pvCaller,
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+            }
+        #endif /* configGENERATE_HEAP_TRACE */
     }
     ( void ) xTaskResumeAll();
 
@@ -242,6 +273,13 @@ void vPortFree( void * pv )
             prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
             xFreeBytesRemaining += pxLink->xBlockSize;
             traceFREE( pv, pxLink->xBlockSize );
+
+            #if ( configGENERATE_HEAP_TRACE == 1 )
+                {
+                    vHeapTraceRecord( eHeapTraceFree, pv, pxLink->xBlockSize, portGET_HEAP_TRACE_CALLER(),
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+            #endif
         }
         ( void ) xTaskResumeAll();
     }
@@ -284,3 +322,23 @@ static void prvHeapInit( void )
     pxFirstFreeBlock->pxNextFreeBlock = &xEnd;
 }
 /*-----------------------------------------------------------*/
+
+#if ( configGENERATE_HEAP_TRACE == 1 )
+
+    static size_t prvGetLargestFreeBlock( void )
+    {
+        BlockLink_t * pxBlock;
+        size_t xMaxSize = 0;
+
+        /* The list is in order of size, so the largest block is the last one
+         * before xEnd. */
+        for( pxBlock = xStart.pxNextFreeBlock; pxBlock != &xEnd; pxBlock = pxBlock->pxNextFreeBlock )
+        {
+            xMaxSize = pxBlock->xBlockSize;
+        }
+
+        return xMaxSize;
+    }
+
+#endif /* configGENERATE_HEAP_TRACE */
+/*-----------------------------------------------------------*/
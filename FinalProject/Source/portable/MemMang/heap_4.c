@@ -44,6 +44,10 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    #include "heap_trace.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
@@ -90,6 +94,13 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEG
  */
 static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Returns the size of the largest free block, for the heap trace.
+ */
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    static size_t prvGetLargestFreeBlock( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -119,6 +130,11 @@ void * pvPortMalloc( size_t xWantedSize )
     BlockLink_t * pxBlock, * pxPreviousBlock, * pxNewBlockLink;
     void * pvReturn = NULL;
 
+    #if ( configGENERATE_HEAP_TRACE == 1 )
+        void * const pvCaller = portGET_HEAP_TRACE_CALLER();
+        const size_t xRequestedSize = xWantedSize;
+    #endif
+
     vTaskSuspendAll();
     {
         /* If this is the first call to malloc then the heap will require
@@ -252,6 +268,21 @@ void * pvPortMalloc( size_t xWantedSize )
         }
 
         traceMALLOC( pvReturn, xWantedSize );
+
+        #if ( configGENERATE_HEAP_TRACE == 1 )
+            {
+                if( pvReturn != NULL )
+                {
+                    vHeapTraceRecord( eHeapTraceMalloc, pvReturn, pxBlock->xBlockSize & ~xBlockAllocatedBit, pvCaller,
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+                else
+                {
+                    vHeapTraceRecord( eHeapTraceMallocFailed, NULL, xRequestedSize, pvCaller,
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+            }
+        #endif /* configGENERATE_HEAP_TRACE */
     }
     ( void ) xTaskResumeAll();
 
@@ -279,6 +310,10 @@ void vPortFree( void * pv )
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
 
+    #if ( configGENERATE_HEAP_TRACE == 1 )
+        size_t xFreedSize;
+    #endif
+
     if( pv != NULL )
     {
         /* The memory being freed will have an BlockLink_t structure immediately
@@ -305,8 +340,23 @@ void vPortFree( void * pv )
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE( pv, pxLink->xBlockSize );
+
+                    #if ( configGENERATE_HEAP_TRACE == 1 )
+                        {
+                            /* prvInsertBlockIntoFreeList() may merge it with its neighbours. */
+                            xFreedSize = pxLink->xBlockSize;
+                        }
+                    #endif
+
                     prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
                     xNumberOfSuccessfulFrees++;
+
+                    #if ( configGENERATE_HEAP_TRACE == 1 )
+                        {
+                            vHeapTraceRecord( eHeapTraceFree, pv, xFreedSize, portGET_HEAP_TRACE_CALLER(),
+                                              xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                        }
+                    #endif
                 }
                 ( void ) xTaskResumeAll();
             }
@@ -452,6 +502,32 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVI
 }
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_HEAP_TRACE == 1 )
+
+    static size_t prvGetLargestFreeBlock( void ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock;
+        size_t xMaxSize = 0;
+
+        /* Only called once the heap is initialised. */
+        for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+        {
+            if( pxBlock->xBlockSize > xMaxSize )
+            {
+                xMaxSize = pxBlock->xBlockSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xMaxSize;
+    }
+
+#endif /* configGENERATE_HEAP_TRACE */
+/*-----------------------------------------------------------*/
+
 void vPortGetHeapStats( HeapStats_t * pxHeapStats )
 {
     BlockLink_t * pxBlock;
@@ -78,6 +78,10 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    #include "heap_trace.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
@@ -108,6 +112,13 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert );
 
+/*
+ * Returns the size of the largest free block, for the heap trace.
+ */
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    static size_t prvGetLargestFreeBlock( void );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -137,6 +148,11 @@ void * pvPortMalloc( size_t xWantedSize )
     BlockLink_t * pxBlock, * pxPreviousBlock, * pxNewBlockLink;
     void * pvReturn = NULL;
 
+    #if ( configGENERATE_HEAP_TRACE == 1 )
+        void * const pvCaller = portGET_HEAP_TRACE_CALLER();
+        const size_t xRequestedSize = xWantedSize;
+    #endif
+
     /* The heap must be initialised before the first call to
      * prvPortMalloc(). */
     configASSERT( pxEnd );
@@ -261,6 +277,21 @@ void * pvPortMalloc( size_t xWantedSize )
         }
 
         traceMALLOC( pvReturn, xWantedSize );
+
+        #if ( configGENERATE_HEAP_TRACE == 1 )
+            {
+                if( pvReturn != NULL )
+                {
+                    vHeapTraceRecord( eHeapTraceMalloc, pvReturn, pxBlock->xBlockSize & ~xBlockAllocatedBit, pvCaller,
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+                else
+                {
+                    vHeapTraceRecord( eHeapTraceMallocFailed, NULL, xRequestedSize, pvCaller,
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+            }
+        #endif /* configGENERATE_HEAP_TRACE */
     }
     ( void ) xTaskResumeAll();
 
@@ -287,6 +318,10 @@ void vPortFree( void * pv )
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
 
+    #if ( configGENERATE_HEAP_TRACE == 1 )
+        size_t xFreedSize;
+    #endif
+
     if( pv != NULL )
     {
         /* The memory being freed will have an BlockLink_t structure immediately
@@ -313,8 +348,23 @@ void vPortFree( void * pv )
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE( pv, pxLink->xBlockSize );
+
+                    #if ( configGENERATE_HEAP_TRACE == 1 )
+                        {
+                            /* prvInsertBlockIntoFreeList() may merge it with its neighbours. */
+                            xFreedSize = pxLink->xBlockSize;
+                        }
+                    #endif
+
                     prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
                     xNumberOfSuccessfulFrees++;
+
+                    #if ( configGENERATE_HEAP_TRACE == 1 )
+                        {
+                            vHeapTraceRecord( eHeapTraceFree, pv, xFreedSize, portGET_HEAP_TRACE_CALLER(),
+                                              xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                        }
+                    #endif
                 }
                 ( void ) xTaskResumeAll();
             }
@@ -406,6 +456,33 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_HEAP_TRACE == 1 )
+
+    static size_t prvGetLargestFreeBlock( void )
+    {
+        BlockLink_t * pxBlock;
+        size_t xMaxSize = 0;
+
+        /* The list runs through the end markers of all the regions but the
+         * last, which are never larger. */
+        for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+        {
+            if( pxBlock->xBlockSize > xMaxSize )
+            {
+                xMaxSize = pxBlock->xBlockSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xMaxSize;
+    }
+
+#endif /* configGENERATE_HEAP_TRACE */
+/*-----------------------------------------------------------*/
+
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
 {
     BlockLink_t * pxFirstFreeBlockInRegion = NULL, * pxPreviousFreeBlock;
@@ -0,0 +1,823 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that take a bounded
+ * time however fragmented the heap is.  As with heap_5.c the heap can be
+ * defined across multiple non-contiguous blocks, and adjacent memory blocks are
+ * combined (coalesced) as they are freed.
+ *
+ * heap_4.c and heap_5.c keep a single list of free blocks in address order,
+ * which pvPortMalloc() walks to find a block large enough and vPortFree() walks
+ * to find where the freed block goes.  Both take longer the more fragmented the
+ * heap is.  This implementation uses two level segregated fit (TLSF) instead.
+ * Free blocks are kept in one list per size class.  The first level of classes
+ * are powers of two, and the second level splits each power of two into
+ * heapSL_INDEX_COUNT equal ranges.  A bitmap per level records which lists
+ * hold a block, so pvPortMalloc() finds the smallest class that is certain to
+ * fit the request with two bit scans and takes the first block in it.  Each
+ * block records the block before it in memory, so vPortFree() finds the blocks
+ * either side of the one being freed without searching.  Neither function
+ * loops over blocks.
+ *
+ * A request is served from the lowest class in which every block is large
+ * enough, so a block that would fit in the class below can be passed over.  The
+ * unused end of the block taken is returned to the heap.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc(), exactly
+ * as for heap_5.c - see heap_5.c for an example.  Unlike heap_5.c the regions
+ * do not have to be given in address order, but must not overlap.
+ *
+ * The size classes go up to 2 ^ configHEAP_6_MAX_BLOCK_SIZE_LOG2 bytes, which
+ * is also the limit on a single allocation.  A region larger than that is
+ * split into several free blocks that are never combined.
+ */
+#include <stddef.h>
+#include <limits.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    #include "heap_trace.h"
+#endif
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE          ( ( size_t ) 8 )
+
+#if portBYTE_ALIGNMENT == 32
+    #define heapBYTE_ALIGNMENT_LOG2    5
+#elif portBYTE_ALIGNMENT == 16
+    #define heapBYTE_ALIGNMENT_LOG2    4
+#elif portBYTE_ALIGNMENT == 8
+    #define heapBYTE_ALIGNMENT_LOG2    3
+#elif portBYTE_ALIGNMENT == 4
+    #define heapBYTE_ALIGNMENT_LOG2    2
+#elif portBYTE_ALIGNMENT == 2
+    #define heapBYTE_ALIGNMENT_LOG2    1
+#elif portBYTE_ALIGNMENT == 1
+    #define heapBYTE_ALIGNMENT_LOG2    0
+#else
+    #error "Invalid portBYTE_ALIGNMENT definition"
+#endif
+
+/* Each power of two is split into heapSL_INDEX_COUNT second level classes. */
+#define heapSL_INDEX_COUNT_LOG2    4
+#define heapSL_INDEX_COUNT         ( 1U << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all go in the first first level
+ * class, which is split into classes portBYTE_ALIGNMENT bytes apart. */
+#define heapFL_INDEX_SHIFT         ( heapSL_INDEX_COUNT_LOG2 + heapBYTE_ALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE       ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* Every block is smaller than heapMAX_BLOCK_SIZE. */
+#define heapFL_INDEX_COUNT         ( configHEAP_6_MAX_BLOCK_SIZE_LOG2 - heapFL_INDEX_SHIFT + 1 )
+#define heapMAX_BLOCK_SIZE         ( ( size_t ) 1 << configHEAP_6_MAX_BLOCK_SIZE_LOG2 )
+
+#if ( ( configHEAP_6_MAX_BLOCK_SIZE_LOG2 <= heapFL_INDEX_SHIFT ) || ( configHEAP_6_MAX_BLOCK_SIZE_LOG2 > 31 ) )
+    #error configHEAP_6_MAX_BLOCK_SIZE_LOG2 must be more than log2( portBYTE_ALIGNMENT ) + 4 and at most 31
+#endif
+
+/* The block that follows pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )    ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + ( ( pxBlock )->xBlockSize & ~xBlockAllocatedBit ) ) )
+
+/* Define the structure placed at the start of each block.  Only the first two
+ * members are kept while a block is allocated, the free list links are in the
+ * memory handed to the application. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPreviousPhysicalBlock; /*<< The block before this one in memory, NULL for the first block in a region. */
+    size_t xBlockSize;                             /*<< The size of the block, this structure included. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;         /*<< The next free block in the same size class. */
+    struct A_BLOCK_LINK * pxPreviousFreeBlock;     /*<< The previous free block in the same size class. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the highest bit set in ulValue, which must not be 0.
+ */
+static UBaseType_t prvFindLastSet( uint32_t ulValue );
+
+/*
+ * Returns the first and second level class of a free block of xBlockSize
+ * bytes.
+ */
+static void prvMapBlockSize( size_t xBlockSize,
+                             UBaseType_t * puxFL,
+                             UBaseType_t * puxSL );
+
+/*
+ * Returns the first free block in the lowest non-empty class at or above the
+ * class ( uxFL, uxSL ), or NULL if there is none.
+ */
+static BlockLink_t * prvFindFreeBlock( UBaseType_t uxFL,
+                                       UBaseType_t uxSL );
+
+/*
+ * Add a free block to, or remove one from, the list of its class.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert );
+static void prvRemoveBlockFromFreeList( BlockLink_t * pxBlockToRemove );
+
+/*
+ * Returns the size of the largest free block, for the heap trace.
+ */
+#if ( configGENERATE_HEAP_TRACE == 1 )
+    static size_t prvGetLargestFreeBlock( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of BlockLink_t placed at the beginning of each allocated
+ * memory block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* A free block must have room for all of BlockLink_t. */
+static const size_t xMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free blocks of each class, and the bitmaps that record which classes
+ * have free blocks.  Bit uxFL of ulFLBitmap is set when ulSLBitmaps[ uxFL ] is
+ * not 0, and bit uxSL of ulSLBitmaps[ uxFL ] when pxFreeLists[ uxFL ][ uxSL ]
+ * is not NULL. */
+static BlockLink_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFLBitmap = 0U;
+static uint32_t ulSLBitmaps[ heapFL_INDEX_COUNT ];
+
+static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+ * member of an BlockLink_t structure is set then the block belongs to the
+ * application.  When the bit is free the block is still part of the free heap
+ * space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock, * pxNewBlockLink, * pxNewBlockLinkNext;
+    UBaseType_t uxFL, uxSL;
+    size_t xClassSize;
+    void * pvReturn = NULL;
+
+    #if ( configGENERATE_HEAP_TRACE == 1 )
+        void * const pvCaller = portGET_HEAP_TRACE_CALLER();
+        const size_t xRequestedSize = xWantedSize;
+    #endif
+
+    /* The heap must be initialised before the first call to
+     * prvPortMalloc(). */
+    configASSERT( xHeapHasBeenInitialised );
+
+    vTaskSuspendAll();
+    {
+        /* heapMAX_BLOCK_SIZE is at most 2 ^ 31, so the arithmetic below cannot
+         * overflow and the sizes passed to prvFindLastSet() fit in a uint32_t. */
+        if( ( xWantedSize > 0 ) && ( xWantedSize < heapMAX_BLOCK_SIZE ) )
+        {
+            /* The wanted size is increased so it can contain the BlockLink_t
+             * header in addition to the requested amount of bytes, rounded up
+             * so that blocks are always aligned, and so that the block can hold
+             * all of BlockLink_t once it is freed. */
+            xWantedSize += xHeapStructSize;
+            xWantedSize = ( xWantedSize + ( ( size_t ) portBYTE_ALIGNMENT_MASK ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+            if( xWantedSize < xMinimumBlockSize )
+            {
+                xWantedSize = xMinimumBlockSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Round up to the start of the next class, unless the size already
+             * is one, as every block in that class is large enough. */
+            xClassSize = xWantedSize;
+
+            if( xClassSize >= heapSMALL_BLOCK_SIZE )
+            {
+                xClassSize += ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xClassSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xClassSize < heapMAX_BLOCK_SIZE ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            {
+                prvMapBlockSize( xClassSize, &uxFL, &uxSL );
+                pxBlock = prvFindFreeBlock( uxFL, uxSL );
+
+                if( pxBlock != NULL )
+                {
+                    /* This block is being returned for use so must be taken out
+                     * of the list of free blocks. */
+                    prvRemoveBlockFromFreeList( pxBlock );
+
+                    /* If the block is larger than required it can be split into
+                     * two. */
+                    if( ( pxBlock->xBlockSize - xWantedSize ) >= xMinimumBlockSize )
+                    {
+                        /* This block is to be split into two.  Create a new
+                         * block following the number of bytes requested. The void
+                         * cast is used to prevent byte alignment warnings from the
+                         * compiler. */
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+
+                        /* Calculate the sizes of two blocks split from the
+                         * single block. */
+                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                        pxNewBlockLink->pxPreviousPhysicalBlock = pxBlock;
+                        pxBlock->xBlockSize = xWantedSize;
+
+                        /* The block after may be free if the two were too large
+                         * to merge, which the smaller new block may not be. */
+                        pxNewBlockLinkNext = heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink );
+
+                        if( ( ( pxNewBlockLinkNext->xBlockSize & xBlockAllocatedBit ) == 0 ) &&
+                            ( ( pxNewBlockLinkNext->xBlockSize + pxNewBlockLink->xBlockSize ) < heapMAX_BLOCK_SIZE ) )
+                        {
+                            prvRemoveBlockFromFreeList( pxNewBlockLinkNext );
+                            pxNewBlockLink->xBlockSize += pxNewBlockLinkNext->xBlockSize;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPreviousPhysicalBlock = pxNewBlockLink;
+
+                        /* Insert the new block into the list of free blocks. */
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* The block is being returned - it is allocated and owned
+                     * by the application.  Return the memory space pointed to -
+                     * jumping over the BlockLink_t header at its start. */
+                    pxBlock->xBlockSize |= xBlockAllocatedBit;
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    xNumberOfSuccessfulAllocations++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+
+        #if ( configGENERATE_HEAP_TRACE == 1 )
+            {
+                if( pvReturn != NULL )
+                {
+                    vHeapTraceRecord( eHeapTraceMalloc, pvReturn, pxBlock->xBlockSize & ~xBlockAllocatedBit, pvCaller,
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+                else
+                {
+                    vHeapTraceRecord( eHeapTraceMallocFailed, NULL, xRequestedSize, pvCaller,
+                                      xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                }
+            }
+        #endif /* configGENERATE_HEAP_TRACE */
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                extern void vApplicationMallocFailedHook( void );
+                vApplicationMallocFailedHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink, * pxNeighbour;
+
+    #if ( configGENERATE_HEAP_TRACE == 1 )
+        size_t xFreedSize;
+    #endif
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have an BlockLink_t header immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        /* Check the block is actually allocated. */
+        configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+        if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += pxLink->xBlockSize;
+                traceFREE( pv, pxLink->xBlockSize );
+
+                #if ( configGENERATE_HEAP_TRACE == 1 )
+                    {
+                        /* It may be merged with its neighbours below. */
+                        xFreedSize = pxLink->xBlockSize;
+                    }
+                #endif
+
+                /* Merge with the block before this one if that is free.  Blocks
+                 * are not merged past heapMAX_BLOCK_SIZE, which only stops the
+                 * blocks a large region was split into being merged back. */
+                pxNeighbour = pxLink->pxPreviousPhysicalBlock;
+
+                if( ( pxNeighbour != NULL ) &&
+                    ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) &&
+                    ( ( pxNeighbour->xBlockSize + pxLink->xBlockSize ) < heapMAX_BLOCK_SIZE ) )
+                {
+                    prvRemoveBlockFromFreeList( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxLink->xBlockSize;
+                    pxLink = pxNeighbour;
+                    heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPreviousPhysicalBlock = pxLink;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the block after this one if that is free.  The
+                 * last block in each region is followed by a zero sized block
+                 * that is marked as allocated, so this never leaves the
+                 * region. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxLink );
+
+                if( ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) &&
+                    ( ( pxNeighbour->xBlockSize + pxLink->xBlockSize ) < heapMAX_BLOCK_SIZE ) )
+                {
+                    prvRemoveBlockFromFreeList( pxNeighbour );
+                    pxLink->xBlockSize += pxNeighbour->xBlockSize;
+                    heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPreviousPhysicalBlock = pxLink;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvInsertBlockIntoFreeList( pxLink );
+                xNumberOfSuccessfulFrees++;
+
+                #if ( configGENERATE_HEAP_TRACE == 1 )
+                    {
+                        vHeapTraceRecord( eHeapTraceFree, pv, xFreedSize, portGET_HEAP_TRACE_CALLER(),
+                                          xFreeBytesRemaining, prvGetLargestFreeBlock() );
+                    }
+                #endif
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulValue )
+{
+    UBaseType_t uxBit;
+
+    #if ( defined( __GNUC__ ) && ( UINT_MAX == 0xFFFFFFFFU ) )
+        {
+            uxBit = ( UBaseType_t ) 31 - ( UBaseType_t ) __builtin_clz( ulValue );
+        }
+    #else
+        {
+            UBaseType_t uxShift;
+
+            /* A binary search, which takes the same five steps for any value. */
+            uxBit = ( UBaseType_t ) 0;
+
+            for( uxShift = ( UBaseType_t ) 16; uxShift > ( UBaseType_t ) 0; uxShift >>= 1 )
+            {
+                if( ( ulValue >> uxShift ) != 0U )
+                {
+                    ulValue >>= uxShift;
+                    uxBit += uxShift;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    #endif /* if ( defined( __GNUC__ ) && ( UINT_MAX == 0xFFFFFFFFU ) ) */
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapBlockSize( size_t xBlockSize,
+                             UBaseType_t * puxFL,
+                             UBaseType_t * puxSL )
+{
+    UBaseType_t uxLog2;
+
+    if( xBlockSize < heapSMALL_BLOCK_SIZE )
+    {
+        *puxFL = ( UBaseType_t ) 0;
+        *puxSL = ( UBaseType_t ) ( xBlockSize >> heapBYTE_ALIGNMENT_LOG2 );
+    }
+    else
+    {
+        /* The second level class is given by the bits below the highest one
+         * set. */
+        uxLog2 = prvFindLastSet( ( uint32_t ) xBlockSize );
+        *puxFL = uxLog2 - ( UBaseType_t ) heapFL_INDEX_SHIFT + ( UBaseType_t ) 1;
+        *puxSL = ( UBaseType_t ) ( xBlockSize >> ( uxLog2 - heapSL_INDEX_COUNT_LOG2 ) ) ^ ( UBaseType_t ) heapSL_INDEX_COUNT;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindFreeBlock( UBaseType_t uxFL,
+                                       UBaseType_t uxSL )
+{
+    uint32_t ulMap;
+    BlockLink_t * pxBlock = NULL;
+
+    /* Look for a class at or above uxSL in the same power of two first. */
+    ulMap = ulSLBitmaps[ uxFL ] & ( ~0U << uxSL );
+
+    if( ulMap == 0U )
+    {
+        /* Then for the lowest class of a higher power of two. */
+        ulMap = ulFLBitmap & ( ~0U << ( uxFL + ( UBaseType_t ) 1 ) );
+
+        if( ulMap != 0U )
+        {
+            /* ulMap & -ulMap leaves the lowest bit set. */
+            uxFL = prvFindLastSet( ulMap & ( ~ulMap + 1U ) );
+            ulMap = ulSLBitmaps[ uxFL ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( ulMap != 0U )
+    {
+        uxSL = prvFindLastSet( ulMap & ( ~ulMap + 1U ) );
+        pxBlock = pxFreeLists[ uxFL ][ uxSL ];
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert )
+{
+    UBaseType_t uxFL, uxSL;
+
+    prvMapBlockSize( pxBlockToInsert->xBlockSize, &uxFL, &uxSL );
+
+    pxBlockToInsert->pxPreviousFreeBlock = NULL;
+    pxBlockToInsert->pxNextFreeBlock = pxFreeLists[ uxFL ][ uxSL ];
+
+    if( pxBlockToInsert->pxNextFreeBlock != NULL )
+    {
+        pxBlockToInsert->pxNextFreeBlock->pxPreviousFreeBlock = pxBlockToInsert;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFL ][ uxSL ] = pxBlockToInsert;
+    ulFLBitmap |= 1U << uxFL;
+    ulSLBitmaps[ uxFL ] |= 1U << uxSL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlockFromFreeList( BlockLink_t * pxBlockToRemove )
+{
+    UBaseType_t uxFL, uxSL;
+
+    prvMapBlockSize( pxBlockToRemove->xBlockSize, &uxFL, &uxSL );
+
+    if( pxBlockToRemove->pxNextFreeBlock != NULL )
+    {
+        pxBlockToRemove->pxNextFreeBlock->pxPreviousFreeBlock = pxBlockToRemove->pxPreviousFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlockToRemove->pxPreviousFreeBlock != NULL )
+    {
+        pxBlockToRemove->pxPreviousFreeBlock->pxNextFreeBlock = pxBlockToRemove->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was first in its list. */
+        pxFreeLists[ uxFL ][ uxSL ] = pxBlockToRemove->pxNextFreeBlock;
+
+        if( pxFreeLists[ uxFL ][ uxSL ] == NULL )
+        {
+            ulSLBitmaps[ uxFL ] &= ~( 1U << uxSL );
+
+            if( ulSLBitmaps[ uxFL ] == 0U )
+            {
+                ulFLBitmap &= ~( 1U << uxFL );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_HEAP_TRACE == 1 )
+
+    static size_t prvGetLargestFreeBlock( void )
+    {
+        BlockLink_t * pxBlock;
+        UBaseType_t uxFL, uxSL;
+        size_t xMaxSize = 0;
+
+        /* The largest free block is in the highest non-empty class, the only
+         * list that has to be walked. */
+        if( ulFLBitmap != 0U )
+        {
+            uxFL = prvFindLastSet( ulFLBitmap );
+            uxSL = prvFindLastSet( ulSLBitmaps[ uxFL ] );
+
+            for( pxBlock = pxFreeLists[ uxFL ][ uxSL ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xMaxSize;
+    }
+
+#endif /* configGENERATE_HEAP_TRACE */
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+    BlockLink_t * pxBlock, * pxPreviousBlock;
+    size_t xAddress, xRegionEnd, xBlockSize;
+    size_t xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xHeapHasBeenInitialised == pdFALSE );
+
+    /* Work out the position of the top bit in a size_t variable. */
+    xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( size_t ) pxHeapRegion->pucStartAddress;
+        xRegionEnd = xAddress + pxHeapRegion->xSizeInBytes;
+        xAddress += ( portBYTE_ALIGNMENT - 1 );
+        xAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+        /* Leave room for the zero sized block that marks the end of the
+         * region. */
+        xRegionEnd -= xHeapStructSize;
+        xRegionEnd &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+        /* Check the region can hold at least one block. */
+        configASSERT( xRegionEnd >= ( xAddress + xMinimumBlockSize ) );
+
+        /* Cover the region with free blocks.  Blocks must be smaller than
+         * heapMAX_BLOCK_SIZE, so a large region is split into blocks of half
+         * that, which leaves a last block of at least half that too. */
+        pxPreviousBlock = NULL;
+
+        while( ( xRegionEnd - xAddress ) >= xMinimumBlockSize )
+        {
+            xBlockSize = xRegionEnd - xAddress;
+
+            if( xBlockSize >= heapMAX_BLOCK_SIZE )
+            {
+                xBlockSize = heapMAX_BLOCK_SIZE >> 1;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxBlock = ( BlockLink_t * ) xAddress;
+            pxBlock->pxPreviousPhysicalBlock = pxPreviousBlock;
+            pxBlock->xBlockSize = xBlockSize;
+            prvInsertBlockIntoFreeList( pxBlock );
+
+            xTotalHeapSize += xBlockSize;
+            pxPreviousBlock = pxBlock;
+            xAddress += xBlockSize;
+        }
+
+        /* The block that marks the end of the region is marked as allocated so
+         * that vPortFree() never merges a block with what follows the
+         * region. */
+        pxBlock = ( BlockLink_t * ) xAddress;
+        pxBlock->pxPreviousPhysicalBlock = pxPreviousBlock;
+        pxBlock->xBlockSize = xBlockAllocatedBit;
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+
+    xHeapHasBeenInitialised = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFL, uxSL;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* Unlike pvPortMalloc() and vPortFree() this walks every free
+         * block. */
+        for( uxFL = ( UBaseType_t ) 0; uxFL < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFL++ )
+        {
+            for( uxSL = ( UBaseType_t ) 0; uxSL < ( UBaseType_t ) heapSL_INDEX_COUNT; uxSL++ )
+            {
+                for( pxBlock = pxFreeLists[ uxFL ][ uxSL ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    /* Increment the number of blocks and record the largest
+                     * and smallest block seen so far. */
+                    xBlocks++;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+
+                    if( pxBlock->xBlockSize < xMinSize )
+                    {
+                        xMinSize = pxBlock->xBlockSize;
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
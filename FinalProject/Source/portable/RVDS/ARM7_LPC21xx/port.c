@@ -33,6 +33,9 @@
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#if configUSE_HR_TIMERS == 1
+	#include "hrtimer.h"
+#endif
 
 /* Constants required to setup the initial task context. */
 #define portINITIAL_SPSR				( ( StackType_t ) 0x1f ) /* System mode, ARM mode, interrupts enabled. */
@@ -55,6 +58,14 @@
 #define portTIMER_MATCH_ISR_BIT		( ( uint8_t ) 0x01 )
 #define portCLEAR_VIC_INTERRUPT		( ( uint32_t ) 0 )
 
+/* Constants required to drive the high resolution timers from match register
+0 of timer 1.  The application starts timer 1 with configTimer1() and reads it
+for the run time stats, so only its match register is used here. */
+#define portHR_TIMER_VIC_CHANNEL		( ( uint32_t ) 0x0005 )
+#define portHR_TIMER_VIC_CHANNEL_BIT	( ( uint32_t ) 0x0020 )
+#define portHR_TIMER_MR0_MASK			( ( uint32_t ) 0x07 )
+#define portHR_TIMER_MR0_ISR_BIT		( ( uint32_t ) 0x01 )
+
 /*-----------------------------------------------------------*/
 
 /* The code generated by the Keil compiler does not maintain separate
@@ -77,6 +88,15 @@ static void prvSetupTimerInterrupt( void );
  */
 extern __asm void vPortStartFirstTask( void );
 
+#if configUSE_HR_TIMERS == 1
+
+	/* The timer 1 ISR saves the context of the interrupted task in portASM.s,
+	then calls vPortHrTimerISRHandler(). */
+	void vPortHrTimerISREntry( void );
+	void vPortHrTimerISRHandler( void );
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* 
@@ -289,4 +309,66 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_HR_TIMERS == 1
 
+	void vPortHrTimerSetup( void )
+	{
+		/* Match register 0 neither resets nor stops the counter, and only
+		interrupts while a timer is active. */
+		T1MCR &= ~portHR_TIMER_MR0_MASK;
+		T1IR = portHR_TIMER_MR0_ISR_BIT;
+
+		/* Setup the VIC for timer 1, in the slot after the tick and the
+		UART. */
+		VICIntSelect &= ~( portHR_TIMER_VIC_CHANNEL_BIT );
+		VICVectAddr2 = ( uint32_t ) vPortHrTimerISREntry;
+		VICVectCntl2 = portHR_TIMER_VIC_CHANNEL | portTIMER_VIC_ENABLE;
+		VICIntEnable |= portHR_TIMER_VIC_CHANNEL_BIT;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortHrTimerGetCount( void )
+	{
+		return T1TC;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHrTimerSetCompare( uint32_t ulCount )
+	{
+		T1MR0 = ulCount;
+		T1MCR |= portINTERRUPT_ON_MATCH;
+
+		/* A match is only signalled as the counter moves onto ulCount, so if
+		it already has the interrupt is raised in software instead.  Should
+		the counter reach ulCount between the two, the interrupt runs twice and
+		the second time finds nothing to do. */
+		if( ( int32_t ) ( ulCount - T1TC ) <= 0 )
+		{
+			VICSoftInt = portHR_TIMER_VIC_CHANNEL_BIT;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHrTimerDisableCompare( void )
+	{
+		T1MCR &= ~portINTERRUPT_ON_MATCH;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHrTimerISRHandler( void )
+	{
+		/* Clear both sources first, so an expiry that the callbacks set the
+		compare channel for interrupts again. */
+		T1IR = portHR_TIMER_MR0_ISR_BIT;
+		VICSoftIntClr = portHR_TIMER_VIC_CHANNEL_BIT;
+
+		if( xHrTimerProcessCompare() != pdFALSE )
+		{
+			vTaskSwitchContext();
+		}
+
+		VICVectAddr = portCLEAR_VIC_INTERRUPT;		/* Acknowledge the Interrupt */
+	}
+
+#endif /* configUSE_HR_TIMERS */
+/*-----------------------------------------------------------*/
@@ -30,11 +30,13 @@
 
 	IMPORT	vTaskSwitchContext
 	IMPORT	xTaskIncrementTick
+	IMPORT	vPortHrTimerISRHandler [WEAK]
 
 	EXPORT	vPortYieldProcessor
 	EXPORT	vPortStartFirstTask
 	EXPORT	vPreemptiveTick
 	EXPORT	vPortYield
+	EXPORT	vPortHrTimerISREntry
 
 
 VICVECTADDR	EQU	0xFFFFF030
@@ -119,6 +121,27 @@ SkipContextSwitch
 	LDR	R0, =VICVECTADDR				; Acknowledge the interrupt
 	STR	R0,[R0]
 
+	portRESTORE_CONTEXT					; Restore the context of the highest
+										; priority task that is ready to run.
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Interrupt service routine for the high resolution timers (hrtimer.c)
+; Only installed if configUSE_HR_TIMERS is set to 1 in FreeRTOSConfig.h, the
+; handler is imported weak so the port links without it otherwise.
+;
+; Uses match register 0 of timer 1 of LPC21XX Family
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+vPortHrTimerISREntry
+
+	PRESERVE8
+
+	portSAVE_CONTEXT					; Save the context of the current task.
+
+	LDR R0, =vPortHrTimerISRHandler		; Call the timer callbacks, which
+	MOV LR, PC							; may make a task ready to run, and
+	BX R0								; select it if it has to preempt.
+
 	portRESTORE_CONTEXT					; Restore the context of the highest
 										; priority task that is ready to run.
 	END
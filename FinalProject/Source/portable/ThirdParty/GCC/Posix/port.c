@@ -64,10 +64,14 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#if ( configUSE_HR_TIMERS == 1 )
+    #include "hrtimer.h"
+#endif
 #include "utils/wait_for_event.h"
 /*-----------------------------------------------------------*/
 
 #define SIG_RESUME SIGUSR1
+#define SIG_HR_TIMER SIGUSR2
 
 typedef struct THREAD
 {
@@ -111,6 +115,9 @@ static void prvSuspendSelf( Thread_t * thread);
 static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
 static void vPortStartFirstTask( void );
+#if ( configUSE_HR_TIMERS == 1 )
+static void vPortHrTimerHandler( int sig );
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvFatalError( const char *pcCall, int iErrno )
@@ -236,6 +243,10 @@ Thread_t *xCurrentThread;
     sigemptyset( &sigtick.sa_mask );
     sigaction( SIGALRM, &sigtick, NULL );
 
+#if ( configUSE_HR_TIMERS == 1 )
+    sigaction( SIG_HR_TIMER, &sigtick, NULL );
+#endif
+
     /* Signal the scheduler to exit its loop. */
     xSchedulerEnd = pdTRUE;
     (void)pthread_kill( hMainThread, SIG_RESUME );
@@ -403,6 +414,129 @@ Thread_t *pxThreadToResume;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HR_TIMERS == 1 )
+
+/*
+ * The high resolution timers count microseconds (or whatever
+ * configHR_TIMER_COUNTS_PER_SECOND is) of CLOCK_MONOTONIC, and the compare
+ * channel is a POSIX timer on the same clock, armed with the absolute time the
+ * counter reaches the compare value at.  It raises SIG_HR_TIMER, which is
+ * handled as SIGALRM is.
+ */
+#define portHR_TIMER_NS_PER_COUNT	( 1000000000ULL / configHR_TIMER_COUNTS_PER_SECOND )
+
+static timer_t xHrTimer;
+
+void vPortHrTimerSetup( void )
+{
+struct sigaction sighrtimer;
+struct sigevent xEvent;
+int iRet;
+
+    /* Block the signals in this thread before the handler is installed, as
+     * the scheduler may not have been started yet. */
+    (void)pthread_once( &hSigSetupThread, prvSetupSignalsAndSchedulerPolicy );
+
+    sighrtimer.sa_flags = 0;
+    sighrtimer.sa_handler = vPortHrTimerHandler;
+    sigfillset( &sighrtimer.sa_mask );
+
+    iRet = sigaction( SIG_HR_TIMER, &sighrtimer, NULL );
+    if ( iRet )
+    {
+        prvFatalError( "sigaction", errno );
+    }
+
+    memset( &xEvent, 0, sizeof( xEvent ) );
+    xEvent.sigev_notify = SIGEV_SIGNAL;
+    xEvent.sigev_signo = SIG_HR_TIMER;
+
+    iRet = timer_create( CLOCK_MONOTONIC, &xEvent, &xHrTimer );
+    if ( iRet )
+    {
+        prvFatalError( "timer_create", errno );
+    }
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortHrTimerGetCount( void )
+{
+    return ( uint32_t ) ( prvGetTimeNs() / portHR_TIMER_NS_PER_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+void vPortHrTimerSetCompare( uint32_t ulCount )
+{
+struct itimerspec xCompare;
+uint64_t ullNow;
+int64_t llTarget;
+int iRet;
+
+    /* Widen ulCount to the 64-bit count it is the low half of.  An absolute
+     * time that has already passed expires straight away. */
+    ullNow = prvGetTimeNs() / portHR_TIMER_NS_PER_COUNT;
+    llTarget = ( int64_t ) ullNow + ( int32_t ) ( ulCount - ( uint32_t ) ullNow );
+
+    if ( llTarget < 1 )
+    {
+        llTarget = 1;
+    }
+
+    xCompare.it_interval.tv_sec = 0;
+    xCompare.it_interval.tv_nsec = 0;
+    xCompare.it_value.tv_sec = ( time_t ) ( ( uint64_t ) llTarget * portHR_TIMER_NS_PER_COUNT / 1000000000ULL );
+    xCompare.it_value.tv_nsec = ( long ) ( ( uint64_t ) llTarget * portHR_TIMER_NS_PER_COUNT % 1000000000ULL );
+
+    iRet = timer_settime( xHrTimer, TIMER_ABSTIME, &xCompare, NULL );
+    if ( iRet )
+    {
+        prvFatalError( "timer_settime", errno );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortHrTimerDisableCompare( void )
+{
+struct itimerspec xCompare;
+
+    memset( &xCompare, 0, sizeof( xCompare ) );
+    (void)timer_settime( xHrTimer, 0, &xCompare, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vPortHrTimerHandler( int sig )
+{
+Thread_t *pxThreadToSuspend;
+Thread_t *pxThreadToResume;
+BaseType_t xSwitchRequired;
+
+    uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+
+    pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    xSwitchRequired = xHrTimerProcessCompare();
+
+#if ( configUSE_PREEMPTION == 1 )
+    if ( xSwitchRequired != pdFALSE )
+    {
+        vTaskSwitchContext();
+
+        pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+    }
+#else
+    ( void ) xSwitchRequired;
+    ( void ) pxThreadToSuspend;
+    ( void ) pxThreadToResume;
+#endif
+
+    uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HR_TIMERS */
+
 void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield )
 {
 Thread_t *pxThread = prvGetThreadFromTask( pxTaskToDelete );
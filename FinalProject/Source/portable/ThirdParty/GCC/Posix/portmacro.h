@@ -124,6 +124,10 @@ extern void vPortCancelThread( void *pxTaskToDelete );
  */
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
+/* Used by Atomic_CompareAndSwap_u32() in atomic.h instead of masking signals. */
+#define portATOMIC_COMPARE_AND_SWAP_U32( pulDestination, ulExchange, ulComparand ) \
+	( __sync_bool_compare_and_swap( ( pulDestination ), ( ulComparand ), ( ulExchange ) ) ? 1U : 0U )
+
 extern unsigned long ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
 #define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
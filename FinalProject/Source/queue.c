@@ -60,9 +60,9 @@
  * not necessary, and the pcHead pointer is set to NULL to indicate that the
  * structure instead holds a pointer to the mutex holder (if any).  Map alternative
  * names to the pcHead and structure member to ensure the readability of the code
- * is maintained.  The QueuePointers_t and SemaphoreData_t types are used to form
- * a union as their usage is mutually exclusive dependent on what the queue is
- * being used for. */
+ * is maintained.  The QueuePointers_t, SemaphoreData_t and QueueSetData_t types
+ * are used to form a union as their usage is mutually exclusive dependent on
+ * what the queue is being used for. */
 #define uxQueueType               pcHead
 #define queueQUEUE_IS_MUTEX       NULL
 
@@ -78,6 +78,11 @@ typedef struct SemaphoreData
     UBaseType_t uxRecursiveCallCount; /*< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
 } SemaphoreData_t;
 
+typedef struct QueueSetData
+{
+    UBaseType_t uxLastSlot; /*< The slot of the member last selected when the structure is used as a queue set. */
+} QueueSetData_t;
+
 /* Semaphores do not actually store or copy data, so have an item size of
  * zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
@@ -92,6 +97,41 @@ typedef struct SemaphoreData
     #define queueYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+#if ( configUSE_QUEUE_SETS == 1 )
+
+/* A queue set holds one bit per member in uxQueueSetBits, so it has at most
+ * queueSET_MAX_MEMBERS members.  The highest one is found with the port's count
+ * leading zeros instruction where it has one, as the ready priorities are in
+ * tasks.c, otherwise by halving the word, which takes five or six steps
+ * whatever the number of members. */
+    #define queueSET_MAX_MEMBERS    ( ( UBaseType_t ) ( sizeof( UBaseType_t ) * 8U ) )
+
+    #ifdef portGET_HIGHEST_PRIORITY
+        #define queueSET_HIGHEST_SLOT( uxSlot, uxBits )    portGET_HIGHEST_PRIORITY( uxSlot, uxBits )
+    #else
+        #define queueSET_HIGHEST_SLOT( uxSlot, uxBits )                                            \
+    {                                                                                              \
+        UBaseType_t uxRemaining = ( uxBits );                                                      \
+        UBaseType_t uxShift;                                                                       \
+                                                                                                   \
+        ( uxSlot ) = ( UBaseType_t ) 0;                                                            \
+                                                                                                   \
+        for( uxShift = ( UBaseType_t ) ( sizeof( UBaseType_t ) * 4U ); uxShift > ( UBaseType_t ) 0; uxShift >>= 1 ) \
+        {                                                                                          \
+            if( ( uxRemaining >> uxShift ) != ( UBaseType_t ) 0 )                                  \
+            {                                                                                      \
+                uxRemaining >>= uxShift;                                                           \
+                ( uxSlot ) += uxShift;                                                             \
+            }                                                                                      \
+        }                                                                                          \
+    }
+    #endif
+
+/* The members of a queue set are kept in its storage area, indexed by slot. */
+    #define queueSET_MEMBERS( pxQueueSet )    ( ( Queue_t ** ) ( pxQueueSet )->pcHead ) /*lint !e9087 !e740 The storage area of a set holds member handles. */
+
+#endif /* configUSE_QUEUE_SETS */
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -106,6 +146,7 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
     {
         QueuePointers_t xQueue;     /*< Data required exclusively when this structure is used as a queue. */
         SemaphoreData_t xSemaphore; /*< Data required exclusively when this structure is used as a semaphore. */
+        QueueSetData_t xQueueSet;   /*< Data required exclusively when this structure is used as a queue set. */
     } u;
 
     List_t xTasksWaitingToSend;             /*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
@@ -124,6 +165,7 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
 
     #if ( configUSE_QUEUE_SETS == 1 )
         struct QueueDefinition * pxQueueSetContainer;
+        UBaseType_t uxQueueSetBits; /*< In a set, the bits of the members that may hold data.  In a member, its own bit in the set. */
     #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -203,6 +245,27 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy as many of uxItemCount items as there is space for into, or as many as
+ * there are out of, a queue that holds data, with at most two memcpy() calls
+ * each.  The number of items copied is returned.
+ */
+static UBaseType_t prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                           const void * pvItemsToQueue,
+                                           const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                             void * const pvBuffer,
+                                             const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to uxCount tasks from pxEventList, one for each item sent or
+ * space freed.  Returns pdTRUE if one of them has a higher priority than the
+ * running task.  Must be called from a critical section with the queue
+ * unlocked.
+ */
+static BaseType_t prvUnblockTasksWaiting( List_t * const pxEventList,
+                                          UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -210,6 +273,13 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
  * the queue set that the queue contains data.
  */
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the member of a queue set in the highest slot that holds data, or
+ * NULL if none does.  Bits of members found empty are cleared on the way.  Must
+ * be called from a critical section.
+ */
+    static Queue_t * prvQueueSetFirstReady( Queue_t * const pxQueueSet ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
@@ -500,6 +570,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     #if ( configUSE_QUEUE_SETS == 1 )
         {
             pxNewQueue->pxQueueSetContainer = NULL;
+            pxNewQueue->uxQueueSetBits = ( UBaseType_t ) 0;
         }
     #endif /* configUSE_QUEUE_SETS */
 
@@ -2012,157 +2083,570 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-
-    configASSERT( xQueue );
-
-    taskENTER_CRITICAL();
-    {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
-
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItemsToQueue,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait )
 {
-    UBaseType_t uxReturn;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxSent;
     Queue_t * const pxQueue = xQueue;
 
     configASSERT( pxQueue );
+    configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
 
-    taskENTER_CRITICAL();
+    /* Only queues that hold data, not semaphores, can take several items. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    if( uxItemCount == ( UBaseType_t ) 0U )
     {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+        return 0U;
     }
-    taskEXIT_CRITICAL();
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* As xQueueGenericSend(), but once there is room for one item
+             * as many as fit are copied in one go. */
+            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            {
+                traceQUEUE_SEND( pxQueue );
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+                uxSent = prvCopyMultipleToQueue( pxQueue, pvItemsToQueue, uxItemCount );
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+                #if ( configUSE_QUEUE_SETS == 1 )
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        BaseType_t xYieldRequired = pdFALSE;
+                        UBaseType_t x;
+
+                        /* The set only records that the queue holds data,
+                         * which the first call does.  Each call also wakes a
+                         * task blocked on the set, so one call per item lets
+                         * as many tasks select the queue as items were sent. */
+                        for( x = ( UBaseType_t ) 0U; x < uxSent; x++ )
+                        {
+                            if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                        }
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
+                        if( xYieldRequired != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                #endif /* configUSE_QUEUE_SETS */
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+                if( prvUnblockTasksWaiting( &( pxQueue->xTasksWaitingToReceive ), uxSent ) != pdFALSE )
+                {
+                    /* A single yield, however many receivers were unblocked. */
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
-        {
-            vQueueUnregisterQueue( pxQueue );
+                taskEXIT_CRITICAL();
+                return uxSent;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return 0U;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
         }
-    #endif
+        taskEXIT_CRITICAL();
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-        {
-            /* The queue can only have been allocated dynamically - free it
-             * again. */
-            vPortFree( pxQueue );
-        }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        /* Block exactly as xQueueGenericSend() does. */
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            /* The queue could have been allocated statically or dynamically, so
-             * check before attempting to free the memory. */
-            if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
             {
-                vPortFree( pxQueue );
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
             }
         }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+        else
         {
-            /* The queue must have been statically allocated, so is not going to be
-             * deleted.  Avoid compiler warnings about the unused parameter. */
-            ( void ) pxQueue;
+            /* The timeout has expired. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            traceQUEUE_SEND_FAILED( pxQueue );
+            return 0U;
         }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    } /*lint -restore */
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * const pvItemsToQueue,
+                                        const UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxSent = 0U;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+    /* See xQueueGenericSendFromISR() for the rationale. */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
     {
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
-    }
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( uxItemCount != ( UBaseType_t ) 0U ) )
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
+            BaseType_t xYieldRequired = pdFALSE;
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
-    }
+            uxSent = prvCopyMultipleToQueue( pxQueue, pvItemsToQueue, uxItemCount );
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+            /* The event lists cannot be changed while the queue is locked.
+             * The task that unlocks it unblocks one task per count. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        UBaseType_t x;
 
-#if ( configUSE_MUTEXES == 1 )
+                        /* One call per item wakes up to one set waiter per
+                         * item, as in uxQueueSendMultiple(). */
+                        for( x = ( UBaseType_t ) 0U; x < uxSent; x++ )
+                        {
+                            if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                        }
+                    }
+                    else
+                #endif /* configUSE_QUEUE_SETS */
+                {
+                    xYieldRequired = prvUnblockTasksWaiting( &( pxQueue->xTasksWaitingToReceive ), uxSent );
+                }
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
-    {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+                if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                configASSERT( cTxLock != queueINT8_MAX );
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
-        {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+                /* No more than queueINT8_MAX tasks need to be unblocked. */
+                if( uxSent > ( UBaseType_t ) ( queueINT8_MAX - cTxLock ) )
+                {
+                    pxQueue->cTxLock = queueINT8_MAX;
+                }
+                else
+                {
+                    pxQueue->cTxLock = ( int8_t ) ( cTxLock + ( int8_t ) uxSent );
+                }
+            }
         }
         else
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
         }
-
-        return uxHighestPriorityOfWaitingTasks;
     }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-#endif /* configUSE_MUTEXES */
+    return uxSent;
+}
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
-                                      const void * pvItemToQueue,
-                                      const BaseType_t xPosition )
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxItemCount,
+                                    TickType_t xTicksToWait )
 {
-    BaseType_t xReturn = pdFALSE;
-    UBaseType_t uxMessagesWaiting;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxReceived;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    if( uxItemCount == ( UBaseType_t ) 0U )
+    {
+        return 0U;
+    }
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* As xQueueReceive(), but everything that is there, up to
+             * uxItemCount items, is copied out in one go. */
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+
+                uxReceived = prvCopyMultipleFromQueue( pxQueue, pvBuffer, uxItemCount );
+
+                if( prvUnblockTasksWaiting( &( pxQueue->xTasksWaitingToSend ), uxReceived ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return uxReceived;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return 0U;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Block exactly as xQueueReceive() does. */
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * const pvBuffer,
+                                           const UBaseType_t uxItemCount,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxReceived = 0U;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* See xQueueGenericSendFromISR() for the rationale. */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( uxItemCount != ( UBaseType_t ) 0U ) )
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            uxReceived = prvCopyMultipleFromQueue( pxQueue, pvBuffer, uxItemCount );
+
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( ( prvUnblockTasksWaiting( &( pxQueue->xTasksWaitingToSend ), uxReceived ) != pdFALSE ) &&
+                    ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                configASSERT( cRxLock != queueINT8_MAX );
+
+                if( uxReceived > ( UBaseType_t ) ( queueINT8_MAX - cRxLock ) )
+                {
+                    pxQueue->cRxLock = queueINT8_MAX;
+                }
+                else
+                {
+                    pxQueue->cRxLock = ( int8_t ) ( cRxLock + ( int8_t ) uxReceived );
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxReceived;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        {
+            vQueueUnregisterQueue( pxQueue );
+        }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The queue can only have been allocated dynamically - free it
+             * again. */
+            vPortFree( pxQueue );
+        }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The queue could have been allocated statically or dynamically, so
+             * check before attempting to free the memory. */
+            if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFree( pxQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+        {
+            /* The queue must have been statically allocated, so is not going to be
+             * deleted.  Avoid compiler warnings about the unused parameter. */
+            ( void ) pxQueue;
+        }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      const BaseType_t xPosition )
+{
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxMessagesWaiting;
 
     /* This function is called from a critical section. */
 
@@ -2261,6 +2745,137 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+static UBaseType_t prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                           const void * pvItemsToQueue,
+                                           const UBaseType_t uxItemCount )
+{
+    UBaseType_t uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+    size_t xBytes, xFirst;
+
+    if( uxItemCount < uxCount )
+    {
+        uxCount = uxItemCount;
+    }
+
+    xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+
+    /* Up to the end of the storage area, then the rest from the start. */
+    xFirst = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+    if( xBytes < xFirst )
+    {
+        xFirst = xBytes;
+    }
+
+    ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemsToQueue, xFirst ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+    pxQueue->pcWriteTo += xFirst;                                            /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+    if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                     /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+    {
+        pxQueue->pcWriteTo = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xBytes > xFirst )
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const uint8_t * ) pvItemsToQueue + xFirst, xBytes - xFirst ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+        pxQueue->pcWriteTo += ( xBytes - xFirst );                                                                 /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxQueue->uxMessagesWaiting += uxCount;
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                             void * const pvBuffer,
+                                             const UBaseType_t uxItemCount )
+{
+    UBaseType_t uxCount = pxQueue->uxMessagesWaiting;
+    size_t xBytes, xFirst;
+    int8_t * pcReadFrom;
+
+    if( uxItemCount < uxCount )
+    {
+        uxCount = uxItemCount;
+    }
+
+    xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+
+    /* pcReadFrom points to the last item read, the oldest item follows it. */
+    pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+    if( pcReadFrom >= pxQueue->u.xQueue.pcTail )                       /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+    {
+        pcReadFrom = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xFirst = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom );
+
+    if( xBytes < xFirst )
+    {
+        xFirst = xBytes;
+    }
+
+    ( void ) memcpy( pvBuffer, ( void * ) pcReadFrom, xFirst ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+    pcReadFrom += xFirst;                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+    if( xBytes > xFirst )
+    {
+        ( void ) memcpy( ( uint8_t * ) pvBuffer + xFirst, ( void * ) pxQueue->pcHead, xBytes - xFirst ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+        pcReadFrom = pxQueue->pcHead + ( xBytes - xFirst );                                              /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Back to the last item read, as prvCopyDataFromQueue() leaves it. */
+    pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    pxQueue->uxMessagesWaiting -= uxCount;
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaiting( List_t * const pxEventList,
+                                          UBaseType_t uxCount )
+{
+    BaseType_t xYieldRequired = pdFALSE;
+
+    /* With a single task waiting, the usual case, this is one wake up for the
+     * whole batch.  More are only made when several tasks wait, as each can
+     * take an item. */
+    while( ( uxCount > ( UBaseType_t ) 0U ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+        {
+            xYieldRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxCount--;
+    }
+
+    return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2905,10 +3520,52 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
     QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength )
+    {
+        UBaseType_t uxMaxMembers = uxEventQueueLength;
+
+        /* The length was the total of the lengths of the members, which is at
+         * least the number of members, and a set cannot have more members than
+         * bits. */
+        if( uxMaxMembers > queueSET_MAX_MEMBERS )
+        {
+            uxMaxMembers = queueSET_MAX_MEMBERS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xQueueCreateSetBitmap( uxMaxMembers );
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueSetHandle_t xQueueCreateSetBitmap( const UBaseType_t uxMaxMembers )
     {
         QueueSetHandle_t pxQueue;
+        UBaseType_t uxSlot;
+
+        /* One bit of uxQueueSetBits per member. */
+        configASSERT( uxMaxMembers <= queueSET_MAX_MEMBERS );
+
+        pxQueue = xQueueGenericCreate( uxMaxMembers, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+
+        if( pxQueue != NULL )
+        {
+            for( uxSlot = ( UBaseType_t ) 0; uxSlot < uxMaxMembers; uxSlot++ )
+            {
+                queueSET_MEMBERS( pxQueue )[ uxSlot ] = NULL;
+            }
 
-        pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+            pxQueue->u.xQueueSet.uxLastSlot = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
         return pxQueue;
     }
@@ -2921,25 +3578,51 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
                                QueueSetHandle_t xQueueSet )
     {
-        BaseType_t xReturn;
+        BaseType_t xReturn = pdFAIL;
+        Queue_t * const pxQueueOrSemaphore = ( Queue_t * ) xQueueOrSemaphore;
+        UBaseType_t uxSlot;
 
         taskENTER_CRITICAL();
         {
-            if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
+            if( pxQueueOrSemaphore->pxQueueSetContainer != NULL )
             {
                 /* Cannot add a queue/semaphore to more than one queue set. */
-                xReturn = pdFAIL;
-            }
-            else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxMessagesWaiting != ( UBaseType_t ) 0 )
-            {
-                /* Cannot add a queue/semaphore to a queue set if there are already
-                 * items in the queue/semaphore. */
-                xReturn = pdFAIL;
+                mtCOVERAGE_TEST_MARKER();
             }
             else
             {
-                ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
-                xReturn = pdPASS;
+                for( uxSlot = ( UBaseType_t ) 0; uxSlot < xQueueSet->uxLength; uxSlot++ )
+                {
+                    if( queueSET_MEMBERS( xQueueSet )[ uxSlot ] == NULL )
+                    {
+                        queueSET_MEMBERS( xQueueSet )[ uxSlot ] = pxQueueOrSemaphore;
+                        pxQueueOrSemaphore->uxQueueSetBits = ( UBaseType_t ) 1U << uxSlot;
+                        pxQueueOrSemaphore->pxQueueSetContainer = xQueueSet;
+                        xReturn = pdPASS;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                /* A member that already holds data is ready straight away. */
+                if( ( xReturn == pdPASS ) && ( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 ) )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueueOrSemaphore ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
         taskEXIT_CRITICAL();
@@ -2957,29 +3640,30 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     {
         BaseType_t xReturn;
         Queue_t * const pxQueueOrSemaphore = ( Queue_t * ) xQueueOrSemaphore;
+        UBaseType_t uxSlot;
 
-        if( pxQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
-        {
-            /* The queue was not a member of the set. */
-            xReturn = pdFAIL;
-        }
-        else if( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 )
-        {
-            /* It is dangerous to remove a queue from a set when the queue is
-             * not empty because the queue set will still hold pending events for
-             * the queue. */
-            xReturn = pdFAIL;
-        }
-        else
+        taskENTER_CRITICAL();
         {
-            taskENTER_CRITICAL();
+            if( pxQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
             {
+                /* The queue was not a member of the set. */
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                /* Readiness is kept as a bit rather than as queued events, so
+                 * nothing is left behind in the set. */
+                queueSET_HIGHEST_SLOT( uxSlot, pxQueueOrSemaphore->uxQueueSetBits );
+                queueSET_MEMBERS( xQueueSet )[ uxSlot ] = NULL;
+                xQueueSet->uxQueueSetBits &= ~( pxQueueOrSemaphore->uxQueueSetBits );
+
                 /* The queue is no longer contained in the set. */
+                pxQueueOrSemaphore->uxQueueSetBits = ( UBaseType_t ) 0;
                 pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+                xReturn = pdPASS;
             }
-            taskEXIT_CRITICAL();
-            xReturn = pdPASS;
         }
+        taskEXIT_CRITICAL();
 
         return xReturn;
     } /*lint !e818 xQueueSet could not be declared as pointing to const as it is a typedef. */
@@ -2987,15 +3671,139 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_SETS == 1 )
+
+    static Queue_t * prvQueueSetFirstReady( Queue_t * const pxQueueSet )
+    {
+        Queue_t * pxMember = NULL;
+        UBaseType_t uxSlot, uxBelow;
+
+        while( pxQueueSet->uxQueueSetBits != ( UBaseType_t ) 0 )
+        {
+            /* Start below the member selected last and wrap round to the top,
+             * so a member that stays ready does not hide the others.  The mask
+             * keeps the shift in range should the set have been reset. */
+            uxSlot = pxQueueSet->u.xQueueSet.uxLastSlot & ( queueSET_MAX_MEMBERS - ( UBaseType_t ) 1U );
+            uxBelow = pxQueueSet->uxQueueSetBits & ( ( ( UBaseType_t ) 1U << uxSlot ) - ( UBaseType_t ) 1U );
+
+            if( uxBelow != ( UBaseType_t ) 0 )
+            {
+                queueSET_HIGHEST_SLOT( uxSlot, uxBelow );
+            }
+            else
+            {
+                queueSET_HIGHEST_SLOT( uxSlot, pxQueueSet->uxQueueSetBits );
+            }
+
+            if( queueSET_MEMBERS( pxQueueSet )[ uxSlot ]->uxMessagesWaiting != ( UBaseType_t ) 0 )
+            {
+                pxMember = queueSET_MEMBERS( pxQueueSet )[ uxSlot ];
+                pxQueueSet->u.xQueueSet.uxLastSlot = uxSlot;
+                break;
+            }
+            else
+            {
+                /* Read until empty since its bit was set. */
+                pxQueueSet->uxQueueSetBits &= ~( ( UBaseType_t ) 1U << uxSlot );
+            }
+        }
+
+        return pxMember;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
     QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
                                                 TickType_t const xTicksToWait )
     {
-        QueueSetMemberHandle_t xReturn = NULL;
+        Queue_t * const pxQueueSet = xQueueSet;
+        Queue_t * pxMember;
+        TickType_t xTicksLeft = xTicksToWait;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
 
-        ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
-        return xReturn;
+        configASSERT( pxQueueSet );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+
+        /* As xQueueReceive(), with the set empty while no member holds data. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxMember = prvQueueSetFirstReady( pxQueueSet );
+
+                if( pxMember != NULL )
+                {
+                    taskEXIT_CRITICAL();
+                    return pxMember;
+                }
+                else if( xTicksLeft == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+                    return NULL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueueSet );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksLeft ) == pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxMember = prvQueueSetFirstReady( pxQueueSet );
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxMember == NULL )
+                {
+                    vTaskPlaceOnEventList( &( pxQueueSet->xTasksWaitingToReceive ), xTicksLeft );
+                    prvUnlockQueue( pxQueueSet );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    prvUnlockQueue( pxQueueSet );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueueSet );
+                ( void ) xTaskResumeAll();
+                xTicksLeft = ( TickType_t ) 0;
+            }
+        } /*lint -restore */
     }
 
 #endif /* configUSE_QUEUE_SETS */
@@ -3005,10 +3813,16 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )
     {
-        QueueSetMemberHandle_t xReturn = NULL;
+        Queue_t * pxMember;
+        UBaseType_t uxSavedInterruptStatus;
 
-        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL ); /*lint !e961 Casting from one typedef to another is not redundant. */
-        return xReturn;
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxMember = prvQueueSetFirstReady( xQueueSet );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return pxMember;
     }
 
 #endif /* configUSE_QUEUE_SETS */
@@ -3020,6 +3834,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     {
         Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
         BaseType_t xReturn = pdFALSE;
+        int8_t cTxLock;
 
         /* This function must be called form a critical section. */
 
@@ -3027,30 +3842,23 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * to prvNotifyQueueSetContainer is preceded by a check that
          * pxQueueSetContainer != NULL */
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
-        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
-        {
-            const int8_t cTxLock = pxQueueSetContainer->cTxLock;
+        cTxLock = pxQueueSetContainer->cTxLock;
 
-            traceQUEUE_SET_SEND( pxQueueSetContainer );
+        traceQUEUE_SET_SEND( pxQueueSetContainer );
 
-            /* The data copied is the handle of the queue that contains data. */
-            xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+        /* Mark the queue as holding data.  Nothing is copied, and the bit may
+         * already be set if the queue was not empty. */
+        pxQueueSetContainer->uxQueueSetBits |= pxQueue->uxQueueSetBits;
 
-            if( cTxLock == queueUNLOCKED )
+        if( cTxLock == queueUNLOCKED )
+        {
+            if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
             {
-                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority. */
-                        xReturn = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    /* The task waiting has a higher priority. */
+                    xReturn = pdTRUE;
                 }
                 else
                 {
@@ -3059,17 +3867,242 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             }
             else
             {
-                configASSERT( cTxLock != queueINT8_MAX );
-
-                pxQueueSetContainer->cTxLock = ( int8_t ) ( cTxLock + 1 );
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            configASSERT( cTxLock != queueINT8_MAX );
+
+            pxQueueSetContainer->cTxLock = ( int8_t ) ( cTxLock + 1 );
         }
 
         return xReturn;
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+/*
+ * A zero copy queue is a pool of buffers and two queues of pointers into it:
+ * the free buffers and the committed ones.  Acquire and release move a
+ * pointer through the first, commit and receive through the second, so the
+ * blocking and the ISR behaviour are those of the underlying queues while the
+ * items themselves are never copied.
+ */
+    typedef struct ZeroCopyQueueDefinition
+    {
+        QueueHandle_t xFree;      /*< Buffers that can be acquired.  Senders block on this queue. */
+        QueueHandle_t xCommitted; /*< Committed buffers, in commit order.  Receivers block on this queue. */
+        uint8_t * pucBuffers;     /*< The first of uxLength buffers. */
+        size_t xBufferSize;       /*< Item size rounded up to portBYTE_ALIGNMENT. */
+        UBaseType_t uxLength;
+    } ZeroCopyQueue_t;
+
+/* A pointer passed in by the application must be one of the queue's buffers. */
+    #define prvASSERT_ZERO_COPY_BUFFER( pxQueue, pvItem )                                                                    \
+    configASSERT( ( ( uint8_t * ) ( pvItem ) >= ( pxQueue )->pucBuffers ) &&                                                 \
+                  ( ( uint8_t * ) ( pvItem ) < ( ( pxQueue )->pucBuffers + ( ( pxQueue )->xBufferSize * ( pxQueue )->uxLength ) ) ) && \
+                  ( ( ( size_t ) ( ( uint8_t * ) ( pvItem ) - ( pxQueue )->pucBuffers ) % ( pxQueue )->xBufferSize ) == ( size_t ) 0 ) )
+
+    ZeroCopyQueueHandle_t xQueueCreateZeroCopy( const UBaseType_t uxQueueLength,
+                                                const UBaseType_t uxItemSize )
+    {
+        ZeroCopyQueue_t * pxQueue = NULL;
+        size_t xHeaderSize, xBufferSize;
+        uint8_t * pucBuffer;
+        UBaseType_t x;
+
+        configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* Every buffer, and so the first one, starts on an aligned address. */
+        xHeaderSize = ( sizeof( ZeroCopyQueue_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+        xBufferSize = ( ( size_t ) uxItemSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+        /* Check for multiplication overflow. */
+        if( ( ( SIZE_MAX - xHeaderSize ) / xBufferSize ) >= ( size_t ) uxQueueLength )
+        {
+            pxQueue = ( ZeroCopyQueue_t * ) pvPortMalloc( xHeaderSize + ( xBufferSize * ( size_t ) uxQueueLength ) ); /*lint !e9087 !e9079 The buffers follow the aligned header in the same allocation. */
+        }
+
+        if( pxQueue != NULL )
+        {
+            pxQueue->xFree = xQueueCreate( uxQueueLength, ( UBaseType_t ) sizeof( void * ) );
+            pxQueue->xCommitted = xQueueCreate( uxQueueLength, ( UBaseType_t ) sizeof( void * ) );
+
+            if( ( pxQueue->xFree != NULL ) && ( pxQueue->xCommitted != NULL ) )
+            {
+                pxQueue->pucBuffers = ( ( uint8_t * ) pxQueue ) + xHeaderSize; /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+                pxQueue->xBufferSize = xBufferSize;
+                pxQueue->uxLength = uxQueueLength;
+
+                /* The queue is not visible to any other task yet, so this
+                 * cannot block. */
+                for( x = ( UBaseType_t ) 0; x < uxQueueLength; x++ )
+                {
+                    pucBuffer = pxQueue->pucBuffers + ( xBufferSize * ( size_t ) x );
+                    ( void ) xQueueSend( pxQueue->xFree, &pucBuffer, ( TickType_t ) 0 );
+                }
+            }
+            else
+            {
+                if( pxQueue->xFree != NULL )
+                {
+                    vQueueDelete( pxQueue->xFree );
+                }
+
+                if( pxQueue->xCommitted != NULL )
+                {
+                    vQueueDelete( pxQueue->xCommitted );
+                }
+
+                vPortFree( pxQueue );
+                pxQueue = NULL;
+            }
+        }
+        else
+        {
+            traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+        }
+
+        return pxQueue;
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueDeleteZeroCopy( ZeroCopyQueueHandle_t xQueue )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        vQueueDelete( pxQueue->xFree );
+        vQueueDelete( pxQueue->xCommitted );
+        vPortFree( pxQueue );
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvQueueAcquire( ZeroCopyQueueHandle_t xQueue,
+                           TickType_t xTicksToWait )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        ( void ) xQueueReceive( pxQueue->xFree, &pvItem, xTicksToWait );
+
+        return pvItem;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvQueueAcquireFromISR( ZeroCopyQueueHandle_t xQueue )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        /* Nothing blocks sending to xFree, so no task can be woken. */
+        ( void ) xQueueReceiveFromISR( pxQueue->xFree, &pvItem, NULL );
+
+        return pvItem;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueCommit( ZeroCopyQueueHandle_t xQueue,
+                             void * pvItem )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+        prvASSERT_ZERO_COPY_BUFFER( pxQueue, pvItem );
+
+        /* xCommitted can hold every buffer, so there is always space. */
+        xReturn = xQueueSend( pxQueue->xCommitted, &pvItem, ( TickType_t ) 0 );
+        configASSERT( xReturn == pdPASS );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueCommitFromISR( ZeroCopyQueueHandle_t xQueue,
+                                    void * pvItem,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+        prvASSERT_ZERO_COPY_BUFFER( pxQueue, pvItem );
+
+        xReturn = xQueueSendFromISR( pxQueue->xCommitted, &pvItem, pxHigherPriorityTaskWoken );
+        configASSERT( xReturn == pdPASS );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvQueueReceiveZeroCopy( ZeroCopyQueueHandle_t xQueue,
+                                   TickType_t xTicksToWait )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        ( void ) xQueueReceive( pxQueue->xCommitted, &pvItem, xTicksToWait );
+
+        return pvItem;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvQueueReceiveZeroCopyFromISR( ZeroCopyQueueHandle_t xQueue )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        /* Nothing blocks sending to xCommitted, so no task can be woken. */
+        ( void ) xQueueReceiveFromISR( pxQueue->xCommitted, &pvItem, NULL );
+
+        return pvItem;
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueRelease( ZeroCopyQueueHandle_t xQueue,
+                        void * pvItem )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+        prvASSERT_ZERO_COPY_BUFFER( pxQueue, pvItem );
+
+        /* xFree can hold every buffer, so there is always space. */
+        xReturn = xQueueSend( pxQueue->xFree, &pvItem, ( TickType_t ) 0 );
+        configASSERT( xReturn == pdPASS );
+        ( void ) xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueReleaseFromISR( ZeroCopyQueueHandle_t xQueue,
+                               void * pvItem,
+                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+        prvASSERT_ZERO_COPY_BUFFER( pxQueue, pvItem );
+
+        xReturn = xQueueSendFromISR( pxQueue->xFree, &pvItem, pxHigherPriorityTaskWoken );
+        configASSERT( xReturn == pdPASS );
+        ( void ) xReturn;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
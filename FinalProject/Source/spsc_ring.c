@@ -0,0 +1,392 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_ring.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_ring.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* The storage has one slot more than the ring's length, so that uxHead ==
+ * uxTail means empty without a shared item count that both sides would have to
+ * update. */
+typedef struct SpscRingDef_t
+{
+    volatile UBaseType_t uxHead;             /* Next slot the producer writes.  Only written by the producer. */
+    volatile UBaseType_t uxTail;             /* Next slot the consumer reads.  Only written by the consumer. */
+    volatile TaskHandle_t xTaskWaiting;      /* The consumer while it is about to block or blocked on the ring, otherwise NULL. */
+    UBaseType_t uxSlots;                     /* uxLength + 1. */
+    UBaseType_t uxItemSize;
+    uint8_t * pucStorage;
+} SpscRing_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copies pvItem into the ring if there is space, without masking interrupts.
+ * Returns the consumer's handle if it must be notified, else NULL.
+ */
+static TaskHandle_t prvWriteItem( SpscRing_t * const pxRing,
+                                  const void * pvItem,
+                                  BaseType_t * const pxReturn ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies up to uxMaxItems items out of the ring with at most two memcpy()
+ * calls, and returns how many were copied.
+ */
+static UBaseType_t prvReadItems( SpscRing_t * const pxRing,
+                                 uint8_t * pucBuffer,
+                                 UBaseType_t uxMaxItems ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize )
+    {
+        SpscRing_t * pxRing;
+        size_t xStorageBytes;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        xStorageBytes = ( ( size_t ) uxLength + ( size_t ) 1 ) * ( size_t ) uxItemSize;
+
+        /* Check for multiplication and addition overflow. */
+        configASSERT( ( xStorageBytes / uxItemSize ) == ( ( size_t ) uxLength + ( size_t ) 1 ) );
+        configASSERT( ( sizeof( SpscRing_t ) + xStorageBytes ) > xStorageBytes );
+
+        /* The ring and its storage are allocated in one go, as queues are. */
+        pxRing = ( SpscRing_t * ) pvPortMalloc( sizeof( SpscRing_t ) + xStorageBytes ); /*lint !e9087 !e9079 The ring and its storage are one allocation. */
+
+        if( pxRing != NULL )
+        {
+            pxRing->uxHead = ( UBaseType_t ) 0;
+            pxRing->uxTail = ( UBaseType_t ) 0;
+            pxRing->xTaskWaiting = NULL;
+            pxRing->uxSlots = uxLength + ( UBaseType_t ) 1;
+            pxRing->uxItemSize = uxItemSize;
+            pxRing->pucStorage = ( ( uint8_t * ) pxRing ) + sizeof( SpscRing_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxRing;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vSpscRingDelete( SpscRingHandle_t xRing )
+{
+    configASSERT( xRing );
+    configASSERT( xRing->xTaskWaiting == NULL );
+
+    vPortFree( ( void * ) xRing );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvWriteItem( SpscRing_t * const pxRing,
+                                  const void * pvItem,
+                                  BaseType_t * const pxReturn )
+{
+    UBaseType_t uxHead = pxRing->uxHead, uxNext;
+    TaskHandle_t xTaskToNotify = NULL;
+
+    uxNext = uxHead + ( UBaseType_t ) 1;
+
+    if( uxNext == pxRing->uxSlots )
+    {
+        uxNext = ( UBaseType_t ) 0;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( uxNext != pxRing->uxTail )
+    {
+        ( void ) memcpy( ( void * ) &( pxRing->pucStorage[ uxHead * pxRing->uxItemSize ] ), pvItem, ( size_t ) pxRing->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        /* The item must be in the slot before the consumer can see it. */
+        portMEMORY_BARRIER();
+        pxRing->uxHead = uxNext;
+
+        /* The consumer publishes xTaskWaiting and then checks uxHead again, the
+         * producer publishes uxHead and then checks xTaskWaiting, so at least
+         * one of them sees the other and the item cannot be missed. */
+        portMEMORY_BARRIER();
+
+        if( pxRing->xTaskWaiting != NULL )
+        {
+            xTaskToNotify = pxRing->xTaskWaiting;
+            pxRing->xTaskWaiting = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        *pxReturn = pdPASS;
+    }
+    else
+    {
+        *pxReturn = errQUEUE_FULL;
+    }
+
+    return xTaskToNotify;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItem,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscRing_t * const pxRing = xRing;
+    TaskHandle_t xTaskToNotify;
+    BaseType_t xReturn;
+
+    configASSERT( pxRing );
+    configASSERT( pvItem );
+
+    xTaskToNotify = prvWriteItem( pxRing, pvItem, &xReturn );
+
+    if( xTaskToNotify != NULL )
+    {
+        ( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingSend( SpscRingHandle_t xRing,
+                          const void * pvItem )
+{
+    SpscRing_t * const pxRing = xRing;
+    TaskHandle_t xTaskToNotify;
+    BaseType_t xReturn;
+
+    configASSERT( pxRing );
+    configASSERT( pvItem );
+
+    xTaskToNotify = prvWriteItem( pxRing, pvItem, &xReturn );
+
+    if( xTaskToNotify != NULL )
+    {
+        ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvReadItems( SpscRing_t * const pxRing,
+                                 uint8_t * pucBuffer,
+                                 UBaseType_t uxMaxItems )
+{
+    UBaseType_t uxHead, uxTail = pxRing->uxTail, uxCount, uxFirst;
+
+    uxHead = pxRing->uxHead;
+
+    /* Read uxHead before the slots it covers. */
+    portMEMORY_BARRIER();
+
+    if( uxHead >= uxTail )
+    {
+        uxCount = uxHead - uxTail;
+    }
+    else
+    {
+        uxCount = ( pxRing->uxSlots - uxTail ) + uxHead;
+    }
+
+    if( uxCount > uxMaxItems )
+    {
+        uxCount = uxMaxItems;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( uxCount > ( UBaseType_t ) 0 )
+    {
+        /* Up to the end of the storage, then the rest from the start. */
+        uxFirst = pxRing->uxSlots - uxTail;
+
+        if( uxFirst > uxCount )
+        {
+            uxFirst = uxCount;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) pucBuffer, ( const void * ) &( pxRing->pucStorage[ uxTail * pxRing->uxItemSize ] ), ( size_t ) uxFirst * pxRing->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        if( uxCount > uxFirst )
+        {
+            ( void ) memcpy( ( void * ) &( pucBuffer[ uxFirst * pxRing->uxItemSize ] ), ( const void * ) pxRing->pucStorage, ( size_t ) ( uxCount - uxFirst ) * pxRing->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxTail += uxCount;
+
+        if( uxTail >= pxRing->uxSlots )
+        {
+            uxTail -= pxRing->uxSlots;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The items must be copied out before the producer can reuse the
+         * slots. */
+        portMEMORY_BARRIER();
+        pxRing->uxTail = uxTail;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSpscRingReceive( SpscRingHandle_t xRing,
+                               void * pvBuffer,
+                               UBaseType_t uxMaxItems,
+                               TickType_t xTicksToWait )
+{
+    SpscRing_t * const pxRing = xRing;
+    UBaseType_t uxReceived;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxRing );
+    configASSERT( pvBuffer );
+    configASSERT( uxMaxItems > ( UBaseType_t ) 0 );
+
+    uxReceived = prvReadItems( pxRing, ( uint8_t * ) pvBuffer, uxMaxItems );
+
+    if( ( uxReceived == ( UBaseType_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Drop any notification left over from an earlier wait, then say
+             * that this task is waiting and look once more, as the producer
+             * may have sent an item just before xTaskWaiting was set. */
+            ( void ) xTaskNotifyStateClear( NULL );
+
+            /* Should only be one consumer. */
+            configASSERT( pxRing->xTaskWaiting == NULL );
+            pxRing->xTaskWaiting = xTaskGetCurrentTaskHandle();
+            portMEMORY_BARRIER();
+
+            if( pxRing->uxHead == pxRing->uxTail )
+            {
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Whether or not the producer cleared it. */
+            pxRing->xTaskWaiting = NULL;
+
+            uxReceived = prvReadItems( pxRing, ( uint8_t * ) pvBuffer, uxMaxItems );
+        } while( ( uxReceived == ( UBaseType_t ) 0 ) &&
+                 ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxReceived;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing )
+{
+    const SpscRing_t * const pxRing = xRing;
+    UBaseType_t uxHead, uxTail;
+
+    configASSERT( pxRing );
+
+    uxHead = pxRing->uxHead;
+    uxTail = pxRing->uxTail;
+
+    if( uxHead >= uxTail )
+    {
+        return uxHead - uxTail;
+    }
+    else
+    {
+        return ( pxRing->uxSlots - uxTail ) + uxHead;
+    }
+}
+/*-----------------------------------------------------------*/
@@ -213,6 +213,31 @@
         prvResetNextTaskUnblockTime();                                            \
     }
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/* The delayed task wheel has a slot per tick, indexed by the wake time modulo
+ * the number of slots.  A bit per slot in ulDelayedWheelOccupied[] and a bit
+ * per word of that in ulDelayedWheelWords find the next occupied slot. */
+    #define taskDELAYED_WHEEL_SLOTS    ( ( UBaseType_t ) 1U << configDELAYED_TASK_WHEEL_SLOT_BITS )
+    #define taskDELAYED_WHEEL_MASK     ( taskDELAYED_WHEEL_SLOTS - ( UBaseType_t ) 1U )
+    #define taskDELAYED_WHEEL_WORDS    ( ( taskDELAYED_WHEEL_SLOTS + ( UBaseType_t ) 31U ) >> 5 )
+
+    #define taskIS_IN_DELAYED_WHEEL( pxList )                \
+    ( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ] ) ) &&       \
+      ( ( pxList ) <= &( xDelayedTaskWheel[ taskDELAYED_WHEEL_MASK ] ) ) )
+
+/* The list that holds the task which leaves the Blocked state first. */
+    #define taskNEXT_DELAYED_LIST()    prvNextDelayedList()
+
+#else
+
+/* Without the wheel all delays go to the sorted delayed task list. */
+    #define prvInsertDelayedTask( pxTCB )    vListInsert( pxDelayedTaskList, &( ( pxTCB )->xStateListItem ) )
+
+    #define taskNEXT_DELAYED_LIST()          ( pxDelayedTaskList )
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -227,7 +252,13 @@
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 #else
-	#define prvAddTaskToReadyList(pxTCB)    vListInsert( &(xReadyTasksListEDF), &((pxTCB)->xStateListItem) )	
+	/* xReadyTasksListEDF is ordered by deadline.  The item value is restored
+	 * from xTaskDeadline as blocking overwrites it with the time to wake. */
+	#define prvAddTaskToReadyList( pxTCB )                                                       \
+	do {                                                                                     \
+		listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->xTaskDeadline ); \
+		vListInsert( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) );              \
+	} while( 0 )
 #endif
 /*-----------------------------------------------------------*/
 
@@ -253,6 +284,23 @@
     #define taskEVENT_LIST_ITEM_VALUE_IN_USE    0x80000000UL
 #endif
 
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/*
+ * The outermost section of one kind that is being timed, see
+ * vTaskCriticalSectionEntered() and vTaskSuspendAllFrom().
+ */
+    typedef struct tskSECTION_TIMER
+    {
+        const char * pcFile; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        uint32_t ulLine;
+        uint8_t * pucSite;   /*< The call site's cached slot, NULL if the section is not timed. */
+        uint32_t ulStart;    /*< portGET_CRITICAL_SECTION_TIME() when the section was entered. */
+        UBaseType_t uxNesting;
+    } SectionTimer_t;
+
+#endif
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -339,7 +387,19 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 		 /* E.C. : the period of a task */
 		#if ( configUSE_EDF_SCHEDULER == 1 )
 				TickType_t xTaskPeriod; /*< Stores the period in tick of the task. > */
+				TickType_t xTaskDeadline; /*< Absolute deadline of the current job, in ticks. */
+				uint8_t ucEventListOrdered; /*< Set to pdTRUE while xEventListItem is in an event list kept in deadline order, see vTaskPlaceOnEventList(). */
 		#endif
+
+    #if ( configGENERATE_JOB_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulJobRunTime; /*< Time the current job has spent in the Running state so far. */
+        uint8_t ucJobDone;                        /*< Set from the end of a job until the task is next switched in. */
+        TaskJobTimeStats_t xJobTimeStats;         /*< Execution times of the completed jobs. */
+    #endif
+
+    #if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+        SectionTimer_t xCriticalSection; /*< The critical section the task was in when it was switched out, if any. */
+    #endif
 		
 } tskTCB;
 
@@ -362,6 +422,16 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Poi
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+    PRIVILEGED_DATA static List_t xDelayedTaskWheel[ taskDELAYED_WHEEL_SLOTS ];        /*< Delayed tasks that wake within taskDELAYED_WHEEL_SLOTS ticks of xDelayedWheelTime, by wake time. */
+    PRIVILEGED_DATA static uint32_t ulDelayedWheelOccupied[ taskDELAYED_WHEEL_WORDS ]; /*< A bit per slot that may hold tasks.  Slots emptied by other means than the tick are cleared when next looked at. */
+    PRIVILEGED_DATA static uint32_t ulDelayedWheelWords = 0U;                          /*< A bit per word of ulDelayedWheelOccupied[] that is not zero. */
+    PRIVILEGED_DATA static TickType_t xDelayedWheelTime = ( TickType_t ) configINITIAL_TICK_COUNT; /*< No task in the wheel wakes before this time. */
+    PRIVILEGED_DATA static List_t * pxDelayedWheelNextList = &xDelayedTaskList1;    /*< The list xNextTaskUnblockTime was last taken from, where the tick starts looking. */
+
+#endif
+
 #if ( configUSE_EDF_SCHEDULER == 1 )	
 	PRIVILEGED_DATA List_t xReadyTasksListEDF; 										 /*< Ready tasks ordered by their deadline. */
 #endif
@@ -379,6 +449,12 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 
 #endif
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    PRIVILEGED_DATA static List_t xMailboxSendersList; /*< Tasks blocked in xTaskMailboxSend() on a mailbox that holds a message, whichever task it belongs to. */
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
  * the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -397,6 +473,10 @@ PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
+#if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_ISR_CALLBACKS == 1 ) )
+    PRIVILEGED_DATA static volatile BaseType_t xTickCallbacksRunning = pdFALSE; /*< pdTRUE while the tick runs timer callbacks, which must not block or suspend the scheduler. */
+#endif
+
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
  * to determine the number of priority lists to read back from the remote target. */
@@ -421,6 +501,17 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 #endif
 
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/* Only accessed with interrupts disabled, or with the scheduler suspended by
+ * the task that suspended it. */
+    PRIVILEGED_DATA static TaskSectionStats_t xSectionStats[ configCRITICAL_SECTION_SITES ];
+    PRIVILEGED_DATA static UBaseType_t uxSectionSitesUsed = ( UBaseType_t ) 0U;
+    PRIVILEGED_DATA static SectionTimer_t xCriticalSectionTimer = { NULL, 0U, NULL, 0U, ( UBaseType_t ) 0U };
+    PRIVILEGED_DATA static SectionTimer_t xSuspendTimer = { NULL, 0U, NULL, 0U, ( UBaseType_t ) 0U };
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -543,6 +634,25 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/*
+ * Place the task represented by pxTCB, the item value of which holds its wake
+ * time, in its slot of the delayed task wheel if the wake time is close
+ * enough, or in the delayed task list otherwise.  The wake time must not have
+ * overflowed.
+ */
+    static void prvInsertDelayedTask( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the slot of the delayed task wheel or the delayed task list, whichever
+ * holds the task that wakes first.  Returns the (empty) delayed task list if no
+ * task is delayed.
+ */
+    static List_t * prvNextDelayedList( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 /*
@@ -554,6 +664,63 @@ static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configGENERATE_JOB_TIME_STATS == 1 )
+
+/*
+ * Called by xTaskDelayUntil() to close the running task's current job and
+ * add its execution time to the task's job time statistics.
+ */
+    static void prvRecordJobEnd( const TickType_t xTimeIncrement,
+                                 const BaseType_t xWillBlock ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+/*
+ * Add the time since pxTimer was started to the statistics of its call site,
+ * allocating the site a slot the first time.  Called with interrupts
+ * disabled.
+ */
+    static void prvRecordSection( const SectionTimer_t * const pxTimer,
+                                  const eSectionKind eKind ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/*
+ * Give the task represented by pxTCB a new absolute deadline, moving it to its
+ * place in xReadyTasksListEDF if it is ready.  Called with interrupts masked.
+ * Returns pdTRUE, and sets xYieldPending, if the running task is no longer the
+ * most urgent one.
+ */
+    static BaseType_t prvSetTaskDeadline( TCB_t * const pxTCB,
+                                          const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the task represented by pxTCB to the place of its deadline in the
+ * deadline ordered event list it is blocked on, if any.  Called from the task
+ * level with interrupts masked, as an interrupt may not change an event list
+ * that a task could be inserting into with the queue locked.
+ */
+    static void prvMoveInEventList( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+/*
+ * Unblock every task waiting in xTaskMailboxSend(), after the calling task
+ * took a message from one of its mailboxes.  The senders do not record the
+ * mailbox they wait for, so each checks its own again and blocks for the rest
+ * of its time if it is still full.  Called from the task level with interrupts
+ * masked.  Returns pdTRUE if a sender should run before the calling task.
+ */
+    static BaseType_t prvWakeMailboxSenders( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Called after a Task_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -824,11 +991,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             						
 					  /*E.C. : initialize the period */
 						pxNewTCB->xTaskPeriod = param_period;						
+						pxNewTCB->xTaskDeadline = param_period + xTaskGetTickCount();
 					
 						/*E.C. : insert the period value in the generic list iteam before to add the task in RL: */
 
 	
-						listSET_LIST_ITEM_VALUE( &((pxNewTCB)->xStateListItem), (pxNewTCB)->xTaskPeriod + xTaskGetTickCount() );
+						listSET_LIST_ITEM_VALUE( &((pxNewTCB)->xStateListItem), (pxNewTCB)->xTaskDeadline );
 					
 										
 						prvAddNewTaskToReadyList( pxNewTCB );
@@ -1080,6 +1248,15 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* xTaskPeriodicCreate() sets the first deadline.  Other tasks
+             * have none and only run when no job is ready. */
+            pxNewTCB->xTaskDeadline = portMAX_DELAY;
+            pxNewTCB->ucEventListOrdered = pdFALSE;
+        }
+    #endif
+
     #if ( portCRITICAL_NESTING_IN_TCB == 1 )
         {
             pxNewTCB->uxCriticalNesting = ( UBaseType_t ) 0U;
@@ -1098,6 +1275,20 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         }
     #endif /* configGENERATE_RUN_TIME_STATS */
 
+    #if ( configGENERATE_JOB_TIME_STATS == 1 )
+        {
+            pxNewTCB->ulJobRunTime = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            pxNewTCB->ucJobDone = ( uint8_t ) pdFALSE;
+            ( void ) memset( &( pxNewTCB->xJobTimeStats ), 0x00, sizeof( TaskJobTimeStats_t ) );
+        }
+    #endif /* configGENERATE_JOB_TIME_STATS */
+
+    #if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+        {
+            pxNewTCB->xCriticalSection.uxNesting = ( UBaseType_t ) 0U;
+        }
+    #endif
+
     #if ( portUSING_MPU_WRAPPERS == 1 )
         {
             vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1235,7 +1426,13 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * so far. */
             if( xSchedulerRunning == pdFALSE )
             {
+								#if configUSE_EDF_SCHEDULER == 0
                 if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+								#else
+								/* Start with the earliest deadline, the first of equal
+								 * deadlines as in xReadyTasksListEDF. */
+								if( pxNewTCB->xStateListItem.xItemValue < pxCurrentTCB->xStateListItem.xItemValue )
+								#endif
                 {
                     pxCurrentTCB = pxNewTCB;
                 }
@@ -1457,10 +1654,25 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             /* Update the wake time ready for the next call. */
             *pxPreviousWakeTime = xTimeToWake;
 
+            /* A periodic task calls this function once per job, so this is
+             * where the job ends. */
+            #if ( configGENERATE_JOB_TIME_STATS == 1 )
+                {
+                    prvRecordJobEnd( xTimeIncrement, xShouldDelay );
+                }
+            #endif
+
             if( xShouldDelay != pdFALSE )
             {
                 traceTASK_DELAY_UNTIL( xTimeToWake );
 
+                /* The next job is released at the time to wake. */
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        pxCurrentTCB->xTaskDeadline = xTimeToWake + pxCurrentTCB->xTaskPeriod;
+                    }
+                #endif
+
                 /* prvAddCurrentTaskToDelayedList() needs the block time, not
                  * the time to wake, so subtract the current tick count. */
                 prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
@@ -1510,6 +1722,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  *
                  * This task cannot be in an event list as it is the currently
                  * executing task. */
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        pxCurrentTCB->xTaskDeadline = xTickCount + xTicksToDelay + pxCurrentTCB->xTaskPeriod;
+                    }
+                #endif
+
                 prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
             }
             xAlreadyYielded = xTaskResumeAll();
@@ -1566,6 +1784,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 eReturn = eBlocked;
             }
 
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                else if( taskIS_IN_DELAYED_WHEEL( pxStateList ) )
+                {
+                    /* The task is in a slot of the delayed task wheel. */
+                    eReturn = eBlocked;
+                }
+            #endif
+
             #if ( INCLUDE_vTaskSuspend == 1 )
                 else if( pxStateList == &xSuspendedTaskList )
                 {
@@ -1859,6 +2085,212 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static BaseType_t prvSetTaskDeadline( TCB_t * const pxTCB,
+                                          const TickType_t xDeadline )
+    {
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        pxTCB->xTaskDeadline = xDeadline;
+
+        /* A task that is not ready picks up the deadline when it is next added
+         * to the ready list. */
+        if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            {
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                prvAddTaskToReadyList( pxTCB );
+            }
+            else if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
+            {
+                /* The ready list cannot be changed while the scheduler is
+                 * suspended.  xTaskResumeAll() moves the tasks in
+                 * xPendingReadyList from wherever they are to the ready list,
+                 * which puts this one at its new place. */
+                listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                /* Already in xPendingReadyList. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxTCB != pxCurrentTCB )
+            {
+                if( xDeadline < pxCurrentTCB->xTaskDeadline )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( ( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE ) ||
+                     ( listGET_OWNER_OF_HEAD_ENTRY( &xReadyTasksListEDF ) != pxCurrentTCB ) ) /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            {
+                /* The running task may have moved back behind another. */
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xSwitchRequired != pdFALSE )
+        {
+            /* As in xTaskRemoveFromEventList(). */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xSwitchRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvMoveInEventList( TCB_t * const pxTCB )
+    {
+        List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+        /* Event group and timer service task waiters are not in deadline
+         * order, and a task in xPendingReadyList is no longer waiting. */
+        if( ( pxEventList != NULL ) &&
+            ( pxEventList != &xPendingReadyList ) &&
+            ( pxTCB->ucEventListOrdered != pdFALSE ) )
+        {
+            listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), pxTCB->xTaskDeadline );
+            vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           const TickType_t xDeadline )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            if( xDeadline != pxTCB->xTaskDeadline )
+            {
+                if( ( prvSetTaskDeadline( pxTCB, xDeadline ) != pdFALSE ) && ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvMoveInEventList( pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskRaiseDeadline( TaskHandle_t xTask,
+                             const TickType_t xDeadline )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            if( xDeadline < pxTCB->xTaskDeadline )
+            {
+                if( ( prvSetTaskDeadline( pxTCB, xDeadline ) != pdFALSE ) && ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvMoveInEventList( pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskRaiseDeadlineFromISR( TaskHandle_t xTask,
+                                    const TickType_t xDeadline,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        TCB_t * const pxTCB = xTask;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTask );
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( xDeadline < pxTCB->xTaskDeadline )
+            {
+                if( ( prvSetTaskDeadline( pxTCB, xDeadline ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xTaskGetDeadline( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TickType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xReturn = pxTCB->xTaskDeadline;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
     void vTaskSuspend( TaskHandle_t xTaskToSuspend )
@@ -2300,7 +2732,9 @@ void vTaskEndScheduler( void )
 }
 /*----------------------------------------------------------*/
 
-void vTaskSuspendAll( void )
+/* The name is in parentheses so that the call site tagging vTaskSuspendAll()
+ * macro of configGENERATE_CRITICAL_SECTION_STATS is not expanded here. */
+void ( vTaskSuspendAll )( void )
 {
     /* A critical section is not required as the variable is of type
      * BaseType_t.  Please read Richard Barry's reply in the following link to a
@@ -2311,6 +2745,11 @@ void vTaskSuspendAll( void )
      * do not otherwise exhibit real time behaviour. */
     portSOFTWARE_BARRIER();
 
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_ISR_CALLBACKS == 1 ) )
+        /* Timer callbacks run from the tick must not suspend the scheduler. */
+        configASSERT( xTickCallbacksRunning == pdFALSE );
+    #endif
+
     /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
      * is used to allow calls to vTaskSuspendAll() to nest. */
     ++uxSchedulerSuspended;
@@ -2402,11 +2841,21 @@ BaseType_t xTaskResumeAll( void )
     {
         --uxSchedulerSuspended;
 
-        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-        {
-            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+        #if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
             {
-                /* Move any readied tasks from the pending list into the
+                if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) && ( xSuspendTimer.pucSite != NULL ) )
+                {
+                    prvRecordSection( &xSuspendTimer, eSchedulerSuspended );
+                    xSuspendTimer.pucSite = NULL;
+                }
+            }
+        #endif
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        {
+            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            {
+                /* Move any readied tasks from the pending list into the
                  * appropriate ready list. */
                 while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
                 {
@@ -2417,8 +2866,15 @@ BaseType_t xTaskResumeAll( void )
                     prvAddTaskToReadyList( pxTCB );
 
                     /* If the moved task has a priority higher than or equal to
-                     * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                     * the current task, or under EDF an earlier deadline, then
+                     * a yield must be performed.  A task with the same deadline
+                     * is inserted behind the current task, so it would not be
+                     * selected by the yield. */
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( pxTCB->xTaskDeadline < pxCurrentTCB->xTaskDeadline )
+                    #else
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #endif
                     {
                         xYieldPending = pdTRUE;
                     }
@@ -2667,6 +3123,17 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                 pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
             }
 
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    UBaseType_t uxSlot;
+
+                    for( uxSlot = ( UBaseType_t ) 0U; ( uxSlot < taskDELAYED_WHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxSlot ] ), pcNameToQuery );
+                    }
+                }
+            #endif
+
             #if ( INCLUDE_vTaskSuspend == 1 )
                 {
                     if( pxTCB == NULL )
@@ -2731,6 +3198,17 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                 uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
                 uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                    {
+                        UBaseType_t uxSlot;
+
+                        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < taskDELAYED_WHEEL_SLOTS; uxSlot++ )
+                        {
+                            uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxSlot ] ), eBlocked );
+                        }
+                    }
+                #endif
+
                 #if ( INCLUDE_vTaskDelete == 1 )
                     {
                         /* Fill in an TaskStatus_t structure with information on
@@ -2916,6 +3394,17 @@ BaseType_t xTaskIncrementTick( void )
     TickType_t xItemValue;
     BaseType_t xSwitchRequired = pdFALSE;
 
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+        /* Volatile as tasks are taken from the list through a ListItem_t,
+         * which the compiler may assume does not alias the MiniListItem_t
+         * that ends the list, so the head must be read again each time. */
+        List_t * volatile pxDelayedList;
+        BaseType_t xListSearched = pdFALSE;
+    #else
+        List_t * pxDelayedList;
+    #endif
+
     /* Called by the portable layer each time a tick interrupt occurs.
      * Increments the tick then checks to see if the new tick value will cause any
      * tasks to be unblocked. */
@@ -2943,12 +3432,47 @@ BaseType_t xTaskIncrementTick( void )
         /* See if this tick has made a timeout expire.  Tasks are stored in
          * the  queue in the order of their wake time - meaning once one task
          * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
+         * look any further down the list.  With the delayed task wheel the
+         * list is the wheel slot or delayed list holding the next task to
+         * wake.  The tick starts from the list xNextTaskUnblockTime was taken
+         * from and only searches the wheel once that list has no task due, so
+         * the wheel is searched once per list that wakes tasks rather than
+         * once per task. */
         if( xConstTickCount >= xNextTaskUnblockTime )
         {
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    pxDelayedList = pxDelayedWheelNextList;
+                }
+            #endif
+
             for( ; ; )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                    {
+                        /* Tasks taken from the list, or an event or deletion
+                         * since the list was found, can leave the next task to
+                         * wake in another list. */
+                        if( ( xListSearched == pdFALSE ) &&
+                            ( ( listLIST_IS_EMPTY( pxDelayedList ) != pdFALSE ) ||
+                              ( xConstTickCount < listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedList ) ) ) )
+                        {
+                            pxDelayedList = taskNEXT_DELAYED_LIST();
+                            pxDelayedWheelNextList = pxDelayedList;
+                            xListSearched = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                #else /* configUSE_DELAYED_TASK_WHEEL */
+                    {
+                        pxDelayedList = taskNEXT_DELAYED_LIST();
+                    }
+                #endif /* configUSE_DELAYED_TASK_WHEEL */
+
+                if( listLIST_IS_EMPTY( pxDelayedList ) != pdFALSE )
                 {
                     /* The delayed list is empty.  Set xNextTaskUnblockTime
                      * to the maximum possible value so it is extremely
@@ -2964,7 +3488,7 @@ BaseType_t xTaskIncrementTick( void )
                      * item at the head of the delayed list.  This is the time
                      * at which the task at the head of the delayed list must
                      * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
                     xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
 
                     if( xConstTickCount < xItemValue )
@@ -2985,6 +3509,12 @@ BaseType_t xTaskIncrementTick( void )
                     /* It is time to remove the item from the Blocked state. */
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
+                    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                        {
+                            xListSearched = pdFALSE;
+                        }
+                    #endif
+
                     /* Is the task waiting on an event also?  If so remove
                      * it from the event list. */
                     if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
@@ -3001,13 +3531,6 @@ BaseType_t xTaskIncrementTick( void )
                      * list. */
                     prvAddTaskToReadyList( pxTCB );
 										
-										
-										#if configUSE_EDF_SCHEDULER == 1
-										
-											pxTCB->xStateListItem.xItemValue = pxTCB->xTaskPeriod + xTaskGetTickCount();
-										
-										#endif /* End of #if configUSE_EDF_SCHEDULER == 1 */
-										
 
                     /* A task being unblocked cannot cause an immediate
                      * context switch if preemption is turned off. */
@@ -3041,6 +3564,26 @@ BaseType_t xTaskIncrementTick( void )
                 }
             }
         }
+
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                /* No task wakes at or before this tick any more, so the wheel
+                 * can move on to it.  A tick stepped over by vTaskStepTick()
+                 * leaves the wheel behind, so its slot is still looked at. */
+                xDelayedWheelTime = xConstTickCount;
+            }
+        #endif
+
+        #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_ISR_CALLBACKS == 1 ) )
+            {
+                /* Timers whose callbacks run from the tick interrupt expire
+                 * here.  A callback that readies a task through a FromISR
+                 * function sets xYieldPending, checked below. */
+                xTickCallbacksRunning = pdTRUE;
+                vTimerProcessIsrTimers( xConstTickCount );
+                xTickCallbacksRunning = pdFALSE;
+            }
+        #endif
 				
 				#if configUSE_EDF_SCHEDULER == 0
 
@@ -3267,6 +3810,18 @@ void vTaskSwitchContext( void )
                 if( ulTotalRunTime > ulTaskSwitchedInTime )
                 {
                     pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+
+                    /* Only the time spent running counts towards a job, so
+                     * preemption is excluded.  After the end of a job the rest
+                     * of the slice belongs to neither that job nor the next. */
+                    #if ( configGENERATE_JOB_TIME_STATS == 1 )
+                        {
+                            if( pxCurrentTCB->ucJobDone == ( uint8_t ) pdFALSE )
+                            {
+                                pxCurrentTCB->ulJobRunTime += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                            }
+                        }
+                    #endif
                 }
                 else
                 {
@@ -3280,6 +3835,20 @@ void vTaskSwitchContext( void )
         /* Check for stack overflow, if configured. */
         taskCHECK_FOR_STACK_OVERFLOW();
 
+        /* A task that yields inside a critical section resumes it when it runs
+         * again, while the next task runs with interrupts enabled.  Close the
+         * measurement and keep the section with the task. */
+        #if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+            {
+                if( xCriticalSectionTimer.uxNesting != ( UBaseType_t ) 0U )
+                {
+                    prvRecordSection( &xCriticalSectionTimer, eCriticalSection );
+                    pxCurrentTCB->xCriticalSection = xCriticalSectionTimer;
+                    xCriticalSectionTimer.uxNesting = ( UBaseType_t ) 0U;
+                }
+            }
+        #endif
+
         /* Before the currently running task is switched out, save its errno. */
         #if ( configUSE_POSIX_ERRNO == 1 )
             {
@@ -3303,6 +3872,24 @@ void vTaskSwitchContext( void )
 				
 				traceTASK_SWITCHED_IN();
 
+        /* The next job of the task starts the first time it runs again. */
+        #if ( configGENERATE_JOB_TIME_STATS == 1 )
+            {
+                pxCurrentTCB->ucJobDone = ( uint8_t ) pdFALSE;
+            }
+        #endif
+
+        #if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+            {
+                if( pxCurrentTCB->xCriticalSection.uxNesting != ( UBaseType_t ) 0U )
+                {
+                    xCriticalSectionTimer = pxCurrentTCB->xCriticalSection;
+                    xCriticalSectionTimer.ulStart = ( uint32_t ) portGET_CRITICAL_SECTION_TIME();
+                    pxCurrentTCB->xCriticalSection.uxNesting = ( UBaseType_t ) 0U;
+                }
+            }
+        #endif
+
         /* After the new task is switched in, update the global errno. */
         #if ( configUSE_POSIX_ERRNO == 1 )
             {
@@ -3340,8 +3927,18 @@ void vTaskPlaceOnEventList( List_t * const pxEventList,
      *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
      * Therefore, the event list is sorted in descending priority order.
      *
+     * Under EDF all tasks share one priority, so the list is sorted by absolute
+     * deadline instead and the most urgent job is woken first.
+     *
      * The queue that contains the event list is locked, preventing
      * simultaneous access from interrupts. */
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), pxCurrentTCB->xTaskDeadline );
+            pxCurrentTCB->ucEventListOrdered = pdTRUE;
+        }
+    #endif
+
     vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
     prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
@@ -3363,6 +3960,13 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
      * task that is not in the Blocked state. */
     listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
 
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* The item value holds the bits waited for, not a deadline. */
+            pxCurrentTCB->ucEventListOrdered = pdFALSE;
+        }
+    #endif
+
     /* Place the event list item of the TCB at the end of the appropriate event
      * list.  It is safe to access the event list here because it is part of an
      * event group implementation - and interrupts don't access event groups
@@ -3394,6 +3998,12 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
          * can be used in place of vListInsert. */
         listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                pxCurrentTCB->ucEventListOrdered = pdFALSE;
+            }
+        #endif
+
         /* If the task should block indefinitely then set the block time to a
          * value that will be recognised as an indefinite delay inside the
          * prvAddCurrentTaskToDelayedList() function. */
@@ -3457,7 +4067,11 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        if( pxUnblockedTCB->xTaskDeadline < pxCurrentTCB->xTaskDeadline )
+    #else
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
     {
         /* Return true if the task removed from the event list has a higher
          * priority than the calling task.  This allows the calling task to know if
@@ -3515,7 +4129,11 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        if( pxUnblockedTCB->xTaskDeadline < pxCurrentTCB->xTaskDeadline )
+    #else
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
     {
         /* The unblocked task has a priority above that of the calling task, so
          * a context switch is required.  This function is called with the
@@ -3687,7 +4305,17 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			
 				#if (configUSE_EDF_SCHEDULER == 1)
 			
-						pxCurrentTCB->xStateListItem.xItemValue = EDF_IDLE_PERIOD + xTaskGetTickCount();
+						/* Move the idle deadline forward.  The item has to be
+						 * re-inserted, changing its value in place would leave
+						 * xReadyTasksListEDF unsorted and the idle task at the head
+						 * of tasks that were released while it was not running. */
+						taskENTER_CRITICAL();
+						{
+								( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+								pxCurrentTCB->xTaskDeadline = EDF_IDLE_PERIOD + xTaskGetTickCount();
+								prvAddTaskToReadyList( pxCurrentTCB );
+						}
+						taskEXIT_CRITICAL();
 						
 				#endif
         /* See if any tasks have deleted themselves - if so then the idle task
@@ -3939,6 +4567,17 @@ static void prvInitialiseTaskLists( void )
     vListInitialise( &xDelayedTaskList2 );
     vListInitialise( &xPendingReadyList );
 
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+        {
+            UBaseType_t uxSlot;
+
+            for( uxSlot = ( UBaseType_t ) 0U; uxSlot < taskDELAYED_WHEEL_SLOTS; uxSlot++ )
+            {
+                vListInitialise( &( xDelayedTaskWheel[ uxSlot ] ) );
+            }
+        }
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
+
     #if ( INCLUDE_vTaskDelete == 1 )
         {
             vListInitialise( &xTasksWaitingTermination );
@@ -3951,6 +4590,12 @@ static void prvInitialiseTaskLists( void )
         }
     #endif /* INCLUDE_vTaskSuspend */
 
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        {
+            vListInitialise( &xMailboxSendersList );
+        }
+    #endif /* configUSE_TASK_NOTIFICATIONS */
+
     /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
      * using list2. */
     pxDelayedTaskList = &xDelayedTaskList1;
@@ -4268,7 +4913,15 @@ static void prvCheckTasksWaitingTermination( void )
 
 static void prvResetNextTaskUnblockTime( void )
 {
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+    List_t * const pxDelayedList = taskNEXT_DELAYED_LIST();
+
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+        {
+            pxDelayedWheelNextList = pxDelayedList;
+        }
+    #endif
+
+    if( listLIST_IS_EMPTY( pxDelayedList ) != pdFALSE )
     {
         /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
          * the maximum possible value so it is  extremely unlikely that the
@@ -4282,11 +4935,136 @@ static void prvResetNextTaskUnblockTime( void )
          * the item at the head of the delayed list.  This is the time at
          * which the task at the head of the delayed list should be removed
          * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedList );
     }
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+    static UBaseType_t prvDelayedWheelLowestBit( uint32_t ulBits )
+    {
+        UBaseType_t uxBit = ( UBaseType_t ) 0U;
+        UBaseType_t uxShift;
+
+        /* Halve the bitmap, there is no portable count trailing zeros. */
+        for( uxShift = ( UBaseType_t ) 16U; uxShift > ( UBaseType_t ) 0U; uxShift >>= 1 )
+        {
+            if( ( ulBits & ( ( ( uint32_t ) 1U << uxShift ) - 1U ) ) == 0U )
+            {
+                ulBits >>= uxShift;
+                uxBit += uxShift;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return uxBit;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInsertDelayedTask( TCB_t * const pxTCB )
+    {
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+        UBaseType_t uxSlot;
+
+        if( ( TickType_t ) ( xTimeToWake - xDelayedWheelTime ) <= ( TickType_t ) taskDELAYED_WHEEL_MASK )
+        {
+            /* Every task in the wheel wakes within a lap of xDelayedWheelTime,
+             * so the tasks that share a slot share their wake time and the slot
+             * needs no sorting. */
+            uxSlot = ( UBaseType_t ) xTimeToWake & taskDELAYED_WHEEL_MASK;
+            listINSERT_END( &( xDelayedTaskWheel[ uxSlot ] ), &( pxTCB->xStateListItem ) );
+            ulDelayedWheelOccupied[ uxSlot >> 5 ] |= ( uint32_t ) 1U << ( uxSlot & ( UBaseType_t ) 31U );
+            ulDelayedWheelWords |= ( uint32_t ) 1U << ( uxSlot >> 5 );
+        }
+        else
+        {
+            vListInsert( pxDelayedTaskList, &( pxTCB->xStateListItem ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static List_t * prvNextDelayedList( void )
+    {
+        const UBaseType_t uxFirstSlot = ( UBaseType_t ) xDelayedWheelTime & taskDELAYED_WHEEL_MASK;
+        const UBaseType_t uxFirstWord = uxFirstSlot >> 5;
+        List_t * pxDelayedList = pxDelayedTaskList;
+        UBaseType_t uxWord, uxSlot;
+        uint32_t ulBits;
+
+        while( ulDelayedWheelWords != 0U )
+        {
+            /* The wheel is read from the slot of xDelayedWheelTime onwards,
+             * wrapping round to the slots before it, which is wake time order. */
+            ulBits = ulDelayedWheelOccupied[ uxFirstWord ] & ( ~( uint32_t ) 0U << ( uxFirstSlot & ( UBaseType_t ) 31U ) );
+
+            if( ulBits != 0U )
+            {
+                uxWord = uxFirstWord;
+            }
+            else
+            {
+                ulBits = ulDelayedWheelWords & ( ~( uint32_t ) 1U << uxFirstWord );
+
+                if( ulBits == 0U )
+                {
+                    /* Only the words up to and including the first one have
+                     * bits left, all of them in slots before the first. */
+                    ulBits = ulDelayedWheelWords;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxWord = prvDelayedWheelLowestBit( ulBits );
+                ulBits = ulDelayedWheelOccupied[ uxWord ];
+            }
+
+            uxSlot = ( uxWord << 5 ) + prvDelayedWheelLowestBit( ulBits );
+
+            if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxSlot ] ) ) != pdFALSE )
+            {
+                /* The tasks of the slot were unblocked by an event, deleted or
+                 * suspended, none of which clear the bit. */
+                ulDelayedWheelOccupied[ uxWord ] &= ~( ( uint32_t ) 1U << ( uxSlot & ( UBaseType_t ) 31U ) );
+
+                if( ulDelayedWheelOccupied[ uxWord ] == 0U )
+                {
+                    ulDelayedWheelWords &= ~( ( uint32_t ) 1U << uxWord );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Neither the wheel nor the delayed task list hold overflowed
+                 * wake times, so the heads compare directly. */
+                if( ( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE ) ||
+                    ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( xDelayedTaskWheel[ uxSlot ] ) ) <= listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList ) ) )
+                {
+                    pxDelayedList = &( xDelayedTaskWheel[ uxSlot ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                break;
+            }
+        }
+
+        return pxDelayedList;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
 
     TaskHandle_t xTaskGetCurrentTaskHandle( void )
@@ -5533,76 +6311,914 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    BaseType_t xTaskMailboxSend( TaskHandle_t xTaskToNotify,
+                                 UBaseType_t uxIndex,
+                                 const uint32_t * pulWords,
+                                 UBaseType_t uxWords,
+                                 BaseType_t xOverwrite,
+                                 TickType_t xTicksToWait )
     {
-        return xIdleTaskHandle->ulRunTimeCounter;
-    }
-
-#endif
-/*-----------------------------------------------------------*/
+        TCB_t * pxTCB;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        uint8_t ucOriginalNotifyState;
+        UBaseType_t uxWord;
+        TimeOut_t xTimeOut;
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+        configASSERT( xTaskToNotify );
+        configASSERT( pulWords );
+        configASSERT( uxWords > ( UBaseType_t ) 0 );
+        configASSERT( ( uxIndex + uxWords ) <= configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        pxTCB = xTaskToNotify;
 
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
-    {
-        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+        /* A task cannot wait for its own mailbox to be read. */
+        configASSERT( !( ( pxTCB == pxCurrentTCB ) && ( xOverwrite == pdFALSE ) && ( xTicksToWait != ( TickType_t ) 0 ) ) );
 
-        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            }
+        #endif
 
-        /* For percentage calculations. */
-        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
 
-        /* Avoid divide by zero errors. */
-        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
-        {
-            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
-        }
-        else
+        /* As xQueueGenericSend(), with the mailbox full while its
+         * notification state records a pending message. */
+        for( ; ; )
         {
-            ulReturn = 0;
-        }
+            taskENTER_CRITICAL();
+            {
+                ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndex ];
 
-        return ulReturn;
-    }
+                if( ( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED ) || ( xOverwrite != pdFALSE ) )
+                {
+                    /* The whole message is written inside the critical section,
+                     * so the task never sees part of it. */
+                    for( uxWord = ( UBaseType_t ) 0; uxWord < uxWords; uxWord++ )
+                    {
+                        pxTCB->ulNotifiedValue[ uxIndex + uxWord ] = pulWords[ uxWord ];
+                    }
 
-#endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
-/*-----------------------------------------------------------*/
+                    pxTCB->ucNotifyState[ uxIndex ] = taskNOTIFICATION_RECEIVED;
 
-static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
-                                            const BaseType_t xCanBlockIndefinitely )
-{
-    TickType_t xTimeToWake;
-    const TickType_t xConstTickCount = xTickCount;
+                    traceTASK_NOTIFY( uxIndex );
 
-    #if ( INCLUDE_xTaskAbortDelay == 1 )
-        {
-            /* About to enter a delayed list, so ensure the ucDelayAborted flag is
-             * reset to pdFALSE so it can be detected as having been set to pdTRUE
-             * when the task leaves the Blocked state. */
-            pxCurrentTCB->ucDelayAborted = pdFALSE;
-        }
-    #endif
+                    /* As xTaskGenericNotify(). */
+                    if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+                    {
+                        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                        prvAddTaskToReadyList( pxTCB );
 
-    /* Remove the task from the ready list before adding it to the blocked list
-     * as the same list item is used for both lists. */
-    if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-    {
-        /* The current task must be in a ready list, so there is no need to
-         * check, and the port reset macro can be called directly. */
-        portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+                        /* The task should not have been on an event list. */
+                        configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
-        {
-            if( ( xTicksToWait == portMAX_DELAY ) && ( xCanBlockIndefinitely != pdFALSE ) )
-            {
-                /* Add the task to the suspended task list instead of a delayed task
+                        #if ( configUSE_TICKLESS_IDLE != 0 )
+                            {
+                                prvResetNextTaskUnblockTime();
+                            }
+                        #endif
+
+                        #if ( configUSE_EDF_SCHEDULER == 1 )
+                            if( pxTCB->xTaskDeadline < pxCurrentTCB->xTaskDeadline )
+                        #else
+                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        #endif
+                        {
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+                    return pdPASS;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The pending message is left for the task to receive. */
+                    taskEXIT_CRITICAL();
+                    return pdFAIL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            /* Only a task empties a mailbox, so with the scheduler suspended it
+             * stays full until this task is on xMailboxSendersList.  Interrupts
+             * never change that list. */
+            vTaskSuspendAll();
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( pxTCB->ucNotifyState[ uxIndex ] == taskNOTIFICATION_RECEIVED )
+                {
+                    vTaskPlaceOnEventList( &xMailboxSendersList, xTicksToWait );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Read in the meantime, try again. */
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                ( void ) xTaskResumeAll();
+                return pdFAIL;
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskMailboxSendFromISR( TaskHandle_t xTaskToNotify,
+                                        UBaseType_t uxIndex,
+                                        const uint32_t * pulWords,
+                                        UBaseType_t uxWords,
+                                        BaseType_t xOverwrite,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdPASS;
+        uint8_t ucOriginalNotifyState;
+        UBaseType_t uxSavedInterruptStatus;
+        UBaseType_t uxWord;
+
+        configASSERT( xTaskToNotify );
+        configASSERT( pulWords );
+        configASSERT( uxWords > ( UBaseType_t ) 0 );
+        configASSERT( ( uxIndex + uxWords ) <= configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* See the comment in xTaskGenericNotifyFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        pxTCB = xTaskToNotify;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndex ];
+
+            if( ( ucOriginalNotifyState == taskNOTIFICATION_RECEIVED ) && ( xOverwrite == pdFALSE ) )
+            {
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                for( uxWord = ( UBaseType_t ) 0; uxWord < uxWords; uxWord++ )
+                {
+                    pxTCB->ulNotifiedValue[ uxIndex + uxWord ] = pulWords[ uxWord ];
+                }
+
+                pxTCB->ucNotifyState[ uxIndex ] = taskNOTIFICATION_RECEIVED;
+
+                traceTASK_NOTIFY_FROM_ISR( uxIndex );
+
+                /* As xTaskGenericNotifyFromISR(). */
+                if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+                {
+                    configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                    {
+                        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                        prvAddTaskToReadyList( pxTCB );
+                    }
+                    else
+                    {
+                        listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    }
+
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( pxTCB->xTaskDeadline < pxCurrentTCB->xTaskDeadline )
+                    #else
+                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    #endif
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskMailboxReceive( UBaseType_t uxIndex,
+                                    uint32_t * pulWords,
+                                    UBaseType_t uxWords,
+                                    TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxWord;
+
+        configASSERT( pulWords );
+        configASSERT( uxWords > ( UBaseType_t ) 0 );
+        configASSERT( ( uxIndex + uxWords ) <= configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* As xTaskGenericNotifyWait(), except that a pending message is taken
+         * in the first critical section. */
+        taskENTER_CRITICAL();
+        {
+            if( pxCurrentTCB->ucNotifyState[ uxIndex ] != taskNOTIFICATION_RECEIVED )
+            {
+                pxCurrentTCB->ucNotifyState[ uxIndex ] = taskWAITING_NOTIFICATION;
+
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_WAIT_BLOCK( uxIndex );
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                for( uxWord = ( UBaseType_t ) 0; uxWord < uxWords; uxWord++ )
+                {
+                    pulWords[ uxWord ] = pxCurrentTCB->ulNotifiedValue[ uxIndex + uxWord ];
+                }
+
+                pxCurrentTCB->ucNotifyState[ uxIndex ] = taskNOT_WAITING_NOTIFICATION;
+                xReturn = pdPASS;
+
+                if( prvWakeMailboxSenders() != pdFALSE )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xReturn == pdFAIL )
+        {
+            taskENTER_CRITICAL();
+            {
+                traceTASK_NOTIFY_WAIT( uxIndex );
+
+                if( pxCurrentTCB->ucNotifyState[ uxIndex ] == taskNOTIFICATION_RECEIVED )
+                {
+                    for( uxWord = ( UBaseType_t ) 0; uxWord < uxWords; uxWord++ )
+                    {
+                        pulWords[ uxWord ] = pxCurrentTCB->ulNotifiedValue[ uxIndex + uxWord ];
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* Timed out. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxCurrentTCB->ucNotifyState[ uxIndex ] = taskNOT_WAITING_NOTIFICATION;
+
+                if( ( xReturn == pdPASS ) && ( prvWakeMailboxSenders() != pdFALSE ) )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    static BaseType_t prvWakeMailboxSenders( void )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+
+        while( listLIST_IS_EMPTY( &xMailboxSendersList ) == pdFALSE )
+        {
+            if( xTaskRemoveFromEventList( &xMailboxSendersList ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xYieldRequired;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    {
+        return xIdleTaskHandle->ulRunTimeCounter;
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+
+        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+
+        /* For percentage calculations. */
+        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+
+        /* Avoid divide by zero errors. */
+        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        {
+            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
+        }
+        else
+        {
+            ulReturn = 0;
+        }
+
+        return ulReturn;
+    }
+
+#endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_JOB_TIME_STATS == 1 )
+
+    static void prvRecordJobEnd( const TickType_t xTimeIncrement,
+                                 const BaseType_t xWillBlock )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow, ulSlice = 0, ulJobTime;
+        TaskJobTimeStats_t * const pxStats = &( pxCurrentTCB->xJobTimeStats );
+        UBaseType_t uxBin;
+
+        /* Called with the scheduler suspended, so pxCurrentTCB cannot be
+         * switched out while its statistics are updated. */
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+        #else
+            ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        /* Add the part of the current slice that has not been accounted for
+         * by vTaskSwitchContext() yet. */
+        if( ulNow > ulTaskSwitchedInTime )
+        {
+            ulSlice = ulNow - ulTaskSwitchedInTime;
+        }
+
+        ulJobTime = pxCurrentTCB->ulJobRunTime + ulSlice;
+
+        if( ( pxStats->ulJobs == 0U ) || ( ulJobTime < pxStats->ulMinTime ) )
+        {
+            pxStats->ulMinTime = ulJobTime;
+        }
+
+        if( ulJobTime > pxStats->ulMaxTime )
+        {
+            pxStats->ulMaxTime = ulJobTime;
+        }
+
+        uxBin = ( UBaseType_t ) ( ulJobTime / ( configRUN_TIME_COUNTER_TYPE ) configJOB_TIME_HISTOGRAM_BIN_WIDTH );
+
+        if( uxBin >= ( UBaseType_t ) configJOB_TIME_HISTOGRAM_BINS )
+        {
+            uxBin = ( UBaseType_t ) configJOB_TIME_HISTOGRAM_BINS - 1U;
+        }
+
+        pxStats->ulHistogram[ uxBin ]++;
+        pxStats->ulLastTime = ulJobTime;
+        pxStats->ulTotalTime += ulJobTime;
+        pxStats->ulJobs++;
+        pxStats->xPeriod = xTimeIncrement;
+
+        if( xWillBlock != pdFALSE )
+        {
+            /* The rest of the slice is spent blocking, not in the next job. */
+            pxCurrentTCB->ulJobRunTime = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            pxCurrentTCB->ucJobDone = ( uint8_t ) pdTRUE;
+        }
+        else
+        {
+            /* The job is late and the next one starts straight away.  The
+             * next switch out adds the whole slice, so start from minus the
+             * part that has already been charged to this job. */
+            pxCurrentTCB->ulJobRunTime = ( configRUN_TIME_COUNTER_TYPE ) 0 - ulSlice;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetJobTimeStats( TaskHandle_t xTask,
+                               TaskJobTimeStats_t * pxJobTimeStats )
+    {
+        TCB_t * pxTCB;
+
+        configASSERT( pxJobTimeStats );
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            *pxJobTimeStats = pxTCB->xJobTimeStats;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskResetJobTimeStats( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        configRUN_TIME_COUNTER_TYPE ulNow;
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) memset( &( pxTCB->xJobTimeStats ), 0x00, sizeof( TaskJobTimeStats_t ) );
+
+            /* The job in progress is measured from now on.  For the running
+             * task that means leaving out the part of the slice before now,
+             * see prvRecordJobEnd(). */
+            pxTCB->ulJobRunTime = ( configRUN_TIME_COUNTER_TYPE ) 0;
+
+            if( pxTCB == pxCurrentTCB )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+                #else
+                    ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                if( ulNow > ulTaskSwitchedInTime )
+                {
+                    pxTCB->ulJobRunTime -= ( ulNow - ulTaskSwitchedInTime );
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configGENERATE_JOB_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_JOB_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    void vTaskGetJobTimeStatsText( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        TaskJobTimeStats_t xStats;
+        UBaseType_t uxArraySize, x, uxBin;
+
+        #if ( configUSE_TRACE_FACILITY != 1 )
+            {
+                #error configUSE_TRACE_FACILITY must also be set to 1 in FreeRTOSConfig.h to use vTaskGetJobTimeStatsText().
+            }
+        #endif
+
+        /* As vTaskGetRunTimeStats(), this is a debug aid that depends on
+         * sprintf() and is not part of the scheduler. */
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Allocate an array index for each task.  NOTE!  If
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        uxArraySize = uxCurrentNumberOfTasks;
+        pxTaskStatusArray = pvPortMalloc( uxArraySize * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxTaskStatusArray != NULL )
+        {
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+
+            for( x = 0; x < uxArraySize; x++ )
+            {
+                vTaskGetJobTimeStats( pxTaskStatusArray[ x ].xHandle, &xStats );
+
+                /* Tasks that never completed a job, such as the idle task,
+                 * are left out. */
+                if( xStats.ulJobs == 0U )
+                {
+                    continue;
+                }
+
+                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+                /* sizeof( int ) == sizeof( long ) on the targets this is used
+                 * on, so a smaller printf() library can be used. */
+                sprintf( pcWriteBuffer, "\t%u\t%u\t%u\t%u\t%u\t", /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                         ( unsigned int ) xStats.xPeriod,
+                         ( unsigned int ) xStats.ulJobs,
+                         ( unsigned int ) xStats.ulMinTime,
+                         ( unsigned int ) xStats.ulMaxTime,
+                         ( unsigned int ) ( xStats.ulTotalTime / xStats.ulJobs ) );
+                pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+
+                for( uxBin = 0; uxBin < ( UBaseType_t ) configJOB_TIME_HISTOGRAM_BINS; uxBin++ )
+                {
+                    sprintf( pcWriteBuffer, ( uxBin == 0U ) ? "%u" : ",%u", ( unsigned int ) xStats.ulHistogram[ uxBin ] ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                }
+
+                sprintf( pcWriteBuffer, "\r\n" ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configGENERATE_JOB_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CRITICAL_SECTION_STATS == 1 )
+
+    static void prvRecordSection( const SectionTimer_t * const pxTimer,
+                                  const eSectionKind eKind )
+    {
+        const uint32_t ulTime = ( uint32_t ) portGET_CRITICAL_SECTION_TIME() - pxTimer->ulStart;
+        uint32_t ulBinLimit = ( uint32_t ) configCRITICAL_SECTION_HISTOGRAM_BIN_WIDTH;
+        UBaseType_t uxSlot = ( UBaseType_t ) *( pxTimer->pucSite );
+        UBaseType_t uxBin = 0U;
+        TaskSectionStats_t * pxStats;
+
+        if( uxSlot == 0U )
+        {
+            /* The first section from this call site.  The last slot is
+             * shared by the sites that come after the table is full. */
+            if( uxSectionSitesUsed < ( ( UBaseType_t ) configCRITICAL_SECTION_SITES - 1U ) )
+            {
+                pxStats = &( xSectionStats[ uxSectionSitesUsed ] );
+                pxStats->pcFile = pxTimer->pcFile;
+                pxStats->ulLine = pxTimer->ulLine;
+                pxStats->eKind = eKind;
+                uxSectionSitesUsed++;
+                uxSlot = uxSectionSitesUsed;
+            }
+            else
+            {
+                uxSlot = ( UBaseType_t ) configCRITICAL_SECTION_SITES;
+            }
+
+            *( pxTimer->pucSite ) = ( uint8_t ) uxSlot;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStats = &( xSectionStats[ uxSlot - 1U ] );
+
+        if( ulTime > pxStats->ulMaxTime )
+        {
+            pxStats->ulMaxTime = ulTime;
+        }
+
+        /* Bins double in width, so a wide range of durations needs few bins
+         * and the bin is found in at most configCRITICAL_SECTION_HISTOGRAM_BINS
+         * steps. */
+        while( ( uxBin < ( ( UBaseType_t ) configCRITICAL_SECTION_HISTOGRAM_BINS - 1U ) ) && ( ulTime >= ulBinLimit ) )
+        {
+            ulBinLimit <<= 1;
+            uxBin++;
+        }
+
+        pxStats->ulHistogram[ uxBin ]++;
+        pxStats->ulTotalTime += ulTime;
+        pxStats->ulCount++;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskCriticalSectionEntered( const char * pcFile,
+                                      uint32_t ulLine,
+                                      uint8_t * pucSite )
+    {
+        /* Called just after portENTER_CRITICAL(), so nothing else can run. */
+        xCriticalSectionTimer.uxNesting++;
+
+        if( xCriticalSectionTimer.uxNesting == ( UBaseType_t ) 1U )
+        {
+            xCriticalSectionTimer.pcFile = pcFile;
+            xCriticalSectionTimer.ulLine = ulLine;
+            xCriticalSectionTimer.pucSite = pucSite;
+            xCriticalSectionTimer.ulStart = ( uint32_t ) portGET_CRITICAL_SECTION_TIME();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskCriticalSectionExiting( void )
+    {
+        /* Called just before portEXIT_CRITICAL().  A section entered through
+         * portENTER_CRITICAL() directly is not counted, so an unmatched exit
+         * is ignored rather than trusted. */
+        if( xCriticalSectionTimer.uxNesting != ( UBaseType_t ) 0U )
+        {
+            xCriticalSectionTimer.uxNesting--;
+
+            if( xCriticalSectionTimer.uxNesting == ( UBaseType_t ) 0U )
+            {
+                prvRecordSection( &xCriticalSectionTimer, eCriticalSection );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskSuspendAllFrom( const char * pcFile,
+                              uint32_t ulLine,
+                              uint8_t * pucSite )
+    {
+        ( vTaskSuspendAll )();
+
+        /* The scheduler is suspended now, so no other task can get here and
+         * xSuspendTimer is not shared with interrupts.  xTaskResumeAll()
+         * records the suspension. */
+        if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+        {
+            xSuspendTimer.pcFile = pcFile;
+            xSuspendTimer.ulLine = ulLine;
+            xSuspendTimer.pucSite = pucSite;
+            xSuspendTimer.ulStart = ( uint32_t ) portGET_CRITICAL_SECTION_TIME();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetCriticalSectionStats( TaskSectionStats_t * const pxSectionStats,
+                                               const UBaseType_t uxArraySize )
+    {
+        UBaseType_t uxSlot, uxCount = 0U, x;
+        TaskSectionStats_t xStats;
+
+        configASSERT( pxSectionStats );
+
+        /* One short critical section per slot rather than one for the whole
+         * table, so reading the statistics does not dominate them. */
+        for( uxSlot = 0U; uxSlot < ( UBaseType_t ) configCRITICAL_SECTION_SITES; uxSlot++ )
+        {
+            taskENTER_CRITICAL();
+            {
+                xStats = xSectionStats[ uxSlot ];
+            }
+            taskEXIT_CRITICAL();
+
+            if( xStats.ulCount == 0U )
+            {
+                continue;
+            }
+
+            /* Insert sorted by the longest section, dropping the shortest
+             * when the array is full. */
+            x = uxCount;
+
+            if( x == uxArraySize )
+            {
+                if( ( x == 0U ) || ( xStats.ulMaxTime <= pxSectionStats[ x - 1U ].ulMaxTime ) )
+                {
+                    continue;
+                }
+
+                x--;
+            }
+            else
+            {
+                uxCount++;
+            }
+
+            while( ( x > 0U ) && ( pxSectionStats[ x - 1U ].ulMaxTime < xStats.ulMaxTime ) )
+            {
+                pxSectionStats[ x ] = pxSectionStats[ x - 1U ];
+                x--;
+            }
+
+            pxSectionStats[ x ] = xStats;
+        }
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskResetCriticalSectionStats( void )
+    {
+        UBaseType_t uxSlot;
+
+        /* The call sites keep their slots, only the statistics are cleared. */
+        for( uxSlot = 0U; uxSlot < ( UBaseType_t ) configCRITICAL_SECTION_SITES; uxSlot++ )
+        {
+            taskENTER_CRITICAL();
+            {
+                xSectionStats[ uxSlot ].ulCount = 0U;
+                xSectionStats[ uxSlot ].ulMaxTime = 0U;
+                xSectionStats[ uxSlot ].ulTotalTime = 0U;
+                ( void ) memset( xSectionStats[ uxSlot ].ulHistogram, 0x00, sizeof( xSectionStats[ uxSlot ].ulHistogram ) );
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+
+#endif /* configGENERATE_CRITICAL_SECTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_CRITICAL_SECTION_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    void vTaskGetCriticalSectionStatsText( char * pcWriteBuffer )
+    {
+        TaskSectionStats_t * pxStatsArray;
+        const char * pcFile;
+        const char * pcName;
+        UBaseType_t uxArraySize, x, uxBin;
+
+        /* As vTaskGetRunTimeStats(), this is a debug aid that depends on
+         * sprintf() and is not part of the scheduler. */
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        pxStatsArray = pvPortMalloc( configCRITICAL_SECTION_SITES * sizeof( TaskSectionStats_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxStatsArray != NULL )
+        {
+            uxArraySize = uxTaskGetCriticalSectionStats( pxStatsArray, configCRITICAL_SECTION_SITES );
+
+            for( x = 0; x < uxArraySize; x++ )
+            {
+                /* __FILE__ may hold the whole path, only the file name is
+                 * written. */
+                pcName = "other";
+
+                if( pxStatsArray[ x ].pcFile != NULL )
+                {
+                    pcName = pxStatsArray[ x ].pcFile;
+
+                    for( pcFile = pcName; *pcFile != ( char ) 0x00; pcFile++ )
+                    {
+                        if( ( *pcFile == '/' ) || ( *pcFile == '\\' ) )
+                        {
+                            pcName = pcFile + 1;
+                        }
+                    }
+                }
+
+                /* sizeof( int ) == sizeof( long ) on the targets this is used
+                 * on, so a smaller printf() library can be used. */
+                sprintf( pcWriteBuffer, "%s:%u\t%s\t%u\t%u\t%u\t", /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                         pcName,
+                         ( unsigned int ) pxStatsArray[ x ].ulLine,
+                         ( pxStatsArray[ x ].eKind == eCriticalSection ) ? "crit" : "susp",
+                         ( unsigned int ) pxStatsArray[ x ].ulCount,
+                         ( unsigned int ) pxStatsArray[ x ].ulMaxTime,
+                         ( unsigned int ) ( pxStatsArray[ x ].ulTotalTime / pxStatsArray[ x ].ulCount ) );
+                pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+
+                for( uxBin = 0; uxBin < ( UBaseType_t ) configCRITICAL_SECTION_HISTOGRAM_BINS; uxBin++ )
+                {
+                    sprintf( pcWriteBuffer, ( uxBin == 0U ) ? "%u" : ",%u", ( unsigned int ) pxStatsArray[ x ].ulHistogram[ uxBin ] ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                }
+
+                sprintf( pcWriteBuffer, "\r\n" ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxStatsArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configGENERATE_CRITICAL_SECTION_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
+                                            const BaseType_t xCanBlockIndefinitely )
+{
+    TickType_t xTimeToWake;
+    const TickType_t xConstTickCount = xTickCount;
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_ISR_CALLBACKS == 1 ) )
+        /* Timer callbacks run from the tick must not block. */
+        configASSERT( xTickCallbacksRunning == pdFALSE );
+    #endif
+
+    #if ( INCLUDE_xTaskAbortDelay == 1 )
+        {
+            /* About to enter a delayed list, so ensure the ucDelayAborted flag is
+             * reset to pdFALSE so it can be detected as having been set to pdTRUE
+             * when the task leaves the Blocked state. */
+            pxCurrentTCB->ucDelayAborted = pdFALSE;
+        }
+    #endif
+
+    /* Remove the task from the ready list before adding it to the blocked list
+     * as the same list item is used for both lists. */
+    if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+    {
+        /* The current task must be in a ready list, so there is no need to
+         * check, and the port reset macro can be called directly. */
+        portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( INCLUDE_vTaskSuspend == 1 )
+        {
+            if( ( xTicksToWait == portMAX_DELAY ) && ( xCanBlockIndefinitely != pdFALSE ) )
+            {
+                /* Add the task to the suspended task list instead of a delayed task
                  * list to ensure it is not woken by a timing event.  It will block
                  * indefinitely. */
                 listINSERT_END( &xSuspendedTaskList, &( pxCurrentTCB->xStateListItem ) );
@@ -5627,7 +7243,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 {
                     /* The wake time has not overflowed, so the current block list
                      * is used. */
-                    vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                    prvInsertDelayedTask( pxCurrentTCB );
 
                     /* If the task entering the blocked state was placed at the
                      * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -5635,6 +7251,12 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                     if( xTimeToWake < xNextTaskUnblockTime )
                     {
                         xNextTaskUnblockTime = xTimeToWake;
+
+                        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                            {
+                                pxDelayedWheelNextList = listLIST_ITEM_CONTAINER( &( pxCurrentTCB->xStateListItem ) );
+                            }
+                        #endif
                     }
                     else
                     {
@@ -5661,7 +7283,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             else
             {
                 /* The wake time has not overflowed, so the current block list is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                prvInsertDelayedTask( pxCurrentTCB );
 
                 /* If the task entering the blocked state was placed at the head of the
                  * list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -5669,6 +7291,12 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 if( xTimeToWake < xNextTaskUnblockTime )
                 {
                     xNextTaskUnblockTime = xTimeToWake;
+
+                    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                        {
+                            pxDelayedWheelNextList = listLIST_ITEM_CONTAINER( &( pxCurrentTCB->xStateListItem ) );
+                        }
+                    #endif
                 }
                 else
                 {
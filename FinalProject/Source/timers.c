@@ -38,6 +38,7 @@
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "atomic.h"
 
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
     #error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
@@ -70,6 +71,37 @@
     #define tmrSTATUS_IS_ACTIVE                  ( ( uint8_t ) 0x01 )
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
+    #define tmrSTATUS_IS_ISR_CALLBACK            ( ( uint8_t ) 0x08 )
+
+    #if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+        #define tmrISR_COMMAND_MASK    ( ( uint32_t ) configTIMER_ISR_COMMAND_QUEUE_LENGTH - ( uint32_t ) 1 )
+    #endif
+
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+        /* The xPendingCommand of a timer that is not in the pending chain. */
+        #define tmrNO_PENDING_COMMAND         ( ( BaseType_t ) -1 )
+
+        /* Queued to wake the timer service task when the pending chain stops
+         * being empty.  Only pended function calls are queued otherwise. */
+        #define tmrCOMMAND_PROCESS_PENDING    ( ( BaseType_t ) 10 )
+    #endif
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* Geometry of the timing wheel.  A digit is configTIMER_WHEEL_SLOT_BITS bits of
+ * a tick count, and level k of the wheel holds the timers whose expiry time
+ * first differs from the wheel time in digit k, in the slot given by their own
+ * digit k.  Level 0 therefore holds timers that expire before digit 1 of the
+ * wheel time changes, each slot for a single tick.  The wheel time moves
+ * straight to the next expiry time, and the slots its digits then point at are
+ * moved down (cascaded) to lower levels, so the timer task wakes only for
+ * expiries and not for every slot a level passes. */
+        #define tmrWHEEL_SLOTS                      ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK                  ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+        #define tmrWHEEL_LEVELS                     ( ( ( sizeof( TickType_t ) * 8U ) + configTIMER_WHEEL_SLOT_BITS - 1U ) / configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_DIGIT( xTime, uxLevel )    ( ( UBaseType_t ) ( ( ( xTime ) >> ( ( uxLevel ) * configTIMER_WHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK ) )
+        #define tmrWHEEL_LOWER_DIGITS( uxLevel )    ( ( ( TickType_t ) 1U << ( ( uxLevel ) * configTIMER_WHEEL_SLOT_BITS ) ) - ( TickType_t ) 1U )
+    #endif
 
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
@@ -82,6 +114,16 @@
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxTimerNumber;              /*<< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
+        #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+            struct tmrTimerControl * pxNextPending; /*<< The timer after this one in the pending chain. */
+            TickType_t xPendingValue;               /*<< The xOptionalValue of the pending command. */
+            TickType_t xPendingPeriod;              /*<< The period set by a pending or replaced change period command, 0 if none. */
+            BaseType_t xPendingCommand;             /*<< The latest command sent to the timer, tmrNO_PENDING_COMMAND once processed. */
+        #endif
+        #if ( configUSE_TIMER_SLACK == 1 )
+            TickType_t xTimerSlackInTicks;          /*<< How many ticks late the timer may expire, see vTimerSetSlack(). */
+            TickType_t xExpiryTimeWithoutSlack;     /*<< The time the timer is due, from which the next expiry of an auto-reload timer is calculated. */
+        #endif
         uint8_t ucStatus;                           /*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
     } xTIMER;
 
@@ -134,15 +176,69 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* With configUSE_TIMER_WHEEL the active timers are instead kept in the slots of
+ * the timing wheel, unsorted, or in xTimerWheelNextLap if they expire after the
+ * tick count next wraps.  ulTimerWheelOccupied has a bit per slot that may hold
+ * timers; bits are cleared when their slot is found empty, as timers are
+ * removed from a slot with uxListRemove().  xTimerWheelTime is the tick up to
+ * which the wheel has been advanced, which lags the tick count while the timer
+ * service task is busy. */
+        PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+        PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ tmrWHEEL_LEVELS ];
+        PRIVILEGED_DATA static List_t xTimerWheelNextLap;
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+    #else
+        PRIVILEGED_DATA static List_t xActiveTimerList1;
+        PRIVILEGED_DATA static List_t xActiveTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #endif
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
     PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
+    #if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+
+/* Timers that run their callbacks from the tick interrupt are kept in their own
+ * pair of lists, which only vTimerProcessIsrTimers() accesses.  Commands reach
+ * it through xIsrTimerCommands[], a ring that uses the sequence numbers of
+ * mpsc_queue.c: a slot whose sequence number equals the position of the slot
+ * is free for the sender that claims that position, one more means it holds
+ * that position's command.  Senders claim positions by advancing
+ * ulIsrTimerCommandHead with Atomic_CompareAndSwap_u32(), the tick is the only
+ * reader and the only writer of ulIsrTimerCommandTail.  xIsrTimerTime is the
+ * tick last processed.  xIsrTimersToFree holds deleted timers waiting to be
+ * passed to the timer service task. */
+        PRIVILEGED_DATA static List_t xIsrTimerList1;
+        PRIVILEGED_DATA static List_t xIsrTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentIsrTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowIsrTimerList;
+        PRIVILEGED_DATA static DaemonTaskMessage_t xIsrTimerCommands[ configTIMER_ISR_COMMAND_QUEUE_LENGTH ];
+        PRIVILEGED_DATA static volatile uint32_t ulIsrTimerCommandSequence[ configTIMER_ISR_COMMAND_QUEUE_LENGTH ];
+        PRIVILEGED_DATA static volatile uint32_t ulIsrTimerCommandHead = 0U;
+        PRIVILEGED_DATA static uint32_t ulIsrTimerCommandTail = 0U;
+        PRIVILEGED_DATA static TickType_t xIsrTimerTime = ( TickType_t ) 0U;
+
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            PRIVILEGED_DATA static List_t xIsrTimersToFree;
+        #endif
+    #endif /* configUSE_TIMER_ISR_CALLBACKS */
+
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+/* Timers with a command the timer service task has not processed yet, in the
+ * order they got their first one.  A timer only keeps its latest command, so
+ * however many it is sent before the task runs, for example resets of a
+ * watchdog timer, it is in the chain once and the task processes one command
+ * for it.  The chain and the pending commands are only changed in critical
+ * sections. */
+        PRIVILEGED_DATA static Timer_t * pxFirstPendingTimer = NULL;
+        PRIVILEGED_DATA static Timer_t * pxLastPendingTimer = NULL;
+    #endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -166,6 +262,33 @@
  */
     static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Applies a start, reset, stop, change period or delete command to a timer.
+ */
+    static void prvProcessTimerCommand( Timer_t * const pxTimer,
+                                        const BaseType_t xCommandID,
+                                        const TickType_t xMessageValue ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+/*
+ * Makes the command the pending command of the timer, adding the timer to the
+ * pending chain if it is not in it already.  Must be called with interrupts
+ * masked.  Returns pdTRUE if the chain was empty, in which case the timer
+ * service task has to be woken.
+ */
+        static BaseType_t prvPendTimerCommand( Timer_t * const pxTimer,
+                                               const BaseType_t xCommandID,
+                                               const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the timer service task to process the pending command of every
+ * timer in the pending chain.
+ */
+        static void prvProcessPendingCommands( void ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_COMMAND_COALESCING */
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
@@ -191,11 +314,43 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+/*
+ * Returns the time in [xExpiryTime, xExpiryTime + xSlack] that is a multiple
+ * of the largest power of two, which is when a timer with that slack expires.
+ */
+        static TickType_t prvApplyTimerSlack( const TickType_t xExpiryTime,
+                                              const TickType_t xSlack ) PRIVILEGED_FUNCTION;
+    #endif
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Add an active timer to the slot of the timing wheel its expiry time, already
+ * in its list item, maps to.
+ */
+        static void prvWheelInsert( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Advance the timing wheel to xEventTime, returned by prvGetNextExpireTime(),
+ * cascading the timers of the slots that time points at.  No timer may expire
+ * before xEventTime.
+ */
+        static void prvWheelAdvance( const TickType_t xEventTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the index of the lowest bit set in ulSlots, which must not be zero.
+ */
+        static UBaseType_t prvWheelLowestSlot( uint32_t ulSlots ) PRIVILEGED_FUNCTION;
+    #else
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+        static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+    #endif
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -228,6 +383,48 @@
                                        void * const pvTimerID,
                                        TimerCallbackFunction_t pxCallbackFunction,
                                        Timer_t * pxNewTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+
+/*
+ * Copy a command for a timer that runs its callback from the tick interrupt
+ * into the command ring.  Returns pdFAIL without waiting if the ring is full.
+ * Can be called from tasks and interrupts.
+ */
+        static BaseType_t prvSendIsrTimerCommand( const DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take the oldest command out of the command ring.  Returns pdFAIL if there is
+ * none, or if its sender has not finished writing it.  Only called from the
+ * tick.
+ */
+        static BaseType_t prvReceiveIsrTimerCommand( DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert a timer into xIsrTimerList1 or xIsrTimerList2, returning pdTRUE
+ * instead if it has already expired, as prvInsertTimerInActiveList() does for
+ * the other timers.
+ */
+        static BaseType_t prvInsertIsrTimer( Timer_t * const pxTimer,
+                                             const TickType_t xNextExpiryTime,
+                                             const TickType_t xTimeNow,
+                                             const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * A timer that runs its callback from the tick interrupt, no longer in a
+ * list, expired at xExpiredTime.  Reload it if it is an auto-reload timer,
+ * then call its callback.
+ */
+        static void prvExpireIsrTimer( Timer_t * const pxTimer,
+                                       TickType_t xExpiredTime,
+                                       const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Apply a command received from the command ring.
+ */
+        static void prvProcessIsrTimerCommand( const DaemonTaskMessage_t * const pxMessage,
+                                               const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+    #endif /* configUSE_TIMER_ISR_CALLBACKS */
 /*-----------------------------------------------------------*/
 
     BaseType_t xTimerCreateTimerTask( void )
@@ -374,6 +571,22 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+            {
+                pxNewTimer->pxNextPending = NULL;
+                pxNewTimer->xPendingValue = ( TickType_t ) 0U;
+                pxNewTimer->xPendingPeriod = ( TickType_t ) 0U;
+                pxNewTimer->xPendingCommand = tmrNO_PENDING_COMMAND;
+            }
+        #endif
+
+        #if ( configUSE_TIMER_SLACK == 1 )
+            {
+                pxNewTimer->xTimerSlackInTicks = ( TickType_t ) 0U;
+                pxNewTimer->xExpiryTimeWithoutSlack = ( TickType_t ) 0U;
+            }
+        #endif
+
         if( uxAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
@@ -394,30 +607,106 @@
 
         configASSERT( xTimer );
 
+        #if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+            if( ( ( ( Timer_t * ) xTimer )->ucStatus & tmrSTATUS_IS_ISR_CALLBACK ) != 0 )
+            {
+                /* The command goes to the tick through the command ring, which
+                 * is emptied on every tick, so the caller never blocks and no
+                 * task has to be woken. */
+                xMessage.xMessageID = xCommandID;
+                xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+                xMessage.u.xTimerParameters.pxTimer = xTimer;
+
+                xReturn = prvSendIsrTimerCommand( &xMessage );
+
+                traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+
+                ( void ) pxHigherPriorityTaskWoken;
+                ( void ) xTicksToWait;
+            }
+            else
+        #endif /* configUSE_TIMER_ISR_CALLBACKS */
+
         /* Send a message to the timer service task to perform a particular action
          * on a particular timer definition. */
         if( xTimerQueue != NULL )
         {
-            /* Send a command to the timer service task to start the xTimer timer. */
-            xMessage.xMessageID = xCommandID;
-            xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
-            xMessage.u.xTimerParameters.pxTimer = xTimer;
-
-            if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
-            {
-                if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+            #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
                 {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                    BaseType_t xWakeDaemon;
+
+                    /* The command replaces any the timer service task has not
+                     * processed yet, so it cannot fail and the caller never
+                     * blocks.  The queue only carries a message to wake the
+                     * task, once per batch of commands, and if it is full the
+                     * task is awake anyway. */
+                    ( void ) xTicksToWait;
+
+                    if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            xWakeDaemon = prvPendTimerCommand( xTimer, xCommandID, xOptionalValue );
+                        }
+                        taskEXIT_CRITICAL();
+
+                        if( xWakeDaemon != pdFALSE )
+                        {
+                            xMessage.xMessageID = tmrCOMMAND_PROCESS_PENDING;
+                            ( void ) xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        UBaseType_t uxSavedInterruptStatus;
+
+                        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+                        {
+                            xWakeDaemon = prvPendTimerCommand( xTimer, xCommandID, xOptionalValue );
+                        }
+                        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+                        if( xWakeDaemon != pdFALSE )
+                        {
+                            xMessage.xMessageID = tmrCOMMAND_PROCESS_PENDING;
+                            ( void ) xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    xReturn = pdPASS;
                 }
-                else
+            #else /* if ( configUSE_TIMER_COMMAND_COALESCING == 1 ) */
                 {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                    /* Send a command to the timer service task to start the xTimer timer. */
+                    xMessage.xMessageID = xCommandID;
+                    xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+                    xMessage.u.xTimerParameters.pxTimer = xTimer;
+
+                    if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+                    {
+                        if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+                        {
+                            xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                        }
+                        else
+                        {
+                            xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                        }
+                    }
+                    else
+                    {
+                        xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+                    }
                 }
-            }
-            else
-            {
-                xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
-            }
+            #endif /* configUSE_TIMER_COMMAND_COALESCING */
 
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
         }
@@ -469,6 +758,101 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+
+        void vTimerSetIsrCallback( TimerHandle_t xTimer,
+                                   const BaseType_t xFromISR )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                /* An active timer is in the lists of either the timer service
+                 * task or the tick, and cannot be moved to the other. */
+                configASSERT( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0 );
+
+                if( xFromISR != pdFALSE )
+                {
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ISR_CALLBACK;
+                }
+                else
+                {
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ISR_CALLBACK );
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_TIMER_ISR_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        void vTimerSetSlack( TimerHandle_t xTimer,
+                             const TickType_t xSlackInTicks )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                pxTimer->xTimerSlackInTicks = xSlackInTicks;
+            }
+            taskEXIT_CRITICAL();
+        }
+/*-----------------------------------------------------------*/
+
+        TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+        {
+            Timer_t * pxTimer = xTimer;
+            TickType_t xReturn;
+
+            configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                xReturn = pxTimer->xTimerSlackInTicks;
+            }
+            taskEXIT_CRITICAL();
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvApplyTimerSlack( const TickType_t xExpiryTime,
+                                              const TickType_t xSlack )
+        {
+            TickType_t xLatestTime = xExpiryTime + xSlack;
+            TickType_t xDifferentBits;
+
+            /* No slack is applied across a wrap of the tick count, so the timer
+             * stays in the timer list, or wheel lap, of its expiry time. */
+            if( xLatestTime > xExpiryTime )
+            {
+                /* The highest bit that differs between the two times is set in
+                 * the latest time.  Clearing the bits below it gives the multiple
+                 * of the largest power of two in the window.  Timers whose windows
+                 * contain that multiple round to it and expire together. */
+                xDifferentBits = xExpiryTime ^ xLatestTime;
+
+                while( ( xDifferentBits & ( xDifferentBits - ( TickType_t ) 1U ) ) != ( TickType_t ) 0U )
+                {
+                    xDifferentBits &= xDifferentBits - ( TickType_t ) 1U;
+                }
+
+                xLatestTime &= ~( xDifferentBits - ( TickType_t ) 1U );
+            }
+            else
+            {
+                xLatestTime = xExpiryTime;
+            }
+
+            return xLatestTime;
+        }
+
+    #endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
     UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer )
     {
         Timer_t * pxTimer = xTimer;
@@ -536,7 +920,12 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #if ( configUSE_TIMER_WHEEL == 1 )
+            /* The timers expiring at the wheel time are in its level 0 slot. */
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xTimerWheel[ 0 ][ tmrWHEEL_DIGIT( xTimerWheelTime, 0U ) ] ) ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #else
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #endif
 
         /* Remove the timer from the list of active timers.  A check has already
          * been performed to ensure the list is not empty. */
@@ -547,7 +936,13 @@
          * expiry time and re-insert the timer in the list of active timers. */
         if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
         {
-            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            #if ( configUSE_TIMER_SLACK == 1 )
+                /* Reload from the time the timer was due so the slack does not
+                 * add up over the periods. */
+                prvReloadTimer( pxTimer, pxTimer->xExpiryTimeWithoutSlack, xTimeNow );
+            #else
+                prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            #endif
         }
         else
         {
@@ -596,52 +991,65 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
-                                            BaseType_t xListWasEmpty )
-    {
-        TickType_t xTimeNow;
-        BaseType_t xTimerListsWereSwitched;
+    #if ( configUSE_TIMER_WHEEL == 1 )
 
-        vTaskSuspendAll();
+        static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+                                                BaseType_t xListWasEmpty )
         {
-            /* Obtain the time now to make an assessment as to whether the timer
-             * has expired or not.  If obtaining the time causes the lists to switch
-             * then don't process this timer as any timers that remained in the list
-             * when the lists were switched will have been processed within the
-             * prvSampleTimeNow() function. */
-            xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+            TickType_t xTimeNow;
 
-            if( xTimerListsWereSwitched == pdFALSE )
+            vTaskSuspendAll();
             {
-                /* The tick count has not overflowed, has the timer expired? */
-                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                xTimeNow = xTaskGetTickCount();
+
+                /* Times are compared by their distance from the wheel time, so
+                 * the tick count wrapping makes no difference. */
+                if( ( xListWasEmpty == pdFALSE ) &&
+                    ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) <= ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) )
                 {
                     ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+
+                    /* The timers due at the new wheel time end up in its level
+                     * 0 slot, and one of them is processed per call as with
+                     * the timer lists. */
+                    prvWheelAdvance( xNextExpireTime );
+
+                    if( listLIST_IS_EMPTY( &( xTimerWheel[ 0 ][ tmrWHEEL_DIGIT( xTimerWheelTime, 0U ) ] ) ) == pdFALSE )
+                    {
+                        prvProcessExpiredTimer( xTimerWheelTime, xTimeNow );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
                 else
                 {
-                    /* The tick count has not overflowed, and the next expire
-                     * time has not been reached yet.  This task should therefore
-                     * block to wait for the next expire time or a command to be
-                     * received - whichever comes first.  The following line cannot
-                     * be reached unless xNextExpireTime > xTimeNow, except in the
-                     * case when the current timer list is empty. */
                     if( xListWasEmpty != pdFALSE )
                     {
-                        /* The current timer list is empty - is the overflow list
-                         * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        /* No timers are active, so the wheel can be moved to the
+                         * present without visiting anything. */
+                        xTimerWheelTime = xTimeNow;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
                     }
 
-                    vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+                    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+                        /* A command sent while the queue was full did not
+                         * queue a message to wake this task, so do not block
+                         * while there are pending commands. */
+                        if( pxFirstPendingTimer == NULL )
+                    #endif
+                    {
+                        vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+                    }
 
                     if( xTaskResumeAll() == pdFALSE )
                     {
-                        /* Yield to wait for either a command to arrive, or the
-                         * block time to expire.  If a command arrived between the
-                         * critical section being exited and this yield then the yield
-                         * will not cause the task to block. */
+                        /* As in the version that uses the timer lists. */
                         portYIELD_WITHIN_API();
                     }
                     else
@@ -650,92 +1058,375 @@
                     }
                 }
             }
-            else
-            {
-                ( void ) xTaskResumeAll();
-            }
         }
-    }
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
-    {
-        TickType_t xNextExpireTime;
-
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
-        {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
-        }
-        else
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
-        }
-
-        return xNextExpireTime;
-    }
-/*-----------------------------------------------------------*/
-
-    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
-    {
-        TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+            TickType_t xNextExpireTime = ( TickType_t ) 0U;
+            TickType_t xExpiryTime;
+            UBaseType_t uxLevel, uxSlot;
+            uint32_t ulSlots;
+            List_t * pxSlot;
+            ListItem_t const * pxItem;
+            ListItem_t const * pxEnd;
+
+            *pxListWasEmpty = pdTRUE;
+
+            /* The next timer to expire is in the first occupied slot, from the
+             * slot of the wheel time, of the lowest level that has one, as a
+             * level is passed through before the digit of the level above
+             * changes.  The timers of a level 0 slot share their expiry time,
+             * those of a higher slot are looked through for the earliest. */
+            for( uxLevel = ( UBaseType_t ) 0U; ( uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS ) && ( *pxListWasEmpty != pdFALSE ); uxLevel++ )
+            {
+                ulSlots = ulTimerWheelOccupied[ uxLevel ] & ~( ( ( uint32_t ) 1U << tmrWHEEL_DIGIT( xTimerWheelTime, uxLevel ) ) - 1U );
 
-        xTimeNow = xTaskGetTickCount();
+                while( ulSlots != 0U )
+                {
+                    uxSlot = prvWheelLowestSlot( ulSlots );
+                    pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
 
-        if( xTimeNow < xLastTime )
-        {
-            prvSwitchTimerLists();
-            *pxTimerListsWereSwitched = pdTRUE;
-        }
-        else
-        {
-            *pxTimerListsWereSwitched = pdFALSE;
-        }
+                    if( listLIST_IS_EMPTY( pxSlot ) != pdFALSE )
+                    {
+                        /* Its timers were stopped or reset. */
+                        ulTimerWheelOccupied[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+                        ulSlots &= ~( ( uint32_t ) 1U << uxSlot );
+                    }
+                    else
+                    {
+                        xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxSlot );
 
-        xLastTime = xTimeNow;
+                        if( uxLevel > ( UBaseType_t ) 0U )
+                        {
+                            pxEnd = listGET_END_MARKER( pxSlot );
 
-        return xTimeNow;
-    }
-/*-----------------------------------------------------------*/
+                            for( pxItem = listGET_NEXT( listGET_HEAD_ENTRY( pxSlot ) ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+                            {
+                                xExpiryTime = listGET_LIST_ITEM_VALUE( pxItem );
 
-    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
-                                                  const TickType_t xNextExpiryTime,
-                                                  const TickType_t xTimeNow,
-                                                  const TickType_t xCommandTime )
-    {
-        BaseType_t xProcessTimerNow = pdFALSE;
+                                if( xExpiryTime < xNextExpireTime )
+                                {
+                                    xNextExpireTime = xExpiryTime;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
 
-        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+                        *pxListWasEmpty = pdFALSE;
+                        break;
+                    }
+                }
+            }
 
-        if( xNextExpiryTime <= xTimeNow )
-        {
-            /* Has the expiry time elapsed between the command to start/reset a
-             * timer was issued, and the time the command was processed? */
-            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            if( ( *pxListWasEmpty != pdFALSE ) && ( listLIST_IS_EMPTY( &xTimerWheelNextLap ) == pdFALSE ) )
             {
-                /* The time between a command being issued and the command being
-                 * processed actually exceeds the timers period.  */
-                xProcessTimerNow = pdTRUE;
+                /* Nothing expires before the tick count wraps, at which point the
+                 * timers of the next lap are placed in the wheel. */
+                xNextExpireTime = ( TickType_t ) 0U;
+                *pxListWasEmpty = pdFALSE;
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                mtCOVERAGE_TEST_MARKER();
             }
+
+            return xNextExpireTime;
         }
-        else
+/*-----------------------------------------------------------*/
+
+        static UBaseType_t prvWheelLowestSlot( uint32_t ulSlots )
         {
-            if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+            UBaseType_t uxSlot = ( UBaseType_t ) 0U;
+            UBaseType_t uxShift;
+
+            /* Halve the bitmap, there is no portable count trailing zeros. */
+            for( uxShift = ( UBaseType_t ) 16U; uxShift > ( UBaseType_t ) 0U; uxShift >>= 1 )
+            {
+                if( ( ulSlots & ( ( ( uint32_t ) 1U << uxShift ) - 1U ) ) == 0U )
+                {
+                    ulSlots >>= uxShift;
+                    uxSlot += uxShift;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            return uxSlot;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvWheelInsert( Timer_t * const pxTimer )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            const TickType_t xDifferentBits = xExpiryTime ^ xTimerWheelTime;
+            UBaseType_t uxLevel, uxSlot;
+
+            if( xExpiryTime < xTimerWheelTime )
+            {
+                /* The timer expires after the tick count wraps. */
+                vListInsertEnd( &xTimerWheelNextLap, &( pxTimer->xTimerListItem ) );
+            }
+            else
+            {
+                /* Find the highest digit that differs from the wheel time, which
+                 * is greater in the expiry time.  A timer due at the wheel time
+                 * itself goes to the level 0 slot of that time. */
+                for( uxLevel = ( UBaseType_t ) tmrWHEEL_LEVELS - 1U; uxLevel > ( UBaseType_t ) 0U; uxLevel-- )
+                {
+                    if( ( xDifferentBits >> ( uxLevel * configTIMER_WHEEL_SLOT_BITS ) ) != ( TickType_t ) 0U )
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                uxSlot = tmrWHEEL_DIGIT( xExpiryTime, uxLevel );
+                vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+                ulTimerWheelOccupied[ uxLevel ] |= ( uint32_t ) 1U << uxSlot;
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvWheelAdvance( const TickType_t xEventTime )
+        {
+            const TickType_t xPreviousTime = xTimerWheelTime;
+            List_t * pxSlot;
+            UBaseType_t uxLevel;
+
+            xTimerWheelTime = xEventTime;
+
+            if( xEventTime < xPreviousTime )
+            {
+                /* The tick count wrapped.  The wheel is otherwise empty at this
+                 * point, so the timers of the new lap go straight to their
+                 * slots. */
+                while( listLIST_IS_EMPTY( &xTimerWheelNextLap ) == pdFALSE )
+                {
+                    Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xTimerWheelNextLap ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    prvWheelInsert( pxTimer );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* On every level from the top, cascade the slot the digit of the
+             * new wheel time points at.  The timers there now share that digit
+             * with the wheel time so move to a lower level, or to the level 0
+             * slot of the wheel time if they are due.  As no timer expires
+             * before the new wheel time, the slots skipped over are empty. */
+            for( uxLevel = ( UBaseType_t ) tmrWHEEL_LEVELS - 1U; uxLevel > ( UBaseType_t ) 0U; uxLevel-- )
+            {
+                pxSlot = &( xTimerWheel[ uxLevel ][ tmrWHEEL_DIGIT( xEventTime, uxLevel ) ] );
+
+                while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                {
+                    Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    prvWheelInsert( pxTimer );
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+    #else /* configUSE_TIMER_WHEEL */
+
+        static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+                                                BaseType_t xListWasEmpty )
+        {
+            TickType_t xTimeNow;
+            BaseType_t xTimerListsWereSwitched;
+
+            vTaskSuspendAll();
+            {
+                /* Obtain the time now to make an assessment as to whether the timer
+                 * has expired or not.  If obtaining the time causes the lists to switch
+                 * then don't process this timer as any timers that remained in the list
+                 * when the lists were switched will have been processed within the
+                 * prvSampleTimeNow() function. */
+                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+                if( xTimerListsWereSwitched == pdFALSE )
+                {
+                    /* The tick count has not overflowed, has the timer expired? */
+                    if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                    {
+                        ( void ) xTaskResumeAll();
+                        prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                    }
+                    else
+                    {
+                        /* The tick count has not overflowed, and the next expire
+                         * time has not been reached yet.  This task should therefore
+                         * block to wait for the next expire time or a command to be
+                         * received - whichever comes first.  The following line cannot
+                         * be reached unless xNextExpireTime > xTimeNow, except in the
+                         * case when the current timer list is empty. */
+                        if( xListWasEmpty != pdFALSE )
+                        {
+                            /* The current timer list is empty - is the overflow list
+                             * also empty? */
+                            xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        }
+
+                        #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+                            /* A command sent while the queue was full did not
+                             * queue a message to wake this task, so do not block
+                             * while there are pending commands. */
+                            if( pxFirstPendingTimer == NULL )
+                        #endif
+                        {
+                            vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+                        }
+
+                        if( xTaskResumeAll() == pdFALSE )
+                        {
+                            /* Yield to wait for either a command to arrive, or the
+                             * block time to expire.  If a command arrived between the
+                             * critical section being exited and this yield then the yield
+                             * will not cause the task to block. */
+                            portYIELD_WITHIN_API();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
+                {
+                    ( void ) xTaskResumeAll();
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+        {
+            TickType_t xNextExpireTime;
+
+            /* Timers are listed in expiry time order, with the head of the list
+             * referencing the task that will expire first.  Obtain the time at which
+             * the timer with the nearest expiry time will expire.  If there are no
+             * active timers then just set the next expire time to 0.  That will cause
+             * this task to unblock when the tick count overflows, at which point the
+             * timer lists will be switched and the next expiry time can be
+             * re-assessed.  */
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+
+            return xNextExpireTime;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+    {
+        TickType_t xTimeNow;
+
+        #if ( configUSE_TIMER_WHEEL == 1 )
+            {
+                /* The timing wheel follows the tick count through a wrap by
+                 * itself. */
+                xTimeNow = xTaskGetTickCount();
+                *pxTimerListsWereSwitched = pdFALSE;
+            }
+        #else
+            {
+                PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+
+                xTimeNow = xTaskGetTickCount();
+
+                if( xTimeNow < xLastTime )
+                {
+                    prvSwitchTimerLists();
+                    *pxTimerListsWereSwitched = pdTRUE;
+                }
+                else
+                {
+                    *pxTimerListsWereSwitched = pdFALSE;
+                }
+
+                xLastTime = xTimeNow;
+            }
+        #endif /* configUSE_TIMER_WHEEL */
+
+        return xTimeNow;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                  const TickType_t xNextExpiryTime,
+                                                  const TickType_t xTimeNow,
+                                                  const TickType_t xCommandTime )
+    {
+        BaseType_t xProcessTimerNow = pdFALSE;
+
+        #if ( configUSE_TIMER_SLACK == 1 )
+            {
+                /* The timer is listed at the time it expires with its slack,
+                 * which is in the same lap of the tick count as the time it is
+                 * due, so the checks below hold for either. */
+                pxTimer->xExpiryTimeWithoutSlack = xNextExpiryTime;
+                listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), prvApplyTimerSlack( xNextExpiryTime, pxTimer->xTimerSlackInTicks ) );
+            }
+        #else
+            {
+                listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            }
+        #endif
+        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+        if( xNextExpiryTime <= xTimeNow )
+        {
+            /* Has the expiry time elapsed between the command to start/reset a
+             * timer was issued, and the time the command was processed? */
+            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            {
+                /* The time between a command being issued and the command being
+                 * processed actually exceeds the timers period.  */
+                xProcessTimerNow = pdTRUE;
+            }
+            else
+            {
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    prvWheelInsert( pxTimer );
+                #else
+                    vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                #endif
+            }
+        }
+        else
+        {
+            if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
             {
                 /* If, since the command was issued, the tick count has overflowed
                  * but the expiry time has not, then the timer must have already passed
@@ -744,7 +1435,11 @@
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    prvWheelInsert( pxTimer );
+                #else
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #endif
             }
         }
 
@@ -752,12 +1447,253 @@
     }
 /*-----------------------------------------------------------*/
 
+    static void prvProcessTimerCommand( Timer_t * const pxTimer,
+                                        const BaseType_t xCommandID,
+                                        const TickType_t xMessageValue )
+    {
+        BaseType_t xTimerListsWereSwitched;
+        TickType_t xTimeNow;
+
+        if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+        {
+            /* The timer is in a list, remove it. */
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xMessageValue );
+
+        /* In this case the xTimerListsWereSwitched parameter is not used, but
+         *  it must be present in the function call.  prvSampleTimeNow() must be
+         *  called after the message is received from xTimerQueue so there is no
+         *  possibility of a higher priority task adding a message to the message
+         *  queue with a time that is ahead of the timer daemon task (because it
+         *  pre-empted the timer daemon task after the xTimeNow value was set). */
+        xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+        switch( xCommandID )
+        {
+            case tmrCOMMAND_START:
+            case tmrCOMMAND_START_FROM_ISR:
+            case tmrCOMMAND_RESET:
+            case tmrCOMMAND_RESET_FROM_ISR:
+                /* Start or restart a timer. */
+                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+                if( prvInsertTimerInActiveList( pxTimer, xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessageValue ) != pdFALSE )
+                {
+                    /* The timer expired before it was added to the active
+                     * timer list.  Process it now. */
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                    {
+                        prvReloadTimer( pxTimer, xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+
+                    /* Call the timer callback. */
+                    traceTIMER_EXPIRED( pxTimer );
+                    pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                break;
+
+            case tmrCOMMAND_STOP:
+            case tmrCOMMAND_STOP_FROM_ISR:
+                /* The timer has already been removed from the active list. */
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                break;
+
+            case tmrCOMMAND_CHANGE_PERIOD:
+            case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                pxTimer->xTimerPeriodInTicks = xMessageValue;
+                configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                /* The new period does not really have a reference, and can
+                 * be longer or shorter than the old one.  The command time is
+                 * therefore set to the current time, and as the period cannot
+                 * be zero the next expiry time can only be in the future,
+                 * meaning (unlike for the xTimerStart() case above) there is
+                 * no fail case that needs to be handled here. */
+                ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                break;
+
+            case tmrCOMMAND_DELETE:
+                #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                    {
+                        /* The timer has already been removed from the active list,
+                         * just free up the memory if the memory was dynamically
+                         * allocated. */
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                        {
+                            vPortFree( pxTimer );
+                        }
+                        else
+                        {
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        }
+                    }
+                #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                    {
+                        /* If dynamic allocation is not enabled, the memory
+                         * could not have been dynamically allocated. So there is
+                         * no need to free the memory - just mark the timer as
+                         * "not active". */
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+                #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                break;
+
+            default:
+                /* Don't expect to get here. */
+                break;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+        static BaseType_t prvPendTimerCommand( Timer_t * const pxTimer,
+                                               const BaseType_t xCommandID,
+                                               const TickType_t xOptionalValue )
+        {
+            BaseType_t xChainWasEmpty = pdFALSE;
+
+            if( pxTimer->xPendingCommand == tmrNO_PENDING_COMMAND )
+            {
+                pxTimer->pxNextPending = NULL;
+
+                if( pxLastPendingTimer == NULL )
+                {
+                    pxFirstPendingTimer = pxTimer;
+                    xChainWasEmpty = pdTRUE;
+                }
+                else
+                {
+                    pxLastPendingTimer->pxNextPending = pxTimer;
+                }
+
+                pxLastPendingTimer = pxTimer;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* A later command takes the place of an earlier one, as processing
+             * both would leave the timer as processing the later one alone
+             * does - except that the period set by a change period command
+             * must survive a start, reset or stop that replaces it, and
+             * nothing may replace a delete or the timer would never be freed. */
+            if( pxTimer->xPendingCommand != tmrCOMMAND_DELETE )
+            {
+                if( ( xCommandID == tmrCOMMAND_CHANGE_PERIOD ) || ( xCommandID == tmrCOMMAND_CHANGE_PERIOD_FROM_ISR ) )
+                {
+                    pxTimer->xPendingPeriod = xOptionalValue;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTimer->xPendingCommand = xCommandID;
+                pxTimer->xPendingValue = xOptionalValue;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xChainWasEmpty;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvProcessPendingCommands( void )
+        {
+            Timer_t * pxTimer;
+            BaseType_t xCommandID;
+            TickType_t xMessageValue, xPeriod;
+
+            for( ; ; )
+            {
+                /* Take one timer at a time so interrupts are only masked for
+                 * a few instructions, however long the chain is.  Commands sent
+                 * to the timer once it is off the chain put it back on. */
+                taskENTER_CRITICAL();
+                {
+                    pxTimer = pxFirstPendingTimer;
+
+                    if( pxTimer != NULL )
+                    {
+                        pxFirstPendingTimer = pxTimer->pxNextPending;
+
+                        if( pxFirstPendingTimer == NULL )
+                        {
+                            pxLastPendingTimer = NULL;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        xCommandID = pxTimer->xPendingCommand;
+                        xMessageValue = pxTimer->xPendingValue;
+                        xPeriod = pxTimer->xPendingPeriod;
+
+                        pxTimer->xPendingCommand = tmrNO_PENDING_COMMAND;
+                        pxTimer->xPendingPeriod = ( TickType_t ) 0U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxTimer == NULL )
+                {
+                    break;
+                }
+
+                /* A change period command that was replaced still sets the
+                 * period (a zero period is never valid, so it means none). */
+                if( ( xPeriod != ( TickType_t ) 0U ) && ( xCommandID != tmrCOMMAND_CHANGE_PERIOD ) && ( xCommandID != tmrCOMMAND_CHANGE_PERIOD_FROM_ISR ) )
+                {
+                    pxTimer->xTimerPeriodInTicks = xPeriod;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvProcessTimerCommand( pxTimer, xCommandID, xMessageValue );
+            }
+        }
+
+    #endif /* configUSE_TIMER_COMMAND_COALESCING */
+/*-----------------------------------------------------------*/
+
     static void prvProcessReceivedCommands( void )
     {
         DaemonTaskMessage_t xMessage;
-        Timer_t * pxTimer;
-        BaseType_t xTimerListsWereSwitched;
-        TickType_t xTimeNow;
+
+        #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+            {
+                /* Commands can be pending without a message in the queue if
+                 * the queue was full when they were sent. */
+                prvProcessPendingCommands();
+            }
+        #endif
 
         while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
         {
@@ -783,146 +1719,57 @@
                 }
             #endif /* INCLUDE_xTimerPendFunctionCall */
 
+            #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+                if( xMessage.xMessageID == tmrCOMMAND_PROCESS_PENDING )
+                {
+                    prvProcessPendingCommands();
+                }
+                else
+            #endif
+
             /* Commands that are positive are timer commands rather than pended
              * function calls. */
             if( xMessage.xMessageID >= ( BaseType_t ) 0 )
             {
                 /* The messages uses the xTimerParameters member to work on a
                  * software timer. */
-                pxTimer = xMessage.u.xTimerParameters.pxTimer;
-
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
-                {
-                    /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
-
-                /* In this case the xTimerListsWereSwitched parameter is not used, but
-                 *  it must be present in the function call.  prvSampleTimeNow() must be
-                 *  called after the message is received from xTimerQueue so there is no
-                 *  possibility of a higher priority task adding a message to the message
-                 *  queue with a time that is ahead of the timer daemon task (because it
-                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
-                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-
-                switch( xMessage.xMessageID )
-                {
-                    case tmrCOMMAND_START:
-                    case tmrCOMMAND_START_FROM_ISR:
-                    case tmrCOMMAND_RESET:
-                    case tmrCOMMAND_RESET_FROM_ISR:
-                        /* Start or restart a timer. */
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-
-                        if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-                        {
-                            /* The timer expired before it was added to the active
-                             * timer list.  Process it now. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-                            {
-                                prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
-
-                            /* Call the timer callback. */
-                            traceTIMER_EXPIRED( pxTimer );
-                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-
-                        break;
-
-                    case tmrCOMMAND_STOP:
-                    case tmrCOMMAND_STOP_FROM_ISR:
-                        /* The timer has already been removed from the active list. */
-                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        break;
-
-                    case tmrCOMMAND_CHANGE_PERIOD:
-                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-                        pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                        /* The new period does not really have a reference, and can
-                         * be longer or shorter than the old one.  The command time is
-                         * therefore set to the current time, and as the period cannot
-                         * be zero the next expiry time can only be in the future,
-                         * meaning (unlike for the xTimerStart() case above) there is
-                         * no fail case that needs to be handled here. */
-                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                        break;
-
-                    case tmrCOMMAND_DELETE:
-                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-                            {
-                                /* The timer has already been removed from the active list,
-                                 * just free up the memory if the memory was dynamically
-                                 * allocated. */
-                                if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
-                                {
-                                    vPortFree( pxTimer );
-                                }
-                                else
-                                {
-                                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                                }
-                            }
-                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
-                            {
-                                /* If dynamic allocation is not enabled, the memory
-                                 * could not have been dynamically allocated. So there is
-                                 * no need to free the memory - just mark the timer as
-                                 * "not active". */
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
-                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                        break;
-
-                    default:
-                        /* Don't expect to get here. */
-                        break;
-                }
+                prvProcessTimerCommand( xMessage.u.xTimerParameters.pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
     }
 /*-----------------------------------------------------------*/
 
-    static void prvSwitchTimerLists( void )
-    {
-        TickType_t xNextExpireTime;
-        List_t * pxTemp;
+    #if ( configUSE_TIMER_WHEEL == 0 )
 
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        static void prvSwitchTimerLists( void )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            TickType_t xNextExpireTime;
+            List_t * pxTemp;
+
+            /* The tick count has overflowed.  The timer lists must be switched.
+             * If there are any timers still referenced from the current timer list
+             * then they must have expired and should be processed before the lists
+             * are switched. */
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            pxTemp = pxCurrentTimerList;
+            pxCurrentTimerList = pxOverflowTimerList;
+            pxOverflowTimerList = pxTemp;
         }
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
-    }
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -934,10 +1781,51 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    {
+                        UBaseType_t uxLevel, uxSlot;
+
+                        for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS; uxLevel++ )
+                        {
+                            for( uxSlot = ( UBaseType_t ) 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                            {
+                                vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                            }
+                        }
+
+                        vListInitialise( &xTimerWheelNextLap );
+                    }
+                #else
+                    {
+                        vListInitialise( &xActiveTimerList1 );
+                        vListInitialise( &xActiveTimerList2 );
+                        pxCurrentTimerList = &xActiveTimerList1;
+                        pxOverflowTimerList = &xActiveTimerList2;
+                    }
+                #endif /* configUSE_TIMER_WHEEL */
+
+                #if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+                    {
+                        uint32_t ulSlot;
+
+                        vListInitialise( &xIsrTimerList1 );
+                        vListInitialise( &xIsrTimerList2 );
+                        pxCurrentIsrTimerList = &xIsrTimerList1;
+                        pxOverflowIsrTimerList = &xIsrTimerList2;
+                        xIsrTimerTime = xTaskGetTickCount();
+
+                        for( ulSlot = ( uint32_t ) 0; ulSlot <= tmrISR_COMMAND_MASK; ulSlot++ )
+                        {
+                            ulIsrTimerCommandSequence[ ulSlot ] = ulSlot;
+                        }
+
+                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                            {
+                                vListInitialise( &xIsrTimersToFree );
+                            }
+                        #endif
+                    }
+                #endif /* configUSE_TIMER_ISR_CALLBACKS */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                     {
@@ -976,6 +1864,319 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_ISR_CALLBACKS == 1 )
+
+        static BaseType_t prvSendIsrTimerCommand( const DaemonTaskMessage_t * const pxMessage )
+        {
+            uint32_t ulPosition, ulSlot = 0U;
+            int32_t lTurn;
+            BaseType_t xReturn = pdFAIL;
+
+            ulPosition = ulIsrTimerCommandHead;
+
+            for( ; ; )
+            {
+                ulSlot = ulPosition & tmrISR_COMMAND_MASK;
+                lTurn = ( int32_t ) ( ulIsrTimerCommandSequence[ ulSlot ] - ulPosition );
+
+                if( lTurn == ( int32_t ) 0 )
+                {
+                    /* The slot is free.  Claim it unless another task or
+                     * interrupt has just done so. */
+                    if( Atomic_CompareAndSwap_u32( &ulIsrTimerCommandHead, ulPosition + ( uint32_t ) 1, ulPosition ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                    {
+                        xReturn = pdPASS;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( lTurn < ( int32_t ) 0 )
+                {
+                    /* The ring is full, the tick has not caught up yet. */
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulPosition = ulIsrTimerCommandHead;
+            }
+
+            if( xReturn == pdPASS )
+            {
+                xIsrTimerCommands[ ulSlot ] = *pxMessage;
+
+                /* The command must be in the slot before the tick can see it. */
+                portMEMORY_BARRIER();
+                ulIsrTimerCommandSequence[ ulSlot ] = ulPosition + ( uint32_t ) 1;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvReceiveIsrTimerCommand( DaemonTaskMessage_t * const pxMessage )
+        {
+            const uint32_t ulSlot = ulIsrTimerCommandTail & tmrISR_COMMAND_MASK;
+            BaseType_t xReturn;
+
+            if( ulIsrTimerCommandSequence[ ulSlot ] == ( ulIsrTimerCommandTail + ( uint32_t ) 1 ) )
+            {
+                /* Read the sequence number before the command it covers. */
+                portMEMORY_BARRIER();
+                *pxMessage = xIsrTimerCommands[ ulSlot ];
+
+                /* The command must be copied out before the slot is reused. */
+                portMEMORY_BARRIER();
+                ulIsrTimerCommandSequence[ ulSlot ] = ulIsrTimerCommandTail + tmrISR_COMMAND_MASK + ( uint32_t ) 1;
+                ulIsrTimerCommandTail++;
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvInsertIsrTimer( Timer_t * const pxTimer,
+                                             const TickType_t xNextExpiryTime,
+                                             const TickType_t xTimeNow,
+                                             const TickType_t xCommandTime )
+        {
+            BaseType_t xProcessTimerNow = pdFALSE;
+
+            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+            /* As prvInsertTimerInActiveList(). */
+            if( xNextExpiryTime <= xTimeNow )
+            {
+                if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                {
+                    xProcessTimerNow = pdTRUE;
+                }
+                else
+                {
+                    vListInsert( pxOverflowIsrTimerList, &( pxTimer->xTimerListItem ) );
+                }
+            }
+            else
+            {
+                if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+                {
+                    xProcessTimerNow = pdTRUE;
+                }
+                else
+                {
+                    vListInsert( pxCurrentIsrTimerList, &( pxTimer->xTimerListItem ) );
+                }
+            }
+
+            return xProcessTimerNow;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvExpireIsrTimer( Timer_t * const pxTimer,
+                                       TickType_t xExpiredTime,
+                                       const TickType_t xTimeNow )
+        {
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+            {
+                /* As prvReloadTimer(), a backlog of expiries is cleared by
+                 * calling the callback for each. */
+                while( prvInsertIsrTimer( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime ) != pdFALSE )
+                {
+                    xExpiredTime += pxTimer->xTimerPeriodInTicks;
+
+                    traceTIMER_EXPIRED( pxTimer );
+                    pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                }
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            }
+
+            traceTIMER_EXPIRED( pxTimer );
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvProcessIsrTimerCommand( const DaemonTaskMessage_t * const pxMessage,
+                                               const TickType_t xTimeNow )
+        {
+            Timer_t * const pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+            const TickType_t xMessageValue = pxMessage->u.xTimerParameters.xMessageValue;
+
+            if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+            {
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, xMessageValue );
+
+            switch( pxMessage->xMessageID )
+            {
+                case tmrCOMMAND_START_DONT_TRACE:
+                case tmrCOMMAND_START:
+                case tmrCOMMAND_START_FROM_ISR:
+                case tmrCOMMAND_RESET:
+                case tmrCOMMAND_RESET_FROM_ISR:
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+                    if( prvInsertIsrTimer( pxTimer, xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessageValue ) != pdFALSE )
+                    {
+                        /* The timer expired before the command reached the
+                         * tick. */
+                        prvExpireIsrTimer( pxTimer, xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    break;
+
+                case tmrCOMMAND_STOP:
+                case tmrCOMMAND_STOP_FROM_ISR:
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    break;
+
+                case tmrCOMMAND_CHANGE_PERIOD:
+                case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                    pxTimer->xTimerPeriodInTicks = xMessageValue;
+                    configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+                    ( void ) prvInsertIsrTimer( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                    break;
+
+                case tmrCOMMAND_DELETE:
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+
+                    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                        {
+                            /* The memory cannot be freed from an interrupt, so
+                             * the timer service task is asked to do it. */
+                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                            {
+                                vListInsertEnd( &xIsrTimersToFree, &( pxTimer->xTimerListItem ) );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                    break;
+
+                default:
+                    /* Don't expect to get here. */
+                    break;
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        void vTimerProcessIsrTimers( const TickType_t xTimeNow )
+        {
+            DaemonTaskMessage_t xMessage;
+            Timer_t * pxTimer;
+            List_t * pxTemp;
+
+            if( xTimeNow < xIsrTimerTime )
+            {
+                /* The tick count wrapped.  Timers still on the current list
+                 * have expired, and only their expiries before the wrap are
+                 * processed before the lists are switched, as in
+                 * prvSwitchTimerLists(). */
+                while( listLIST_IS_EMPTY( pxCurrentIsrTimerList ) == pdFALSE )
+                {
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentIsrTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    prvExpireIsrTimer( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ), tmrMAX_TIME_BEFORE_OVERFLOW );
+                }
+
+                pxTemp = pxCurrentIsrTimerList;
+                pxCurrentIsrTimerList = pxOverflowIsrTimerList;
+                pxOverflowIsrTimerList = pxTemp;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xIsrTimerTime = xTimeNow;
+
+            /* Commands are applied in the order their slots were claimed. */
+            while( prvReceiveIsrTimerCommand( &xMessage ) != pdFAIL )
+            {
+                prvProcessIsrTimerCommand( &xMessage, xTimeNow );
+            }
+
+            /* The list is in expiry time order, so stop at the first timer
+             * that has not expired. */
+            while( listLIST_IS_EMPTY( pxCurrentIsrTimerList ) == pdFALSE )
+            {
+                if( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentIsrTimerList ) <= xTimeNow )
+                {
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentIsrTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    prvExpireIsrTimer( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ), xTimeNow );
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                {
+                    /* Pass deleted timers on to the timer service task, which
+                     * frees them.  One that does not fit in the timer queue is
+                     * tried again on the next tick. */
+                    while( listLIST_IS_EMPTY( &xIsrTimersToFree ) == pdFALSE )
+                    {
+                        pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xIsrTimersToFree ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                        /* The timer service task must find it in no list. */
+                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+                        xMessage.xMessageID = tmrCOMMAND_DELETE;
+                        xMessage.u.xTimerParameters.xMessageValue = ( TickType_t ) 0U;
+                        xMessage.u.xTimerParameters.pxTimer = pxTimer;
+
+                        if( xQueueSendToBackFromISR( xTimerQueue, &xMessage, NULL ) != pdPASS )
+                        {
+                            vListInsertEnd( &xIsrTimersToFree, &( pxTimer->xTimerListItem ) );
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        }
+
+    #endif /* configUSE_TIMER_ISR_CALLBACKS */
+/*-----------------------------------------------------------*/
+
     BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
     {
         BaseType_t xReturn;
@@ -0,0 +1,595 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "topic.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build topic.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* Items are numbered in the order they are published.  A subscriber's cursor
+ * is the number of the next item it receives, or of the item it holds, and it
+ * is ( ulPublished - cursor ) items behind.  The ring only keeps the last
+ * uxLength items, so the slot of an item is found by counting back from
+ * uxHead, which also works when the numbers wrap. */
+typedef struct TopicSubscriberDef_t
+{
+    struct TopicSubscriberDef_t * pxNext;
+    struct TopicDef_t * pxTopic;
+    TaskHandle_t xTask;             /* The task that subscribed. */
+    uint32_t ulCursor;
+    UBaseType_t uxMissed;
+    volatile BaseType_t xWaiting;   /* pdTRUE while the task is about to block or blocked waiting for an item. */
+    BaseType_t xHolding;            /* pdTRUE from pvTopicReceive() to xTopicRelease(). */
+} TopicSubscriber_t;
+
+typedef struct TopicDef_t
+{
+    uint32_t ulPublished;                /* Number of items published so far. */
+    UBaseType_t uxHead;                  /* Slot the next item is written to. */
+    UBaseType_t uxLength;
+    UBaseType_t uxItemSize;
+    BaseType_t xWhenFull;                /* topicOVERWRITE or topicBACKPRESSURE. */
+    TopicSubscriber_t * pxSubscribers;   /* Changed in critical sections, as interrupts walk it. */
+    List_t xTasksWaitingToPublish;       /* Publishers blocked on a full topicBACKPRESSURE topic. */
+    uint8_t * pucStorage;
+} Topic_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if the topic is a topicBACKPRESSURE topic and a subscriber is
+ * a whole ring behind.  Must be called with interrupts masked.
+ */
+static BaseType_t prvIsFull( const Topic_t * pxTopic ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies pvItem into the ring unless prvIsFull().  Must be called with
+ * interrupts masked.
+ */
+static BaseType_t prvWriteItem( Topic_t * const pxTopic,
+                                const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks a publisher waiting on the topic if it is no longer full.  Must be
+ * called with interrupts masked.  Returns pdTRUE if a context switch is
+ * required.
+ */
+static BaseType_t prvUnblockPublisher( Topic_t * const pxTopic ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    TopicHandle_t xTopicCreate( UBaseType_t uxLength,
+                                UBaseType_t uxItemSize,
+                                BaseType_t xWhenFull )
+    {
+        Topic_t * pxTopic;
+        size_t xStorageBytes;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+        configASSERT( ( xWhenFull == topicOVERWRITE ) || ( xWhenFull == topicBACKPRESSURE ) );
+
+        xStorageBytes = ( size_t ) uxLength * ( size_t ) uxItemSize;
+
+        /* Check for multiplication and addition overflow. */
+        configASSERT( ( xStorageBytes / uxItemSize ) == ( size_t ) uxLength );
+        configASSERT( ( sizeof( Topic_t ) + xStorageBytes ) > xStorageBytes );
+
+        /* The topic and its ring are allocated in one go, as queues are. */
+        pxTopic = ( Topic_t * ) pvPortMalloc( sizeof( Topic_t ) + xStorageBytes ); /*lint !e9087 !e9079 The topic and its ring are one allocation. */
+
+        if( pxTopic != NULL )
+        {
+            pxTopic->ulPublished = ( uint32_t ) 0;
+            pxTopic->uxHead = ( UBaseType_t ) 0;
+            pxTopic->uxLength = uxLength;
+            pxTopic->uxItemSize = uxItemSize;
+            pxTopic->xWhenFull = xWhenFull;
+            pxTopic->pxSubscribers = NULL;
+            vListInitialise( &( pxTopic->xTasksWaitingToPublish ) );
+            pxTopic->pucStorage = ( ( uint8_t * ) pxTopic ) + sizeof( Topic_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxTopic;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    void vTopicDelete( TopicHandle_t xTopic )
+    {
+        configASSERT( xTopic );
+        configASSERT( xTopic->pxSubscribers == NULL );
+        configASSERT( listLIST_IS_EMPTY( &( xTopic->xTasksWaitingToPublish ) ) != pdFALSE );
+
+        vPortFree( ( void * ) xTopic );
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsFull( const Topic_t * pxTopic )
+{
+    const TopicSubscriber_t * pxSubscriber;
+    BaseType_t xReturn = pdFALSE;
+
+    if( pxTopic->xWhenFull == topicBACKPRESSURE )
+    {
+        for( pxSubscriber = pxTopic->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext )
+        {
+            if( ( pxTopic->ulPublished - pxSubscriber->ulCursor ) >= ( uint32_t ) pxTopic->uxLength )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItem( Topic_t * const pxTopic,
+                                const void * pvItem )
+{
+    BaseType_t xReturn;
+
+    if( prvIsFull( pxTopic ) == pdFALSE )
+    {
+        ( void ) memcpy( ( void * ) &( pxTopic->pucStorage[ pxTopic->uxHead * pxTopic->uxItemSize ] ), pvItem, ( size_t ) pxTopic->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        pxTopic->uxHead++;
+
+        if( pxTopic->uxHead == pxTopic->uxLength )
+        {
+            pxTopic->uxHead = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTopic->ulPublished++;
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_FULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTopicPublish( TopicHandle_t xTopic,
+                          const void * pvItem,
+                          TickType_t xTicksToWait )
+{
+    Topic_t * const pxTopic = xTopic;
+    TopicSubscriber_t * pxSubscriber;
+    BaseType_t xReturn, xBlocked;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxTopic );
+    configASSERT( pvItem );
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = prvWriteItem( pxTopic, pvItem );
+    }
+    taskEXIT_CRITICAL();
+
+    if( ( xReturn == errQUEUE_FULL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            xBlocked = pdFALSE;
+
+            /* Subscribers release items in critical sections, so the topic
+             * cannot stop being full between the check and the task being
+             * placed in xTasksWaitingToPublish. */
+            taskENTER_CRITICAL();
+            {
+                if( prvIsFull( pxTopic ) != pdFALSE )
+                {
+                    vTaskPlaceOnEventList( &( pxTopic->xTasksWaitingToPublish ), xTicksToWait );
+                    xBlocked = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBlocked != pdFALSE )
+            {
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvWriteItem( pxTopic, pvItem );
+            }
+            taskEXIT_CRITICAL();
+        } while( ( xReturn == errQUEUE_FULL ) &&
+                 ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn == pdPASS )
+    {
+        /* As sbSEND_COMPLETED() in stream_buffer.c.  Subscriptions are only
+         * added and removed by tasks, so the list cannot change while the
+         * scheduler is suspended. */
+        vTaskSuspendAll();
+        {
+            for( pxSubscriber = pxTopic->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext )
+            {
+                if( pxSubscriber->xWaiting != pdFALSE )
+                {
+                    pxSubscriber->xWaiting = pdFALSE;
+                    ( void ) xTaskNotify( pxSubscriber->xTask, ( uint32_t ) 0, eNoAction );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTopicPublishFromISR( TopicHandle_t xTopic,
+                                 const void * pvItem,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    Topic_t * const pxTopic = xTopic;
+    TopicSubscriber_t * pxSubscriber;
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xReturn;
+
+    configASSERT( pxTopic );
+    configASSERT( pvItem );
+
+    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = prvWriteItem( pxTopic, pvItem );
+
+        if( xReturn == pdPASS )
+        {
+            for( pxSubscriber = pxTopic->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext )
+            {
+                if( pxSubscriber->xWaiting != pdFALSE )
+                {
+                    pxSubscriber->xWaiting = pdFALSE;
+                    ( void ) xTaskNotifyFromISR( pxSubscriber->xTask, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic )
+    {
+        Topic_t * const pxTopic = xTopic;
+        TopicSubscriber_t * pxSubscriber;
+
+        configASSERT( pxTopic );
+
+        pxSubscriber = ( TopicSubscriber_t * ) pvPortMalloc( sizeof( TopicSubscriber_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+        if( pxSubscriber != NULL )
+        {
+            pxSubscriber->pxTopic = pxTopic;
+            pxSubscriber->xTask = xTaskGetCurrentTaskHandle();
+            pxSubscriber->uxMissed = ( UBaseType_t ) 0;
+            pxSubscriber->xWaiting = pdFALSE;
+            pxSubscriber->xHolding = pdFALSE;
+
+            taskENTER_CRITICAL();
+            {
+                pxSubscriber->ulCursor = pxTopic->ulPublished;
+                pxSubscriber->pxNext = pxTopic->pxSubscribers;
+                pxTopic->pxSubscribers = pxSubscriber;
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxSubscriber;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber )
+    {
+        TopicSubscriber_t * const pxSubscriber = xSubscriber;
+        Topic_t * pxTopic;
+        TopicSubscriber_t ** ppxLink;
+        BaseType_t xYieldRequired;
+
+        configASSERT( pxSubscriber );
+
+        pxTopic = pxSubscriber->pxTopic;
+
+        taskENTER_CRITICAL();
+        {
+            for( ppxLink = &( pxTopic->pxSubscribers ); *ppxLink != pxSubscriber; ppxLink = &( ( *ppxLink )->pxNext ) )
+            {
+                configASSERT( *ppxLink != NULL );
+            }
+
+            *ppxLink = pxSubscriber->pxNext;
+
+            /* It may have been the subscriber publishers were waiting for. */
+            xYieldRequired = prvUnblockPublisher( pxTopic );
+        }
+        taskEXIT_CRITICAL();
+
+        vPortFree( ( void * ) pxSubscriber );
+
+        if( xYieldRequired != pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+const void * pvTopicReceive( TopicSubscriberHandle_t xSubscriber,
+                             TickType_t xTicksToWait )
+{
+    TopicSubscriber_t * const pxSubscriber = xSubscriber;
+    Topic_t * pxTopic;
+    const void * pvReturn = NULL;
+    UBaseType_t uxBehind, uxSlot;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxSubscriber );
+    configASSERT( pxSubscriber->xHolding == pdFALSE );
+    configASSERT( pxSubscriber->xTask == xTaskGetCurrentTaskHandle() );
+
+    pxTopic = pxSubscriber->pxTopic;
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        /* Drop any notification left over from an earlier wait before looking,
+         * a publisher may notify as soon as xWaiting is set. */
+        ( void ) xTaskNotifyStateClear( NULL );
+
+        taskENTER_CRITICAL();
+        {
+            uxBehind = ( UBaseType_t ) ( pxTopic->ulPublished - pxSubscriber->ulCursor );
+
+            if( uxBehind > pxTopic->uxLength )
+            {
+                /* Only a topicOVERWRITE topic lets a subscriber fall this far
+                 * behind.  Skip to the oldest item still in the ring. */
+                pxSubscriber->uxMissed += uxBehind - pxTopic->uxLength;
+                pxSubscriber->ulCursor += ( uint32_t ) ( uxBehind - pxTopic->uxLength );
+                uxBehind = pxTopic->uxLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxBehind > ( UBaseType_t ) 0 )
+            {
+                if( pxTopic->uxHead >= uxBehind )
+                {
+                    uxSlot = pxTopic->uxHead - uxBehind;
+                }
+                else
+                {
+                    uxSlot = ( pxTopic->uxHead + pxTopic->uxLength ) - uxBehind;
+                }
+
+                pvReturn = ( const void * ) &( pxTopic->pucStorage[ uxSlot * pxTopic->uxItemSize ] ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+                pxSubscriber->xHolding = pdTRUE;
+            }
+            else if( xTicksToWait != ( TickType_t ) 0 )
+            {
+                pxSubscriber->xWaiting = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( pvReturn != NULL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+        {
+            break;
+        }
+        else
+        {
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+
+            /* Whether or not a publisher cleared it. */
+            pxSubscriber->xWaiting = pdFALSE;
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockPublisher( Topic_t * const pxTopic )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    if( ( listLIST_IS_EMPTY( &( pxTopic->xTasksWaitingToPublish ) ) == pdFALSE ) &&
+        ( prvIsFull( pxTopic ) == pdFALSE ) )
+    {
+        xReturn = xTaskRemoveFromEventList( &( pxTopic->xTasksWaitingToPublish ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTopicRelease( TopicSubscriberHandle_t xSubscriber )
+{
+    TopicSubscriber_t * const pxSubscriber = xSubscriber;
+    Topic_t * pxTopic;
+    BaseType_t xReturn, xYieldRequired;
+
+    configASSERT( pxSubscriber );
+    configASSERT( pxSubscriber->xHolding != pdFALSE );
+
+    pxTopic = pxSubscriber->pxTopic;
+
+    taskENTER_CRITICAL();
+    {
+        /* The slot is reused by the item published uxLength after it. */
+        if( ( pxTopic->ulPublished - pxSubscriber->ulCursor ) > ( uint32_t ) pxTopic->uxLength )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            xReturn = pdPASS;
+        }
+
+        pxSubscriber->ulCursor++;
+        pxSubscriber->xHolding = pdFALSE;
+
+        xYieldRequired = prvUnblockPublisher( pxTopic );
+    }
+    taskEXIT_CRITICAL();
+
+    if( xYieldRequired != pdFALSE )
+    {
+        portYIELD_WITHIN_API();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTopicGetMissed( TopicSubscriberHandle_t xSubscriber )
+{
+    configASSERT( xSubscriber );
+
+    return xSubscriber->uxMissed;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,423 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mpsc_queue.h"
+#include "workqueue.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build workqueue.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+typedef struct WorkItemDef_t
+{
+    WorkFunction_t pxFunction;
+    void * pvParameter1;
+    uint32_t ulParameter2;
+    TickType_t xDeadline;   /* Absolute, see workqueueNO_DEADLINE for items that have none. */
+    uint32_t ulSequence;    /* Set when the worker takes the item, to run items with equal deadlines in order. */
+} WorkItem_t;
+
+/* The worker moves submitted items from the MPSC queue to pxTaken[], a binary
+ * heap with the item to run next at the top.  Only the worker touches the
+ * heap. */
+typedef struct WorkQueueDef_t
+{
+    MpscQueueHandle_t xSubmitted;   /* Items submitted and not yet taken by the worker. */
+    TaskHandle_t xWorker;
+    UBaseType_t uxLength;
+    UBaseType_t uxTaken;            /* The number of items in pxTaken[]. */
+    uint32_t ulTakenCount;          /* The number of items taken so far. */
+    WorkItem_t * pxTaken;
+} WorkQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The worker task of every work queue.
+ */
+static portTASK_FUNCTION_PROTO( prvWorkerTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves submitted items to the heap while there is room.  If the heap is
+ * empty and nothing has been submitted, blocks until something is.
+ */
+static void prvTakeSubmittedItems( WorkQueue_t * const pxWorkQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxItem runs before pxOther.
+ */
+static BaseType_t prvRunsBefore( const WorkItem_t * const pxItem,
+                                 const WorkItem_t * const pxOther ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes the item at the top of the heap and runs it.
+ */
+static void prvRunNextItem( WorkQueue_t * const pxWorkQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Converts a relative deadline to an absolute one.
+ */
+static TickType_t prvAbsoluteDeadline( const TickType_t xTimeNow,
+                                       const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const configSTACK_DEPTH_TYPE usStackDepth,
+                                        UBaseType_t uxPriority,
+                                        UBaseType_t uxLength )
+    {
+        WorkQueue_t * pxWorkQueue;
+        size_t xHeapBytes;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+
+        xHeapBytes = ( size_t ) uxLength * sizeof( WorkItem_t );
+
+        /* Check for multiplication and addition overflow. */
+        configASSERT( ( xHeapBytes / sizeof( WorkItem_t ) ) == ( size_t ) uxLength );
+        configASSERT( ( sizeof( WorkQueue_t ) + xHeapBytes ) > xHeapBytes );
+
+        /* The work queue and its heap are allocated in one go. */
+        pxWorkQueue = ( WorkQueue_t * ) pvPortMalloc( sizeof( WorkQueue_t ) + xHeapBytes ); /*lint !e9087 !e9079 The work queue and its heap are one allocation. */
+
+        if( pxWorkQueue != NULL )
+        {
+            pxWorkQueue->xWorker = NULL;
+            pxWorkQueue->uxLength = uxLength;
+            pxWorkQueue->uxTaken = ( UBaseType_t ) 0;
+            pxWorkQueue->ulTakenCount = ( uint32_t ) 0;
+            pxWorkQueue->pxTaken = ( WorkItem_t * ) ( ( ( uint8_t * ) pxWorkQueue ) + sizeof( WorkQueue_t ) ); /*lint !e9016 !e9087 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+            pxWorkQueue->xSubmitted = xMpscQueueCreate( uxLength, ( UBaseType_t ) sizeof( WorkItem_t ) );
+
+            if( pxWorkQueue->xSubmitted != NULL )
+            {
+                if( xTaskCreate( prvWorkerTask, pcName, usStackDepth, ( void * ) pxWorkQueue, uxPriority, &( pxWorkQueue->xWorker ) ) != pdPASS )
+                {
+                    vMpscQueueDelete( pxWorkQueue->xSubmitted );
+                    vPortFree( pxWorkQueue );
+                    pxWorkQueue = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                vPortFree( pxWorkQueue );
+                pxWorkQueue = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxWorkQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static TickType_t prvAbsoluteDeadline( const TickType_t xTimeNow,
+                                       const TickType_t xRelativeDeadline )
+{
+    TickType_t xDeadline;
+
+    if( xRelativeDeadline == workqueueNO_DEADLINE )
+    {
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                xDeadline = xTimeNow + ( TickType_t ) EDF_IDLE_PERIOD;
+            }
+        #else
+            {
+                xDeadline = portMAX_DELAY;
+            }
+        #endif
+    }
+    else
+    {
+        xDeadline = xTimeNow + xRelativeDeadline;
+    }
+
+    return xDeadline;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkFunction_t pxFunction,
+                             void * pvParameter1,
+                             uint32_t ulParameter2,
+                             TickType_t xRelativeDeadline,
+                             TickType_t xTicksToWait )
+{
+    WorkQueue_t * const pxWorkQueue = xWorkQueue;
+    WorkItem_t xItem;
+    BaseType_t xReturn;
+
+    configASSERT( pxWorkQueue );
+    configASSERT( pxFunction );
+
+    xItem.pxFunction = pxFunction;
+    xItem.pvParameter1 = pvParameter1;
+    xItem.ulParameter2 = ulParameter2;
+    xItem.xDeadline = prvAbsoluteDeadline( xTaskGetTickCount(), xRelativeDeadline );
+    xItem.ulSequence = ( uint32_t ) 0;
+
+    xReturn = xMpscQueueSend( pxWorkQueue->xSubmitted, &xItem, xTicksToWait );
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* Raised after the item is sent, so that a worker the send
+             * unblocks is moved to its place among the ready tasks. */
+            if( xReturn == pdPASS )
+            {
+                vTaskRaiseDeadline( pxWorkQueue->xWorker, xItem.xDeadline );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkFunction_t pxFunction,
+                                    void * pvParameter1,
+                                    uint32_t ulParameter2,
+                                    TickType_t xRelativeDeadline,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    WorkQueue_t * const pxWorkQueue = xWorkQueue;
+    WorkItem_t xItem;
+    BaseType_t xReturn;
+
+    configASSERT( pxWorkQueue );
+    configASSERT( pxFunction );
+
+    xItem.pxFunction = pxFunction;
+    xItem.pvParameter1 = pvParameter1;
+    xItem.ulParameter2 = ulParameter2;
+    xItem.xDeadline = prvAbsoluteDeadline( xTaskGetTickCountFromISR(), xRelativeDeadline );
+    xItem.ulSequence = ( uint32_t ) 0;
+
+    xReturn = xMpscQueueSendFromISR( pxWorkQueue->xSubmitted, &xItem, pxHigherPriorityTaskWoken );
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            if( xReturn == pdPASS )
+            {
+                vTaskRaiseDeadlineFromISR( pxWorkQueue->xWorker, xItem.xDeadline, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue )
+{
+    configASSERT( xWorkQueue );
+
+    return xWorkQueue->xWorker;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRunsBefore( const WorkItem_t * const pxItem,
+                                 const WorkItem_t * const pxOther )
+{
+    BaseType_t xReturn;
+
+    if( pxItem->xDeadline != pxOther->xDeadline )
+    {
+        xReturn = ( pxItem->xDeadline < pxOther->xDeadline ) ? pdTRUE : pdFALSE;
+    }
+    else
+    {
+        /* The sequence numbers of the items in the heap are less than
+         * uxLength apart, so this holds when they wrap. */
+        xReturn = ( ( int32_t ) ( pxItem->ulSequence - pxOther->ulSequence ) < 0 ) ? pdTRUE : pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTakeSubmittedItems( WorkQueue_t * const pxWorkQueue )
+{
+    WorkItem_t xItem;
+    UBaseType_t uxIndex, uxParent;
+    TickType_t xTicksToWait = ( TickType_t ) 0;
+
+    while( pxWorkQueue->uxTaken < pxWorkQueue->uxLength )
+    {
+        if( xMpscQueueReceive( pxWorkQueue->xSubmitted, &xItem, xTicksToWait ) == pdPASS )
+        {
+            xItem.ulSequence = pxWorkQueue->ulTakenCount;
+            pxWorkQueue->ulTakenCount++;
+
+            /* Sift the item up from the bottom of the heap. */
+            uxIndex = pxWorkQueue->uxTaken;
+            pxWorkQueue->uxTaken++;
+
+            while( uxIndex > ( UBaseType_t ) 0 )
+            {
+                uxParent = ( uxIndex - ( UBaseType_t ) 1 ) / ( UBaseType_t ) 2;
+
+                if( prvRunsBefore( &xItem, &( pxWorkQueue->pxTaken[ uxParent ] ) ) != pdFALSE )
+                {
+                    pxWorkQueue->pxTaken[ uxIndex ] = pxWorkQueue->pxTaken[ uxParent ];
+                    uxIndex = uxParent;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            pxWorkQueue->pxTaken[ uxIndex ] = xItem;
+            xTicksToWait = ( TickType_t ) 0;
+        }
+        else if( pxWorkQueue->uxTaken == ( UBaseType_t ) 0 )
+        {
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* Nothing to do, so no deadline until an item raises it.
+                     * That is only done now there is nothing to take, as it
+                     * would undo the deadline raised by an item not yet
+                     * taken. */
+                    vTaskSetDeadline( NULL, portMAX_DELAY );
+                }
+            #endif
+
+            xTicksToWait = portMAX_DELAY;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunNextItem( WorkQueue_t * const pxWorkQueue )
+{
+    const WorkItem_t xItem = pxWorkQueue->pxTaken[ 0 ];
+    WorkItem_t * pxLast;
+    UBaseType_t uxIndex = ( UBaseType_t ) 0, uxChild;
+
+    /* Sift the last item down from the top of the heap. */
+    pxWorkQueue->uxTaken--;
+    pxLast = &( pxWorkQueue->pxTaken[ pxWorkQueue->uxTaken ] );
+
+    for( ; ; )
+    {
+        uxChild = ( uxIndex * ( UBaseType_t ) 2 ) + ( UBaseType_t ) 1;
+
+        if( uxChild >= pxWorkQueue->uxTaken )
+        {
+            break;
+        }
+
+        if( ( ( uxChild + ( UBaseType_t ) 1 ) < pxWorkQueue->uxTaken ) &&
+            ( prvRunsBefore( &( pxWorkQueue->pxTaken[ uxChild + ( UBaseType_t ) 1 ] ), &( pxWorkQueue->pxTaken[ uxChild ] ) ) != pdFALSE ) )
+        {
+            uxChild++;
+        }
+
+        if( prvRunsBefore( &( pxWorkQueue->pxTaken[ uxChild ] ), pxLast ) != pdFALSE )
+        {
+            pxWorkQueue->pxTaken[ uxIndex ] = pxWorkQueue->pxTaken[ uxChild ];
+            uxIndex = uxChild;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    pxWorkQueue->pxTaken[ uxIndex ] = *pxLast;
+
+    xItem.pxFunction( xItem.pvParameter1, xItem.ulParameter2 );
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvWorkerTask, pvParameters )
+{
+    WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) pvParameters;
+
+    for( ; ; )
+    {
+        prvTakeSubmittedItems( pxWorkQueue );
+
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                /* Run with the deadline of the most urgent item.  Setting it
+                 * undoes what items submitted since the MPSC queue was last
+                 * found empty raised it to, so those are taken too and the
+                 * deadline raised to theirs if it is earlier.  Items submitted
+                 * after that raise it themselves. */
+                vTaskSetDeadline( NULL, pxWorkQueue->pxTaken[ 0 ].xDeadline );
+                prvTakeSubmittedItems( pxWorkQueue );
+                vTaskRaiseDeadline( NULL, pxWorkQueue->pxTaken[ 0 ].xDeadline );
+            }
+        #endif
+
+        prvRunNextItem( pxWorkQueue );
+    }
+}
@@ -55,6 +55,7 @@
 /* Standard includes. */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
@@ -110,6 +111,10 @@ unsigned int CPU_Load = 0;
 
 char runTimeStatusBuff[200];
 
+#if ( configGENERATE_JOB_TIME_STATS == 1 )
+	char jobTimeStatusBuff[200];		/**> Per job execution times, read by FinalProject/Tools/wcetstats.py */
+#endif
+
 /*-----------------------------------------------------------*/
 /*                   User-Defined-Macros                     */
 /*-----------------------------------------------------------*/
@@ -183,7 +188,19 @@ void Task_B( void * pvParameters )
 			
 			xSerialPutChar('\n');
 			
-			vSerialPutString( (const signed char *) ((char*)&runTimeStatusBuff[0]), 65);
+			#if ( configGENERATE_JOB_TIME_STATS == 1 )
+			
+				/* The UART sends one string at a time, so the job times
+				replace the run time stats while they are measured. */
+				vTaskGetJobTimeStatsText(jobTimeStatusBuff);
+				
+				vSerialPutString( (const signed char *) jobTimeStatusBuff, (unsigned short) strlen(jobTimeStatusBuff));
+			
+			#else
+			
+				vSerialPutString( (const signed char *) ((char*)&runTimeStatusBuff[0]), 65);
+			
+			#endif
 						
 			vTaskDelayUntil( &xLastWakeTime, TASK_B_DELAY_MS);
 			
@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+"""Schedulability campaign: random task sets through the kernel.
+
+    campaign.py --scheduler EDF --sets 200 --tasks 6
+    campaign.py --scheduler FP --tick-us 1000 --switch-us 25 --tick-isr-us 8 \\
+                --csv fp.csv --svg fp.svg
+
+For every utilisation level between --umin and --umax, --sets task sets are
+drawn with UUniFast (Bini and Buttazzo, 2005) and periods log-uniformly
+distributed in [--tmin, --tmax].  Each set is then judged twice:
+
+  bound   the analytical test of schedanalysis.py on the ideal task set
+          (EDF: U <= 1, FP: exact response time analysis with rate
+          monotonic priorities),
+  kernel  a run of the real kernel on the Posix port in virtual time
+          (FinalProject/Project Folder/Posix_GCC), accepted when no job
+          misses its deadline within --horizon.
+
+The kernel runs in units of one microsecond.  Periods are rounded to whole
+ticks of --tick-us, as vTaskDelayUntil() can only express ticks, execution
+times are kept to the microsecond, and every context switch and tick
+interrupt consumes --switch-us and --tick-isr-us before any task makes
+progress.  The difference between the two acceptance ratios is therefore
+the utilisation lost to tick quantisation and kernel overhead.
+
+The runs are spread over --jobs host processes.  Results are printed as a
+table and can be written as CSV and as an SVG plot of acceptance ratio
+against utilisation.  Every set is generated from --seed, its level and its
+index, so a campaign is reproducible and can be extended.
+"""
+
+import argparse
+import concurrent.futures
+import csv
+import math
+import os
+import random
+import sys
+import tempfile
+
+import schedanalysis
+import schedverify
+import taskset as ts
+
+US_PER_MS = 1000
+
+
+def uunifast(n, utilisation, rng):
+    """n task utilisations summing to utilisation, uniformly distributed."""
+    result = []
+    remaining = utilisation
+    for i in range(1, n):
+        nxt = remaining * rng.random() ** (1.0 / (n - i))
+        result.append(remaining - nxt)
+        remaining = nxt
+    result.append(remaining)
+    return result
+
+
+def generate(n, utilisation, tmin, tmax, step, rng, scheduler):
+    """One implicit deadline task set with the given total utilisation."""
+    tasks = []
+    for i, u in enumerate(uunifast(n, utilisation, rng)):
+        period = math.exp(rng.uniform(math.log(tmin), math.log(tmax)))
+        period = max(step, round(period / step) * step)
+        # Execution times are kept to the microsecond.
+        wcet = max(1, round(u * period * US_PER_MS)) / US_PER_MS
+        tasks.append(ts.Task(name="T%d" % (i + 1), wcet=wcet,
+                             period=round(period, 6)))
+    if scheduler == "FP":
+        ts.assign_priorities(tasks, "RM")
+    return ts.TaskSet(tasks=tasks, scheduler=scheduler)
+
+
+def write_task_file(path, taskset, cfg):
+    """Task file for the runner, execution times in microseconds."""
+    tick = cfg["tick_us"]
+    prios = schedverify.kernel_priorities(taskset.tasks, taskset.scheduler)
+    with open(path, "w") as f:
+        f.write("duration %d\n" % cfg["duration"])
+        f.write("resolution %d\n" % tick)
+        f.write("overhead %d %d\n" % (cfg["switch_us"], cfg["tick_isr_us"]))
+        for t, prio in zip(taskset.tasks, prios):
+            period = max(1, round(t.period * US_PER_MS / tick))
+            f.write("task %s 0 %d %d %d %d\n" % (
+                t.name, math.ceil(t.wcet * US_PER_MS - 1e-6), period, period,
+                prio))
+
+
+def kernel_accepts(taskset, cfg):
+    """Run the set on the kernel; return (no deadline missed, overhead share)."""
+    fd, path = tempfile.mkstemp(suffix=".tasks")
+    os.close(fd)
+    try:
+        write_task_file(path, taskset, cfg)
+        out = schedverify.run_runner(cfg["runner"], path)
+    finally:
+        os.unlink(path)
+
+    tick = cfg["tick_us"]
+    done = {}
+    overhead = 0.0
+    for line in out.splitlines():
+        fields = line.split()
+        if fields[0] == "job":
+            done[(int(fields[1]) - 1, int(fields[2]))] = int(fields[3])
+        elif fields[0] == "units":
+            overhead = int(fields[3]) / int(fields[2])
+        elif fields[0] == "overflow":
+            raise RuntimeError("runner trace buffer overflowed")
+
+    # Every job whose deadline falls within the run must have completed by it.
+    end = cfg["duration"] * tick
+    for i, t in enumerate(taskset.tasks):
+        period = max(1, round(t.period * US_PER_MS / tick)) * tick
+        release = 0
+        while release + period <= end:
+            completion = done.get((i, release))
+            if completion is None or completion > release + period:
+                return False, overhead
+            release += period
+    return True, overhead
+
+
+def evaluate(args):
+    """Worker: generate set (level, index) and judge it both ways."""
+    cfg, level, index, utilisation = args
+    rng = random.Random("%s:%d:%d" % (cfg["seed"], level, index))
+    taskset = generate(cfg["tasks"], utilisation, cfg["tmin"], cfg["tmax"],
+                       cfg["step"], rng, cfg["scheduler"])
+    bound = schedanalysis.analyse(taskset).schedulable
+    kernel, overhead = kernel_accepts(taskset, cfg)
+    return level, bound, kernel, overhead
+
+
+def levels(umin, umax, ustep):
+    count = int(round((umax - umin) / ustep)) + 1
+    return [round(umin + i * ustep, 6) for i in range(count)]
+
+
+def run(cfg, jobs):
+    """Return one row per utilisation level."""
+    us = levels(cfg["umin"], cfg["umax"], cfg["ustep"])
+    rows = [{"utilisation": u, "sets": 0, "bound": 0, "kernel": 0,
+             "overhead": 0.0} for u in us]
+    work = [(cfg, level, index, u) for level, u in enumerate(us)
+            for index in range(cfg["sets"])]
+    with concurrent.futures.ProcessPoolExecutor(max_workers=jobs) as pool:
+        for level, bound, kernel, overhead in pool.map(evaluate, work,
+                                                       chunksize=4):
+            row = rows[level]
+            row["sets"] += 1
+            row["bound"] += bound
+            row["kernel"] += kernel
+            row["overhead"] += overhead
+    for row in rows:
+        row["overhead"] /= max(1, row["sets"])
+    return rows
+
+
+def utilisation_loss(rows, ustep):
+    """Area between the analytical and the kernel acceptance ratio curves."""
+    return sum((r["bound"] - r["kernel"]) / r["sets"] * ustep
+               for r in rows if r["sets"])
+
+
+def safe_utilisation(rows):
+    """Highest level up to which the kernel accepted every set."""
+    safe = None
+    for r in rows:
+        if r["kernel"] != r["sets"]:
+            break
+        safe = r["utilisation"]
+    return safe
+
+
+def write_csv(path, rows):
+    with open(path, "w", newline="") as f:
+        w = csv.writer(f)
+        w.writerow(["utilisation", "sets", "bound_accepted",
+                    "kernel_accepted", "bound_ratio", "kernel_ratio",
+                    "overhead_share"])
+        for r in rows:
+            w.writerow([r["utilisation"], r["sets"], r["bound"], r["kernel"],
+                        "%.4f" % (r["bound"] / r["sets"]),
+                        "%.4f" % (r["kernel"] / r["sets"]),
+                        "%.5f" % r["overhead"]])
+
+
+def write_svg(path, rows, title):
+    """Acceptance ratio against utilisation, one line per verdict."""
+    width, height, margin = 640, 400, 50
+    umin, umax = rows[0]["utilisation"], rows[-1]["utilisation"]
+    span = (umax - umin) or 1.0
+
+    def x(u):
+        return margin + (u - umin) / span * (width - 2 * margin)
+
+    def y(ratio):
+        return height - margin - ratio * (height - 2 * margin)
+
+    out = ['<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d" '
+           'font-family="sans-serif" font-size="12">' % (width, height),
+           '<rect width="100%" height="100%" fill="white"/>',
+           '<text x="%d" y="20" text-anchor="middle">%s</text>'
+           % (width // 2, title)]
+    for i in range(6):
+        ratio = i / 5
+        out.append('<line x1="%d" y1="%.1f" x2="%d" y2="%.1f" stroke="#ddd"/>'
+                   % (margin, y(ratio), width - margin, y(ratio)))
+        out.append('<text x="%d" y="%.1f" text-anchor="end">%.1f</text>'
+                   % (margin - 5, y(ratio) + 4, ratio))
+    for r in rows[::max(1, len(rows) // 10)]:
+        out.append('<text x="%.1f" y="%d" text-anchor="middle">%.2f</text>'
+                   % (x(r["utilisation"]), height - margin + 16,
+                      r["utilisation"]))
+    out.append('<text x="%d" y="%d" text-anchor="middle">utilisation</text>'
+               % (width // 2, height - 10))
+    out.append('<text x="15" y="%d" transform="rotate(-90 15 %d)" '
+               'text-anchor="middle">acceptance ratio</text>'
+               % (height // 2, height // 2))
+    for key, colour, label in (("bound", "#1f77b4", "analytical bound"),
+                               ("kernel", "#d62728", "kernel")):
+        points = " ".join("%.1f,%.1f" % (x(r["utilisation"]),
+                                         y(r[key] / r["sets"]))
+                          for r in rows)
+        out.append('<polyline fill="none" stroke="%s" stroke-width="2" '
+                   'points="%s"/>' % (colour, points))
+        legend_y = margin + (15 if key == "bound" else 30)
+        out.append('<line x1="%d" y1="%d" x2="%d" y2="%d" stroke="%s" '
+                   'stroke-width="2"/><text x="%d" y="%d">%s</text>'
+                   % (margin + 10, legend_y, margin + 30, legend_y, colour,
+                      margin + 35, legend_y + 4, label))
+    out.append("</svg>\n")
+    with open(path, "w") as f:
+        f.write("\n".join(out))
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("--scheduler", choices=("EDF", "FP"), default="EDF")
+    ap.add_argument("--sets", type=int, default=100,
+                    help="task sets per utilisation level (default 100)")
+    ap.add_argument("--tasks", type=int, default=5,
+                    help="tasks per set (default 5)")
+    ap.add_argument("--umin", type=float, default=0.5)
+    ap.add_argument("--umax", type=float, default=1.0)
+    ap.add_argument("--ustep", type=float, default=0.025)
+    ap.add_argument("--tmin", type=float, default=5.0,
+                    help="shortest period in ms (default 5)")
+    ap.add_argument("--tmax", type=float, default=90.0,
+                    help="longest period in ms (default 90)")
+    ap.add_argument("--period-step", type=float, default=0.1,
+                    help="periods are multiples of this many ms (default "
+                         "0.1, so they do not all fall on tick boundaries)")
+    ap.add_argument("--horizon", type=float,
+                    help="simulated time per set in ms (default 10 * tmax)")
+    ap.add_argument("--tick-us", type=int, default=1000,
+                    help="kernel tick period in microseconds (default 1000)")
+    ap.add_argument("--switch-us", type=int, default=0,
+                    help="cost of one context switch in microseconds")
+    ap.add_argument("--tick-isr-us", type=int, default=0,
+                    help="cost of one tick interrupt in microseconds")
+    ap.add_argument("--seed", default="1")
+    ap.add_argument("--jobs", type=int, default=os.cpu_count(),
+                    help="parallel runner processes (default: all CPUs)")
+    ap.add_argument("--runner", help="use this runner binary instead of "
+                                     "building the Posix project")
+    ap.add_argument("--csv", help="write the results to this CSV file")
+    ap.add_argument("--svg", help="plot the acceptance ratios to this file")
+    args = ap.parse_args(argv)
+
+    horizon = args.horizon or 10 * args.tmax
+    if args.scheduler == "EDF" and \
+            args.tmax * US_PER_MS / args.tick_us >= schedverify.EDF_IDLE_PERIOD:
+        sys.stderr.write("periods must stay below EDF_IDLE_PERIOD (%d "
+                         "ticks) or the idle task runs ahead of the tasks\n"
+                         % schedverify.EDF_IDLE_PERIOD)
+        return 2
+    if args.tick_isr_us >= args.tick_us:
+        sys.stderr.write("the tick interrupt must be shorter than the tick\n")
+        return 2
+
+    try:
+        runner = args.runner or schedverify.runner_path(args.scheduler)
+    except (OSError, schedverify.subprocess.SubprocessError) as e:
+        sys.stderr.write("cannot build the runner: %s\n" % e)
+        return 2
+    cfg = {"scheduler": args.scheduler, "sets": args.sets,
+           "tasks": args.tasks, "umin": args.umin, "umax": args.umax,
+           "ustep": args.ustep, "tmin": args.tmin, "tmax": args.tmax,
+           "step": args.period_step, "seed": args.seed,
+           "tick_us": args.tick_us, "switch_us": args.switch_us,
+           "tick_isr_us": args.tick_isr_us, "runner": runner,
+           "duration": int(round(horizon * US_PER_MS / args.tick_us))}
+
+    try:
+        rows = run(cfg, args.jobs)
+    except RuntimeError as e:
+        sys.stderr.write("%s\n" % e)
+        return 2
+
+    sys.stdout.write("%-8s %6s %8s %8s %10s\n" % ("U", "sets", "bound",
+                                                  "kernel", "overhead"))
+    for r in rows:
+        sys.stdout.write("%-8.3f %6d %8.3f %8.3f %9.2f%%\n" % (
+            r["utilisation"], r["sets"], r["bound"] / r["sets"],
+            r["kernel"] / r["sets"], 100 * r["overhead"]))
+    safe = safe_utilisation(rows)
+    sys.stdout.write("\nutilisation loss (area between the curves): %.4f\n"
+                     % utilisation_loss(rows, args.ustep))
+    sys.stdout.write("kernel accepted every set up to U = %s\n"
+                     % ("-" if safe is None else "%.3f" % safe))
+
+    if args.csv:
+        write_csv(args.csv, rows)
+    if args.svg:
+        write_svg(args.svg, rows, "%s, %d tasks, tick %d us, switch %d us, "
+                  "tick ISR %d us" % (args.scheduler, args.tasks,
+                                      args.tick_us, args.switch_us,
+                                      args.tick_isr_us))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+"""Replay a heap trace to size the heap.
+
+    heaptrace.py uart.log --total-heap-size 13312
+    RTOSSim_EDF tasks.txt | heaptrace.py - --buckets 20
+
+The input is the output of vHeapTraceGetText() (configGENERATE_HEAP_TRACE),
+captured from the board's UART, or the trace printed by the Posix runner:
+
+    heaptask <task> <name>
+    heapinfo <heap size> <events> <failed> <min free> <min largest free> <max fragmentation>
+    heap <event> <time> <malloc|free|failed> <task> <caller> <address> <size> <free> <largest free>
+
+with the task, caller and address in hexadecimal and the sizes in bytes,
+including the heap's own block headers.  Other lines are ignored, so a whole
+log can be passed in.  Events are merged by number, so several reports of the
+same run can be concatenated; the last heapinfo line wins.
+
+The report gives the live and peak bytes of each task (a block counts against
+the task that allocated it until it is freed, by whichever task), the free
+bytes, largest free block and fragmentation over time, the blocks live at the
+peak by call site, and a size for configTOTAL_HEAP_SIZE:
+
+  - the peak in use, below which the application cannot run at all;
+  - the span from the lowest to the highest byte ever allocated.  heap_1.c and
+    heap_4.c take the first block that fits in address order, so they place
+    every block of the same run at the same address in any heap at least that
+    large.  heap_2.c, heap_5.c and heap_6.c may place blocks differently in a
+    smaller heap, so there it is an estimate.  It is only known when the ring
+    still holds the first event;
+  - otherwise, the heap size less the spare room any allocation left in the
+    largest free block, as if the bytes removed all came out of that block.
+
+The suggestion adds the bytes configTOTAL_HEAP_SIZE loses to alignment and to
+the heap's end marker, known exactly with --total-heap-size, and --margin.
+"""
+
+import argparse
+import sys
+
+BAR = 40
+
+
+def parse(lines):
+    """Return (info, events, tasks) from report lines."""
+    info, events, tasks = None, {}, {}
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        try:
+            if fields[0] == "heaptask" and len(fields) >= 3:
+                tasks[int(fields[1], 16)] = " ".join(fields[2:])
+            elif fields[0] == "heapinfo" and len(fields) == 7:
+                size, count, failed, min_free, min_largest, frag = (
+                    int(f) for f in fields[1:])
+                info = {"size": size, "events": count, "failed": failed,
+                        "min_free": min_free, "min_largest": min_largest,
+                        "max_frag": frag}
+            elif fields[0] == "heap" and len(fields) == 10:
+                if fields[3] not in ("malloc", "free", "failed"):
+                    continue
+                events[int(fields[1])] = {
+                    "n": int(fields[1]), "time": int(fields[2]),
+                    "kind": fields[3], "task": int(fields[4], 16),
+                    "caller": int(fields[5], 16),
+                    "address": int(fields[6], 16), "size": int(fields[7]),
+                    "free": int(fields[8]), "largest": int(fields[9])}
+        except ValueError:
+            continue
+    return info, [events[n] for n in sorted(events)], tasks
+
+
+def fragmentation(free, largest):
+    """Share of the free bytes outside the largest free block, in percent."""
+    return 100.0 * (free - largest) / free if free else 0.0
+
+
+def task_name(tasks, handle):
+    if handle == 0:
+        return "(startup)"
+    return tasks.get(handle, "%x" % handle)
+
+
+def replay(info, events, tasks):
+    """Replay the events.  Returns a dict of the figures reported."""
+    heap = info["size"]
+    per_task = {}
+    live = {}
+    unmatched = 0
+    peak_free, peak_live = None, {}
+    low, high = None, None
+    slack = info["min_free"]
+    previous = None
+
+    for e in events:
+        t = per_task.setdefault(e["task"], {"mallocs": 0, "frees": 0,
+                                            "failed": 0, "live": 0,
+                                            "peak": 0})
+        if e["kind"] == "malloc":
+            t["mallocs"] += 1
+            t["live"] += e["size"]
+            t["peak"] = max(t["peak"], t["live"])
+            live[e["address"]] = (e["task"], e["size"], e["caller"])
+            low = e["address"] if low is None else min(low, e["address"])
+            end = e["address"] + e["size"]
+            high = end if high is None else max(high, end)
+            if previous is not None:
+                slack = min(slack, previous["largest"] - e["size"])
+        elif e["kind"] == "free":
+            t["frees"] += 1
+            block = live.pop(e["address"], None)
+            if block is None:
+                unmatched += 1
+            else:
+                per_task[block[0]]["live"] -= block[1]
+        else:
+            t["failed"] += 1
+        if peak_free is None or e["free"] < peak_free:
+            peak_free, peak_live = e["free"], dict(live)
+        previous = e
+
+    first = events[0]["n"] if events else info["events"]
+    gaps = info["events"] - len(events)
+    return {"heap": heap, "tasks": per_task, "unmatched": unmatched,
+            "peak_live": peak_live, "peak_free": peak_free,
+            "span": (high - low) if (first == 0 and low is not None) else None,
+            "slack": max(slack, 0), "lost": gaps}
+
+
+def report(info, events, tasks, r, buckets, out):
+    heap = r["heap"]
+    out.write("heap %d bytes, %d events (%d overwritten), %d failed "
+              "allocations\n" % (heap, info["events"], r["lost"],
+                                 info["failed"]))
+    out.write("lowest free %d bytes, smallest largest free block %d bytes, "
+              "worst fragmentation %.1f %%\n" % (
+                  info["min_free"], info["min_largest"],
+                  info["max_frag"] / 10.0))
+    if r["lost"]:
+        out.write("note: the first %d events were overwritten, the figures "
+                  "per task and per call site only cover the rest\n"
+                  % r["lost"])
+    if r["unmatched"]:
+        out.write("note: %d frees of blocks allocated before the first event "
+                  "left\n" % r["unmatched"])
+
+    out.write("\n%-16s %8s %8s %7s %10s %10s\n" % (
+        "task", "mallocs", "frees", "failed", "live", "peak"))
+    for handle, t in sorted(r["tasks"].items(),
+                            key=lambda kv: -kv[1]["peak"]):
+        out.write("%-16s %8d %8d %7d %10d %10d\n" % (
+            task_name(tasks, handle)[:16], t["mallocs"], t["frees"],
+            t["failed"], t["live"], t["peak"]))
+
+    if events:
+        t0, t1 = events[0]["time"], events[-1]["time"]
+        width = max(1, (t1 - t0 + buckets) // buckets)
+        rows = {}
+        for e in events:
+            b = (e["time"] - t0) // width
+            row = rows.setdefault(b, [heap, heap, 0.0])
+            row[0] = min(row[0], e["free"])
+            row[1] = min(row[1], e["largest"])
+            row[2] = max(row[2], fragmentation(e["free"], e["largest"]))
+        out.write("\n%10s %10s %10s %10s %7s\n" % (
+            "from", "in use", "free", "largest", "frag %"))
+        for b in sorted(rows):
+            free, largest, frag = rows[b]
+            out.write("%10d %10d %10d %10d %7.1f |%s\n" % (
+                t0 + b * width, heap - free, free, largest, frag,
+                "#" * int(round(frag * BAR / 100.0))))
+
+    sites = {}
+    for task, size, caller in r["peak_live"].values():
+        s = sites.setdefault(caller, [0, 0, set()])
+        s[0] += 1
+        s[1] += size
+        s[2].add(task_name(tasks, task))
+    if sites:
+        out.write("\nblocks live at the peak, by call site\n%18s %7s %10s  %s\n"
+                  % ("caller", "blocks", "bytes", "tasks"))
+        for caller, s in sorted(sites.items(), key=lambda kv: -kv[1][1]):
+            out.write("%18x %7d %10d  %s\n" % (caller, s[0], s[1],
+                                               ", ".join(sorted(s[2]))))
+
+
+def suggest(info, r, total, margin, align, out):
+    heap = r["heap"]
+    peak = heap - info["min_free"]
+    if total is not None:
+        overhead, how = total - heap, "lost by the heap, from --total-heap-size"
+    else:
+        overhead, how = 2 * align, "assumed, give --total-heap-size"
+    if r["span"] is not None:
+        need, basis = max(r["span"], peak), "span of the allocated bytes"
+    else:
+        need, basis = heap - r["slack"], "heap less the least spare room"
+    size = int((need + overhead) * (1.0 + margin))
+    size = (size + align - 1) // align * align
+
+    out.write("\nconfigTOTAL_HEAP_SIZE\n")
+    out.write("  %-34s %10d\n" % ("peak in use", peak))
+    if r["span"] is not None:
+        out.write("  %-34s %10d\n" % ("span of the allocated bytes",
+                                      r["span"]))
+    else:
+        out.write("  %-34s %10d\n" % ("least spare room in the largest "
+                                      "block", r["slack"]))
+    out.write("  %-34s %10d  (%s)\n" % ("overhead", overhead, how))
+    out.write("  %-34s %10d  (%s, +%g %%)\n" % ("suggested", size, basis,
+                                                 margin * 100))
+    if info["failed"]:
+        out.write("  note: %d allocations failed, the trace does not show "
+                  "how much more they needed\n" % info["failed"])
+    return size
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("report", help="captured report, - for stdin")
+    ap.add_argument("--buckets", type=int, default=16,
+                    help="rows of the fragmentation timeline (default 16)")
+    ap.add_argument("--total-heap-size", type=int,
+                    help="configTOTAL_HEAP_SIZE the trace was taken with")
+    ap.add_argument("--margin", type=float, default=0.1,
+                    help="fraction added to the suggested size "
+                         "(default 0.1)")
+    ap.add_argument("--align", type=int, default=8,
+                    help="portBYTE_ALIGNMENT, the suggestion is rounded up "
+                         "to it (default 8)")
+    args = ap.parse_args(argv)
+
+    try:
+        if args.report == "-":
+            info, events, tasks = parse(sys.stdin)
+        else:
+            with open(args.report, errors="replace") as f:
+                info, events, tasks = parse(f)
+    except OSError as e:
+        sys.stderr.write("%s\n" % e)
+        return 2
+    if info is None:
+        sys.stderr.write("%s: no heapinfo line found\n" % args.report)
+        return 2
+
+    r = replay(info, events, tasks)
+    report(info, events, tasks, r, max(1, args.buckets), sys.stdout)
+    suggest(info, r, args.total_heap_size, args.margin, args.align,
+            sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,288 @@
+#!/usr/bin/env python3
+"""Schedulability analysis for periodic task sets on one processor.
+
+    schedanalysis.py ../SIMSO/FinalProject.xml
+    schedanalysis.py tasks.json --scheduler FP --json
+
+Analyses:
+  FP   exact response time analysis for arbitrary deadlines (level-i busy
+       period, every job in it), plus time demand at the scheduling points.
+  EDF  processor demand analysis checked with QPA (Zhang and Burns, 2009)
+       over min(La, L), where L is the synchronous busy period.
+
+Task sets are read with taskset.load(), so SimSo XML and the JSON format
+described there are both accepted.  Offsets are ignored (the synchronous
+release is the worst case).  Tasks of equal fixed priority are assumed to
+interfere with each other, which is what FIFO ordering of a FreeRTOS ready
+list can produce when time slicing is off.
+
+All arithmetic is exact: parameters are scaled to integers using the least
+common denominator of their decimal values, so 4.3118 ms and 2.5 ms are not
+subject to rounding and the cost of every step is independent of the length
+of the hyperperiod.
+
+The exit status is 0 when every task set is schedulable, 1 when one is not
+and 2 on errors, so the script can be used as a build step.
+"""
+
+import argparse
+import json
+import math
+import sys
+from dataclasses import dataclass
+from fractions import Fraction
+from functools import reduce
+from typing import List, Optional
+
+import simulate
+import taskset as ts
+
+
+@dataclass
+class ITask:
+    """A task with integer parameters, in units of 1/scale ms."""
+    name: str
+    wcet: int
+    period: int
+    deadline: int
+    priority: int
+
+
+@dataclass
+class Result:
+    scheduler: str
+    schedulable: bool
+    utilisation: float
+    busy_period: Optional[float]
+    # FP: worst case response time per task (None if unbounded).
+    response: Optional[List[Optional[float]]] = None
+    # EDF: a deadline at which demand exceeds supply, if any.
+    failure: Optional[float] = None
+    checked_points: int = 0
+
+
+def integerise(taskset, ticks_per_ms=None):
+    """Scale a task set to integer units.
+
+    With ticks_per_ms the parameters are first quantised to kernel ticks the
+    way the Posix runner uses them, otherwise they are scaled exactly.
+    Returns (tasks, scale) where one unit is 1/scale ms.
+    """
+    if ticks_per_ms:
+        return ([ITask(t.name, t.wcet, t.period, t.deadline, t.priority)
+                 for t in simulate.quantise(taskset, ticks_per_ms)],
+                Fraction(ticks_per_ms).limit_denominator())
+    values = [Fraction(str(v)) for t in taskset.tasks
+              for v in (t.wcet, t.period, t.deadline)]
+    scale = reduce(lambda a, b: a * b // math.gcd(a, b),
+                   (v.denominator for v in values), 1)
+    tasks = [ITask(t.name, int(Fraction(str(t.wcet)) * scale),
+                   int(Fraction(str(t.period)) * scale),
+                   int(Fraction(str(t.deadline)) * scale), t.priority)
+             for t in taskset.tasks]
+    return tasks, scale
+
+
+def utilisation(tasks):
+    return sum(Fraction(t.wcet, t.period) for t in tasks)
+
+
+def _ceil_div(a, b):
+    return -(-a // b)
+
+
+def busy_period(tasks):
+    """Length of the synchronous busy period, None if U > 1."""
+    if utilisation(tasks) > 1:
+        return None
+    w = sum(t.wcet for t in tasks)
+    while True:
+        nxt = sum(_ceil_div(w, t.period) * t.wcet for t in tasks)
+        if nxt == w:
+            return w
+        w = nxt
+
+
+# -- Fixed priority ---------------------------------------------------------
+
+def response_time(task, interferers):
+    """Exact worst case response time of task under fixed priorities.
+
+    interferers are the tasks of higher or equal priority.  Every job of the
+    level-i busy period is examined, so deadlines may exceed periods.
+    Returns None if the response time is unbounded.
+    """
+    level = [task] + list(interferers)
+    if utilisation(level) > 1:
+        return None
+    length = busy_period(level)
+    jobs = _ceil_div(length, task.period)
+    worst = 0
+    w = task.wcet
+    for q in range(jobs):
+        # The completion of job q is at least that of job q - 1 plus C.
+        w = max(w, (q + 1) * task.wcet)
+        while True:
+            nxt = (q + 1) * task.wcet + sum(
+                _ceil_div(w, j.period) * j.wcet for j in interferers)
+            if nxt == w:
+                break
+            w = nxt
+        worst = max(worst, w - q * task.period)
+    return worst
+
+
+def analyse_fp(tasks):
+    response = []
+    for t in tasks:
+        hep = [j for j in tasks if j is not t and j.priority >= t.priority]
+        response.append(response_time(t, hep))
+    ok = all(r is not None and r <= t.deadline
+             for r, t in zip(response, tasks))
+    return response, ok
+
+
+def time_demand(task, higher):
+    """Time demand w(t) = C + sum ceil(t / Tj) Cj at the scheduling points.
+
+    The points are the multiples of the higher priority periods up to the
+    deadline, and the deadline itself; the task is schedulable (for D <= T)
+    if w(t) <= t at any of them.  Returns a list of (t, w(t)).
+    """
+    points = {task.deadline}
+    for j in higher:
+        points.update(range(j.period, task.deadline + 1, j.period))
+    return [(p, task.wcet + sum(_ceil_div(p, j.period) * j.wcet
+                                for j in higher))
+            for p in sorted(points)]
+
+
+# -- EDF ---------------------------------------------------------------------
+
+def demand(tasks, t):
+    """Processor demand bound function h(t)."""
+    return sum(((t - x.deadline) // x.period + 1) * x.wcet
+               for x in tasks if t >= x.deadline)
+
+
+def _last_deadline_before(tasks, t):
+    """Largest absolute deadline strictly smaller than t, or None."""
+    best = None
+    for x in tasks:
+        if t <= x.deadline:
+            continue
+        d = ((t - x.deadline - 1) // x.period) * x.period + x.deadline
+        if best is None or d > best:
+            best = d
+    return best
+
+
+def analyse_edf(tasks):
+    """QPA test.  Returns (schedulable, failure point, points checked)."""
+    u = utilisation(tasks)
+    if u > 1:
+        return False, None, 0
+    if all(t.deadline >= t.period for t in tasks):
+        return True, None, 0  # U <= 1 is exact for implicit deadlines
+
+    bound = busy_period(tasks)
+    if u < 1:
+        la = max(max(t.deadline - t.period for t in tasks),
+                 math.ceil(sum((t.period - t.deadline) * Fraction(t.wcet,
+                                                                  t.period)
+                               for t in tasks) / (1 - u)))
+        bound = min(bound, max(la, max(t.deadline for t in tasks)))
+
+    d_min = min(t.deadline for t in tasks)
+    t = _last_deadline_before(tasks, bound + 1)
+    checked = 0
+    while t is not None:
+        h = demand(tasks, t)
+        checked += 1
+        if h > t:
+            return False, t, checked
+        if h <= d_min:
+            return True, None, checked
+        t = h if h < t else _last_deadline_before(tasks, t)
+    return True, None, checked
+
+
+def analyse(taskset, ticks_per_ms=None, scheduler=None):
+    scheduler = scheduler or taskset.scheduler
+    tasks, scale = integerise(taskset, ticks_per_ms)
+    u = utilisation(tasks)
+    bp = busy_period(tasks)
+    result = Result(scheduler=scheduler, schedulable=False,
+                    utilisation=float(u),
+                    busy_period=None if bp is None else float(bp / scale))
+    if scheduler == "FP":
+        response, ok = analyse_fp(tasks)
+        result.response = [None if r is None else float(Fraction(r, 1) /
+                                                        scale)
+                           for r in response]
+        result.schedulable = ok
+    else:
+        ok, failure, checked = analyse_edf(tasks)
+        result.schedulable = ok
+        result.checked_points = checked
+        if failure is not None:
+            result.failure = float(Fraction(failure, 1) / scale)
+    return result
+
+
+def report(taskset, result, out):
+    out.write("%s  U = %.4f  busy period = %s\n" % (
+        result.scheduler, result.utilisation,
+        "unbounded" if result.busy_period is None
+        else "%g ms" % result.busy_period))
+    if result.response is not None:
+        out.write("%-16s %10s %10s %10s %4s %10s\n" % (
+            "task", "C", "T", "D", "prio", "R"))
+        for t, r in zip(taskset.tasks, result.response):
+            flag = "" if r is not None and r <= t.deadline else "  MISS"
+            out.write("%-16s %10g %10g %10g %4d %10s%s\n" % (
+                t.name[:16], t.wcet, t.period, t.deadline, t.priority,
+                "inf" if r is None else "%g" % r, flag))
+    elif result.failure is not None:
+        out.write("demand exceeds supply at t = %g ms\n" % result.failure)
+    elif result.checked_points:
+        out.write("QPA checked %d points\n" % result.checked_points)
+    out.write("%s\n" % ("schedulable" if result.schedulable
+                        else "NOT schedulable"))
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("taskset", nargs="+",
+                    help="SimSo XML or JSON task set file(s)")
+    ap.add_argument("--scheduler", choices=("EDF", "FP"),
+                    help="override the scheduler named in the file")
+    ap.add_argument("--ticks-per-ms", type=float,
+                    help="analyse the task set as quantised to kernel ticks "
+                         "(execution times rounded up)")
+    ap.add_argument("--json", action="store_true",
+                    help="print one JSON object per task set")
+    args = ap.parse_args(argv)
+
+    status = 0
+    for path in args.taskset:
+        try:
+            taskset = ts.load(path)
+            result = analyse(taskset, args.ticks_per_ms, args.scheduler)
+        except (ts.TaskSetError, OSError) as e:
+            sys.stderr.write("%s: %s\n" % (path, e))
+            return 2
+        if args.json:
+            doc = dict(result.__dict__, file=path,
+                       tasks=[t.name for t in taskset.tasks])
+            sys.stdout.write(json.dumps(doc) + "\n")
+        else:
+            sys.stdout.write("== %s\n" % path)
+            report(taskset, result, sys.stdout)
+        if not result.schedulable:
+            status = 1
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
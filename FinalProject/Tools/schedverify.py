@@ -0,0 +1,358 @@
+#!/usr/bin/env python3
+"""Kernel-in-the-loop schedule verifier.
+
+Runs a SimSo (or JSON) task set through the real kernel on the Posix port and
+compares the dispatch sequence the kernel produced against a SimSo equivalent
+reference schedule:
+
+    schedverify.py ../SIMSO/FinalProject.xml
+    schedverify.py "../../Tasks/Task Design Real System/Task_SIMSO.xml" --gantt
+    schedverify.py "../Project Folder/Posix_GCC/tasksets/semaphore_edf.tasks"
+
+The runner (FinalProject/Project Folder/Posix_GCC) is built on demand.  It
+creates one xTaskPeriodicCreate() task per SimSo task when the EDF scheduler is
+used and one xTaskCreate() task otherwise, and charges virtual execution time
+tick by tick, so the comparison is exact at tick resolution.
+
+Reported:
+  * divergent dispatches: ticks where the kernel ran a job that was not the
+    most urgent ready job (equal priority ties are not counted),
+  * deadline misses, split into those the reference also has and new ones,
+  * response time differences per job and worst case per task.
+
+A task set in the runner's own format (a .tasks file, see main.c) can use
+directives the SimSo model has no equivalent for, such as semaphores.  It is
+run as it is and its dispatch sequence and jobs must match the reference
+schedule kept next to it in a .ref file, line for line.
+
+The exit status is 0 when the kernel schedule is correct, 1 when it diverges
+or misses a deadline the reference meets (or any response time differs, with
+--strict), and 2 on usage or build errors, so the script can gate a batch run.
+"""
+
+import argparse
+import difflib
+import os
+import subprocess
+import sys
+import tempfile
+
+import simulate
+import taskset as ts
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+POSIX_DIR = os.path.join(HERE, os.pardir, "Project Folder", "Posix_GCC")
+
+# As in the FreeRTOSConfig.h of both the LPC2129 and the Posix project.
+EDF_IDLE_PERIOD = 100
+
+
+def runner_path(scheduler, build=True):
+    """Return the Posix runner for the scheduler, building it if asked."""
+    variant = "EDF" if scheduler == "EDF" else "FP"
+    if build:
+        subprocess.run(["make", "-s", "-C", POSIX_DIR, "SCHEDULER=" + variant],
+                       check=True, stdout=subprocess.DEVNULL)
+    return os.path.join(POSIX_DIR, "build", "RTOSSim_" + variant)
+
+
+def kernel_priorities(tasks, scheduler):
+    """Map SimSo priorities onto 1..N FreeRTOS priorities (0 is idle)."""
+    if scheduler == "EDF":
+        return [1] * len(tasks)
+    levels = sorted({t.priority for t in tasks})
+    return [levels.index(t.priority) + 1 for t in tasks]
+
+
+def write_task_file(path, tasks, duration, scheduler):
+    prios = kernel_priorities(tasks, scheduler)
+    with open(path, "w") as f:
+        f.write("duration %d\n" % duration)
+        for t, prio in zip(tasks, prios):
+            name = "".join(c if c.isalnum() else "_" for c in t.name)
+            f.write("task %s %d %d %d %d %d\n" % (name, t.offset, t.wcet,
+                                                   t.period, t.deadline, prio))
+
+
+# Runner exit status when a real timer tick got in before virtual time was
+# started (a loaded host); the run is repeated.
+EXIT_REAL_TICK = 3
+RUN_ATTEMPTS = 10
+
+
+def run_runner(runner, path):
+    """Run the runner on a task file and return its output."""
+    for _ in range(RUN_ATTEMPTS):
+        proc = subprocess.run([runner, path], timeout=600,
+                              stdout=subprocess.PIPE,
+                              stderr=subprocess.PIPE,
+                              universal_newlines=True)
+        if proc.returncode != EXIT_REAL_TICK:
+            break
+    if proc.returncode != 0:
+        raise RuntimeError("runner failed (%d): %s" % (proc.returncode,
+                                                      proc.stderr.strip()))
+    return proc.stdout
+
+
+def run_kernel(runner, tasks, duration, scheduler):
+    """Run the task set on the kernel, return (switches, jobs)."""
+    fd, path = tempfile.mkstemp(suffix=".tasks")
+    os.close(fd)
+    try:
+        write_task_file(path, tasks, duration, scheduler)
+        out = run_runner(runner, path)
+    finally:
+        os.unlink(path)
+
+    switches, jobs = [], []
+    for line in out.splitlines():
+        fields = line.split()
+        if fields[0] == "switch":
+            switches.append((int(fields[1]), int(fields[2]) - 1))
+        elif fields[0] == "job":
+            jobs.append((int(fields[1]) - 1, int(fields[2]), int(fields[3])))
+        elif fields[0] == "overflow":
+            raise RuntimeError("runner trace buffer overflowed")
+    return switches, jobs
+
+
+def compare(tasks, scheduler, ref, kern):
+    """Return a dict describing the differences between ref and kern."""
+    result = {"divergent": [], "ties": 0, "new_misses": [],
+              "expected_misses": [], "response": []}
+
+    # A dispatch diverges when the kernel ran something other than the most
+    # urgent job it had ready (judged on the kernel's own ready set, so one
+    # divergence is not reported again for every tick it displaces later).
+    def urgency(job):
+        return simulate.job_key(scheduler, job, tasks)[0]
+
+    run = None
+    for now, owner in enumerate(kern.owners):
+        ready = kern.ready[now]
+        bad = None
+        if ready:
+            best = min(ready, key=urgency)
+            running = next((j for j in ready if j.task == owner), None)
+            if running is None or urgency(running) != urgency(best):
+                bad = (owner, best.task)
+        if bad and run and run[2] == bad and run[1] == now:
+            run[1] = now + 1
+        elif bad:
+            run = [now, now + 1, bad]
+            result["divergent"].append(run)
+        else:
+            run = None
+        if not bad and owner != ref.owners[now]:
+            result["ties"] += 1
+
+    ref_jobs = {(j.task, j.index): j for j in ref.jobs}
+    for j in kern.jobs:
+        r = ref_jobs.get((j.task, j.index))
+        if j.deadline > len(kern.owners):
+            continue  # deadline beyond the end of the run
+        if j.missed:
+            (result["expected_misses"] if r and r.missed
+             else result["new_misses"]).append(j)
+        if r and j.response != r.response:
+            result["response"].append((j, r))
+    return result
+
+
+def worst_response(jobs, ntasks):
+    worst = [None] * ntasks
+    for j in jobs:
+        if j.response is not None and (worst[j.task] is None or
+                                       j.response > worst[j.task]):
+            worst[j.task] = j.response
+    return worst
+
+
+def gantt(tasks, ref, kern, width=100):
+    """ASCII chart of both schedules, one row per task."""
+    lines = []
+    duration = len(ref.owners)
+    for start in range(0, duration, width):
+        stop = min(duration, start + width)
+        lines.append("tick %d..%d" % (start, stop))
+        for i, t in enumerate(tasks):
+            for label, s in (("ref", ref), ("krn", kern)):
+                row = "".join("#" if s.owners[k] == i else "."
+                              for k in range(start, stop))
+                lines.append("  %-12s %s |%s|" % (t.name[:12], label, row))
+    return "\n".join(lines)
+
+
+def report(tasks, scheduler, ref, kern, diff, ticks_per_ms, out):
+    def ms(ticks):
+        return "%g ms" % (ticks / ticks_per_ms)
+
+    name = [t.name for t in tasks] + ["idle"]
+    for start, stop, (owner, best) in diff["divergent"]:
+        out.write("DIVERGENT  tick %d..%d: kernel ran %s while %s was more "
+                  "urgent\n" % (start, stop, name[owner], name[best]))
+    for j in diff["new_misses"]:
+        done = "completed at %d" % j.completion if j.completion is not None \
+            else "not completed"
+        out.write("MISS       %s job %d released %d deadline %d %s "
+                  "(reference meets it)\n" % (name[j.task], j.index,
+                                              j.release, j.deadline, done))
+    for j in diff["expected_misses"]:
+        out.write("miss       %s job %d deadline %d (also missed by the "
+                  "reference)\n" % (name[j.task], j.index, j.deadline))
+    for j, r in diff["response"]:
+        out.write("response   %s job %d: kernel %s, reference %s\n"
+                  % (name[j.task], j.index,
+                     "-" if j.response is None else j.response,
+                     "-" if r.response is None else r.response))
+
+    wk = worst_response(kern.jobs, len(tasks))
+    wr = worst_response(ref.jobs, len(tasks))
+    out.write("\n%-16s %6s %6s %6s %10s %10s\n" % ("task", "C", "T", "D",
+                                                   "R ref", "R kernel"))
+    for i, t in enumerate(tasks):
+        out.write("%-16s %6d %6d %6d %10s %10s\n" % (
+            t.name[:16], t.wcet, t.period, t.deadline,
+            "-" if wr[i] is None else wr[i], "-" if wk[i] is None else wk[i]))
+    out.write("\n%s, %d ticks (%s), %d divergent intervals, %d tie "
+              "ticks, %d new misses, %d response differences\n"
+              % (scheduler, len(ref.owners), ms(len(ref.owners)),
+                 len(diff["divergent"]), diff["ties"],
+                 len(diff["new_misses"]), len(diff["response"])))
+
+
+def edf_notes(tasks):
+    """Known limits of the EDF kernel that explain some divergences."""
+    notes = []
+    for t in tasks:
+        if t.deadline != t.period:
+            notes.append("%s has D != T, the kernel uses the period as "
+                         "relative deadline" % t.name)
+        if t.period >= EDF_IDLE_PERIOD:
+            notes.append("%s has a period of %d ticks, not below "
+                         "EDF_IDLE_PERIOD (%d), the idle task can run ahead "
+                         "of it" % (t.name, t.period, EDF_IDLE_PERIOD))
+        if t.offset:
+            notes.append("%s has an offset, emulated by a first "
+                         "vTaskDelayUntil() that only blocks once the task's "
+                         "creation deadline is the earliest" % t.name)
+    return notes
+
+
+def verify(taskset, ticks_per_ms=1.0, duration_ms=None, runner=None,
+           build=True):
+    """Run the whole comparison; returns (tasks, ref, kern, diff)."""
+    tasks = simulate.quantise(taskset, ticks_per_ms)
+    duration_ms = duration_ms or taskset.duration or taskset.hyperperiod()
+    duration = int(round(duration_ms * ticks_per_ms))
+    runner = runner or runner_path(taskset.scheduler, build)
+
+    switches, jobs = run_kernel(runner, tasks, duration, taskset.scheduler)
+    owners = simulate.owners_from_switches(switches, duration)
+    kern = simulate.replay(tasks, duration, owners)
+
+    # The runner records completions itself, they must agree with the ones
+    # rebuilt from the dispatch sequence or the trace cannot be trusted.
+    replayed = sorted((j.task, j.release, j.completion) for j in kern.jobs
+                      if j.completion is not None)
+    if replayed != sorted(jobs):
+        raise RuntimeError("dispatch trace and job records disagree")
+    ref = simulate.simulate(tasks, duration, taskset.scheduler)
+    return tasks, ref, kern, compare(tasks, taskset.scheduler, ref, kern)
+
+
+def trace_lines(lines):
+    """The switch, job and overflow lines of a runner trace."""
+    kept = []
+    for line in lines:
+        fields = line.split()
+        if fields and fields[0] in ("switch", "job", "overflow"):
+            kept.append(" ".join(fields))
+    return kept
+
+
+def verify_runner_file(path, runner=None, build=True):
+    """Run a runner task file, return (scheduler, trace, differences)."""
+    scheduler = "EDF"
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) == 2 and fields[0] == "scheduler":
+                scheduler = fields[1]
+    with open(os.path.splitext(path)[0] + ".ref") as f:
+        expected = trace_lines(f)
+
+    runner = runner or runner_path(scheduler, build)
+    got = trace_lines(run_runner(runner, path).splitlines())
+    diff = list(difflib.unified_diff(expected, got, "reference", "kernel",
+                                     lineterm="", n=2))
+    return scheduler, got, diff
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("taskset", nargs="+",
+                    help="SimSo XML or JSON task set file(s), or runner "
+                         ".tasks files with a .ref reference schedule")
+    ap.add_argument("--ticks-per-ms", type=float, default=1.0,
+                    help="kernel ticks per SimSo millisecond (default 1, "
+                         "configTICK_RATE_HZ 1000)")
+    ap.add_argument("--duration", type=float,
+                    help="simulated time in ms (default: the SimSo duration, "
+                         "else one hyperperiod)")
+    ap.add_argument("--scheduler", choices=("EDF", "FP"),
+                    help="override the scheduler named in the file")
+    ap.add_argument("--runner", help="use this runner binary instead of "
+                                     "building the Posix project")
+    ap.add_argument("--gantt", action="store_true",
+                    help="print both schedules as ASCII charts")
+    ap.add_argument("--strict", action="store_true",
+                    help="fail on any response time difference")
+    args = ap.parse_args(argv)
+
+    status = 0
+    for path in args.taskset:
+        if path.endswith(".tasks"):
+            try:
+                scheduler, got, diff = verify_runner_file(path, args.runner)
+            except (OSError, RuntimeError, subprocess.SubprocessError) as e:
+                sys.stderr.write("%s: %s\n" % (path, e))
+                return 2
+            sys.stdout.write("== %s\n" % path)
+            for line in diff:
+                sys.stdout.write(line + "\n")
+            sys.stdout.write("%s, %d trace lines, %s\n" % (
+                scheduler, len(got),
+                "differs from the reference" if diff else
+                "matches the reference"))
+            if diff:
+                status = 1
+            continue
+        try:
+            taskset = ts.load(path)
+            if args.scheduler:
+                taskset.scheduler = args.scheduler
+            tasks, ref, kern, diff = verify(taskset, args.ticks_per_ms,
+                                            args.duration, args.runner)
+        except (ts.TaskSetError, OSError, RuntimeError,
+                subprocess.SubprocessError) as e:
+            sys.stderr.write("%s: %s\n" % (path, e))
+            return 2
+
+        sys.stdout.write("== %s\n" % path)
+        if taskset.scheduler == "EDF":
+            for note in edf_notes(tasks):
+                sys.stdout.write("note       %s\n" % note)
+        report(tasks, taskset.scheduler, ref, kern, diff, args.ticks_per_ms,
+               sys.stdout)
+        if args.gantt:
+            sys.stdout.write("\n" + gantt(tasks, ref, kern) + "\n")
+        if diff["divergent"] or diff["new_misses"] or \
+                (args.strict and diff["response"]):
+            status = 1
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,174 @@
+"""Tick quantised reference scheduler.
+
+The reference follows the same job model as SimSo with zero overheads:
+periodic jobs released at offset + k * period, preemptive scheduling, the
+highest priority ready job runs.  Time advances in whole kernel ticks because
+that is the resolution at which the kernel can release and preempt jobs, so a
+reference schedule computed here and a kernel trace from the Posix runner can
+be compared tick by tick.
+
+Priority keys:
+  EDF  absolute deadline, then release time (FIFO among equal deadlines, as in
+       xReadyTasksListEDF), then task order.
+  FP   fixed priority (larger is more urgent), then release time, then task
+       order.
+"""
+
+import heapq
+import math
+from dataclasses import dataclass, field
+from typing import List, Optional
+
+IDLE = -1
+
+
+@dataclass
+class TickTask:
+    name: str
+    offset: int
+    wcet: int
+    period: int
+    deadline: int
+    priority: int
+
+
+@dataclass
+class Job:
+    task: int
+    index: int
+    release: int
+    deadline: int
+    remaining: int
+    completion: Optional[int] = None
+
+    @property
+    def response(self):
+        if self.completion is None:
+            return None
+        return self.completion - self.release
+
+    @property
+    def missed(self):
+        return self.completion is None or self.completion > self.deadline
+
+
+@dataclass
+class Schedule:
+    """owners[t] is the task running during tick [t, t + 1), IDLE if none."""
+    owners: List[int] = field(default_factory=list)
+    jobs: List[Job] = field(default_factory=list)
+    # ready[t] is the list of jobs pending at the start of tick t.
+    ready: List[List[Job]] = field(default_factory=list)
+
+
+def quantise(taskset, ticks_per_ms=1.0):
+    """Convert a millisecond TaskSet to whole ticks.
+
+    Execution times are rounded up (a job cannot complete inside a tick it
+    has only partly used) and periods, deadlines and offsets to the nearest
+    tick, which is what vTaskDelayUntil() can express.
+    """
+    ticks = []
+    for t in taskset.tasks:
+        ticks.append(TickTask(
+            name=t.name,
+            offset=int(round(t.offset * ticks_per_ms)),
+            wcet=max(1, int(math.ceil(t.wcet * ticks_per_ms - 1e-9))),
+            period=max(1, int(round(t.period * ticks_per_ms))),
+            deadline=max(1, int(round(t.deadline * ticks_per_ms))),
+            priority=t.priority))
+    return ticks
+
+
+def job_key(scheduler, job, tasks):
+    if scheduler == "EDF":
+        return (job.deadline, job.release, job.task)
+    return (-tasks[job.task].priority, job.release, job.task)
+
+
+def _releases(tasks, duration):
+    """Heap of (release, task) for every job released before duration."""
+    heap = [(t.offset, i) for i, t in enumerate(tasks) if t.offset < duration]
+    heapq.heapify(heap)
+    return heap
+
+
+def _release_due(tasks, heap, now, jobs, pending, counters):
+    while heap and heap[0][0] <= now:
+        release, i = heapq.heappop(heap)
+        t = tasks[i]
+        job = Job(task=i, index=counters[i], release=release,
+                  deadline=release + t.deadline, remaining=t.wcet)
+        counters[i] += 1
+        jobs.append(job)
+        pending[i].append(job)
+        heapq.heappush(heap, (release + t.period, i))
+
+
+def simulate(tasks, duration, scheduler="EDF", keep_ready=False):
+    """Compute the reference schedule over [0, duration) ticks."""
+    heap = _releases(tasks, duration)
+    pending = [[] for _ in tasks]
+    counters = [0] * len(tasks)
+    sched = Schedule()
+
+    for now in range(duration):
+        _release_due(tasks, heap, now, sched.jobs, pending, counters)
+        # Only the oldest job of a task can run, later ones queue behind it
+        # exactly as they do behind a task that has not reached its next
+        # vTaskDelayUntil() yet.
+        heads = [p[0] for p in pending if p]
+        if keep_ready:
+            sched.ready.append(heads)
+        if not heads:
+            sched.owners.append(IDLE)
+            continue
+        job = min(heads, key=lambda j: job_key(scheduler, j, tasks))
+        sched.owners.append(job.task)
+        job.remaining -= 1
+        if job.remaining == 0:
+            job.completion = now + 1
+            pending[job.task].pop(0)
+    return sched
+
+
+def replay(tasks, duration, owners):
+    """Rebuild job completions and ready sets from an observed schedule.
+
+    owners is the per tick running task, as recorded from the kernel.  A tick
+    given to a task without pending work (or to the idle task) is wasted.
+    """
+    heap = _releases(tasks, duration)
+    pending = [[] for _ in tasks]
+    counters = [0] * len(tasks)
+    sched = Schedule(owners=list(owners))
+
+    for now in range(duration):
+        _release_due(tasks, heap, now, sched.jobs, pending, counters)
+        sched.ready.append([p[0] for p in pending if p])
+        owner = owners[now]
+        if owner != IDLE and pending[owner]:
+            job = pending[owner][0]
+            job.remaining -= 1
+            if job.remaining == 0:
+                job.completion = now + 1
+                pending[owner].pop(0)
+    return sched
+
+
+def owners_from_switches(switches, duration):
+    """Expand (tick, task) switch events into a per tick owner list.
+
+    When several switches happen at the same tick the last one is the task
+    that actually ran, the others were zero length dispatches.
+    """
+    owners = [IDLE] * duration
+    events = sorted(switches, key=lambda e: e[0])
+    current = IDLE
+    j = 0
+    for now in range(duration):
+        while j < len(events) and events[j][0] <= now:
+            current = events[j][1]
+            j += 1
+        owners[now] = current
+    return owners
@@ -0,0 +1,214 @@
+"""Task set model shared by the FinalProject scheduling tools.
+
+Task sets are read from SimSo XML files (as saved by the SimSo GUI, see
+FinalProject/SIMSO/FinalProject.xml) or from an equivalent JSON document:
+
+    {
+        "scheduler": "EDF",            # or "FP"
+        "duration": 100.0,             # ms, optional
+        "tasks": [
+            {"name": "T1", "wcet": 2.0, "period": 10.0,
+             "deadline": 10.0, "offset": 0.0, "priority": 3},
+            ...
+        ]
+    }
+
+All times are in milliseconds, as in SimSo.  For fixed priority scheduling a
+larger priority value means a more urgent task, which is both the SimSo and the
+FreeRTOS convention.  "deadline" defaults to the period, "offset" to zero.
+"""
+
+import json
+import math
+import xml.etree.ElementTree as ET
+from dataclasses import dataclass, field
+from fractions import Fraction
+from functools import reduce
+from typing import List, Optional
+
+
+class TaskSetError(ValueError):
+    """Raised when a task set file cannot be used."""
+
+
+@dataclass
+class Task:
+    name: str
+    wcet: float
+    period: float
+    deadline: Optional[float] = None
+    offset: float = 0.0
+    priority: int = 0
+
+    def __post_init__(self):
+        if self.deadline is None:
+            self.deadline = self.period
+        if self.wcet <= 0 or self.period <= 0 or self.deadline <= 0:
+            raise TaskSetError("task %s: wcet, period and deadline must be "
+                               "positive" % self.name)
+
+    @property
+    def utilisation(self):
+        return self.wcet / self.period
+
+
+@dataclass
+class TaskSet:
+    tasks: List[Task] = field(default_factory=list)
+    scheduler: str = "EDF"
+    duration: Optional[float] = None
+
+    @property
+    def utilisation(self):
+        return sum(t.utilisation for t in self.tasks)
+
+    def hyperperiod(self):
+        """Least common multiple of the periods, in ms (exact for decimals)."""
+        periods = [Fraction(str(t.period)) for t in self.tasks]
+        num = reduce(_lcm, (p.numerator for p in periods), 1)
+        den = reduce(math.gcd, (p.denominator for p in periods), 0) or 1
+        return float(Fraction(num, den))
+
+    def by_priority(self):
+        """Tasks sorted from most to least urgent fixed priority."""
+        return sorted(self.tasks, key=lambda t: -t.priority)
+
+
+def _lcm(a, b):
+    return a * b // math.gcd(a, b)
+
+
+def load(path):
+    """Load a task set from a SimSo XML or a JSON file."""
+    with open(path, "rb") as f:
+        head = f.read(64).lstrip()
+    if head.startswith(b"<"):
+        return load_simso(path)
+    return load_json(path)
+
+
+def load_simso(path):
+    try:
+        root = ET.parse(path).getroot()
+    except ET.ParseError as e:
+        raise TaskSetError("%s: %s" % (path, e))
+    if root.tag != "simulation":
+        raise TaskSetError("%s: not a SimSo simulation file" % path)
+
+    sched = root.find("sched")
+    cls = sched.get("class", "") if sched is not None else ""
+    policy = cls.rsplit(".", 1)[-1]
+    scheduler = "FP" if policy in ("FP", "RM", "DM") else "EDF"
+
+    duration = None
+    cycles_per_ms = float(root.get("cycles_per_ms", "0") or 0)
+    if cycles_per_ms and root.get("duration"):
+        duration = float(root.get("duration")) / cycles_per_ms
+
+    tasks = []
+    for node in root.iter("task"):
+        name = node.get("name") or "T%s" % node.get("id")
+        kind = node.get("task_type", "Periodic")
+        if kind != "Periodic":
+            raise TaskSetError("%s: task %s is %s, only periodic tasks are "
+                               "supported" % (path, name, kind))
+        tasks.append(Task(name=name,
+                          wcet=float(node.get("WCET")),
+                          period=float(node.get("period")),
+                          deadline=float(node.get("deadline") or
+                                         node.get("period")),
+                          offset=float(node.get("activationDate") or 0),
+                          priority=int(float(node.get("priority", "0")))))
+    if not tasks:
+        raise TaskSetError("%s: no tasks" % path)
+    if policy in ("RM", "DM"):
+        assign_priorities(tasks, policy)
+    return TaskSet(tasks=tasks, scheduler=scheduler, duration=duration)
+
+
+def assign_priorities(tasks, policy="RM"):
+    """Rate (RM) or deadline (DM) monotonic priorities, most urgent highest.
+
+    Equal periods (deadlines) share a priority level, as SimSo's RM and DM
+    schedulers do not order them either.
+    """
+    attr = "period" if policy == "RM" else "deadline"
+    levels = sorted({getattr(t, attr) for t in tasks}, reverse=True)
+    for t in tasks:
+        t.priority = levels.index(getattr(t, attr)) + 1
+
+
+def load_json(path):
+    try:
+        with open(path) as f:
+            doc = json.load(f)
+    except ValueError as e:
+        raise TaskSetError("%s: %s" % (path, e))
+    try:
+        tasks = [Task(name=str(t.get("name", "T%d" % (i + 1))),
+                      wcet=float(t["wcet"]),
+                      period=float(t["period"]),
+                      deadline=(float(t["deadline"]) if "deadline" in t
+                                else None),
+                      offset=float(t.get("offset", 0.0)),
+                      priority=int(t.get("priority", 0)))
+                 for i, t in enumerate(doc["tasks"])]
+    except (KeyError, TypeError) as e:
+        raise TaskSetError("%s: malformed task entry (%s)" % (path, e))
+    if not tasks:
+        raise TaskSetError("%s: no tasks" % path)
+    return TaskSet(tasks=tasks,
+                   scheduler=str(doc.get("scheduler", "EDF")).upper(),
+                   duration=doc.get("duration"))
+
+
+def to_json(taskset):
+    return json.dumps({
+        "scheduler": taskset.scheduler,
+        "duration": taskset.duration,
+        "tasks": [{"name": t.name, "wcet": t.wcet, "period": t.period,
+                   "deadline": t.deadline, "offset": t.offset,
+                   "priority": t.priority} for t in taskset.tasks],
+    }, indent=2)
+
+
+def to_simso(taskset, cycles_per_ms=1000000):
+    """Render a task set as a SimSo XML document (returned as a string)."""
+    sched = "simso.schedulers.%s" % ("FP" if taskset.scheduler == "FP"
+                                     else "EDF")
+    duration = taskset.duration or taskset.hyperperiod()
+    lines = ['<?xml version="1.0" ?>',
+             '<simulation cycles_per_ms="%d" duration="%d" etm="wcet">'
+             % (cycles_per_ms, round(duration * cycles_per_ms)),
+             '\t<sched class="%s" overhead="0" overhead_activate="0" '
+             'overhead_terminate="0"/>' % sched,
+             '\t<caches memory_access_time="100"/>',
+             '\t<processors>',
+             '\t\t<processor cl_overhead="0" cs_overhead="0" id="1" '
+             'name="CPU 1" speed="1.0"/>',
+             '\t</processors>',
+             '\t<tasks>']
+    if taskset.scheduler == "FP":
+        lines.append('\t\t<field name="priority" type="int"/>')
+    for i, t in enumerate(taskset.tasks):
+        prio = ' priority="%d"' % t.priority if taskset.scheduler == "FP" \
+            else ""
+        lines.append(
+            '\t\t<task ACET="0.0" WCET="%s" abort_on_miss="no" '
+            'activationDate="%s" base_cpi="1.0" deadline="%s" '
+            'et_stddev="0.0" id="%d" instructions="0" '
+            'list_activation_dates="" mix="0.5" name="%s" period="%s" '
+            'preemption_cost="0"%s task_type="Periodic"/>'
+            % (_num(t.wcet), _num(t.offset), _num(t.deadline), i + 1,
+               _xml_escape(t.name), _num(t.period), prio))
+    lines += ['\t</tasks>', '</simulation>', '']
+    return "\n".join(lines)
+
+
+def _num(value):
+    return repr(float(value))
+
+
+def _xml_escape(text):
+    return (text.replace("&", "&amp;").replace("<", "&lt;")
+            .replace('"', "&quot;"))
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Turn measured job execution times into a SimSo task set.
+
+    wcetstats.py uart.log --counter-hz 59940 -o measured.xml
+    RTOSSim_EDF tasks.txt | wcetstats.py - --counter-hz 1000000 --json
+
+The input is the output of vTaskGetJobTimeStatsText() (configGENERATE_JOB_TIME_STATS),
+captured from the board's UART, or the "jobtime" lines printed by the Posix
+runner.  Each line gives, for one task:
+
+    name  period  jobs  min  max  mean  bin0,bin1,...  [bin width]
+
+with the period in ticks and the times in run time counter units.  Other lines
+are ignored, so a whole log can be passed in.  That includes the runner's other
+lines (switch, job, overflow, units, section, heaptask, heapinfo and heap),
+some of which have as many fields, so a task named like one of those tags must
+be read from "jobtime" lines.  When a task appears more than once the last
+line wins, as every report is cumulative.
+
+--counter-hz is the frequency of the run time counter: PCLK / (T1PR + 1) for
+T1TC on the LPC2129 (59940 Hz with the 60 MHz PCLK and T1PR = 1000 of the
+starter files), the resolution times the tick rate for the Posix runner.
+
+The measured maximum, plus --margin, becomes the WCET of the exported task.
+"""
+
+import argparse
+import sys
+
+import taskset as ts
+
+SPARK = " .:-=+*#%@"
+
+# Tags of the Posix runner's lines other than "jobtime".
+RUNNER_TAGS = {"switch", "job", "overflow", "units", "section", "heaptask",
+               "heapinfo", "heap"}
+
+
+def parse(lines):
+    """Return {name: record} from report lines."""
+    records = {}
+    for line in lines:
+        fields = line.split()
+        if not fields or fields[0] in RUNNER_TAGS:
+            continue
+        if fields[0] == "jobtime":
+            fields = fields[1:]
+        if len(fields) not in (7, 8):
+            continue
+        try:
+            period, jobs, lo, hi, mean = (int(f) for f in fields[1:6])
+            histogram = [int(b) for b in fields[6].split(",")]
+            width = int(fields[7]) if len(fields) == 8 else None
+        except ValueError:
+            continue
+        records[fields[0]] = {"period": period, "jobs": jobs, "min": lo,
+                              "max": hi, "mean": mean,
+                              "histogram": histogram, "width": width}
+    return records
+
+
+def to_taskset(records, counter_hz, tick_hz, margin, scheduler):
+    ms_per_count = 1000.0 / counter_hz
+    ms_per_tick = 1000.0 / tick_hz
+    tasks = [ts.Task(name=name,
+                     wcet=round(r["max"] * ms_per_count * (1 + margin), 6),
+                     period=r["period"] * ms_per_tick)
+             for name, r in records.items()]
+    if scheduler == "FP":
+        ts.assign_priorities(tasks, "RM")
+    return ts.TaskSet(tasks=tasks, scheduler=scheduler)
+
+
+def sparkline(histogram):
+    top = max(histogram) or 1
+    return "".join(SPARK[0 if n == 0 else
+                         1 + (len(SPARK) - 2) * n // top]
+                   for n in histogram)
+
+
+def report(records, counter_hz, out):
+    ms = 1000.0 / counter_hz
+    out.write("%-16s %8s %7s %10s %10s %10s  %s\n" % (
+        "task", "T ticks", "jobs", "min ms", "mean ms", "max ms",
+        "histogram"))
+    for name, r in records.items():
+        bins = sparkline(r["histogram"])
+        if r["width"]:
+            bins += "  (%g ms per bin)" % (r["width"] * ms)
+        out.write("%-16s %8d %7d %10.4f %10.4f %10.4f  |%s\n" % (
+            name[:16], r["period"], r["jobs"], r["min"] * ms,
+            r["mean"] * ms, r["max"] * ms, bins))
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("report", help="captured report, - for stdin")
+    ap.add_argument("--counter-hz", type=float, required=True,
+                    help="run time counter frequency")
+    ap.add_argument("--tick-hz", type=float, default=1000.0,
+                    help="configTICK_RATE_HZ (default 1000)")
+    ap.add_argument("--margin", type=float, default=0.0,
+                    help="fraction added to the measured maximum, e.g. 0.2")
+    ap.add_argument("--scheduler", choices=("EDF", "FP"), default="EDF",
+                    help="scheduler of the exported set; FP gets rate "
+                         "monotonic priorities")
+    ap.add_argument("-o", "--output",
+                    help="write the SimSo XML task set to this file")
+    ap.add_argument("--json", action="store_true",
+                    help="write the task set as JSON to stdout instead of "
+                         "the table")
+    args = ap.parse_args(argv)
+
+    try:
+        if args.report == "-":
+            records = parse(sys.stdin)
+        else:
+            with open(args.report, errors="replace") as f:
+                records = parse(f)
+    except OSError as e:
+        sys.stderr.write("%s\n" % e)
+        return 2
+    if not records:
+        sys.stderr.write("%s: no job time statistics found\n" % args.report)
+        return 2
+
+    taskset = to_taskset(records, args.counter_hz, args.tick_hz, args.margin,
+                         args.scheduler)
+    if args.json:
+        sys.stdout.write(ts.to_json(taskset) + "\n")
+    else:
+        report(records, args.counter_hz, sys.stdout)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(ts.to_simso(taskset))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,63 +1,39 @@
-import math
+import os
+import sys
 
-class Task:
-    def __init__(self,periodicity,executionTime):
-        self.periodicity = periodicity
-        self.executionTime = executionTime
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(HERE, os.pardir, os.pardir, "FinalProject", "Tools"))
 
+import schedanalysis
+import taskset
 
-e1 = 2.5
-p1 = 5
 
-e2 = 4.5
-p2 = 15
+# T1 (2.5, 5), T2 (4.5, 15), T3 (3.5, 20) under rate monotonic priorities.
+TASKSET = os.path.join(HERE, "TaskSchedulingandTypeofSchedulers.xml")
 
-e3 = 3.5
-p3 = 20
 
+def time_demand_table(tasks, scale):
+    """[t, w(t), exceededDeadline] per task at its scheduling points.
 
-def W_T1(t):
-    w = e1
-    if(w > p1):
-        exceededDeadline = True
-    else:
-        exceededDeadline = False
-    return[t,w,exceededDeadline]
-
-def W_T2(t):
-    w = e2 + ((math.ceil(float(t)/p1))*e1) 
-    if(w > p3):
-        exceededDeadline = True
-    else:
-        exceededDeadline = False
-    return [t,w,exceededDeadline]
-
-def W_T3(t):
-    w = e3 + ((math.ceil(float(t)/p2))*e2) +((math.ceil(float(t)/p1))*e1) 
-    if(w > p3):
-        exceededDeadline = True
-    else:
-        exceededDeadline = False
-    return [t,w,exceededDeadline]
+    Every task is checked against its own deadline; the points are the
+    multiples of the higher priority periods, where w(t) can step, instead
+    of whole milliseconds.
+    """
+    tables = []
+    for task in tasks:
+        higher = [j for j in tasks if j is not task and j.priority >= task.priority]
+        tables.append([[float(t / scale), float(w / scale), w > t]
+                       for t, w in schedanalysis.time_demand(task, higher)])
+    return tables
 
 
+if __name__ == "__main__":
 
+    ts = taskset.load(TASKSET)
+    tasks, scale = schedanalysis.integerise(ts)
 
-if __name__ == "__main__":
+    for task, table in zip(tasks, time_demand_table(tasks, scale)):
+        print(task.name, table)
+        print('\n')
 
-    T1_list = list()
-    T2_list = list()
-    T3_list = list()
-
-    for t in range(1,p1+1):
-        T1_list.append(W_T1(t))
-    for t in range(1,p2+1):
-        T2_list.append(W_T2(t))
-    for t in range(1,p3+1):
-        T3_list.append(W_T3(t))
-
-    print(T1_list)
-    print('\n')
-    print(T2_list)
-    print('\n')
-    print(T3_list)
\ No newline at end of file
+    schedanalysis.report(ts, schedanalysis.analyse(ts), sys.stdout)